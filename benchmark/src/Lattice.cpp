@@ -39,6 +39,7 @@
 #include "benchmark/benchmark.h"
 #include "lattice/lat-hal.h"
 #include "math/discreteuniformgenerator.h"
+#include "utils/cpufeatures.h"
 
 #include <iostream>
 #include <map>
@@ -417,5 +418,176 @@ DO_POLY_BENCHMARK(BM_switchformat_LATTICE, M6DCRTPoly)
 DO_POLY_BENCHMARK(BM_doubleswitchformat_LATTICE, M6DCRTPoly)
 #endif
 
+// RNS basis conversions at every SIMD level (the level is restored on exit). The conversion constants are
+// random values in the right ranges, which is all the running time depends on.
+constexpr uint32_t BASECONV_ORDER{32768};
+
+static void BaseConvArguments(benchmark::internal::Benchmark* b) {
+    b->ArgNames({"simd", "towers", "bits"});
+    for (int level : {SIMD_SCALAR, SIMD_AVX2, SIMD_AVX512, SIMD_AVX512IFMA}) {
+        for (int towers : {4, 8, 16}) {
+            for (int bits : {50, 60})
+                b->Args({level, towers, bits});
+        }
+    }
+}
+
+static bool SetBaseConvSIMDLevel(benchmark::State& state, SIMDLevel& saved) {
+    auto level{static_cast<SIMDLevel>(state.range(0))};
+    if (level > OpenFHESIMDControls.GetSupportedLevel()) {
+        state.SkipWithError("SIMD level is not supported by the CPU");
+        return false;
+    }
+    saved = OpenFHESIMDControls.GetLevel();
+    OpenFHESIMDControls.SetLevel(level);
+    return true;
+}
+
+// splits the moduli of params into consecutive ranges of the given sizes
+static std::vector<std::shared_ptr<ILDCRTParams<BigInteger>>> SplitParams(
+    const std::shared_ptr<ILDCRTParams<BigInteger>>& params, const std::vector<uint32_t>& sizes,
+    std::vector<std::vector<NativeInteger>>& moduli) {
+    std::vector<std::shared_ptr<ILDCRTParams<BigInteger>>> parts;
+    uint32_t first = 0;
+    for (auto size : sizes) {
+        std::vector<NativeInteger> roots;
+        moduli.emplace_back();
+        for (uint32_t i = first; i < first + size; ++i) {
+            moduli.back().push_back(params->GetParams()[i]->GetModulus());
+            roots.push_back(params->GetParams()[i]->GetRootOfUnity());
+        }
+        parts.push_back(
+            std::make_shared<ILDCRTParams<BigInteger>>(params->GetCyclotomicOrder(), moduli.back(), roots));
+        first += size;
+    }
+    return parts;
+}
+
+static std::vector<NativeInteger> RandomConstants(const std::vector<NativeInteger>& moduli) {
+    DiscreteUniformGeneratorImpl<NativeVector> dug;
+    std::vector<NativeInteger> constants;
+    for (const auto& m : moduli)
+        constants.push_back(dug.GenerateVector(1, m)[0]);
+    return constants;
+}
+
+static std::vector<NativeInteger> PreconConstants(const std::vector<NativeInteger>& constants,
+                                                  const std::vector<NativeInteger>& moduli) {
+    std::vector<NativeInteger> precon;
+    for (size_t i = 0; i < constants.size(); ++i)
+        precon.push_back(constants[i].PrepModMulConst(moduli[i]));
+    return precon;
+}
+
+static std::vector<DoubleNativeInt> BarrettConstants(const std::vector<NativeInteger>& moduli) {
+    const BigInteger barrettBase128Bit(BigInteger(1).LShiftEq(128));
+    std::vector<DoubleNativeInt> mu;
+    for (const auto& m : moduli)
+        mu.push_back((barrettBase128Bit / BigInteger(m)).ConvertToInt<DoubleNativeInt>());
+    return mu;
+}
+
+// sizeFrom constants for every modulus of the target basis, indexed as [i][j]
+static std::vector<std::vector<NativeInteger>> RandomHatConstants(uint32_t sizeFrom,
+                                                                  const std::vector<NativeInteger>& to) {
+    std::vector<std::vector<NativeInteger>> constants;
+    for (uint32_t i = 0; i < sizeFrom; ++i)
+        constants.push_back(RandomConstants(to));
+    return constants;
+}
+
+static void BM_approxswitchcrtbasis_LATTICE(benchmark::State& state) {
+    SIMDLevel saved;
+    if (!SetBaseConvSIMDLevel(state, saved))
+        return;
+    const uint32_t towers = state.range(1);
+    std::vector<std::vector<NativeInteger>> moduli;
+    auto paramsQP = std::make_shared<ILDCRTParams<BigInteger>>(BASECONV_ORDER, 2 * towers, state.range(2));
+    auto parts    = SplitParams(paramsQP, {towers, towers}, moduli);
+
+    auto QHatInvModq       = RandomConstants(moduli[0]);
+    auto QHatInvModqPrecon = PreconConstants(QHatInvModq, moduli[0]);
+    auto QHatModp          = RandomHatConstants(towers, moduli[1]);
+    auto modpBarrettMu     = BarrettConstants(moduli[1]);
+    DCRTPoly x             = makeElement<DCRTPoly>(parts[0]);
+    x.SetFormat(Format::COEFFICIENT);
+
+    while (state.KeepRunning()) {
+        benchmark::DoNotOptimize(
+            x.ApproxSwitchCRTBasis(parts[0], parts[1], QHatInvModq, QHatInvModqPrecon, QHatModp, modpBarrettMu));
+    }
+    OpenFHESIMDControls.SetLevel(saved);
+}
+
+static void BM_fastbaseconvqtobsk_LATTICE(benchmark::State& state) {
+    SIMDLevel saved;
+    if (!SetBaseConvSIMDLevel(state, saved))
+        return;
+    // Bsk = B U {msk} with |B| = |Q|, as in BFV multiplication (BEHZ)
+    const uint32_t towers = state.range(1);
+    std::vector<std::vector<NativeInteger>> moduli;
+    auto paramsQBsk = std::make_shared<ILDCRTParams<BigInteger>>(BASECONV_ORDER, 2 * towers + 1, state.range(2));
+    auto parts      = SplitParams(paramsQBsk, {towers, towers + 1}, moduli);
+
+    const auto& moduliQ          = moduli[0];
+    const auto& moduliBsk        = moduli[1];
+    auto modbskBarrettMu         = BarrettConstants(moduliBsk);
+    auto mtildeQHatInvModq       = RandomConstants(moduliQ);
+    auto mtildeQHatInvModqPrecon = PreconConstants(mtildeQHatInvModq, moduliQ);
+    auto QHatModbsk              = RandomHatConstants(towers, moduliBsk);
+    auto QModbsk                 = RandomConstants(moduliBsk);
+    auto QModbskPrecon           = PreconConstants(QModbsk, moduliBsk);
+    auto mtildeInvModbsk         = RandomConstants(moduliBsk);
+    auto mtildeInvModbskPrecon   = PreconConstants(mtildeInvModbsk, moduliBsk);
+    std::vector<uint64_t> QHatModmtilde(towers, 12345);
+    DCRTPoly x = makeElement<DCRTPoly>(parts[0]);
+    x.SetFormat(Format::COEFFICIENT);
+
+    while (state.KeepRunning()) {
+        DCRTPoly y(x);
+        y.FastBaseConvqToBskMontgomery(paramsQBsk, moduliQ, moduliBsk, modbskBarrettMu, mtildeQHatInvModq,
+                                       mtildeQHatInvModqPrecon, QHatModbsk, QHatModmtilde, QModbsk, QModbskPrecon,
+                                       54321, mtildeInvModbsk, mtildeInvModbskPrecon);
+    }
+    OpenFHESIMDControls.SetLevel(saved);
+}
+
+static void BM_fastbaseconvsk_LATTICE(benchmark::State& state) {
+    SIMDLevel saved;
+    if (!SetBaseConvSIMDLevel(state, saved))
+        return;
+    const uint32_t towers = state.range(1);
+    std::vector<std::vector<NativeInteger>> moduli;
+    auto paramsQBsk = std::make_shared<ILDCRTParams<BigInteger>>(BASECONV_ORDER, 2 * towers + 1, state.range(2));
+    auto parts      = SplitParams(paramsQBsk, {towers, towers + 1}, moduli);
+
+    const auto& moduliQ   = moduli[0];
+    const auto& moduliBsk = moduli[1];
+    const std::vector<NativeInteger> msk{moduliBsk.back()};
+    auto modqBarrettMu     = BarrettConstants(moduliQ);
+    auto modbskBarrettMu   = BarrettConstants(moduliBsk);
+    auto BHatInvModb       = RandomConstants(moduliBsk);
+    auto BHatInvModbPrecon = PreconConstants(BHatInvModb, moduliBsk);
+    auto BHatModmsk        = RandomConstants(std::vector<NativeInteger>(towers, msk[0]));
+    auto BInvModmsk        = RandomConstants(msk);
+    auto BInvModmskPrecon  = PreconConstants(BInvModmsk, msk);
+    auto BHatModq          = RandomHatConstants(towers, moduliQ);
+    auto BModq             = RandomConstants(moduliQ);
+    auto BModqPrecon       = PreconConstants(BModq, moduliQ);
+    DCRTPoly x             = makeElement<DCRTPoly>(paramsQBsk);
+    x.SetFormat(Format::COEFFICIENT);
+
+    while (state.KeepRunning()) {
+        DCRTPoly y(x);
+        y.FastBaseConvSK(parts[0], modqBarrettMu, moduliBsk, modbskBarrettMu, BHatInvModb, BHatInvModbPrecon,
+                         BHatModmsk, BInvModmsk[0], BInvModmskPrecon[0], BHatModq, BModq, BModqPrecon);
+    }
+    OpenFHESIMDControls.SetLevel(saved);
+}
+
+BENCHMARK(BM_approxswitchcrtbasis_LATTICE)->Unit(benchmark::kMicrosecond)->Apply(BaseConvArguments);
+BENCHMARK(BM_fastbaseconvqtobsk_LATTICE)->Unit(benchmark::kMicrosecond)->Apply(BaseConvArguments);
+BENCHMARK(BM_fastbaseconvsk_LATTICE)->Unit(benchmark::kMicrosecond)->Apply(BaseConvArguments);
+
 // execute the benchmarks
 BENCHMARK_MAIN();
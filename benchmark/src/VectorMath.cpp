@@ -109,6 +109,94 @@ static void BM_BigVec_Multeq(benchmark::State& state) {
     }
 }
 
+template <typename V>
+static void multconsteq_BigVec(V& a, const typename V::Integer& b) {
+    a *= b;
+}
+
+template <typename V>
+static void BM_BigVec_MultConsteq(benchmark::State& state) {
+    auto p                = state.range(0);
+    auto q                = LastPrime<typename V::Integer>(MAX_MODULUS_SIZE, p);
+    V a                   = DiscreteUniformGeneratorImpl<V>().GenerateVector(p, q);
+    typename V::Integer b = DiscreteUniformGeneratorImpl<V>().GenerateVector(1, q)[0];
+    while (state.KeepRunning()) {
+        multconsteq_BigVec<V>(a, b);
+    }
+}
+
+template <typename V>
+static void multaddeq_BigVec(V& a, const V& b, const V& c) {
+    a.ModMulAddEq(b, c);
+}
+
+template <typename V>
+static void BM_BigVec_MultAddeq(benchmark::State& state) {
+    auto p = state.range(0);
+    auto q = LastPrime<typename V::Integer>(MAX_MODULUS_SIZE, p);
+    V a    = DiscreteUniformGeneratorImpl<V>().GenerateVector(p, q);
+    V b    = DiscreteUniformGeneratorImpl<V>().GenerateVector(p, q);
+    V c    = DiscreteUniformGeneratorImpl<V>().GenerateVector(p, q);
+    while (state.KeepRunning()) {
+        multaddeq_BigVec<V>(a, b, c);
+    }
+}
+
+// NTT with full reduction after every butterfly vs. lazy reduction (values kept in [0, 4q))
+template <typename V>
+struct NTTBenchmarkData {
+    using CRT = ChineseRemainderTransformFTT<V>;
+
+    explicit NTTBenchmarkData(uint32_t n) : m{2 * n} {
+        modulus = LastPrime<typename V::Integer>(MAX_MODULUS_SIZE, m);
+        tables  = &CRT::GetTables(RootOfUnity<typename V::Integer>(m, modulus), m, modulus);
+        x       = DiscreteUniformGeneratorImpl<V>().GenerateVector(n, modulus);
+    }
+
+    uint32_t m;
+    typename V::Integer modulus;
+    const typename CRT::NTTTables* tables;
+    V x;
+};
+
+template <typename V>
+static void BM_NTT_Reduced(benchmark::State& state) {
+    NTTBenchmarkData<V> d(state.range(0));
+    while (state.KeepRunning()) {
+        intnat::NumberTheoreticTransformNat<V>().ForwardTransformToBitReverseInPlaceReduced(
+            d.tables->rootOfUnityReverse, d.tables->rootOfUnityPreconReverse, &d.x);
+    }
+}
+
+template <typename V>
+static void BM_NTT_Lazy(benchmark::State& state) {
+    NTTBenchmarkData<V> d(state.range(0));
+    while (state.KeepRunning()) {
+        intnat::NumberTheoreticTransformNat<V>().ForwardTransformToBitReverseInPlaceLazy(
+            d.tables->rootOfUnityReverse, d.tables->rootOfUnityPreconReverse, &d.x);
+    }
+}
+
+template <typename V>
+static void BM_INTT_Reduced(benchmark::State& state) {
+    NTTBenchmarkData<V> d(state.range(0));
+    while (state.KeepRunning()) {
+        intnat::NumberTheoreticTransformNat<V>().InverseTransformFromBitReverseInPlaceReduced(
+            d.tables->rootOfUnityInverseReverse, d.tables->rootOfUnityInversePreconReverse,
+            d.tables->cycloOrderInverse, d.tables->cycloOrderInversePrecon, &d.x);
+    }
+}
+
+template <typename V>
+static void BM_INTT_Lazy(benchmark::State& state) {
+    NTTBenchmarkData<V> d(state.range(0));
+    while (state.KeepRunning()) {
+        intnat::NumberTheoreticTransformNat<V>().InverseTransformFromBitReverseInPlaceLazy(
+            d.tables->rootOfUnityInverseReverse, d.tables->rootOfUnityInversePreconReverse,
+            d.tables->cycloOrderInverse, d.tables->cycloOrderInversePrecon, &d.x);
+    }
+}
+
 #define DO_VECTOR_BENCHMARK(X, Y)                                                               \
     BENCHMARK_TEMPLATE(X, Y)->Unit(benchmark::kMicrosecond)->ArgName("parm_16")->Arg(16);       \
     BENCHMARK_TEMPLATE(X, Y)->Unit(benchmark::kMicrosecond)->ArgName("parm_1024")->Arg(1024);   \
@@ -122,12 +210,20 @@ DO_VECTOR_BENCHMARK(BM_BigVec_Add, NativeVector)
 DO_VECTOR_BENCHMARK(BM_BigVec_Addeq, NativeVector)
 DO_VECTOR_BENCHMARK(BM_BigVec_Mult, NativeVector)
 DO_VECTOR_BENCHMARK(BM_BigVec_Multeq, NativeVector)
+DO_VECTOR_BENCHMARK(BM_BigVec_MultConsteq, NativeVector)
+DO_VECTOR_BENCHMARK(BM_BigVec_MultAddeq, NativeVector)
+DO_VECTOR_BENCHMARK(BM_NTT_Reduced, NativeVector)
+DO_VECTOR_BENCHMARK(BM_NTT_Lazy, NativeVector)
+DO_VECTOR_BENCHMARK(BM_INTT_Reduced, NativeVector)
+DO_VECTOR_BENCHMARK(BM_INTT_Lazy, NativeVector)
 
 #ifdef WITH_BE2
 DO_VECTOR_BENCHMARK(BM_BigVec_Add, M2Vector)
 DO_VECTOR_BENCHMARK(BM_BigVec_Addeq, M2Vector)
 DO_VECTOR_BENCHMARK(BM_BigVec_Mult, M2Vector)
 DO_VECTOR_BENCHMARK(BM_BigVec_Multeq, M2Vector)
+DO_VECTOR_BENCHMARK(BM_BigVec_MultConsteq, M2Vector)
+DO_VECTOR_BENCHMARK(BM_BigVec_MultAddeq, M2Vector)
 #endif
 
 #ifdef WITH_BE4
@@ -135,6 +231,8 @@ DO_VECTOR_BENCHMARK(BM_BigVec_Add, M4Vector)
 DO_VECTOR_BENCHMARK(BM_BigVec_Addeq, M4Vector)
 DO_VECTOR_BENCHMARK(BM_BigVec_Mult, M4Vector)
 DO_VECTOR_BENCHMARK(BM_BigVec_Multeq, M4Vector)
+DO_VECTOR_BENCHMARK(BM_BigVec_MultConsteq, M4Vector)
+DO_VECTOR_BENCHMARK(BM_BigVec_MultAddeq, M4Vector)
 #endif
 
 #ifdef WITH_NTL
@@ -142,6 +240,8 @@ DO_VECTOR_BENCHMARK(BM_BigVec_Add, M6Vector)
 DO_VECTOR_BENCHMARK(BM_BigVec_Addeq, M6Vector)
 DO_VECTOR_BENCHMARK(BM_BigVec_Mult, M6Vector)
 DO_VECTOR_BENCHMARK(BM_BigVec_Multeq, M6Vector)
+DO_VECTOR_BENCHMARK(BM_BigVec_MultConsteq, M6Vector)
+DO_VECTOR_BENCHMARK(BM_BigVec_MultAddeq, M6Vector)
 #endif
 
 // execute the benchmarks
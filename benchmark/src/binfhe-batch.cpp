@@ -0,0 +1,136 @@
+//==================================================================================
+// BSD 2-Clause License
+//
+// Copyright (c) 2014-2022, NJIT, Duality Technologies Inc. and other contributors
+//
+// All rights reserved.
+//
+// Author TPOC: contact@openfhe.org
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice, this
+//    list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+//    this list of conditions and the following disclaimer in the documentation
+//    and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+// OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//==================================================================================
+
+
+/*
+ * This file benchmarks batched FHEW gate evaluation: many independent gates bootstrapped
+ * concurrently vs. the same number of gates evaluated one after another
+ */
+
+#include "benchmark/benchmark.h"
+#include "binfhecontext.h"
+
+#include <vector>
+
+using namespace lbcrypto;
+
+/*
+ * Context setup utility methods
+ */
+
+BinFHEContext GenerateFHEWContext(BINFHE_PARAMSET set, BINFHE_METHOD method) {
+    auto cc = BinFHEContext();
+    cc.GenerateBinFHEContext(set, method);
+    return cc;
+}
+
+struct BatchInputs {
+    std::vector<LWECiphertext> ct1s;
+    std::vector<LWECiphertext> ct2s;
+};
+
+BatchInputs EncryptBatch(BinFHEContext& cc, ConstLWEPrivateKey& sk, uint32_t numGates) {
+    BatchInputs inputs;
+    for (uint32_t i = 0; i < numGates; ++i) {
+        inputs.ct1s.push_back(cc.Encrypt(sk, i & 1));
+        inputs.ct2s.push_back(cc.Encrypt(sk, (i >> 1) & 1));
+    }
+    return inputs;
+}
+
+/*
+ * Gate benchmarks; the argument is the number of gates
+ */
+
+template <class ParamSet, class Method>
+void FHEW_BINGATE_SEQUENTIAL(benchmark::State& state, ParamSet param_set, Method method) {
+    BinFHEContext cc = GenerateFHEWContext(BINFHE_PARAMSET(param_set), BINFHE_METHOD(method));
+
+    LWEPrivateKey sk = cc.KeyGen();
+    cc.BTKeyGen(sk);
+
+    uint32_t numGates = state.range(0);
+    auto inputs       = EncryptBatch(cc, sk, numGates);
+
+    for (auto _ : state) {
+        for (uint32_t i = 0; i < numGates; ++i) {
+            LWECiphertext ct = cc.EvalBinGate(NAND, inputs.ct1s[i], inputs.ct2s[i]);
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * numGates);
+}
+
+template <class ParamSet, class Method>
+void FHEW_BINGATE_BATCH(benchmark::State& state, ParamSet param_set, Method method) {
+    BinFHEContext cc = GenerateFHEWContext(BINFHE_PARAMSET(param_set), BINFHE_METHOD(method));
+
+    LWEPrivateKey sk = cc.KeyGen();
+    cc.BTKeyGen(sk);
+
+    uint32_t numGates = state.range(0);
+    auto inputs       = EncryptBatch(cc, sk, numGates);
+
+    for (auto _ : state) {
+        std::vector<LWECiphertext> cts = cc.EvalBinGateBatch({NAND}, inputs.ct1s, inputs.ct2s);
+    }
+    state.SetItemsProcessed(state.iterations() * numGates);
+}
+
+template <class ParamSet, class Method>
+void FHEW_BOOTSTRAP_BATCH(benchmark::State& state, ParamSet param_set, Method method) {
+    BinFHEContext cc = GenerateFHEWContext(BINFHE_PARAMSET(param_set), BINFHE_METHOD(method));
+
+    LWEPrivateKey sk = cc.KeyGen();
+    cc.BTKeyGen(sk);
+
+    uint32_t numGates = state.range(0);
+    auto inputs       = EncryptBatch(cc, sk, numGates);
+
+    for (auto _ : state) {
+        std::vector<LWECiphertext> cts = cc.BootstrapBatch(inputs.ct1s);
+    }
+    state.SetItemsProcessed(state.iterations() * numGates);
+}
+
+BENCHMARK_CAPTURE(FHEW_BINGATE_SEQUENTIAL, STD128_GINX, STD128, GINX)->Unit(benchmark::kMillisecond)->Arg(16)->Arg(64);
+BENCHMARK_CAPTURE(FHEW_BINGATE_BATCH, STD128_GINX, STD128, GINX)->Unit(benchmark::kMillisecond)->Arg(16)->Arg(64);
+BENCHMARK_CAPTURE(FHEW_BOOTSTRAP_BATCH, STD128_GINX, STD128, GINX)->Unit(benchmark::kMillisecond)->Arg(16)->Arg(64);
+
+BENCHMARK_CAPTURE(FHEW_BINGATE_SEQUENTIAL, STD128_LMKCDEY, STD128_LMKCDEY, LMKCDEY)
+    ->Unit(benchmark::kMillisecond)
+    ->Arg(16)
+    ->Arg(64);
+BENCHMARK_CAPTURE(FHEW_BINGATE_BATCH, STD128_LMKCDEY, STD128_LMKCDEY, LMKCDEY)
+    ->Unit(benchmark::kMillisecond)
+    ->Arg(16)
+    ->Arg(64);
+
+BENCHMARK_MAIN();
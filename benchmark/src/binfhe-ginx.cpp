@@ -161,4 +161,48 @@ void FHEW_KEYSWITCH(benchmark::State& state, ParamSet param_set) {
 BENCHMARK_CAPTURE(FHEW_KEYSWITCH, MEDIUM, MEDIUM)->Unit(benchmark::kMicrosecond)->MinTime(1.0);
 BENCHMARK_CAPTURE(FHEW_KEYSWITCH, STD128, STD128)->Unit(benchmark::kMicrosecond)->MinTime(1.0);
 
+// benchmark for key switching with a key in the nested layout (deserialized from earlier versions of the library),
+// for comparison with the flat layout produced by key generation
+template <class ParamSet>
+void FHEW_KEYSWITCH_NESTED(benchmark::State& state, ParamSet param_set) {
+    BINFHE_PARAMSET param(param_set);
+    BinFHEContext cc = GenerateFHEWContext(param);
+
+    LWEPrivateKey sk  = cc.KeyGen();
+    LWEPrivateKey skN = cc.KeyGenN();
+
+    auto ctQN1         = cc.Encrypt(skN, 1, SMALL_DIM);
+    auto keySwitchHint = cc.KeySwitchGen(sk, skN);
+
+    // copies the rows of the flat key into the nested layout
+    const auto& flatA   = *keySwitchHint->GetFlatA();
+    const auto& flatB   = keySwitchHint->GetFlatB();
+    uint32_t N          = flatA.GetNumKeys();
+    uint32_t digitCount = flatA.GetNumVariants();
+    uint32_t baseKS     = flatA.GetRows();
+    uint32_t n          = flatA.GetPolySize();
+    NativeInteger qKS   = cc.GetParams()->GetLWEParams()->GetqKS();
+    std::vector<std::vector<std::vector<NativeVector>>> keyA(
+        N, std::vector<std::vector<NativeVector>>(baseKS, std::vector<NativeVector>(digitCount, NativeVector(n, qKS))));
+    std::vector<std::vector<std::vector<NativeInteger>>> keyB(
+        N, std::vector<std::vector<NativeInteger>>(baseKS, std::vector<NativeInteger>(digitCount)));
+    for (uint32_t i = 0; i < N; ++i) {
+        for (uint32_t v = 0; v < baseKS; ++v) {
+            for (uint32_t j = 0; j < digitCount; ++j) {
+                const NativeInteger* row = flatA.Get(i, j, v, 0);
+                for (uint32_t k = 0; k < n; ++k)
+                    keyA[i][v][j][k] = row[k];
+                keyB[i][v][j] = flatB[(i * digitCount + j) * baseKS + v];
+            }
+        }
+    }
+    auto nestedHint = std::make_shared<LWESwitchingKeyImpl>(std::move(keyA), std::move(keyB));
+
+    for (auto _ : state) {
+        LWECiphertext eQ1 = cc.GetLWEScheme()->KeySwitch(cc.GetParams()->GetLWEParams(), nestedHint, ctQN1);
+    }
+}
+
+BENCHMARK_CAPTURE(FHEW_KEYSWITCH_NESTED, STD128, STD128)->Unit(benchmark::kMicrosecond)->MinTime(1.0);
+
 BENCHMARK_MAIN();
@@ -0,0 +1,144 @@
+//==================================================================================
+// BSD 2-Clause License
+//
+// Copyright (c) 2014-2023, NJIT, Duality Technologies Inc. and other contributors
+//
+// All rights reserved.
+//
+// Author TPOC: contact@openfhe.org
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice, this
+//    list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+//    this list of conditions and the following disclaimer in the documentation
+//    and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+// OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//==================================================================================
+
+
+/*
+ * This file benchmarks the netlist evaluator on ripple-carry adders: gates evaluated one after another
+ * vs. the levelled schedule of BinFHENetlist, which bootstraps the independent gates of a level concurrently
+ */
+
+#include "benchmark/benchmark.h"
+#include "binfhecontext.h"
+#include "binfhe-netlist.h"
+
+#include <sstream>
+#include <string>
+#include <vector>
+
+using namespace lbcrypto;
+
+/*
+ * Context setup utility methods
+ */
+
+BinFHEContext GenerateFHEWContext(BINFHE_PARAMSET set, BINFHE_METHOD method) {
+    auto cc = BinFHEContext();
+    cc.GenerateBinFHEContext(set, method);
+    return cc;
+}
+
+// text netlist of a bits-wide adder a + b with a zero carry-in; outputs the sum bits and the carry-out
+std::string RippleCarryAdder(uint32_t bits) {
+    std::stringstream ss;
+    ss << "INPUT";
+    for (uint32_t i = 0; i < bits; ++i)
+        ss << " a" << i << " b" << i;
+    ss << "\nc0 = CONST 0\n";
+    for (uint32_t i = 0; i < bits; ++i) {
+        ss << "t" << i << " = XOR a" << i << " b" << i << "\n";
+        ss << "s" << i << " = XOR t" << i << " c" << i << "\n";
+        ss << "c" << i + 1 << " = MAJORITY a" << i << " b" << i << " c" << i << "\n";
+    }
+    ss << "OUTPUT";
+    for (uint32_t i = 0; i < bits; ++i)
+        ss << " s" << i;
+    ss << " c" << bits << "\n";
+    return ss.str();
+}
+
+std::vector<LWECiphertext> EncryptOperands(BinFHEContext& cc, ConstLWEPrivateKey& sk, uint32_t bits) {
+    std::vector<LWECiphertext> inputs;
+    for (uint32_t i = 0; i < bits; ++i) {
+        inputs.push_back(cc.Encrypt(sk, i & 1));
+        inputs.push_back(cc.Encrypt(sk, (i >> 1) & 1));
+    }
+    return inputs;
+}
+
+/*
+ * Adder benchmarks; the argument is the number of bits
+ */
+
+template <class ParamSet, class Method>
+void FHEW_ADDER_SEQUENTIAL(benchmark::State& state, ParamSet param_set, Method method) {
+    BinFHEContext cc = GenerateFHEWContext(BINFHE_PARAMSET(param_set), BINFHE_METHOD(method));
+
+    LWEPrivateKey sk = cc.KeyGen();
+    cc.BTKeyGen(sk);
+
+    uint32_t bits = state.range(0);
+    auto inputs   = EncryptOperands(cc, sk, bits);
+
+    for (auto _ : state) {
+        std::vector<LWECiphertext> sums(bits);
+        LWECiphertext carry = cc.EvalBinGate(AND, inputs[0], inputs[1]);
+        sums[0]             = cc.EvalBinGate(XOR, inputs[0], inputs[1]);
+        for (uint32_t i = 1; i < bits; ++i) {
+            auto t  = cc.EvalBinGate(XOR, inputs[2 * i], inputs[2 * i + 1]);
+            sums[i] = cc.EvalBinGate(XOR, t, carry);
+            carry   = cc.EvalBinGate(MAJORITY, {inputs[2 * i], inputs[2 * i + 1], carry});
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * bits);
+}
+
+template <class ParamSet, class Method>
+void FHEW_ADDER_NETLIST(benchmark::State& state, ParamSet param_set, Method method) {
+    BinFHEContext cc = GenerateFHEWContext(BINFHE_PARAMSET(param_set), BINFHE_METHOD(method));
+
+    LWEPrivateKey sk = cc.KeyGen();
+    cc.BTKeyGen(sk);
+
+    uint32_t bits = state.range(0);
+    auto inputs   = EncryptOperands(cc, sk, bits);
+
+    std::istringstream text(RippleCarryAdder(bits));
+    auto netlist = BinFHENetlist::Load(text);
+
+    for (auto _ : state) {
+        std::vector<LWECiphertext> outputs = netlist.Evaluate(cc, inputs);
+    }
+    state.SetItemsProcessed(state.iterations() * bits);
+}
+
+BENCHMARK_CAPTURE(FHEW_ADDER_SEQUENTIAL, STD128_GINX, STD128, GINX)->Unit(benchmark::kMillisecond)->Arg(8)->Arg(16);
+BENCHMARK_CAPTURE(FHEW_ADDER_NETLIST, STD128_GINX, STD128, GINX)->Unit(benchmark::kMillisecond)->Arg(8)->Arg(16);
+
+BENCHMARK_CAPTURE(FHEW_ADDER_SEQUENTIAL, STD128_LMKCDEY, STD128_LMKCDEY, LMKCDEY)
+    ->Unit(benchmark::kMillisecond)
+    ->Arg(8)
+    ->Arg(16);
+BENCHMARK_CAPTURE(FHEW_ADDER_NETLIST, STD128_LMKCDEY, STD128_LMKCDEY, LMKCDEY)
+    ->Unit(benchmark::kMillisecond)
+    ->Arg(8)
+    ->Arg(16);
+
+BENCHMARK_MAIN();
@@ -739,6 +739,59 @@ void CKKSrns_EvalAtIndex(benchmark::State& state) {
 
 BENCHMARK(CKKSrns_EvalAtIndex)->Unit(benchmark::kMicrosecond);
 
+static void ThreadArgs(benchmark::internal::Benchmark* b) {
+    for (int t = 1; t <= OpenFHEParallelControls.GetMachineThreads(); t *= 2)
+        b->ArgName("threads")->Arg(t);
+}
+
+void CKKSrns_EvalBootstrap(benchmark::State& state) {
+    CCParams<CryptoContextCKKSRNS> parameters;
+    SecretKeyDist secretKeyDist = UNIFORM_TERNARY;
+    parameters.SetSecretKeyDist(secretKeyDist);
+    parameters.SetSecurityLevel(HEStd_NotSet);
+    parameters.SetRingDim(1 << 12);
+#if NATIVEINT == 128 && !defined(__EMSCRIPTEN__)
+    parameters.SetScalingModSize(78);
+    parameters.SetScalingTechnique(FIXEDAUTO);
+    parameters.SetFirstModSize(89);
+#else
+    parameters.SetScalingModSize(59);
+    parameters.SetScalingTechnique(FLEXIBLEAUTO);
+    parameters.SetFirstModSize(60);
+#endif
+    std::vector<uint32_t> levelBudget = {4, 4};
+    parameters.SetMultiplicativeDepth(1 + FHECKKSRNS::GetBootstrapDepth(levelBudget, secretKeyDist));
+
+    CryptoContext<DCRTPoly> cc = GenCryptoContext(parameters);
+    cc->Enable(PKE);
+    cc->Enable(KEYSWITCH);
+    cc->Enable(LEVELEDSHE);
+    cc->Enable(ADVANCEDSHE);
+    cc->Enable(FHE);
+
+    usint slots = cc->GetRingDimension() / 2;
+    cc->EvalBootstrapSetup(levelBudget);
+
+    KeyPair<DCRTPoly> keyPair = cc->KeyGen();
+    cc->EvalMultKeyGen(keyPair.secretKey);
+    cc->EvalBootstrapKeyGen(keyPair.secretKey, slots);
+
+    std::vector<double> x(slots);
+    for (usint i = 0; i < slots; i++) {
+        x[i] = 0.001 * i / slots;
+    }
+    Plaintext plaintext = cc->MakeCKKSPackedPlaintext(x, 1, cc->GetMultiplicativeDepth() - 1);
+    auto ciphertext     = cc->Encrypt(keyPair.publicKey, plaintext);
+
+    OpenFHEParallelControls.SetNumThreads(state.range(0));
+    while (state.KeepRunning()) {
+        auto ciphertextAfter = cc->EvalBootstrap(ciphertext);
+    }
+    OpenFHEParallelControls.Enable();
+}
+
+BENCHMARK(CKKSrns_EvalBootstrap)->Unit(benchmark::kMillisecond)->UseRealTime()->Apply(ThreadArgs);
+
 /*
  * BGVrns benchmarks
  * */
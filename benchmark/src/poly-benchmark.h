@@ -37,6 +37,7 @@
 #include "benchmark/benchmark.h"
 #include "lattice/lat-hal.h"
 #include "math/discreteuniformgenerator.h"
+#include "utils/cpufeatures.h"
 
 #include <map>
 #include <memory>
@@ -60,6 +61,12 @@ static void DCRTArguments(benchmark::internal::Benchmark* b) {
     }
 }
 
+static void SIMDArguments(benchmark::internal::Benchmark* b) {
+    for (int level : {SIMD_SCALAR, SIMD_AVX2, SIMD_AVX512, SIMD_AVX512IFMA}) {
+        b->ArgName("simd")->Arg(level);
+    }
+}
+
 static void GeneratePolys(uint32_t order, uint32_t bits, std::shared_ptr<std::vector<NativePoly>>& polyArrayEval,
                           std::shared_ptr<std::vector<NativePoly>>& polyArrayCoef) {
     auto p    = std::make_shared<ILNativeParams>(order, bits);
@@ -259,6 +266,43 @@ static void GenerateDCRTPolys(uint32_t order, uint32_t bits,
     }
 }
 
+// compares the vectorized NTT kernels with the scalar implementation; the SIMD level is restored on exit
+[[maybe_unused]] static void Native_ntt_SIMD(benchmark::State& state) {
+    auto level{static_cast<SIMDLevel>(state.range(0))};
+    if (level > OpenFHESIMDControls.GetSupportedLevel()) {
+        state.SkipWithError("SIMD level is not supported by the CPU");
+        return;
+    }
+    auto saved{OpenFHESIMDControls.GetLevel()};
+    OpenFHESIMDControls.SetLevel(level);
+    std::shared_ptr<std::vector<NativePoly>> polys = NativepolysCoef;
+    NativePoly p;
+    size_t i{POLY_NUM_M1};
+    while (state.KeepRunning()) {
+        p = (*polys)[(i = (i + 1) & POLY_NUM_M1)];
+        p.SwitchFormat();
+    }
+    OpenFHESIMDControls.SetLevel(saved);
+}
+
+[[maybe_unused]] static void Native_intt_SIMD(benchmark::State& state) {
+    auto level{static_cast<SIMDLevel>(state.range(0))};
+    if (level > OpenFHESIMDControls.GetSupportedLevel()) {
+        state.SkipWithError("SIMD level is not supported by the CPU");
+        return;
+    }
+    auto saved{OpenFHESIMDControls.GetLevel()};
+    OpenFHESIMDControls.SetLevel(level);
+    std::shared_ptr<std::vector<NativePoly>> polys = NativepolysEval;
+    NativePoly p;
+    size_t i{POLY_NUM_M1};
+    while (state.KeepRunning()) {
+        p = (*polys)[(i = (i + 1) & POLY_NUM_M1)];
+        p.SwitchFormat();
+    }
+    OpenFHESIMDControls.SetLevel(saved);
+}
+
 [[maybe_unused]] static void Native_ntt_intt(benchmark::State& state) {
     std::shared_ptr<std::vector<NativePoly>> polys = NativepolysCoef;
     NativePoly* p;
@@ -386,6 +430,8 @@ BENCHMARK(Native_ntt)->Unit(benchmark::kMicrosecond);
 BENCHMARK(DCRT_ntt)->Unit(benchmark::kMicrosecond)->Apply(DCRTArguments);
 BENCHMARK(Native_intt)->Unit(benchmark::kMicrosecond);
 BENCHMARK(DCRT_intt)->Unit(benchmark::kMicrosecond)->Apply(DCRTArguments);
+BENCHMARK(Native_ntt_SIMD)->Unit(benchmark::kMicrosecond)->Apply(SIMDArguments);
+BENCHMARK(Native_intt_SIMD)->Unit(benchmark::kMicrosecond)->Apply(SIMDArguments);
 // BENCHMARK(Native_ntt_intt)->Unit(benchmark::kMicrosecond);
 // BENCHMARK(DCRT_ntt_intt)->Unit(benchmark::kMicrosecond)->Apply(DCRTArguments);
 // BENCHMARK(Native_intt_ntt)->Unit(benchmark::kMicrosecond);
@@ -39,8 +39,10 @@
 #include "rgsw-acc.h"
 #include "rgsw-acc-dm.h"
 #include "rgsw-acc-cggi.h"
+#include "rgsw-acc-cggi-fft.h"
 #include "rgsw-acc-lmkcdey.h"
 
+#include <functional>
 #include <map>
 #include <memory>
 #include <vector>
@@ -72,6 +74,8 @@ public:
             ACCscheme = std::make_shared<RingGSWAccumulatorCGGI>();
         else if (method == LMKCDEY)
             ACCscheme = std::make_shared<RingGSWAccumulatorLMKCDEY>();
+        else if (method == GINX_FFT)
+            ACCscheme = std::make_shared<RingGSWAccumulatorCGGIFFT>();
         else
             OPENFHE_THROW("method is invalid");
     }
@@ -114,6 +118,22 @@ public:
     LWECiphertext EvalBinGate(const std::shared_ptr<BinFHECryptoParams>& params, BINGATE gate, const RingGSWBTKey& EK,
                               const std::vector<LWECiphertext>& ctvector, bool extended = false) const;
 
+    /**
+   * Evaluates a batch of independent binary gates. The gate bootstraps are distributed across threads
+   * (one blind rotation per thread at a time); each thread uses its own accumulator.
+   *
+   * @param params a shared pointer to RingGSW scheme parameters
+   * @param gates the gates; either one gate applied to all pairs or one gate per pair
+   * @param EK a shared pointer to the bootstrapping keys
+   * @param ct1s first input ciphertexts
+   * @param ct2s second input ciphertexts
+   * @return the resulting ciphertexts, in input order
+   */
+    std::vector<LWECiphertext> EvalBinGateBatch(const std::shared_ptr<BinFHECryptoParams>& params,
+                                                const std::vector<BINGATE>& gates, const RingGSWBTKey& EK,
+                                                const std::vector<LWECiphertext>& ct1s,
+                                                const std::vector<LWECiphertext>& ct2s, bool extended = false) const;
+
     /**
    * Evaluates NOT gate
    *
@@ -134,6 +154,18 @@ public:
     LWECiphertext Bootstrap(const std::shared_ptr<BinFHECryptoParams>& params, const RingGSWBTKey& EK,
                             ConstLWECiphertext& ct, bool extended = false) const;
 
+    /**
+   * Bootstraps a batch of independent ciphertexts in parallel
+   *
+   * @param params a shared pointer to RingGSW scheme parameters
+   * @param EK a shared pointer to the bootstrapping keys
+   * @param cts input ciphertexts
+   * @return the resulting ciphertexts, in input order
+   */
+    std::vector<LWECiphertext> BootstrapBatch(const std::shared_ptr<BinFHECryptoParams>& params,
+                                              const RingGSWBTKey& EK, const std::vector<LWECiphertext>& cts,
+                                              bool extended = false) const;
+
     /**
    * Evaluate an arbitrary function
    *
@@ -148,6 +180,24 @@ public:
                            ConstLWECiphertext& ct, const std::vector<NativeInteger>& LUT,
                            const NativeInteger& beta) const;
 
+    /**
+   * Evaluate several arbitrary functions on the same input with one blind rotation per stage
+   * (multi-value bootstrapping, https://eprint.iacr.org/2018/622). The accumulator is rotated once
+   * with a common test polynomial and then multiplied by a small plaintext polynomial per LUT, so the
+   * output noise grows with the total variation of each LUT; intended for small plaintext moduli.
+   *
+   * @param params a shared pointer to RingGSW scheme parameters
+   * @param EK a shared pointer to the bootstrapping keys
+   * @param ct input ciphertext
+   * @param LUTs the look-up tables of the to-be-evaluated functions
+   * @param beta the error bound
+   * @return the resulting ciphertexts, one per LUT
+   */
+    std::vector<LWECiphertext> EvalFuncMulti(const std::shared_ptr<BinFHECryptoParams>& params,
+                                             const RingGSWBTKey& EK, ConstLWECiphertext& ct,
+                                             const std::vector<std::vector<NativeInteger>>& LUTs,
+                                             const NativeInteger& beta) const;
+
     /**
    * Evaluate a round down function
    *
@@ -201,6 +251,35 @@ private:
     RLWECiphertext BootstrapGateCore(const std::shared_ptr<BinFHECryptoParams>& params, BINGATE gate,
                                      ConstRingGSWACCKey& ek, ConstLWECiphertext& ct) const;
 
+    /**
+   * Core bootstrapping operation into an accumulator owned by the caller: acc is allocated only if it is empty
+   * or was used with other ring parameters, so that a thread evaluating many gates reuses its polynomials
+   *
+   * @param params a shared pointer to RingGSW scheme parameters
+   * @param gate the gate; can be AND, OR, NAND, NOR, XOR, or XOR
+   * @param ek a shared pointer to the bootstrapping keys
+   * @param ct input ciphertext
+   * @param acc the accumulator, set to the output RingLWE accumulator
+   */
+    void BootstrapGateCore(const std::shared_ptr<BinFHECryptoParams>& params, BINGATE gate, ConstRingGSWACCKey& ek,
+                           ConstLWECiphertext& ct, RLWECiphertext& acc) const;
+
+    // EvalBinGate() and Bootstrap() with an accumulator owned by the caller (see BootstrapGateCore())
+    LWECiphertext EvalBinGate(const std::shared_ptr<BinFHECryptoParams>& params, BINGATE gate, const RingGSWBTKey& EK,
+                              ConstLWECiphertext& ct1, ConstLWECiphertext& ct2, bool extended,
+                              RLWECiphertext& acc) const;
+    LWECiphertext Bootstrap(const std::shared_ptr<BinFHECryptoParams>& params, const RingGSWBTKey& EK,
+                            ConstLWECiphertext& ct, bool extended, RLWECiphertext& acc) const;
+
+    /**
+   * Checks that the bootstrapping and key switching keys are present and match the parameters, so that a
+   * batch with missing or foreign keys fails before any gate is bootstrapped
+   *
+   * @param params a shared pointer to RingGSW scheme parameters
+   * @param EK the bootstrapping keys
+   */
+    void CheckBTKey(const std::shared_ptr<BinFHECryptoParams>& params, const RingGSWBTKey& EK) const;
+
     // Arbitrary function evaluation purposes
 
     /**
@@ -231,6 +310,22 @@ private:
     LWECiphertext BootstrapFunc(const std::shared_ptr<BinFHECryptoParams>& params, const RingGSWBTKey& EK,
                                 ConstLWECiphertext& ct, const Func f, const NativeInteger& fmod) const;
 
+    /**
+   * Multi-value version of BootstrapFunc: one blind rotation of a common test polynomial, then one
+   * plaintext multiplication, sample extraction and key switch per function
+   *
+   * @param params a shared pointer to RingGSW scheme parameters
+   * @param EK a shared pointer to the bootstrapping keys
+   * @param ct input ciphertext
+   * @param fs functions to evaluate in the functional bootstrapping
+   * @param fmod modulus over which the functions are defined
+   * @return the resulting ciphertexts, one per function
+   */
+    std::vector<LWECiphertext> BootstrapFuncMulti(
+        const std::shared_ptr<BinFHECryptoParams>& params, const RingGSWBTKey& EK, ConstLWECiphertext& ct,
+        const std::vector<std::function<NativeInteger(NativeInteger, NativeInteger, NativeInteger)>>& fs,
+        const NativeInteger& fmod) const;
+
 protected:
     std::shared_ptr<LWEEncryptionScheme> LWEscheme{std::make_shared<LWEEncryptionScheme>()};
     std::shared_ptr<RingGSWAccumulator> ACCscheme{nullptr};
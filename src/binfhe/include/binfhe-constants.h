@@ -114,9 +114,10 @@ std::ostream& operator<<(std::ostream& s, BINFHE_OUTPUT f);
  */
 enum BINFHE_METHOD {
     INVALID_METHOD = 0,
-    AP,       // Ducas-Micciancio variant
-    GINX,     // Chillotti-Gama-Georgieva-Izabachene variant
-    LMKCDEY,  // Lee-Micciancio-Kim-Choi-Deryabin-Eom-Yoo variant, ia.cr/2022/198
+    AP,        // Ducas-Micciancio variant
+    GINX,      // Chillotti-Gama-Georgieva-Izabachene variant
+    LMKCDEY,   // Lee-Micciancio-Kim-Choi-Deryabin-Eom-Yoo variant, ia.cr/2022/198
+    GINX_FFT,  // GINX variant with double-precision FFT external products (Q < 2^32)
 };
 std::ostream& operator<<(std::ostream& s, BINFHE_METHOD f);
 
@@ -0,0 +1,194 @@
+//==================================================================================
+// BSD 2-Clause License
+//
+// Copyright (c) 2014-2023, NJIT, Duality Technologies Inc. and other contributors
+//
+// All rights reserved.
+//
+// Author TPOC: contact@openfhe.org
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice, this
+//    list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+//    this list of conditions and the following disclaimer in the documentation
+//    and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+// OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//==================================================================================
+
+#ifndef _BINFHE_FLATKEY_H_
+#define _BINFHE_FLATKEY_H_
+
+#include "utils/exception.h"
+#include "utils/serializable.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <new>
+#include <string>
+#include <vector>
+
+namespace lbcrypto {
+
+/**
+ * @brief Allocator returning memory aligned to the given boundary (a cache line by default)
+ */
+template <typename T, size_t Alignment = 64>
+struct AlignedAllocator {
+    using value_type = T;
+
+    template <typename U>
+    struct rebind {
+        using other = AlignedAllocator<U, Alignment>;
+    };
+
+    AlignedAllocator() noexcept = default;
+
+    template <typename U>
+    AlignedAllocator(const AlignedAllocator<U, Alignment>&) noexcept {}  // NOLINT
+
+    T* allocate(size_t n) {
+        return static_cast<T*>(::operator new(n * sizeof(T), std::align_val_t(Alignment)));
+    }
+
+    void deallocate(T* p, size_t) noexcept {
+        ::operator delete(p, std::align_val_t(Alignment));
+    }
+
+    friend bool operator==(const AlignedAllocator&, const AlignedAllocator&) noexcept {
+        return true;
+    }
+
+    friend bool operator!=(const AlignedAllocator&, const AlignedAllocator&) noexcept {
+        return false;
+    }
+};
+
+/**
+ * @brief Key stored as one contiguous, cache-line aligned array of rows of polySize entries of type T,
+ * addressed by four indices (i, v, r, c). For the bootstrapping keys, row (i, v, r, c) is the polynomial
+ * (in the NTT or FFT domain) in column c of row r of the v-th RGSW ciphertext for LWE secret index i; for the
+ * LWE switching key it is the vector of the switching key for coefficient i, digit index v and digit value r
+ * (see LWESwitchingKeyImpl::GetFlatA). Once generated the key is only read, so a single instance is shared by
+ * all threads using it.
+ */
+template <typename T>
+class FlatKey {
+public:
+    FlatKey() = default;
+
+    /**
+   * Allocates a zero-initialized key
+   *
+   * @param numKeys range of the first index (e.g., LWE secret indices)
+   * @param numVariants range of the second index (e.g., RGSW ciphertexts per LWE secret index)
+   * @param rows range of the third index (e.g., rows of each RGSW ciphertext)
+   * @param cols range of the fourth index (e.g., columns of each RGSW ciphertext)
+   * @param polySize number of entries of type T per row
+   */
+    FlatKey(uint32_t numKeys, uint32_t numVariants, uint32_t rows, uint32_t cols, uint32_t polySize)
+        : m_numKeys(numKeys),
+          m_numVariants(numVariants),
+          m_rows(rows),
+          m_cols(cols),
+          m_polySize(polySize),
+          m_data(static_cast<size_t>(numKeys) * numVariants * rows * cols * polySize) {}
+
+    /**
+   * Keyed accessor
+   *
+   * @param i first index
+   * @param v second index
+   * @param r third index
+   * @param c fourth index
+   * @return pointer to the first of polySize entries
+   */
+    const T* Get(uint32_t i, uint32_t v, uint32_t r, uint32_t c) const {
+        return m_data.data() + Offset(i, v, r, c);
+    }
+
+    T* Get(uint32_t i, uint32_t v, uint32_t r, uint32_t c) {
+        return m_data.data() + Offset(i, v, r, c);
+    }
+
+    uint32_t GetNumKeys() const {
+        return m_numKeys;
+    }
+
+    uint32_t GetNumVariants() const {
+        return m_numVariants;
+    }
+
+    uint32_t GetRows() const {
+        return m_rows;
+    }
+
+    uint32_t GetCols() const {
+        return m_cols;
+    }
+
+    uint32_t GetPolySize() const {
+        return m_polySize;
+    }
+
+    bool operator==(const FlatKey& other) const {
+        return m_numKeys == other.m_numKeys && m_numVariants == other.m_numVariants && m_rows == other.m_rows &&
+               m_cols == other.m_cols && m_polySize == other.m_polySize && m_data == other.m_data;
+    }
+
+    bool operator!=(const FlatKey& other) const {
+        return !(*this == other);
+    }
+
+    template <class Archive>
+    void save(Archive& ar) const {
+        ar(::cereal::make_nvp("d", std::vector<uint32_t>{m_numKeys, m_numVariants, m_rows, m_cols, m_polySize}));
+        ar(::cereal::make_nvp("v", m_data));
+    }
+
+    template <class Archive>
+    void load(Archive& ar) {
+        std::vector<uint32_t> dims;
+        ar(::cereal::make_nvp("d", dims));
+        if (dims.size() != 5)
+            OPENFHE_THROW("invalid dimensions of a serialized flat key");
+        m_numKeys     = dims[0];
+        m_numVariants = dims[1];
+        m_rows        = dims[2];
+        m_cols        = dims[3];
+        m_polySize    = dims[4];
+        ar(::cereal::make_nvp("v", m_data));
+        if (m_data.size() != static_cast<size_t>(m_numKeys) * m_numVariants * m_rows * m_cols * m_polySize)
+            OPENFHE_THROW("size mismatch in a serialized flat key");
+    }
+
+private:
+    size_t Offset(uint32_t i, uint32_t v, uint32_t r, uint32_t c) const {
+        return (((static_cast<size_t>(i) * m_numVariants + v) * m_rows + r) * m_cols + c) * m_polySize;
+    }
+
+    uint32_t m_numKeys{};
+    uint32_t m_numVariants{};
+    uint32_t m_rows{};
+    uint32_t m_cols{};
+    uint32_t m_polySize{};
+
+    std::vector<T, AlignedAllocator<T>> m_data;
+};
+
+}  // namespace lbcrypto
+
+#endif  // _BINFHE_FLATKEY_H_
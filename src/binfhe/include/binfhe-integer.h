@@ -0,0 +1,230 @@
+//==================================================================================
+// BSD 2-Clause License
+//
+// Copyright (c) 2014-2023, NJIT, Duality Technologies Inc. and other contributors
+//
+// All rights reserved.
+//
+// Author TPOC: contact@openfhe.org
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice, this
+//    list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+//    this list of conditions and the following disclaimer in the documentation
+//    and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+// OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//==================================================================================
+
+/*
+  Radix-decomposed multi-bit integer arithmetic on top of the functional bootstrapping of BinFHEContext
+ */
+
+#ifndef BINFHE_BINFHE_INTEGER_H
+#define BINFHE_BINFHE_INTEGER_H
+
+#include "binfhecontext.h"
+
+#include <functional>
+#include <memory>
+#include <vector>
+
+namespace lbcrypto {
+
+class LWEIntegerImpl;
+
+using LWEInteger      = std::shared_ptr<LWEIntegerImpl>;
+using ConstLWEInteger = const std::shared_ptr<const LWEIntegerImpl>;
+
+/**
+ * @brief Unsigned integer encrypted as a vector of LWE ciphertexts, one per radix digit (least significant first).
+ * Every digit also records an upper bound on the plaintext value it may hold. A bound that exceeds the radix
+ * means the digit still carries pending carries that have not been propagated to the next digit yet.
+ */
+class LWEIntegerImpl {
+public:
+    LWEIntegerImpl(std::vector<LWECiphertext>&& digits, std::vector<uint32_t>&& bounds)
+        : m_digits(std::move(digits)), m_bounds(std::move(bounds)) {}
+
+    const std::vector<LWECiphertext>& GetDigits() const {
+        return m_digits;
+    }
+
+    const std::vector<uint32_t>& GetBounds() const {
+        return m_bounds;
+    }
+
+    uint32_t GetNumDigits() const {
+        return m_digits.size();
+    }
+
+private:
+    std::vector<LWECiphertext> m_digits;
+    std::vector<uint32_t> m_bounds;
+};
+
+/**
+ * @brief Evaluator for unsigned integers of a fixed bit width (arithmetic is mod 2^bits). Digits are encrypted
+ * with the maximum plaintext modulus p of the context and hold values in [0, p/2), so every look-up table is
+ * negacyclic and costs a single bootstrapping. Additions are purely linear until a digit could leave [0, p/2);
+ * only then are carries propagated. Bootstrappings of independent digits run in parallel.
+ */
+class BinFHEIntegerEvaluator {
+public:
+    /**
+   * @param cc context with generated bootstrapping keys; it must outlive the evaluator. Its plaintext
+   * space (GetMaxPlaintextSpace) must be at least 16, e.g., GenerateBinFHEContext(set, false, logQ)
+   * @param bits width of the integers, between 1 and 64
+   */
+    BinFHEIntegerEvaluator(const BinFHEContext& cc, uint32_t bits);
+
+    /**
+   * Encrypts an integer digit by digit using a secret key
+   *
+   * @param sk the secret key
+   * @param m the plaintext, reduced mod 2^bits
+   * @return the encrypted integer
+   */
+    LWEInteger Encrypt(ConstLWEPrivateKey& sk, uint64_t m) const;
+
+    /**
+   * Decrypts an integer; pending carries are resolved in the clear
+   *
+   * @param sk the secret key
+   * @param ct the encrypted integer
+   * @return the plaintext in [0, 2^bits)
+   */
+    uint64_t Decrypt(ConstLWEPrivateKey& sk, ConstLWEInteger& ct) const;
+
+    /**
+   * Adds two integers mod 2^bits. Carries are only propagated if a digit could overflow.
+   */
+    LWEInteger EvalAdd(ConstLWEInteger& ct1, ConstLWEInteger& ct2) const;
+
+    /**
+   * Subtracts ct2 from ct1 mod 2^bits as ct1 + ~ct2 + 1
+   */
+    LWEInteger EvalSub(ConstLWEInteger& ct1, ConstLWEInteger& ct2) const;
+
+    /**
+   * Multiplies two integers mod 2^bits (schoolbook; all digit products are bootstrapped in parallel)
+   */
+    LWEInteger EvalMult(ConstLWEInteger& ct1, ConstLWEInteger& ct2) const;
+
+    /**
+   * Evaluates ct1 < ct2
+   *
+   * @return encryption of 0 or 1 with the plaintext modulus GetPlaintextModulus()
+   */
+    LWECiphertext EvalLessThan(ConstLWEInteger& ct1, ConstLWEInteger& ct2) const;
+
+    /**
+   * Evaluates ct1 == ct2
+   *
+   * @return encryption of 0 or 1 with the plaintext modulus GetPlaintextModulus()
+   */
+    LWECiphertext EvalEqual(ConstLWEInteger& ct1, ConstLWEInteger& ct2) const;
+
+    /**
+   * Shifts left by a public number of bits mod 2^bits
+   */
+    LWEInteger EvalShiftLeft(ConstLWEInteger& ct, uint32_t shift) const;
+
+    /**
+   * Logical right shift by a public number of bits
+   */
+    LWEInteger EvalShiftRight(ConstLWEInteger& ct, uint32_t shift) const;
+
+    /**
+   * Propagates all pending carries so that every digit is below the radix. Uses a parallel prefix
+   * (carry-lookahead) over the digits, so its depth is logarithmic in the number of digits.
+   */
+    LWEInteger EvalCarry(ConstLWEInteger& ct) const;
+
+    uint32_t GetBits() const {
+        return m_bits;
+    }
+
+    uint32_t GetDigitBits() const {
+        return m_digitBits;
+    }
+
+    uint32_t GetNumDigits() const {
+        return m_numDigits;
+    }
+
+    LWEPlaintextModulus GetPlaintextModulus() const {
+        return m_p;
+    }
+
+private:
+    using LUT = std::vector<NativeInteger>;
+
+    // negacyclic look-up table of f over the messages [0, p/2)
+    LUT GenerateLUT(const std::function<uint32_t(uint32_t)>& f) const;
+
+    // evaluates luts[i] on cts[i] for all i in parallel
+    std::vector<LWECiphertext> EvalFuncBatch(const std::vector<LWECiphertext>& cts,
+                                             const std::vector<const LUT*>& luts) const;
+
+    // returns scale * ct1 + ct2 as a new ciphertext
+    LWECiphertext EvalLinear(ConstLWECiphertext& ct1, uint32_t scale, ConstLWECiphertext& ct2) const;
+
+    // noiseless encryption of m with dimension n
+    LWECiphertext EncryptTrivial(uint32_t m, uint32_t n) const;
+
+    // one parallel round that splits every digit above the radix into its low part and carry
+    void CarryRound(std::vector<LWECiphertext>& digits, std::vector<uint32_t>& bounds) const;
+
+    // repeats CarryRound until every bound is at most the radix
+    void ReduceBounds(std::vector<LWECiphertext>& digits, std::vector<uint32_t>& bounds) const;
+
+    // Combines the states (0, 1, 2) of adjacent digit ranges; hi[i] covers more significant digits
+    std::vector<LWECiphertext> EvalCombine(const std::vector<LWECiphertext>& hi,
+                                           const std::vector<LWECiphertext>& lo) const;
+
+    // state of the comparison of ct1 and ct2 mapped through the predicate on (0: less, 1: equal, 2: greater)
+    LWECiphertext EvalCompare(ConstLWEInteger& ct1, ConstLWEInteger& ct2,
+                              const std::function<uint32_t(uint32_t)>& predicate) const;
+
+    void ValidateInput(ConstLWEInteger& ct) const;
+
+    const BinFHEContext& m_cc;
+    std::shared_ptr<LWEEncryptionScheme> m_LWEscheme{std::make_shared<LWEEncryptionScheme>()};
+
+    uint32_t m_bits;
+    uint32_t m_digitBits;
+    uint32_t m_numDigits;
+    uint32_t m_base;
+    // largest plaintext value a digit may hold: p/2 - 1
+    uint32_t m_maxValue;
+    LWEPlaintextModulus m_p;
+    NativeInteger m_q;
+    NativeInteger m_delta;
+
+    LUT m_lutMod;
+    LUT m_lutDiv;
+    LUT m_lutState;
+    LUT m_lutCombine;
+    LUT m_lutSign;
+    LUT m_lutFinal;
+    LUT m_lutMultLow;
+    LUT m_lutMultHigh;
+};
+
+}  // namespace lbcrypto
+
+#endif
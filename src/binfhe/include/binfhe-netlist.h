@@ -0,0 +1,188 @@
+//==================================================================================
+// BSD 2-Clause License
+//
+// Copyright (c) 2014-2023, NJIT, Duality Technologies Inc. and other contributors
+//
+// All rights reserved.
+//
+// Author TPOC: contact@openfhe.org
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice, this
+//    list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+//    this list of conditions and the following disclaimer in the documentation
+//    and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+// OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//==================================================================================
+
+/*
+  Boolean circuits (gate netlists) evaluated level by level with concurrent bootstrapping
+ */
+
+#ifndef BINFHE_BINFHE_NETLIST_H
+#define BINFHE_BINFHE_NETLIST_H
+
+#include "binfhecontext.h"
+
+#include <istream>
+#include <memory>
+#include <vector>
+
+namespace lbcrypto {
+
+/**
+ * @brief Directed acyclic graph of boolean gates evaluated with a BinFHEContext. Wires are identified by the
+ * indices returned from the Add* methods, and a gate may only read wires that already exist, so the insertion
+ * order is a topological order. Before evaluation the netlist is compiled into a schedule:
+ * - NOT gates and XOR/XNOR with a constant become free negations that are folded into the neighbouring gates
+ *   (e.g., NOT(AND) -> NAND, XOR(NOT a, b) -> XNOR(a, b), AND(NOT a, NOT b) -> NOR(a, b));
+ * - the remaining constants are propagated and gates that do not reach an output are dropped;
+ * - CMUX is expanded into its three NAND gates;
+ * - every gate is assigned the level 1 + the maximum level of its inputs.
+ * All gates of a level are independent and are bootstrapped concurrently with ParallelFor, which runs on the
+ * work-stealing task pool when the library is built with WITH_TASKPOOL, so idle threads pick up the remaining gates
+ * of the level. The schedule is compiled on first use and cached until the netlist is modified; the Add* methods
+ * must not be called concurrently with Evaluate.
+ *
+ * Text format accepted by Load (one statement per line, '#' starts a comment):
+ *   INPUT a b c            declares inputs in the order they are passed to Evaluate
+ *   one = CONST 1          constant 0 or 1
+ *   t = AND a b            OR, AND, NOR, NAND, XOR, XNOR (two inputs), MAJORITY, CMUX (three inputs), NOT (one)
+ *   OUTPUT t               declares outputs in the order they are returned by Evaluate
+ */
+class BinFHENetlist {
+public:
+    /**
+   * Adds a circuit input
+   * @return the wire of the input
+   */
+    uint32_t AddInput();
+
+    /**
+   * Adds a constant wire
+   * @return the wire of the constant
+   */
+    uint32_t AddConstant(bool value);
+
+    /**
+   * Adds a NOT gate (no bootstrapping is needed)
+   * @return the output wire
+   */
+    uint32_t AddNOT(uint32_t wire);
+
+    /**
+   * Adds a gate; AND3, OR3, AND4 and OR4 are not supported as they need inputs with a different plaintext modulus
+   *
+   * @param gate OR, AND, NOR, NAND, XOR, XNOR, MAJORITY or CMUX (inputs: 0-branch, 1-branch, selector)
+   * @param wires input wires
+   * @return the output wire
+   */
+    uint32_t AddGate(BINGATE gate, const std::vector<uint32_t>& wires);
+
+    /**
+   * Marks a wire as a circuit output
+   */
+    void AddOutput(uint32_t wire);
+
+    /**
+   * Reads a netlist in the text format described above
+   *
+   * @param stream input stream
+   * @return the netlist
+   */
+    static BinFHENetlist Load(std::istream& stream);
+
+    /**
+   * Evaluates the circuit
+   *
+   * @param cc context with generated bootstrapping keys
+   * @param inputs one ciphertext (plaintext modulus 4) per circuit input
+   * @return one ciphertext per circuit output
+   */
+    std::vector<LWECiphertext> Evaluate(const BinFHEContext& cc, const std::vector<LWECiphertext>& inputs) const;
+
+    uint32_t GetNumInputs() const {
+        return m_numInputs;
+    }
+
+    uint32_t GetNumOutputs() const {
+        return m_outputs.size();
+    }
+
+    /**
+   * @return the number of bootstrapped gates after compilation
+   */
+    uint32_t GetNumBootstraps() const;
+
+    /**
+   * @return the number of sequential levels of bootstrapped gates after compilation
+   */
+    uint32_t GetDepth() const;
+
+private:
+    enum NodeType { INPUT_NODE, CONSTANT_NODE, NOT_NODE, GATE_NODE };
+
+    struct Node {
+        NodeType type;
+        BINGATE gate;
+        // input index for INPUT_NODE, value for CONSTANT_NODE
+        uint32_t index;
+        std::vector<uint32_t> wires;
+    };
+
+    enum SignalSource { INPUT_SIGNAL, CONSTANT_SIGNAL, GATE_SIGNAL };
+
+    // a possibly negated reference to a circuit input, a constant or a scheduled gate
+    struct Signal {
+        SignalSource source;
+        uint32_t index;
+        bool negated;
+    };
+
+    struct Step {
+        BINGATE gate;
+        std::vector<Signal> inputs;
+    };
+
+    struct Schedule {
+        std::vector<Step> steps;
+        std::vector<std::vector<uint32_t>> levels;
+        std::vector<Signal> outputs;
+    };
+
+    Schedule Compile() const;
+
+    // returns the cached schedule, compiling it if the netlist was modified since the last call
+    std::shared_ptr<const Schedule> GetSchedule() const;
+
+    static Signal Negate(Signal signal);
+
+    // adds the gate to the schedule after constant and negation folding
+    static Signal Fold(std::vector<Step>& steps, BINGATE gate, const std::vector<Signal>& inputs);
+
+    void ValidateWire(uint32_t wire) const;
+
+    std::vector<Node> m_nodes;
+    std::vector<uint32_t> m_outputs;
+    uint32_t m_numInputs{0};
+    // accessed with std::atomic_load/atomic_store so that concurrent Evaluate calls may fill it in
+    mutable std::shared_ptr<const Schedule> m_schedule;
+};
+
+}  // namespace lbcrypto
+
+#endif
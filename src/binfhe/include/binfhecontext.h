@@ -258,7 +258,8 @@ public:
     LWESwitchingKey KeySwitchGen(ConstLWEPrivateKey& sk, ConstLWEPrivateKey& skN) const;
 
     /**
-   * Generates boostrapping keys
+   * Generates boostrapping keys. For CGGI and GINX_FFT the refresh key is produced directly in the flat,
+   * cache-aligned layout (see RingGSWACCKeyImpl::GetFlatKey and RingGSWACCKeyImpl::GetFourierKey)
    *
    * @param sk secret key
    * @param keygenMode key generation mode for symmetric or public encryption
@@ -313,6 +314,18 @@ public:
    */
     LWECiphertext EvalBinGate(BINGATE gate, const std::vector<LWECiphertext>& ctvector, bool extended = false) const;
 
+    /**
+   * Evaluates a batch of independent binary gates; the bootstraps run in parallel
+   *
+   * @param gates the gates (AND, OR, NAND, NOR, XOR, or XNOR); either one gate for all pairs or one per pair
+   * @param ct1s first input ciphertexts
+   * @param ct2s second input ciphertexts
+   * @return the resulting ciphertexts, in input order
+   */
+    std::vector<LWECiphertext> EvalBinGateBatch(const std::vector<BINGATE>& gates,
+                                                const std::vector<LWECiphertext>& ct1s,
+                                                const std::vector<LWECiphertext>& ct2s, bool extended = false) const;
+
     /**
    * Bootstraps a ciphertext (without peforming any operation)
    *
@@ -321,6 +334,14 @@ public:
    */
     LWECiphertext Bootstrap(ConstLWECiphertext& ct, bool extended = false) const;
 
+    /**
+   * Bootstraps a batch of independent ciphertexts in parallel
+   *
+   * @param cts ciphertexts to be bootstrapped
+   * @return the resulting ciphertexts, in input order
+   */
+    std::vector<LWECiphertext> BootstrapBatch(const std::vector<LWECiphertext>& cts, bool extended = false) const;
+
     /**
    * Evaluate an arbitrary function
    *
@@ -330,6 +351,18 @@ public:
    */
     LWECiphertext EvalFunc(ConstLWECiphertext& ct, const std::vector<NativeInteger>& LUT) const;
 
+    /**
+   * Evaluate several arbitrary functions on the same ciphertext, sharing one blind rotation per
+   * bootstrapping stage (multi-value bootstrapping). The output noise grows with the total variation
+   * of each LUT, so this is meant for small plaintext moduli.
+   *
+   * @param ct ciphertext to be bootstrapped
+   * @param LUTs the look-up tables of the to-be-evaluated functions
+   * @return the resulting ciphertexts, one per LUT
+   */
+    std::vector<LWECiphertext> EvalFuncMulti(ConstLWECiphertext& ct,
+                                             const std::vector<std::vector<NativeInteger>>& LUTs) const;
+
     /**
    * Generate the LUT for the to-be-evaluated function
    *
@@ -33,6 +33,7 @@
 #define _LWE_KEYSWITCHKEY_H_
 
 #include "lwe-keyswitchkey-fwd.h"
+#include "binfhe-flatkey.h"
 
 #include "math/math-hal.h"
 #include "utils/serializable.h"
@@ -44,7 +45,8 @@
 
 namespace lbcrypto {
 /**
- * @brief Class that stores the LWE scheme switching key
+ * @brief Class that stores the LWE scheme switching key, either as nested vectors indexed by
+ * [i][digit value][digit index] or in the flat transposed layout (see GetFlatA)
  */
 class LWESwitchingKeyImpl : public Serializable {
 public:
@@ -58,20 +60,31 @@ public:
                         std::vector<std::vector<std::vector<NativeInteger>>>&& keyB)
         : m_keyA(std::move(keyA)), m_keyB(std::move(keyB)) {}
 
-    LWESwitchingKeyImpl(const LWESwitchingKeyImpl& rhs) : m_keyA(rhs.m_keyA), m_keyB(rhs.m_keyB) {}
+    LWESwitchingKeyImpl(std::shared_ptr<const FlatKey<NativeInteger>> flatA, std::vector<NativeInteger>&& flatB)
+        : m_flatA(std::move(flatA)), m_flatB(std::move(flatB)) {}
+
+    LWESwitchingKeyImpl(const LWESwitchingKeyImpl& rhs)
+        : m_keyA(rhs.m_keyA), m_keyB(rhs.m_keyB), m_flatA(rhs.m_flatA), m_flatB(rhs.m_flatB) {}
 
     LWESwitchingKeyImpl(LWESwitchingKeyImpl&& rhs) noexcept
-        : m_keyA(std::move(rhs.m_keyA)), m_keyB(std::move(rhs.m_keyB)) {}
+        : m_keyA(std::move(rhs.m_keyA)),
+          m_keyB(std::move(rhs.m_keyB)),
+          m_flatA(std::move(rhs.m_flatA)),
+          m_flatB(std::move(rhs.m_flatB)) {}
 
     LWESwitchingKeyImpl& operator=(const LWESwitchingKeyImpl& rhs) {
-        m_keyA = rhs.m_keyA;
-        m_keyB = rhs.m_keyB;
+        m_keyA  = rhs.m_keyA;
+        m_keyB  = rhs.m_keyB;
+        m_flatA = rhs.m_flatA;
+        m_flatB = rhs.m_flatB;
         return *this;
     }
 
     LWESwitchingKeyImpl& operator=(LWESwitchingKeyImpl&& rhs) noexcept {
-        m_keyA = std::move(rhs.m_keyA);
-        m_keyB = std::move(rhs.m_keyB);
+        m_keyA  = std::move(rhs.m_keyA);
+        m_keyB  = std::move(rhs.m_keyB);
+        m_flatA = std::move(rhs.m_flatA);
+        m_flatB = std::move(rhs.m_flatB);
         return *this;
     }
 
@@ -91,8 +104,28 @@ public:
         m_keyB = keyB;
     }
 
+    /**
+   * Flat transposed layout of the A parts, or nullptr if the key uses the nested layout:
+   * GetFlatA()->Get(i, j, v, 0) points to the n coefficients of K_A[i][v][j], so that the rows
+   * selected by the consecutive digits j of one input coefficient i lie in increasing order in memory
+   */
+    const std::shared_ptr<const FlatKey<NativeInteger>>& GetFlatA() const {
+        return m_flatA;
+    }
+
+    /**
+   * B parts of the flat layout: K_B[i][v][j] is stored at (i * digitCount + j) * baseKS + v
+   */
+    const std::vector<NativeInteger>& GetFlatB() const {
+        return m_flatB;
+    }
+
     bool operator==(const LWESwitchingKeyImpl& other) const {
-        return (m_keyA == other.m_keyA && m_keyB == other.m_keyB);
+        if (m_keyA != other.m_keyA || m_keyB != other.m_keyB || m_flatB != other.m_flatB)
+            return false;
+        if (m_flatA == nullptr || other.m_flatA == nullptr)
+            return m_flatA == other.m_flatA;
+        return *m_flatA == *other.m_flatA;
     }
 
     bool operator!=(const LWESwitchingKeyImpl& other) const {
@@ -103,6 +136,12 @@ public:
     void save(Archive& ar, std::uint32_t const version) const {
         ar(::cereal::make_nvp("a", m_keyA));
         ar(::cereal::make_nvp("b", m_keyB));
+        bool flat{m_flatA != nullptr};
+        ar(::cereal::make_nvp("fp", flat));
+        if (flat) {
+            ar(::cereal::make_nvp("fa", *m_flatA));
+            ar(::cereal::make_nvp("fb", m_flatB));
+        }
     }
 
     template <class Archive>
@@ -114,18 +153,34 @@ public:
 
         ar(::cereal::make_nvp("a", m_keyA));
         ar(::cereal::make_nvp("b", m_keyB));
+        m_flatA.reset();
+        m_flatB.clear();
+        if (version > 1) {
+            bool flat{false};
+            ar(::cereal::make_nvp("fp", flat));
+            if (flat) {
+                auto flatA = std::make_shared<FlatKey<NativeInteger>>();
+                ar(::cereal::make_nvp("fa", *flatA));
+                ar(::cereal::make_nvp("fb", m_flatB));
+                m_flatA = std::move(flatA);
+            }
+        }
     }
 
     std::string SerializedObjectName() const override {
         return "LWEPrivateKey";
     }
     static uint32_t SerializedVersion() {
-        return 1;
+        return 2;
     }
 
 private:
     std::vector<std::vector<std::vector<NativeVector>>> m_keyA;
     std::vector<std::vector<std::vector<NativeInteger>>> m_keyB;
+
+    // flat transposed layout (shared read-only between copies)
+    std::shared_ptr<const FlatKey<NativeInteger>> m_flatA;
+    std::vector<NativeInteger> m_flatB;
 };
 
 }  // namespace lbcrypto
@@ -223,6 +223,19 @@ public:
    * @return a shared pointer to the ciphertext
    */
     LWECiphertext NoiselessEmbedding(const std::shared_ptr<LWECryptoParams>& params, LWEPlaintext m) const;
+
+private:
+    /**
+   * Switches ciphertext from (Q,N) to (Q,n) using a key in the flat transposed layout
+   * (see LWESwitchingKeyImpl::GetFlatA); multithreaded over the input coefficients
+   *
+   * @param params a shared pointer to LWE scheme parameters
+   * @param K switching key
+   * @param ctQN input ciphertext
+   * @return a shared pointer to the resulting ciphertext
+   */
+    LWECiphertext KeySwitchFlat(const std::shared_ptr<LWECryptoParams>& params, const LWESwitchingKeyImpl& K,
+                                ConstLWECiphertext& ctQN) const;
 };
 
 }  // namespace lbcrypto
@@ -0,0 +1,107 @@
+//==================================================================================
+// BSD 2-Clause License
+//
+// Copyright (c) 2014-2023, NJIT, Duality Technologies Inc. and other contributors
+//
+// All rights reserved.
+//
+// Author TPOC: contact@openfhe.org
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice, this
+//    list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+//    this list of conditions and the following disclaimer in the documentation
+//    and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+// OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//==================================================================================
+
+#ifndef _RGSW_ACC_CGGI_FFT_H_
+#define _RGSW_ACC_CGGI_FFT_H_
+
+#include "rgsw-acc.h"
+
+#include <memory>
+
+namespace lbcrypto {
+
+/**
+ * @brief Ring GSW accumulator scheme of https://eprint.iacr.org/2018/421.pdf and https://eprint.iacr.org/2020/086
+ * (CGGI with ternary MUX) whose external products are computed with double-precision negacyclic FFTs instead of
+ * 64-bit NTTs. The bootstrapping key is stored in the complex FFT domain as a FlatKey of
+ * n x 2 (s_i = 1, s_i = -1) x digitsG2 x 2 spectra of N doubles each (see RingGSWACCKeyImpl::GetFourierKey).
+ * Only moduli Q < 2^32 are supported, for which the rounding errors of the FFT stay far below the bootstrapping noise.
+ */
+class RingGSWAccumulatorCGGIFFT final : public RingGSWAccumulator {
+public:
+    RingGSWAccumulatorCGGIFFT() = default;
+
+    /**
+   * Key generation for internal Ring GSW as described in https://eprint.iacr.org/2018/421.pdf
+   *
+   * @param params a shared pointer to RingGSW scheme parameters
+   * @param skNTT secret key polynomial in the EVALUATION representation
+   * @param LWEsk the secret key
+   * @return a shared pointer to the resulting keys
+   */
+    RingGSWACCKey KeyGenAcc(const std::shared_ptr<RingGSWCryptoParams>& params, const NativePoly& skNTT,
+                            ConstLWEPrivateKey& LWEsk) const override;
+
+    /**
+   * Main accumulator function used in bootstrapping - GINX_FFT variant
+   *
+   * @param params a shared pointer to RingGSW scheme parameters
+   * @param ek the accumulator key
+   * @param acc previous value of the accumulator
+   * @param a value to update the accumulator with
+   */
+    void EvalAcc(const std::shared_ptr<RingGSWCryptoParams>& params, ConstRingGSWACCKey& ek, RLWECiphertext& acc,
+                 const NativeVector& a) const override;
+
+private:
+    // per-thread scratch space, defined in rgsw-acc-cggi-fft.cpp
+    struct CGGIFFTWorkspace;
+
+    /**
+   * Generates an RGSW encryption of m as in https://eprint.iacr.org/2020/086 and writes its
+   * 2 * digitsG2 polynomials to out in the FFT domain
+   *
+   * @param params a shared pointer to RingGSW scheme parameters
+   * @param skNTT secret key polynomial in the EVALUATION representation
+   * @param m a plaintext
+   * @param out destination of the 2 * digitsG2 * N doubles
+   */
+    void KeyGenCGGIFFT(const std::shared_ptr<RingGSWCryptoParams>& params, const NativePoly& skNTT, LWEPlaintext m,
+                       double* out) const;
+
+    /**
+   * CGGI Accumulation with the ternary MUX: acc += (X^a - 1) * (acc [x] ek1) + (X^-a - 1) * (acc [x] ek2),
+   * with both external products and the monomial multiplications evaluated in the FFT domain
+   *
+   * @param params a shared pointer to RingGSW scheme parameters
+   * @param ek the flat accumulator key in the FFT domain
+   * @param i LWE secret index selecting ek1 = ek(i, 0) and ek2 = ek(i, 1)
+   * @param a exponent of the monomial in [1, 2N)
+   * @param acc previous value of the accumulator in the COEFFICIENT representation
+   * @param ws scratch space of the calling thread
+   */
+    void AddToAccCGGIFFT(const std::shared_ptr<RingGSWCryptoParams>& params, const FlatKey<double>& ek, uint32_t i,
+                         uint32_t a, RLWECiphertext& acc, CGGIFFTWorkspace& ws) const;
+};
+
+}  // namespace lbcrypto
+
+#endif  // _RGSW_ACC_CGGI_FFT_H_
@@ -91,6 +91,19 @@ private:
    */
     void AddToAccCGGI(const std::shared_ptr<RingGSWCryptoParams>& params, ConstRingGSWEvalKey& ek1,
                       ConstRingGSWEvalKey& ek2, const NativeInteger& a, RLWECiphertext& acc) const;
+
+    /**
+   * CGGI Accumulation for keys in the flat layout (see RingGSWACCKeyImpl::GetFlatKey)
+   *
+   * @param params a shared pointer to RingGSW scheme parameters
+   * @param ek the flat accumulator key in the NTT domain
+   * @param i LWE secret index selecting ek1 = ek(i, 0) and ek2 = ek(i, 1)
+   * @param a a value to add to the accumulator
+   * @param acc previous value of the accumulator
+   * @param ws scratch space of the calling thread
+   */
+    void AddToAccCGGI(const std::shared_ptr<RingGSWCryptoParams>& params, const FlatKey<NativeInteger>& ek, uint32_t i,
+                      const NativeInteger& a, RLWECiphertext& acc, Workspace& ws) const;
 };
 
 }  // namespace lbcrypto
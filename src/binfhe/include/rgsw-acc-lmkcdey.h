@@ -69,6 +69,9 @@ public:
                  const NativeVector& a) const override;
 
 private:
+    // per-thread scratch space, defined in rgsw-acc-lmkcdey.cpp
+    struct LMKCDEYWorkspace;
+
     /**
    * LMKCDEY Key generation for internal Ring GSW as described in https://eprint.iacr.org/2022/198
    *
@@ -97,22 +100,24 @@ private:
    * @param params a shared pointer to RingGSW scheme parameters
    * @param ek evaluation key for Ring GSW
    * @param acc previous value of the accumulator
+   * @param ws scratch space of the calling thread
    * @return
    */
     void AddToAccLMKCDEY(const std::shared_ptr<RingGSWCryptoParams>& params, ConstRingGSWEvalKey& ek,
-                         RLWECiphertext& acc) const;
+                         RLWECiphertext& acc, LMKCDEYWorkspace& ws) const;
 
     /**
    * LMKCDEY Accumulation automorphism evaluation as described in https://eprint.iacr.org/2022/198
    *
    * @param params a shared pointer to RingGSW scheme parameters
-   * @param a index
+   * @param k index of the automorphism key (see RingGSWCryptoParams::GetAutoExponent)
    * @param ak evaluation key for Ring GSW
    * @param acc previous value of the accumulator
+   * @param ws scratch space of the calling thread
    * @return
    */
-    void Automorphism(const std::shared_ptr<RingGSWCryptoParams>& params, const NativeInteger& a,
-                      ConstRingGSWEvalKey& ak, RLWECiphertext& acc) const;
+    void Automorphism(const std::shared_ptr<RingGSWCryptoParams>& params, uint32_t k, ConstRingGSWEvalKey& ak,
+                      RLWECiphertext& acc, LMKCDEYWorkspace& ws) const;
 };
 
 }  // namespace lbcrypto
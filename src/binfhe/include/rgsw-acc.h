@@ -38,6 +38,7 @@
 
 #include <vector>
 #include <memory>
+#include <utility>
 
 namespace lbcrypto {
 
@@ -97,6 +98,41 @@ public:
    */
     void SignedDigitDecompose(const std::shared_ptr<RingGSWCryptoParams>& params, const NativePoly& input,
                               std::vector<NativePoly>& output) const;
+
+protected:
+    /**
+   * Scratch space of the NTT-based accumulators: a copy of the accumulator, its gadget digits and a temporary
+   * polynomial. Schemes that need more buffers derive from it.
+   */
+    struct Workspace {
+        std::vector<NativePoly> ct;
+        std::vector<NativePoly> dct;
+        NativePoly tmp;
+        NativeInteger mu;
+
+        std::shared_ptr<ILNativeParams> polyParams;
+
+        // (re)allocates the polynomials when the parameters change
+        void Prepare(const std::shared_ptr<RingGSWCryptoParams>& params);
+    };
+
+    /**
+   * Returns the workspace of type T of the calling thread after calling T::Prepare(args...). The workspace lives as
+   * long as the thread, so that EvalAcc does not touch the heap once warmed up.
+   */
+    template <typename T, typename... Args>
+    static T& GetWorkspace(Args&&... args) {
+        thread_local T ws;
+        ws.Prepare(std::forward<Args>(args)...);
+        return ws;
+    }
+
+    // sets all coefficients to zero without reallocating
+    static void ZeroPoly(NativePoly& p, Format format);
+
+    // out += a * b (all in the EVALUATION representation), b pointing to N coefficients
+    static void MultiplyAccumulate(NativePoly& out, const NativePoly& a, const NativeInteger* b,
+                                   const NativeInteger& Q, const NativeInteger& mu);
 };
 }  // namespace lbcrypto
 
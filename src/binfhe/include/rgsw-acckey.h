@@ -37,6 +37,7 @@
 #include "lwe-privatekey.h"
 #include "lwe-cryptoparameters.h"
 #include "rgsw-evalkey.h"
+#include "binfhe-flatkey.h"
 
 #include "lattice/lat-hal.h"
 #include "math/discretegaussiangenerator.h"
@@ -58,7 +59,8 @@ using ConstRingGSWACCKey = const std::shared_ptr<const RingGSWACCKeyImpl>;
 
 /**
  * @brief Class that stores the refresh key (used in bootstrapping)
- * A three-dimensional vector of RingGSW ciphertexts
+ * A three-dimensional vector of RingGSW ciphertexts, or a flat key in the NTT or FFT domain
+ * that is shared read-only by all copies of the key
  */
 class RingGSWACCKeyImpl : public Serializable {
 public:
@@ -68,17 +70,25 @@ public:
 
     explicit RingGSWACCKeyImpl(const std::vector<std::vector<std::vector<RingGSWEvalKey>>>& key) : m_key(key) {}
 
-    RingGSWACCKeyImpl(const RingGSWACCKeyImpl& rhs) : m_key(rhs.m_key) {}
+    RingGSWACCKeyImpl(const RingGSWACCKeyImpl& rhs)
+        : m_key(rhs.m_key), m_flatKey(rhs.m_flatKey), m_fourierKey(rhs.m_fourierKey) {}
 
-    RingGSWACCKeyImpl(RingGSWACCKeyImpl&& rhs) noexcept : m_key(std::move(rhs.m_key)) {}
+    RingGSWACCKeyImpl(RingGSWACCKeyImpl&& rhs) noexcept
+        : m_key(std::move(rhs.m_key)),
+          m_flatKey(std::move(rhs.m_flatKey)),
+          m_fourierKey(std::move(rhs.m_fourierKey)) {}
 
     RingGSWACCKeyImpl& operator=(const RingGSWACCKeyImpl& rhs) {
-        this->m_key = rhs.m_key;
+        this->m_key        = rhs.m_key;
+        this->m_flatKey    = rhs.m_flatKey;
+        this->m_fourierKey = rhs.m_fourierKey;
         return *this;
     }
 
     RingGSWACCKeyImpl& operator=(RingGSWACCKeyImpl&& rhs) noexcept {
-        this->m_key = std::move(rhs.m_key);
+        this->m_key        = std::move(rhs.m_key);
+        this->m_flatKey    = std::move(rhs.m_flatKey);
+        this->m_fourierKey = std::move(rhs.m_fourierKey);
         return *this;
     }
 
@@ -90,6 +100,30 @@ public:
         m_key = key;
     }
 
+    /**
+   * Flat bootstrapping key in the NTT domain, or nullptr if the key uses the nested layout
+   * (produced by CGGI key generation)
+   */
+    const std::shared_ptr<const FlatKey<NativeInteger>>& GetFlatKey() const {
+        return m_flatKey;
+    }
+
+    void SetFlatKey(std::shared_ptr<const FlatKey<NativeInteger>> key) {
+        m_flatKey = std::move(key);
+    }
+
+    /**
+   * Flat bootstrapping key in the complex FFT domain, or nullptr (used only for GINX_FFT bootstrapping);
+   * see RingGSWAccumulatorCGGIFFT for the layout
+   */
+    const std::shared_ptr<const FlatKey<double>>& GetFourierKey() const {
+        return m_fourierKey;
+    }
+
+    void SetFourierKey(std::shared_ptr<const FlatKey<double>> key) {
+        m_fourierKey = std::move(key);
+    }
+
     std::vector<std::vector<RingGSWEvalKey>>& operator[](uint32_t i) {
         return m_key[i];
     }
@@ -99,6 +133,8 @@ public:
     }
 
     bool operator==(const RingGSWACCKeyImpl& other) const {
+        if (!SameFlatKey(m_flatKey, other.m_flatKey) || !SameFlatKey(m_fourierKey, other.m_fourierKey))
+            return false;
         // as RingGSWEvalKey is shared_ptr<RingGSWEvalKeyImpl>, we have to loop through all elements to compare them
         if (m_key.size() != other.m_key.size())
             return false;
@@ -136,6 +172,8 @@ public:
     template <class Archive>
     void save(Archive& ar, std::uint32_t const version) const {
         ar(::cereal::make_nvp("k", m_key));
+        SaveFlatKey(ar, "np", "n", m_flatKey);
+        SaveFlatKey(ar, "fp", "f", m_fourierKey);
     }
 
     template <class Archive>
@@ -145,13 +183,19 @@ public:
                           " is from a later version of the library");
         }
         ar(::cereal::make_nvp("k", m_key));
+        m_flatKey.reset();
+        m_fourierKey.reset();
+        if (version > 1) {
+            LoadFlatKey(ar, "np", "n", m_flatKey);
+            LoadFlatKey(ar, "fp", "f", m_fourierKey);
+        }
     }
 
     std::string SerializedObjectName() const override {
         return "RingGSWACCKey";
     }
     static uint32_t SerializedVersion() {
-        return 1;
+        return 2;
     }
 
 private:
@@ -159,7 +203,41 @@ private:
     using dim2_t = std::vector<dim3_t>;
     using dim1_t = std::vector<dim2_t>;
 
+    template <typename T>
+    static bool SameFlatKey(const std::shared_ptr<const FlatKey<T>>& a, const std::shared_ptr<const FlatKey<T>>& b) {
+        if (a == nullptr || b == nullptr)
+            return a == b;
+        return a == b || *a == *b;
+    }
+
+    // flat keys are saved as a presence flag followed by the key itself
+    template <class Archive, typename T>
+    static void SaveFlatKey(Archive& ar, const char* flagName, const char* name,
+                            const std::shared_ptr<const FlatKey<T>>& key) {
+        bool present{key != nullptr};
+        ar(::cereal::make_nvp(flagName, present));
+        if (present)
+            ar(::cereal::make_nvp(name, *key));
+    }
+
+    template <class Archive, typename T>
+    static void LoadFlatKey(Archive& ar, const char* flagName, const char* name,
+                            std::shared_ptr<const FlatKey<T>>& key) {
+        bool present{false};
+        ar(::cereal::make_nvp(flagName, present));
+        key.reset();
+        if (present) {
+            auto loaded = std::make_shared<FlatKey<T>>();
+            ar(::cereal::make_nvp(name, *loaded));
+            key = std::move(loaded);
+        }
+    }
+
     std::vector<std::vector<std::vector<RingGSWEvalKey>>> m_key;
+
+    // flat key in the NTT domain (CGGI) and in the complex FFT domain (GINX_FFT)
+    std::shared_ptr<const FlatKey<NativeInteger>> m_flatKey;
+    std::shared_ptr<const FlatKey<double>> m_fourierKey;
 };
 
 }  // namespace lbcrypto
@@ -43,6 +43,7 @@
 #include "lwe-ciphertext.h"
 #include "lwe-keyswitchkey.h"
 #include "lwe-cryptoparameters.h"
+#include "rgsw-fft.h"
 
 #include <memory>
 #include <string>
@@ -145,6 +146,14 @@ public:
         return m_logGen;
     }
 
+    uint32_t GetAutoExponent(uint32_t k) const {
+        return m_autoExp[k];
+    }
+
+    const std::vector<uint32_t>& GetAutoMap(uint32_t k) const {
+        return m_autoMap[k];
+    }
+
     const std::map<uint32_t, std::vector<NativeInteger>>& GetGPowerMap() const {
         return m_Gpower_map;
     }
@@ -161,6 +170,10 @@ public:
         return m_monomials[i];
     }
 
+    const NegacyclicFFT& GetFFT() const {
+        return m_fft;
+    }
+
     BINFHE_METHOD GetMethod() const {
         return m_method;
     }
@@ -262,6 +275,13 @@ private:
     // m_logGen[-1 (mod M)] = M (special case for efficiency)
     std::vector<int32_t> m_logGen;
 
+    // Automorphism exponents of the automorphism keys (only for LMKCDEY):
+    // m_autoExp[0] = -5 (mod M), m_autoExp[k] = 5^k (mod M) for k = 1..m_numAutoKeys
+    std::vector<uint32_t> m_autoExp;
+
+    // Index maps of the automorphisms in m_autoExp for polynomials in EVALUATION representation
+    std::vector<std::vector<uint32_t>> m_autoMap;
+
     // Error distribution generator
     DiscreteGaussianGeneratorImpl<NativeVector> m_dgg;
 
@@ -278,6 +298,9 @@ private:
     // (used only for CGGI bootstrapping)
     std::vector<NativePoly> m_monomials;
 
+    // Negacyclic complex FFT tables (used only for GINX_FFT bootstrapping)
+    NegacyclicFFT m_fft;
+
     // Bootstrapping method (DM or CGGI or LMKCDEY)
     BINFHE_METHOD m_method{BINFHE_METHOD::INVALID_METHOD};
 
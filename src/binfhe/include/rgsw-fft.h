@@ -0,0 +1,109 @@
+//==================================================================================
+// BSD 2-Clause License
+//
+// Copyright (c) 2014-2023, NJIT, Duality Technologies Inc. and other contributors
+//
+// All rights reserved.
+//
+// Author TPOC: contact@openfhe.org
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice, this
+//    list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+//    this list of conditions and the following disclaimer in the documentation
+//    and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+// OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//==================================================================================
+
+#ifndef _RGSW_FFT_H_
+#define _RGSW_FFT_H_
+
+#include <cstdint>
+#include <vector>
+
+namespace lbcrypto {
+
+/**
+ * @brief Negacyclic complex FFT over R = Z[X]/(X^N + 1) in double precision, used by the
+ * GINX_FFT accumulator. A real polynomial of degree < N is folded into N/2 complex values
+ * (p_k + i * p_{k + N/2}) * zeta^k, zeta = exp(i * pi / N), and transformed with an N/2-point FFT,
+ * which yields its evaluations at the roots zeta^(4j + 1) of X^N + 1. Products in this
+ * representation are slot-wise complex products.
+ *
+ * The spectrum is kept in split form: N/2 real parts followed by N/2 imaginary parts, in bit-reversed
+ * slot order. Forward and inverse transforms never permute, so the bit-reversed order is only visible
+ * through GetMonomial.
+ */
+class NegacyclicFFT {
+public:
+    NegacyclicFFT() = default;
+
+    /**
+   * Precomputes the roots of unity, butterfly twiddles and slot exponents
+   *
+   * @param N ring dimension (a power of two, at least 4)
+   */
+    explicit NegacyclicFFT(uint32_t N);
+
+    uint32_t GetN() const {
+        return m_N;
+    }
+
+    /**
+   * Forward transform of a real polynomial with N coefficients
+   *
+   * @param in coefficients of the polynomial
+   * @param out spectrum of the polynomial (N doubles)
+   */
+    void Forward(const double* in, double* out) const;
+
+    /**
+   * Inverse transform; the spectrum is overwritten
+   *
+   * @param in spectrum of the polynomial (N doubles), used as scratch space
+   * @param out coefficients of the polynomial
+   */
+    void Inverse(double* in, double* out) const;
+
+    /**
+   * Spectrum of the polynomial X^a - 1
+   *
+   * @param a exponent in [0, 2N)
+   * @param out spectrum (N doubles)
+   */
+    void GetMonomial(uint32_t a, double* out) const;
+
+private:
+    // ring dimension
+    uint32_t m_N{};
+
+    // butterfly twiddles exp(2 * pi * i * k / len), k < len / 2, for len = 2, 4, ..., N/2;
+    // the twiddles of a stage with len / 2 = h start at offset h - 1
+    std::vector<double> m_twiddleRe;
+    std::vector<double> m_twiddleIm;
+
+    // zeta^t = cos(pi * t / N) + i * sin(pi * t / N) for t < 2N; the first N/2 are the twist factors
+    std::vector<double> m_rootRe;
+    std::vector<double> m_rootIm;
+
+    // exponent 4 * bitrev(p) + 1 of the root zeta^(4j + 1) evaluated at slot p
+    std::vector<uint32_t> m_slotExp;
+};
+
+}  // namespace lbcrypto
+
+#endif  // _RGSW_FFT_H_
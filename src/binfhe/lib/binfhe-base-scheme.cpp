@@ -31,6 +31,9 @@
 
 #include "binfhe-base-scheme.h"
 
+#include "utils/parallel.h"
+
+#include <numeric>
 #include <string>
 
 namespace lbcrypto {
@@ -76,6 +79,13 @@ RingGSWBTKey BinFHEScheme::KeyGen(const std::shared_ptr<BinFHECryptoParams>& par
 LWECiphertext BinFHEScheme::EvalBinGate(const std::shared_ptr<BinFHECryptoParams>& params, BINGATE gate,
                                         const RingGSWBTKey& EK, ConstLWECiphertext& ct1,
                                         ConstLWECiphertext& ct2, bool extended) const {
+    RLWECiphertext acc;
+    return EvalBinGate(params, gate, EK, ct1, ct2, extended, acc);
+}
+
+LWECiphertext BinFHEScheme::EvalBinGate(const std::shared_ptr<BinFHECryptoParams>& params, BINGATE gate,
+                                        const RingGSWBTKey& EK, ConstLWECiphertext& ct1, ConstLWECiphertext& ct2,
+                                        bool extended, RLWECiphertext& acc) const {
     if (params == nullptr)
         OPENFHE_THROW("BinFHECryptoParams is empty");
     if (ct1 == nullptr)
@@ -108,9 +118,10 @@ LWECiphertext BinFHEScheme::EvalBinGate(const std::shared_ptr<BinFHECryptoParams
 
     // the accumulator result is encrypted w.r.t. the transposed secret key
     // we can transpose "a" to get an encryption under the original secret key
-    auto accVec{BootstrapGateCore(params, gate, EK.BSkey, cct1)->GetElements()};
-    accVec[0] = accVec[0].Transpose();
-    accVec[0].SetFormat(Format::COEFFICIENT);
+    BootstrapGateCore(params, gate, EK.BSkey, cct1, acc);
+    auto& accVec = acc->GetElements();
+    auto a{accVec[0].Transpose()};
+    a.SetFormat(Format::COEFFICIENT);
     accVec[1].SetFormat(Format::COEFFICIENT);
 
     // hardcoded for p = 4
@@ -118,7 +129,7 @@ LWECiphertext BinFHEScheme::EvalBinGate(const std::shared_ptr<BinFHECryptoParams
     NativeInteger b{(Q >> 3) + 1};
     b.ModAddFastEq(accVec[1][0], Q);
 
-    auto ctExt = std::make_shared<LWECiphertextImpl>(std::move(accVec[0].GetValues()), b);
+    auto ctExt = std::make_shared<LWECiphertextImpl>(std::move(a.GetValues()), b);
 
     if (extended)
         return ctExt;
@@ -186,9 +197,54 @@ LWECiphertext BinFHEScheme::EvalBinGate(const std::shared_ptr<BinFHECryptoParams
     }
 }
 
+// Independent gates are bootstrapped concurrently. The per-gate parallelism inside the accumulators only
+// covers the few gadget digits, so one gate per thread keeps all cores busy; the nested OpenMP regions in
+// EvalAcc then run serially on each worker. The gates are split into one contiguous chunk per thread, and
+// each chunk reuses one accumulator for all its gates.
+std::vector<LWECiphertext> BinFHEScheme::EvalBinGateBatch(const std::shared_ptr<BinFHECryptoParams>& params,
+                                                          const std::vector<BINGATE>& gates, const RingGSWBTKey& EK,
+                                                          const std::vector<LWECiphertext>& ct1s,
+                                                          const std::vector<LWECiphertext>& ct2s,
+                                                          bool extended) const {
+    if (params == nullptr)
+        OPENFHE_THROW("BinFHECryptoParams is empty");
+
+    const uint32_t length = ct1s.size();
+    if (ct2s.size() != length)
+        OPENFHE_THROW("The input ciphertext vectors should have the same size");
+    if (gates.size() != 1 && gates.size() != length)
+        OPENFHE_THROW("Either one gate or one gate per ciphertext pair is expected");
+
+    // inputs and keys are checked before any gate is bootstrapped
+    CheckBTKey(params, EK);
+    for (uint32_t i = 0; i < length; ++i) {
+        if (ct1s[i] == nullptr || ct2s[i] == nullptr)
+            OPENFHE_THROW("Ciphertext " + std::to_string(i) + " is empty");
+        if (ct1s[i] == ct2s[i])
+            OPENFHE_THROW("Input ciphertexts " + std::to_string(i) + " should be independent");
+        const BINGATE gate = gates[gates.size() == 1 ? 0 : i];
+        if ((gate == MAJORITY) || (gate == AND3) || (gate == OR3) || (gate == AND4) || (gate == OR4) || (gate == CMUX))
+            OPENFHE_THROW("Only two-input gates can be evaluated in a batch");
+    }
+
+    std::vector<LWECiphertext> result(length);
+    ParallelForRange(0, length, OpenFHEParallelControls.GetThreadLimit(length), [&](size_t first, size_t last) {
+        RLWECiphertext acc;
+        for (size_t i = first; i < last; ++i)
+            result[i] = EvalBinGate(params, gates[gates.size() == 1 ? 0 : i], EK, ct1s[i], ct2s[i], extended, acc);
+    });
+    return result;
+}
+
 // Full evaluation as described in https://eprint.iacr.org/2020/086
 LWECiphertext BinFHEScheme::Bootstrap(const std::shared_ptr<BinFHECryptoParams>& params, const RingGSWBTKey& EK,
                                       ConstLWECiphertext& ct, bool extended) const {
+    RLWECiphertext acc;
+    return Bootstrap(params, EK, ct, extended, acc);
+}
+
+LWECiphertext BinFHEScheme::Bootstrap(const std::shared_ptr<BinFHECryptoParams>& params, const RingGSWBTKey& EK,
+                                      ConstLWECiphertext& ct, bool extended, RLWECiphertext& acc) const {
     if (params == nullptr)
         OPENFHE_THROW("BinFHECryptoParams is empty");
     if (ct == nullptr)
@@ -202,15 +258,16 @@ LWECiphertext BinFHEScheme::Bootstrap(const std::shared_ptr<BinFHECryptoParams>&
 
     // the accumulator result is encrypted w.r.t. the transposed secret key
     // we can transpose "a" to get an encryption under the original secret key
-    auto accVec{BootstrapGateCore(params, AND, EK.BSkey, cct)->GetElements()};
-    accVec[0] = accVec[0].Transpose();
-    accVec[0].SetFormat(Format::COEFFICIENT);
+    BootstrapGateCore(params, AND, EK.BSkey, cct, acc);
+    auto& accVec = acc->GetElements();
+    auto a{accVec[0].Transpose()};
+    a.SetFormat(Format::COEFFICIENT);
     accVec[1].SetFormat(Format::COEFFICIENT);
 
     NativeInteger b{Q / (ct->GetptModulus() * 2) + 1};
     b.ModAddFastEq(accVec[1][0], Q);
 
-    auto ctExt = std::make_shared<LWECiphertextImpl>(std::move(accVec[0].GetValues()), b);
+    auto ctExt = std::make_shared<LWECiphertextImpl>(std::move(a.GetValues()), b);
 
     if (!extended)
         ctExt = LWEscheme->SwitchCTtoqn(LWEParams, EK.KSkey, ctExt);
@@ -219,6 +276,56 @@ LWECiphertext BinFHEScheme::Bootstrap(const std::shared_ptr<BinFHECryptoParams>&
     return ctExt;
 }
 
+std::vector<LWECiphertext> BinFHEScheme::BootstrapBatch(const std::shared_ptr<BinFHECryptoParams>& params,
+                                                        const RingGSWBTKey& EK, const std::vector<LWECiphertext>& cts,
+                                                        bool extended) const {
+    if (params == nullptr)
+        OPENFHE_THROW("BinFHECryptoParams is empty");
+
+    const uint32_t length = cts.size();
+    CheckBTKey(params, EK);
+    for (uint32_t i = 0; i < length; ++i) {
+        if (cts[i] == nullptr)
+            OPENFHE_THROW("Ciphertext " + std::to_string(i) + " is empty");
+    }
+
+    std::vector<LWECiphertext> result(length);
+    ParallelForRange(0, length, OpenFHEParallelControls.GetThreadLimit(length), [&](size_t first, size_t last) {
+        RLWECiphertext acc;
+        for (size_t i = first; i < last; ++i)
+            result[i] = Bootstrap(params, EK, cts[i], extended, acc);
+    });
+    return result;
+}
+
+void BinFHEScheme::CheckBTKey(const std::shared_ptr<BinFHECryptoParams>& params, const RingGSWBTKey& EK) const {
+    if (EK.BSkey == nullptr || EK.KSkey == nullptr)
+        OPENFHE_THROW("Bootstrapping keys have not been generated. Please call BTKeyGen before calling bootstrapping.");
+
+    const auto& LWEParams = params->GetLWEParams();
+    const uint32_t n      = LWEParams->Getn();
+    const uint32_t N      = LWEParams->GetN();
+
+    const auto& flatA = EK.KSkey->GetFlatA();
+    const auto& keyA  = EK.KSkey->GetElementsA();
+    bool ksMatches    = false;
+    if (flatA != nullptr)
+        ksMatches = flatA->GetNumKeys() == N && flatA->GetPolySize() == n;
+    else
+        ksMatches = keyA.size() == N && !keyA[0].empty() && !keyA[0][0].empty() && keyA[0][0][0].GetLength() == n;
+    if (!ksMatches)
+        OPENFHE_THROW("The key switching key does not match the parameters");
+
+    // the accumulators check their own layout of the refresh key; only the dimensions of the flat layouts are
+    // checked here
+    const auto& flat    = EK.BSkey->GetFlatKey();
+    const auto& fourier = EK.BSkey->GetFourierKey();
+    if ((flat != nullptr && (flat->GetNumKeys() != n || flat->GetPolySize() != N)) ||
+        (fourier != nullptr && (fourier->GetNumKeys() != n || fourier->GetPolySize() != N)) ||
+        (flat == nullptr && fourier == nullptr && EK.BSkey->GetElements().empty()))
+        OPENFHE_THROW("The bootstrapping key does not match the parameters");
+}
+
 // Evaluation of the NOT operation; no key material is needed
 LWECiphertext BinFHEScheme::EvalNOT(const std::shared_ptr<BinFHECryptoParams>& params, ConstLWECiphertext& ct) const {
     if (params == nullptr)
@@ -331,6 +438,107 @@ LWECiphertext BinFHEScheme::EvalFunc(const std::shared_ptr<BinFHECryptoParams>&
     return BootstrapFunc(params, EK, ct2, fLUT1, q);
 }
 
+// Multi-value evaluation of several LUTs on the same input: the stages shared by all LUTs (the
+// half-domain reduction for periodic and arbitrary functions) are bootstrapped once, and the final
+// stage evaluates all LUTs with a single blind rotation
+std::vector<LWECiphertext> BinFHEScheme::EvalFuncMulti(const std::shared_ptr<BinFHECryptoParams>& params,
+                                                       const RingGSWBTKey& EK, ConstLWECiphertext& ct,
+                                                       const std::vector<std::vector<NativeInteger>>& LUTs,
+                                                       const NativeInteger& beta) const {
+    if (params == nullptr)
+        OPENFHE_THROW("BinFHECryptoParams is empty");
+    if (ct == nullptr)
+        OPENFHE_THROW("Ciphertext is empty");
+    if (LUTs.empty())
+        OPENFHE_THROW("No look-up tables to evaluate");
+
+    NativeInteger q{ct->GetModulus()};
+
+    // all LUTs share the evaluation path: negacyclic (0) or periodic (1) only if all of them are,
+    // the general path (2) otherwise
+    uint32_t functionProperty{this->checkInputFunction(LUTs[0], q)};
+    for (size_t i = 1; i < LUTs.size(); ++i) {
+        if (this->checkInputFunction(LUTs[i], q) != functionProperty)
+            functionProperty = 2;
+    }
+
+    using LUTFunc = std::function<NativeInteger(NativeInteger, NativeInteger, NativeInteger)>;
+    std::vector<LUTFunc> fs;
+    fs.reserve(LUTs.size());
+
+    auto ct1 = std::make_shared<LWECiphertextImpl>(*ct);
+
+    if (functionProperty == 0) {  // negacyclic functions only need one bootstrap
+        for (const auto& LUT : LUTs) {
+            fs.emplace_back([&LUT](NativeInteger x, NativeInteger q, NativeInteger Q) -> NativeInteger {
+                return LUT[x.ConvertToInt()];
+            });
+        }
+        LWEscheme->EvalAddConstEq(ct1, beta);
+        return BootstrapFuncMulti(params, EK, ct1, fs, q);
+    }
+
+    // this is 1/4q_small or -1/4q_small mod q
+    auto f0 = [](NativeInteger x, NativeInteger q, NativeInteger Q) -> NativeInteger {
+        if (x < (q >> 1))
+            return Q - (q >> 2);
+        else
+            return (q >> 2);
+    };
+
+    if (functionProperty == 2) {  // arbitary functions
+        const auto& LWEParams = params->GetLWEParams();
+        uint32_t N{LWEParams->GetN()};
+        if (q.ConvertToInt() > N) {  // need q to be at most = N for arbitary function
+            std::string errMsg =
+                "ERROR: ciphertext modulus q needs to be <= ring dimension for arbitrary function evaluation";
+            OPENFHE_THROW(errMsg);
+        }
+
+        NativeInteger dq{q << 1};
+        // raise the modulus of ct1 : q -> 2q
+        ct1->GetA().SetModulus(dq);
+        auto ct2 = std::make_shared<LWECiphertextImpl>(*ct1);
+        LWEscheme->EvalAddConstEq(ct2, beta);
+
+        auto ct3 = BootstrapFunc(params, EK, ct2, f0, dq);
+        LWEscheme->EvalSubEq2(ct1, ct3);
+        LWEscheme->EvalAddConstEq(ct3, beta);
+        LWEscheme->EvalSubConstEq(ct3, q >> 1);
+
+        // the LUT is repeated to make it periodic over 2q
+        for (const auto& LUT : LUTs) {
+            fs.emplace_back([&LUT](NativeInteger x, NativeInteger q, NativeInteger Q) -> NativeInteger {
+                if (x < (q >> 1))
+                    return LUT[x.ConvertToInt() % LUT.size()];
+                else
+                    return Q - LUT[(x.ConvertToInt() - q.ConvertToInt() / 2) % LUT.size()];
+            });
+        }
+        auto result = BootstrapFuncMulti(params, EK, ct3, fs, dq);
+        for (auto& ctOut : result)
+            ctOut->SetModulus(q);
+        return result;
+    }
+
+    // Else they are periodic functions so we evaluate directly
+    LWEscheme->EvalAddConstEq(ct1, beta);
+    auto ct2 = BootstrapFunc(params, EK, ct1, f0, q);
+    LWEscheme->EvalSubEq2(ct, ct2);
+    LWEscheme->EvalAddConstEq(ct2, beta);
+    LWEscheme->EvalSubConstEq(ct2, q >> 2);
+
+    for (const auto& LUT : LUTs) {
+        fs.emplace_back([&LUT](NativeInteger x, NativeInteger q, NativeInteger Q) -> NativeInteger {
+            if (x < (q >> 1))
+                return LUT[x.ConvertToInt()];
+            else
+                return Q - LUT[x.ConvertToInt() - q.ConvertToInt() / 2];
+        });
+    }
+    return BootstrapFuncMulti(params, EK, ct2, fs, q);
+}
+
 // Evaluate Homomorphic Flooring
 LWECiphertext BinFHEScheme::EvalFloor(const std::shared_ptr<BinFHECryptoParams>& params, const RingGSWBTKey& EK,
                                       ConstLWECiphertext& ct, const NativeInteger& beta, uint32_t roundbits) const {
@@ -524,6 +732,13 @@ std::vector<LWECiphertext> BinFHEScheme::EvalDecomp(const std::shared_ptr<BinFHE
 
 RLWECiphertext BinFHEScheme::BootstrapGateCore(const std::shared_ptr<BinFHECryptoParams>& params, BINGATE gate,
                                                ConstRingGSWACCKey& ek, ConstLWECiphertext& ct) const {
+    RLWECiphertext acc;
+    BootstrapGateCore(params, gate, ek, ct, acc);
+    return acc;
+}
+
+void BinFHEScheme::BootstrapGateCore(const std::shared_ptr<BinFHECryptoParams>& params, BINGATE gate,
+                                     ConstRingGSWACCKey& ek, ConstLWECiphertext& ct, RLWECiphertext& acc) const {
     if (params == nullptr)
         OPENFHE_THROW("BinFHECryptoParams is empty");
     if (ct == nullptr)
@@ -553,7 +768,22 @@ RLWECiphertext BinFHEScheme::BootstrapGateCore(const std::shared_ptr<BinFHECrypt
     auto uv = swap? Q2pNeg : Q2p;
 
     const uint32_t N = LWEParams->GetN();
-    NativeVector m(N, Q);
+    auto& polyParams = RGSWParams->GetPolyParams();
+    if (acc == nullptr || acc->GetElements().size() != 2 || acc->GetElements()[0].GetParams() != polyParams) {
+        std::vector<NativePoly> res(2);
+        res[0] = NativePoly(polyParams, Format::EVALUATION, true);
+        res[1] = NativePoly(polyParams, Format::COEFFICIENT, true);
+        acc    = std::make_shared<RLWECiphertextImpl>(std::move(res));
+    }
+    auto& res = acc->GetElements();
+    // no need to do NTT as all coefficients of this poly are zero
+    res[0].OverrideFormat(Format::EVALUATION);
+    res[1].OverrideFormat(Format::COEFFICIENT);
+    for (uint32_t i = 0; i < N; ++i) {
+        res[0][i] = 0;
+        res[1][i] = 0;
+    }
+
     // Since q | (2*N), we deal with a sparse embedding of Z_Q[x]/(X^{q/2}+1) to
     // Z_Q[x]/(X^N+1)
 
@@ -562,24 +792,15 @@ RLWECiphertext BinFHEScheme::BootstrapGateCore(const std::shared_ptr<BinFHECrypt
     NativeInteger b = ct->GetB();
 
     for (uint32_t i = 0; i < N; i += factor) {
-        m[i] = ((b >= lb) && (b < ub)) ? lv : uv;
+        res[1][i] = ((b >= lb) && (b < ub)) ? lv : uv;
         b.ModSubFastEq(1, q);
     }
-
-    std::vector<NativePoly> res(2);
-    auto& polyParams = RGSWParams->GetPolyParams();
-    // no need to do NTT as all coefficients of this poly are zero
-    res[0] = NativePoly(polyParams, Format::EVALUATION, true);
-    res[1] = NativePoly(polyParams, Format::COEFFICIENT, false);
-    res[1].SetValues(std::move(m), Format::COEFFICIENT);
     res[1].SetFormat(Format::EVALUATION);
 
     // main accumulation computation
     // the following loop is the bottleneck of bootstrapping/binary gate
     // evaluation
-    auto acc = std::make_shared<RLWECiphertextImpl>(std::move(res));
     ACCscheme->EvalAcc(RGSWParams, ek, acc, ct->GetA());
-    return acc;
 }
 
 // Functions below are for large-precision sign evaluation,
@@ -647,4 +868,92 @@ LWECiphertext BinFHEScheme::BootstrapFunc(const std::shared_ptr<BinFHECryptoPara
     return LWEscheme->ModSwitch(fmod, ctKS);
 }
 
+// Multi-value bootstrapping as described in https://eprint.iacr.org/2018/622
+// The test polynomial of BootstrapFuncCore is Delta * t(X^f), f = 2N/q, with the LUT values t_j. Over
+// Z_Q[X]/(X^N + 1), (1 - X^f) * (1 + X^f + ... + X^{N-f}) = 2, so it factors as TV0 * v(X) with the
+// common TV0 = Delta * g / 2 * (1 + X^f + ... + X^{N-f}) and v(X) = (1 - X^f) * t(X^f) / g, where g is
+// the gcd of all LUT values. The coefficients of v are differences of consecutive LUT values, so the
+// accumulator noise is scaled by the total variation of each LUT (in units of g).
+// TV0 is blind-rotated once and each v(X) is applied as a plaintext multiplication.
+std::vector<LWECiphertext> BinFHEScheme::BootstrapFuncMulti(
+    const std::shared_ptr<BinFHECryptoParams>& params, const RingGSWBTKey& EK, ConstLWECiphertext& ct,
+    const std::vector<std::function<NativeInteger(NativeInteger, NativeInteger, NativeInteger)>>& fs,
+    const NativeInteger& fmod) const {
+    if (EK.BSkey == nullptr) {
+        std::string errMsg =
+            "Bootstrapping keys have not been generated. Please call BTKeyGen before calling bootstrapping.";
+        OPENFHE_THROW(errMsg);
+    }
+
+    auto& LWEParams  = params->GetLWEParams();
+    auto& RGSWParams = params->GetRingGSWParams();
+    auto polyParams  = RGSWParams->GetPolyParams();
+
+    NativeInteger Q = LWEParams->GetQ();
+    uint32_t N      = LWEParams->GetN();
+
+    NativeInteger ctMod    = ct->GetModulus();
+    uint32_t factor        = (2 * N / ctMod.ConvertToInt());
+    uint32_t numValues     = ctMod.ConvertToInt<uint32_t>() >> 1;
+    const NativeInteger& b = ct->GetB();
+
+    // LUT values of all functions and their common divisor g
+    std::vector<std::vector<int64_t>> t(fs.size(), std::vector<int64_t>(numValues));
+    int64_t g = fmod.ConvertToInt<int64_t>();
+    for (size_t i = 0; i < fs.size(); ++i) {
+        for (uint32_t j = 0; j < numValues; ++j) {
+            t[i][j] = fs[i](b.ModSub(j, ctMod), ctMod, fmod).ConvertToInt<int64_t>();
+            g       = std::gcd(g, t[i][j]);
+        }
+    }
+
+    // common test polynomial; 1/2 is the inverse of 2 mod Q (Q is odd)
+    NativeInteger delta{Q.ConvertToInt() / fmod.ConvertToInt()};
+    NativeInteger scale{delta.ModMul(NativeInteger(g), Q).ModMul((Q + 1) >> 1, Q)};
+    NativeVector m(N, Q);
+    for (uint32_t j = 0; j < numValues; ++j)
+        m[j * factor] = scale;
+
+    std::vector<NativePoly> res(2);
+    // no need to do NTT as all coefficients of this poly are zero
+    res[0] = NativePoly(polyParams, Format::EVALUATION, true);
+    res[1] = NativePoly(polyParams, Format::COEFFICIENT, false);
+    res[1].SetValues(std::move(m), Format::COEFFICIENT);
+    res[1].SetFormat(Format::EVALUATION);
+
+    auto acc = std::make_shared<RLWECiphertextImpl>(std::move(res));
+    ACCscheme->EvalAcc(RGSWParams, EK.BSkey, acc, ct->GetA());
+    const auto& accVec = acc->GetElements();
+
+    std::vector<LWECiphertext> result;
+    result.reserve(fs.size());
+    for (size_t i = 0; i < fs.size(); ++i) {
+        // v(X) = (1 - X^f) * t(X^f) / g mod X^N + 1
+        NativeVector v(N, Q);
+        for (uint32_t j = 0; j < numValues; ++j) {
+            int64_t vj    = ((j == 0) ? t[i][0] + t[i][numValues - 1] : t[i][j] - t[i][j - 1]) / g;
+            v[j * factor] = (vj >= 0) ? NativeInteger(vj) : Q - NativeInteger(-vj);
+        }
+        NativePoly vPoly(polyParams, Format::COEFFICIENT, false);
+        vPoly.SetValues(std::move(v), Format::COEFFICIENT);
+        vPoly.SetFormat(Format::EVALUATION);
+
+        // the accumulator result is encrypted w.r.t. the transposed secret key
+        // we can transpose "a" to get an encryption under the original secret key
+        NativePoly a0 = (accVec[0] * vPoly).Transpose();
+        NativePoly a1 = accVec[1] * vPoly;
+        a0.SetFormat(Format::COEFFICIENT);
+        a1.SetFormat(Format::COEFFICIENT);
+
+        auto ctExt = std::make_shared<LWECiphertextImpl>(std::move(a0.GetValues()), a1[0]);
+        // Modulus switching to a middle step Q'
+        auto ctMS = LWEscheme->ModSwitch(LWEParams->GetqKS(), ctExt);
+        // Key switching
+        auto ctKS = LWEscheme->KeySwitch(LWEParams, EK.KSkey, ctMS);
+        // Modulus switching
+        result.push_back(LWEscheme->ModSwitch(fmod, ctKS));
+    }
+    return result;
+}
+
 };  // namespace lbcrypto
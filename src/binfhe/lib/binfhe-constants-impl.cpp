@@ -208,6 +208,9 @@ std::ostream& operator<<(std::ostream& s, BINFHE_METHOD f) {
         case LMKCDEY:
             s << "LMKCDEY";
             break;
+        case GINX_FFT:
+            s << "CGGI_FFT";
+            break;
         default:
             s << "UNKNOWN";
             break;
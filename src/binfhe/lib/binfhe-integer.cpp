@@ -0,0 +1,542 @@
+//==================================================================================
+// BSD 2-Clause License
+//
+// Copyright (c) 2014-2023, NJIT, Duality Technologies Inc. and other contributors
+//
+// All rights reserved.
+//
+// Author TPOC: contact@openfhe.org
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice, this
+//    list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+//    this list of conditions and the following disclaimer in the documentation
+//    and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+// OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//==================================================================================
+
+#include "binfhe-integer.h"
+
+#include "utils/parallel.h"
+
+#include <algorithm>
+
+namespace lbcrypto {
+
+// The digit states used by the carry-lookahead and the comparison are 0 (kill / less), 1 (propagate / equal) and
+// 2 (generate / greater). Two states are merged by a look-up table on 2 * hi + lo, where hi covers the more
+// significant digits: 0, 1, 2 -> 0 (hi = 0 or hi = 1, lo = 0), 3 -> 1 (both 1), and 4, 5, 6 -> 2.
+namespace {
+
+uint32_t CombineStates(uint32_t x) {
+    return (x < 3) ? 0 : ((x == 3) ? 1 : 2);
+}
+
+}  // namespace
+
+BinFHEIntegerEvaluator::BinFHEIntegerEvaluator(const BinFHEContext& cc, uint32_t bits) : m_cc(cc), m_bits(bits) {
+    if (bits == 0 || bits > 64)
+        OPENFHE_THROW("The integer width must be between 1 and 64 bits");
+
+    m_p = cc.GetMaxPlaintextSpace().ConvertToInt<LWEPlaintextModulus>();
+    if (m_p < 16)
+        OPENFHE_THROW("Multi-bit integers need a plaintext space of at least 16; use a context with q = 2N");
+    m_delta    = cc.GetBeta() << 1;
+    m_q        = cc.GetMaxPlaintextSpace() * m_delta;
+    m_maxValue = static_cast<uint32_t>(m_p >> 1) - 1;
+
+    // the digit product a * base + b must stay below p/2, i.e., base^2 <= p/2;
+    // the digit size must also divide the width so that all digits share the same radix
+    m_digitBits = std::min((GetMSB(m_p) - 2) / 2, bits);
+    while (bits % m_digitBits != 0)
+        --m_digitBits;
+    m_base      = 1 << m_digitBits;
+    m_numDigits = bits / m_digitBits;
+
+    const uint32_t base = m_base;
+    m_lutMod = GenerateLUT([base](uint32_t x) -> uint32_t {
+        return x % base;
+    });
+    m_lutDiv = GenerateLUT([base](uint32_t x) -> uint32_t {
+        return x / base;
+    });
+    // carry state of a digit in [0, base]
+    m_lutState = GenerateLUT([base](uint32_t x) -> uint32_t {
+        return (x >= base) ? 2 : ((x == base - 1) ? 1 : 0);
+    });
+    m_lutCombine = GenerateLUT(CombineStates);
+    // comparison state of a digit pair from a - b + base - 1
+    m_lutSign = GenerateLUT([base](uint32_t x) -> uint32_t {
+        return (x < base - 1) ? 0 : ((x == base - 1) ? 1 : 2);
+    });
+    // digit after the carry-lookahead from 3 * low + prefix state
+    m_lutFinal = GenerateLUT([base](uint32_t x) -> uint32_t {
+        return (x / 3 + ((x % 3 == 2) ? 1 : 0)) % base;
+    });
+    // low and high part of a digit product from a * base + b
+    m_lutMultLow = GenerateLUT([base](uint32_t x) -> uint32_t {
+        return ((x / base) * (x % base)) % base;
+    });
+    m_lutMultHigh = GenerateLUT([base](uint32_t x) -> uint32_t {
+        return ((x / base) * (x % base)) / base;
+    });
+}
+
+LWEInteger BinFHEIntegerEvaluator::Encrypt(ConstLWEPrivateKey& sk, uint64_t m) const {
+    std::vector<LWECiphertext> digits(m_numDigits);
+    for (uint32_t i = 0; i < m_numDigits; ++i)
+        digits[i] = m_cc.Encrypt(sk, (m >> (i * m_digitBits)) & (m_base - 1), SMALL_DIM, m_p);
+    return std::make_shared<LWEIntegerImpl>(std::move(digits), std::vector<uint32_t>(m_numDigits, m_base - 1));
+}
+
+uint64_t BinFHEIntegerEvaluator::Decrypt(ConstLWEPrivateKey& sk, ConstLWEInteger& ct) const {
+    ValidateInput(ct);
+    const auto& digits = ct->GetDigits();
+
+    uint64_t result = 0;
+    for (uint32_t i = 0; i < m_numDigits; ++i) {
+        LWEPlaintext digit;
+        m_cc.Decrypt(sk, digits[i], &digit, m_p);
+        result += static_cast<uint64_t>(digit) << (i * m_digitBits);
+    }
+    return (m_bits == 64) ? result : result & ((uint64_t(1) << m_bits) - 1);
+}
+
+LWEInteger BinFHEIntegerEvaluator::EvalAdd(ConstLWEInteger& ct1, ConstLWEInteger& ct2) const {
+    ValidateInput(ct1);
+    ValidateInput(ct2);
+
+    auto digits1 = ct1->GetDigits();
+    auto bounds1 = ct1->GetBounds();
+    auto digits2 = ct2->GetDigits();
+    auto bounds2 = ct2->GetBounds();
+
+    auto overflows = [&]() {
+        for (uint32_t i = 0; i < m_numDigits; ++i) {
+            if (bounds1[i] + bounds2[i] > m_maxValue)
+                return true;
+        }
+        return false;
+    };
+    // carries are only propagated when a digit of the sum could leave [0, p/2);
+    // two operands with all digits at most base always fit
+    if (overflows())
+        ReduceBounds(digits1, bounds1);
+    if (overflows())
+        ReduceBounds(digits2, bounds2);
+
+    std::vector<LWECiphertext> digits(m_numDigits);
+    std::vector<uint32_t> bounds(m_numDigits);
+    for (uint32_t i = 0; i < m_numDigits; ++i) {
+        digits[i] = EvalLinear(digits1[i], 1, digits2[i]);
+        bounds[i] = bounds1[i] + bounds2[i];
+    }
+    return std::make_shared<LWEIntegerImpl>(std::move(digits), std::move(bounds));
+}
+
+LWEInteger BinFHEIntegerEvaluator::EvalSub(ConstLWEInteger& ct1, ConstLWEInteger& ct2) const {
+    ValidateInput(ct1);
+    // ~ct2 = (base - 1) - ct2 digit by digit needs all digits of ct2 below the radix
+    auto ct2Carried = EvalCarry(ct2);
+    const auto& digits2 = ct2Carried->GetDigits();
+
+    auto digits1 = ct1->GetDigits();
+    auto bounds1 = ct1->GetBounds();
+    for (uint32_t i = 0; i < m_numDigits; ++i) {
+        if (bounds1[i] + m_base - ((i == 0) ? 0 : 1) > m_maxValue) {
+            ReduceBounds(digits1, bounds1);
+            break;
+        }
+    }
+
+    std::vector<LWECiphertext> digits(m_numDigits);
+    std::vector<uint32_t> bounds(m_numDigits);
+    for (uint32_t i = 0; i < m_numDigits; ++i) {
+        // the + 1 of the two's complement is added to the least significant digit
+        const uint32_t offset = m_base - ((i == 0) ? 0 : 1);
+        digits[i]             = std::make_shared<LWECiphertextImpl>(*digits1[i]);
+        m_LWEscheme->EvalAddConstEq(digits[i], m_delta * NativeInteger(offset));
+        m_LWEscheme->EvalSubEq(digits[i], digits2[i]);
+        bounds[i] = bounds1[i] + offset;
+    }
+    return std::make_shared<LWEIntegerImpl>(std::move(digits), std::move(bounds));
+}
+
+LWEInteger BinFHEIntegerEvaluator::EvalMult(ConstLWEInteger& ct1, ConstLWEInteger& ct2) const {
+    auto ct1Carried     = EvalCarry(ct1);
+    auto ct2Carried     = EvalCarry(ct2);
+    const auto& digits1 = ct1Carried->GetDigits();
+    const auto& digits2 = ct2Carried->GetDigits();
+
+    // the high part of a digit product is always zero for base 2
+    const bool hasHigh      = (m_base - 1) * (m_base - 1) >= m_base;
+    const uint32_t highBound = (m_base - 1) * (m_base - 1) / m_base;
+
+    std::vector<LWECiphertext> inputs;
+    std::vector<const LUT*> luts;
+    std::vector<uint32_t> columns;
+    for (uint32_t i = 0; i < m_numDigits; ++i) {
+        for (uint32_t j = 0; i + j < m_numDigits; ++j) {
+            auto x = EvalLinear(digits1[i], m_base, digits2[j]);
+            inputs.push_back(x);
+            luts.push_back(&m_lutMultLow);
+            columns.push_back(i + j);
+            if (hasHigh && i + j + 1 < m_numDigits) {
+                inputs.push_back(x);
+                luts.push_back(&m_lutMultHigh);
+                columns.push_back(i + j + 1);
+            }
+        }
+    }
+    auto products = EvalFuncBatch(inputs, luts);
+
+    // accumulate the partial products column by column; carries are only propagated when a column is full
+    const uint32_t n = digits1[0]->GetLength();
+    std::vector<LWECiphertext> digits(m_numDigits);
+    std::vector<uint32_t> bounds(m_numDigits, 0);
+    for (uint32_t i = 0; i < m_numDigits; ++i)
+        digits[i] = EncryptTrivial(0, n);
+    for (size_t k = 0; k < products.size(); ++k) {
+        const uint32_t col   = columns[k];
+        const uint32_t bound = (luts[k] == &m_lutMultLow) ? m_base - 1 : highBound;
+        if (bounds[col] + bound > m_maxValue)
+            ReduceBounds(digits, bounds);
+        digits[col] = EvalLinear(products[k], 1, digits[col]);
+        bounds[col] += bound;
+    }
+    return std::make_shared<LWEIntegerImpl>(std::move(digits), std::move(bounds));
+}
+
+LWECiphertext BinFHEIntegerEvaluator::EvalLessThan(ConstLWEInteger& ct1, ConstLWEInteger& ct2) const {
+    return EvalCompare(ct1, ct2, [](uint32_t state) -> uint32_t {
+        return (state == 0) ? 1 : 0;
+    });
+}
+
+LWECiphertext BinFHEIntegerEvaluator::EvalEqual(ConstLWEInteger& ct1, ConstLWEInteger& ct2) const {
+    return EvalCompare(ct1, ct2, [](uint32_t state) -> uint32_t {
+        return (state == 1) ? 1 : 0;
+    });
+}
+
+LWEInteger BinFHEIntegerEvaluator::EvalShiftLeft(ConstLWEInteger& ct, uint32_t shift) const {
+    ValidateInput(ct);
+    const uint32_t n = ct->GetDigits()[0]->GetLength();
+
+    std::vector<LWECiphertext> digits(m_numDigits);
+    std::vector<uint32_t> bounds(m_numDigits, 0);
+    const uint32_t s = std::min(shift, m_bits) / m_digitBits;
+    const uint32_t r = std::min(shift, m_bits) % m_digitBits;
+    for (uint32_t i = 0; i < std::min(s, m_numDigits); ++i)
+        digits[i] = EncryptTrivial(0, n);
+
+    if (r == 0) {
+        // whole digits are moved; pending carries move along with them
+        for (uint32_t i = s; i < m_numDigits; ++i) {
+            digits[i] = ct->GetDigits()[i - s];
+            bounds[i] = ct->GetBounds()[i - s];
+        }
+        return std::make_shared<LWEIntegerImpl>(std::move(digits), std::move(bounds));
+    }
+
+    // digit i is split into the bits that stay in digit i + s and those that move to digit i + s + 1
+    auto ctCarried    = EvalCarry(ct);
+    const auto& input = ctCarried->GetDigits();
+    const uint32_t mask{m_base - 1}, up{m_digitBits - r};
+    const auto lutLow = GenerateLUT([mask, r](uint32_t x) -> uint32_t {
+        return (x << r) & mask;
+    });
+    const auto lutHigh = GenerateLUT([up](uint32_t x) -> uint32_t {
+        return x >> up;
+    });
+
+    std::vector<LWECiphertext> inputs;
+    std::vector<const LUT*> luts;
+    for (uint32_t i = 0; i + s < m_numDigits; ++i) {
+        inputs.push_back(input[i]);
+        luts.push_back(&lutLow);
+        if (i + s + 1 < m_numDigits) {
+            inputs.push_back(input[i]);
+            luts.push_back(&lutHigh);
+        }
+    }
+    auto parts = EvalFuncBatch(inputs, luts);
+
+    // the low part of digit j is parts[2 * j] and its high part parts[2 * j + 1]
+    for (uint32_t j = 0; j + s < m_numDigits; ++j) {
+        digits[j + s] = (j == 0) ? parts[0] : EvalLinear(parts[2 * j], 1, parts[2 * j - 1]);
+        bounds[j + s] = m_base - 1;
+    }
+    return std::make_shared<LWEIntegerImpl>(std::move(digits), std::move(bounds));
+}
+
+LWEInteger BinFHEIntegerEvaluator::EvalShiftRight(ConstLWEInteger& ct, uint32_t shift) const {
+    ValidateInput(ct);
+    const uint32_t n = ct->GetDigits()[0]->GetLength();
+
+    std::vector<LWECiphertext> digits(m_numDigits);
+    std::vector<uint32_t> bounds(m_numDigits, 0);
+    const uint32_t s = std::min(shift, m_bits) / m_digitBits;
+    const uint32_t r = std::min(shift, m_bits) % m_digitBits;
+    for (uint32_t i = m_numDigits - std::min(s, m_numDigits); i < m_numDigits; ++i)
+        digits[i] = EncryptTrivial(0, n);
+    if (s >= m_numDigits)
+        return std::make_shared<LWEIntegerImpl>(std::move(digits), std::move(bounds));
+
+    // the dropped digits must not hold carries into the kept ones
+    auto ctCarried    = EvalCarry(ct);
+    const auto& input = ctCarried->GetDigits();
+    if (r == 0) {
+        for (uint32_t i = 0; i + s < m_numDigits; ++i) {
+            digits[i] = input[i + s];
+            bounds[i] = m_base - 1;
+        }
+        return std::make_shared<LWEIntegerImpl>(std::move(digits), std::move(bounds));
+    }
+
+    // digit i collects the upper bits of digit i + s and the lower bits of digit i + s + 1
+    const uint32_t mask{m_base - 1}, up{m_digitBits - r};
+    const auto lutLow = GenerateLUT([r](uint32_t x) -> uint32_t {
+        return x >> r;
+    });
+    const auto lutHigh = GenerateLUT([mask, up](uint32_t x) -> uint32_t {
+        return (x << up) & mask;
+    });
+
+    std::vector<LWECiphertext> inputs;
+    std::vector<const LUT*> luts;
+    for (uint32_t i = 0; i + s < m_numDigits; ++i) {
+        inputs.push_back(input[i + s]);
+        luts.push_back(&lutLow);
+        if (i + s + 1 < m_numDigits) {
+            inputs.push_back(input[i + s + 1]);
+            luts.push_back(&lutHigh);
+        }
+    }
+    auto parts = EvalFuncBatch(inputs, luts);
+
+    for (uint32_t i = 0; i + s < m_numDigits; ++i) {
+        digits[i] = (i + s + 1 < m_numDigits) ? EvalLinear(parts[2 * i], 1, parts[2 * i + 1]) : parts[2 * i];
+        bounds[i] = m_base - 1;
+    }
+    return std::make_shared<LWEIntegerImpl>(std::move(digits), std::move(bounds));
+}
+
+LWEInteger BinFHEIntegerEvaluator::EvalCarry(ConstLWEInteger& ct) const {
+    ValidateInput(ct);
+
+    auto digits = ct->GetDigits();
+    auto bounds = ct->GetBounds();
+    ReduceBounds(digits, bounds);
+    if (std::all_of(bounds.begin(), bounds.end(), [this](uint32_t b) { return b < m_base; }))
+        return std::make_shared<LWEIntegerImpl>(std::move(digits), std::move(bounds));
+
+    // every digit is now in [0, base], so the carry into each digit is 0 or 1: it is the prefix state of the
+    // lower digits, where a digit generates a carry at base, propagates one at base - 1 and kills it otherwise
+    const uint32_t n = digits[0]->GetLength();
+    std::vector<LWECiphertext> inputs;
+    std::vector<const LUT*> luts;
+    for (uint32_t i = 0; i < m_numDigits; ++i) {
+        if (bounds[i] >= m_base) {
+            inputs.push_back(digits[i]);
+            luts.push_back(&m_lutMod);
+        }
+        if (i + 1 < m_numDigits && bounds[i] + 1 >= m_base) {
+            inputs.push_back(digits[i]);
+            luts.push_back(&m_lutState);
+        }
+    }
+    auto outputs = EvalFuncBatch(inputs, luts);
+
+    std::vector<LWECiphertext> states(m_numDigits - 1);
+    for (uint32_t i = 0, k = 0; i < m_numDigits; ++i) {
+        if (bounds[i] >= m_base)
+            digits[i] = outputs[k++];
+        if (i + 1 < m_numDigits)
+            states[i] = (bounds[i] + 1 >= m_base) ? outputs[k++] : EncryptTrivial(0, n);
+    }
+
+    // inclusive prefix (Hillis-Steele scan) of the states in ceil(log2(n - 1)) parallel levels
+    for (size_t offset = 1; offset < states.size(); offset <<= 1) {
+        std::vector<LWECiphertext> hi(states.begin() + offset, states.end());
+        std::vector<LWECiphertext> lo(states.begin(), states.end() - offset);
+        auto merged = EvalCombine(hi, lo);
+        std::copy(merged.begin(), merged.end(), states.begin() + offset);
+    }
+
+    // digit i >= 1 becomes (low + carry) mod base, with carry = (state of digits 0..i-1 == 2)
+    inputs.resize(m_numDigits - 1);
+    for (uint32_t i = 1; i < m_numDigits; ++i)
+        inputs[i - 1] = EvalLinear(digits[i], 3, states[i - 1]);
+    luts.assign(inputs.size(), &m_lutFinal);
+    outputs = EvalFuncBatch(inputs, luts);
+    std::copy(outputs.begin(), outputs.end(), digits.begin() + 1);
+
+    std::fill(bounds.begin(), bounds.end(), m_base - 1);
+    return std::make_shared<LWEIntegerImpl>(std::move(digits), std::move(bounds));
+}
+
+std::vector<NativeInteger> BinFHEIntegerEvaluator::GenerateLUT(const std::function<uint32_t(uint32_t)>& f) const {
+    // message m occupies the phases [m * delta, (m + 1) * delta) after the beta shift of EvalFunc;
+    // the upper half of the table is the negation of the lower half, so EvalFunc needs one bootstrapping
+    const uint32_t half  = m_q.ConvertToInt<uint32_t>() >> 1;
+    const uint32_t delta = m_delta.ConvertToInt<uint32_t>();
+    LUT lut(half << 1);
+    for (uint32_t x = 0; x < half; ++x) {
+        lut[x]        = m_delta * NativeInteger(f(x / delta));
+        lut[x + half] = m_q - lut[x];
+    }
+    return lut;
+}
+
+std::vector<LWECiphertext> BinFHEIntegerEvaluator::EvalFuncBatch(const std::vector<LWECiphertext>& cts,
+                                                                 const std::vector<const LUT*>& luts) const {
+    if (m_cc.GetRefreshKey() == nullptr || m_cc.GetSwitchKey() == nullptr)
+        OPENFHE_THROW("Bootstrapping keys have not been generated. Please call BTKeyGen before integer arithmetic.");
+    if (luts.size() != cts.size())
+        OPENFHE_THROW("One look-up table per ciphertext is expected");
+
+    // an exception thrown by one of the bootstraps is rethrown here once the others are done
+    const uint32_t length = cts.size();
+    std::vector<LWECiphertext> result(length);
+    ParallelFor(0, length, OpenFHEParallelControls.GetThreadLimit(length),
+                [&](size_t i) { result[i] = m_cc.EvalFunc(cts[i], *luts[i]); });
+    return result;
+}
+
+LWECiphertext BinFHEIntegerEvaluator::EvalLinear(ConstLWECiphertext& ct1, uint32_t scale,
+                                                 ConstLWECiphertext& ct2) const {
+    auto result = std::make_shared<LWECiphertextImpl>(*ct1);
+    if (scale != 1)
+        m_LWEscheme->EvalMultConstEq(result, NativeInteger(scale));
+    m_LWEscheme->EvalAddEq(result, ct2);
+    return result;
+}
+
+LWECiphertext BinFHEIntegerEvaluator::EncryptTrivial(uint32_t m, uint32_t n) const {
+    return std::make_shared<LWECiphertextImpl>(NativeVector(n, m_q), m_delta * NativeInteger(m));
+}
+
+void BinFHEIntegerEvaluator::CarryRound(std::vector<LWECiphertext>& digits, std::vector<uint32_t>& bounds) const {
+    std::vector<LWECiphertext> inputs;
+    std::vector<const LUT*> luts;
+    for (uint32_t i = 0; i < m_numDigits; ++i) {
+        if (bounds[i] < m_base)
+            continue;
+        inputs.push_back(digits[i]);
+        luts.push_back(&m_lutMod);
+        // the carry out of the most significant digit is dropped (mod 2^bits)
+        if (i + 1 < m_numDigits) {
+            inputs.push_back(digits[i]);
+            luts.push_back(&m_lutDiv);
+        }
+    }
+    if (inputs.empty())
+        return;
+    auto outputs = EvalFuncBatch(inputs, luts);
+
+    std::vector<LWECiphertext> carries(m_numDigits);
+    std::vector<uint32_t> carryBounds(m_numDigits, 0);
+    for (uint32_t i = 0, k = 0; i < m_numDigits; ++i) {
+        if (bounds[i] < m_base)
+            continue;
+        if (i + 1 < m_numDigits) {
+            carries[i + 1]     = outputs[k + 1];
+            carryBounds[i + 1] = bounds[i] / m_base;
+        }
+        digits[i] = outputs[k];
+        bounds[i] = m_base - 1;
+        k += (i + 1 < m_numDigits) ? 2 : 1;
+    }
+    for (uint32_t i = 1; i < m_numDigits; ++i) {
+        if (carries[i] != nullptr) {
+            digits[i] = EvalLinear(carries[i], 1, digits[i]);
+            bounds[i] += carryBounds[i];
+        }
+    }
+}
+
+void BinFHEIntegerEvaluator::ReduceBounds(std::vector<LWECiphertext>& digits, std::vector<uint32_t>& bounds) const {
+    // a round maps a bound b > base to at most base - 1 + b / base < b, so this terminates with bounds <= base
+    while (*std::max_element(bounds.begin(), bounds.end()) > m_base)
+        CarryRound(digits, bounds);
+}
+
+std::vector<LWECiphertext> BinFHEIntegerEvaluator::EvalCombine(const std::vector<LWECiphertext>& hi,
+                                                               const std::vector<LWECiphertext>& lo) const {
+    std::vector<LWECiphertext> inputs(hi.size());
+    for (size_t i = 0; i < hi.size(); ++i)
+        inputs[i] = EvalLinear(hi[i], 2, lo[i]);
+    return EvalFuncBatch(inputs, std::vector<const LUT*>(inputs.size(), &m_lutCombine));
+}
+
+LWECiphertext BinFHEIntegerEvaluator::EvalCompare(ConstLWEInteger& ct1, ConstLWEInteger& ct2,
+                                                  const std::function<uint32_t(uint32_t)>& predicate) const {
+    auto ct1Carried     = EvalCarry(ct1);
+    auto ct2Carried     = EvalCarry(ct2);
+    const auto& digits1 = ct1Carried->GetDigits();
+    const auto& digits2 = ct2Carried->GetDigits();
+
+    // a_i - b_i + base - 1 is in [0, 2 * base - 2] and below base - 1 exactly when a_i < b_i
+    std::vector<LWECiphertext> states(m_numDigits);
+    for (uint32_t i = 0; i < m_numDigits; ++i) {
+        states[i] = std::make_shared<LWECiphertextImpl>(*digits1[i]);
+        m_LWEscheme->EvalAddConstEq(states[i], m_delta * NativeInteger(m_base - 1));
+        m_LWEscheme->EvalSubEq(states[i], digits2[i]);
+    }
+
+    const uint32_t base = m_base;
+    if (m_numDigits == 1) {
+        auto lut = GenerateLUT([base, &predicate](uint32_t x) -> uint32_t {
+            return predicate((x < base - 1) ? 0 : ((x == base - 1) ? 1 : 2));
+        });
+        return m_cc.EvalFunc(states[0], lut);
+    }
+    states = EvalFuncBatch(states, std::vector<const LUT*>(m_numDigits, &m_lutSign));
+
+    // pairwise tree reduction; the most significant differing digit decides
+    while (states.size() > 2) {
+        std::vector<LWECiphertext> hi, lo;
+        for (size_t i = 0; i + 1 < states.size(); i += 2) {
+            hi.push_back(states[i + 1]);
+            lo.push_back(states[i]);
+        }
+        auto merged = EvalCombine(hi, lo);
+        if (states.size() % 2 == 1)
+            merged.push_back(states.back());
+        states = std::move(merged);
+    }
+
+    // the last merge and the predicate share one bootstrapping
+    auto lut = GenerateLUT([&predicate](uint32_t x) -> uint32_t {
+        return predicate(CombineStates(x));
+    });
+    return m_cc.EvalFunc(EvalLinear(states[1], 2, states[0]), lut);
+}
+
+void BinFHEIntegerEvaluator::ValidateInput(ConstLWEInteger& ct) const {
+    if (ct == nullptr)
+        OPENFHE_THROW("Integer ciphertext is empty");
+    if (ct->GetNumDigits() != m_numDigits || ct->GetBounds().size() != m_numDigits)
+        OPENFHE_THROW("Integer ciphertext does not match the width of the evaluator");
+    for (const auto& digit : ct->GetDigits()) {
+        if (digit == nullptr)
+            OPENFHE_THROW("Integer ciphertext has an empty digit");
+    }
+}
+
+}  // namespace lbcrypto
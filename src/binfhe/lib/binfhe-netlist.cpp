@@ -0,0 +1,431 @@
+//==================================================================================
+// BSD 2-Clause License
+//
+// Copyright (c) 2014-2023, NJIT, Duality Technologies Inc. and other contributors
+//
+// All rights reserved.
+//
+// Author TPOC: contact@openfhe.org
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice, this
+//    list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+//    this list of conditions and the following disclaimer in the documentation
+//    and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+// OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//==================================================================================
+
+#include "binfhe-netlist.h"
+
+#include "utils/parallel.h"
+
+#include <algorithm>
+#include <atomic>
+#include <memory>
+#include <sstream>
+#include <string>
+#include <unordered_map>
+#include <utility>
+
+namespace lbcrypto {
+
+uint32_t BinFHENetlist::AddInput() {
+    m_schedule.reset();
+    m_nodes.push_back(Node{INPUT_NODE, OR, m_numInputs++, {}});
+    return m_nodes.size() - 1;
+}
+
+uint32_t BinFHENetlist::AddConstant(bool value) {
+    m_schedule.reset();
+    m_nodes.push_back(Node{CONSTANT_NODE, OR, value ? 1u : 0u, {}});
+    return m_nodes.size() - 1;
+}
+
+uint32_t BinFHENetlist::AddNOT(uint32_t wire) {
+    ValidateWire(wire);
+    m_schedule.reset();
+    m_nodes.push_back(Node{NOT_NODE, OR, 0, {wire}});
+    return m_nodes.size() - 1;
+}
+
+uint32_t BinFHENetlist::AddGate(BINGATE gate, const std::vector<uint32_t>& wires) {
+    size_t arity;
+    switch (gate) {
+        case OR:
+        case AND:
+        case NOR:
+        case NAND:
+        case XOR:
+        case XNOR:
+        case XOR_FAST:
+        case XNOR_FAST:
+            arity = 2;
+            break;
+        case MAJORITY:
+        case CMUX:
+            arity = 3;
+            break;
+        default:
+            OPENFHE_THROW("Netlists support OR, AND, NOR, NAND, XOR, XNOR, MAJORITY and CMUX gates only");
+    }
+    if (wires.size() != arity)
+        OPENFHE_THROW("The gate expects " + std::to_string(arity) + " input wires");
+    for (uint32_t wire : wires)
+        ValidateWire(wire);
+
+    m_schedule.reset();
+    m_nodes.push_back(Node{GATE_NODE, gate, 0, wires});
+    return m_nodes.size() - 1;
+}
+
+void BinFHENetlist::AddOutput(uint32_t wire) {
+    ValidateWire(wire);
+    m_schedule.reset();
+    m_outputs.push_back(wire);
+}
+
+BinFHENetlist BinFHENetlist::Load(std::istream& stream) {
+    static const std::unordered_map<std::string, BINGATE> gates{
+        {"OR", OR},     {"AND", AND},           {"NOR", NOR},           {"NAND", NAND},
+        {"XOR", XOR},   {"XNOR", XNOR},         {"XOR_FAST", XOR_FAST}, {"XNOR_FAST", XNOR_FAST},
+        {"CMUX", CMUX}, {"MAJORITY", MAJORITY},
+    };
+
+    BinFHENetlist netlist;
+    std::unordered_map<std::string, uint32_t> wires;
+    std::string line;
+    for (uint32_t lineNo = 1; std::getline(stream, line); ++lineNo) {
+        const std::string where = "Netlist line " + std::to_string(lineNo) + ": ";
+        std::istringstream tokenizer(line.substr(0, line.find('#')));
+        std::vector<std::string> tokens;
+        for (std::string token; tokenizer >> token;)
+            tokens.push_back(std::move(token));
+        if (tokens.empty())
+            continue;
+
+        auto lookup = [&](const std::string& name) {
+            auto it = wires.find(name);
+            if (it == wires.end())
+                OPENFHE_THROW(where + "undefined wire " + name);
+            return it->second;
+        };
+        auto define = [&](const std::string& name, uint32_t wire) {
+            if (!wires.emplace(name, wire).second)
+                OPENFHE_THROW(where + "wire " + name + " is defined twice");
+        };
+
+        if (tokens[0] == "INPUT") {
+            for (size_t i = 1; i < tokens.size(); ++i)
+                define(tokens[i], netlist.AddInput());
+            continue;
+        }
+        if (tokens[0] == "OUTPUT") {
+            for (size_t i = 1; i < tokens.size(); ++i)
+                netlist.AddOutput(lookup(tokens[i]));
+            continue;
+        }
+        if (tokens.size() < 4 || tokens[1] != "=")
+            OPENFHE_THROW(where + "expected <wire> = <gate> <inputs>");
+
+        const std::string& op = tokens[2];
+        if (op == "CONST") {
+            if (tokens.size() != 4 || (tokens[3] != "0" && tokens[3] != "1"))
+                OPENFHE_THROW(where + "CONST expects the value 0 or 1");
+            define(tokens[0], netlist.AddConstant(tokens[3] == "1"));
+        }
+        else if (op == "NOT") {
+            if (tokens.size() != 4)
+                OPENFHE_THROW(where + "NOT expects one input wire");
+            define(tokens[0], netlist.AddNOT(lookup(tokens[3])));
+        }
+        else {
+            auto it = gates.find(op);
+            if (it == gates.end())
+                OPENFHE_THROW(where + "unknown gate " + op);
+            std::vector<uint32_t> inputs;
+            for (size_t i = 3; i < tokens.size(); ++i)
+                inputs.push_back(lookup(tokens[i]));
+            define(tokens[0], netlist.AddGate(it->second, inputs));
+        }
+    }
+    return netlist;
+}
+
+std::vector<LWECiphertext> BinFHENetlist::Evaluate(const BinFHEContext& cc,
+                                                   const std::vector<LWECiphertext>& inputs) const {
+    if (inputs.size() != m_numInputs)
+        OPENFHE_THROW("The netlist expects " + std::to_string(m_numInputs) + " input ciphertexts");
+    for (size_t i = 0; i < inputs.size(); ++i) {
+        if (inputs[i] == nullptr)
+            OPENFHE_THROW("Ciphertext " + std::to_string(i) + " is empty");
+    }
+    if (cc.GetRefreshKey() == nullptr || cc.GetSwitchKey() == nullptr)
+        OPENFHE_THROW("Bootstrapping keys have not been generated. Please call BTKeyGen before evaluating a netlist.");
+
+    const auto cached = GetSchedule();
+    const auto& schedule = *cached;
+    std::vector<LWECiphertext> values(schedule.steps.size());
+    auto resolve = [&](const Signal& signal) -> LWECiphertext {
+        if (signal.source == CONSTANT_SIGNAL)
+            return cc.EvalConstant(signal.index != 0);
+        const auto& ct = (signal.source == INPUT_SIGNAL) ? inputs[signal.index] : values[signal.index];
+        return signal.negated ? cc.EvalNOT(ct) : ct;
+    };
+
+    for (const auto& level : schedule.levels) {
+        // resolve the arguments and reject dependent inputs before any gate of the level is bootstrapped
+        const uint32_t length = level.size();
+        std::vector<std::vector<LWECiphertext>> args(length);
+        for (uint32_t k = 0; k < length; ++k) {
+            for (const auto& signal : schedule.steps[level[k]].inputs)
+                args[k].push_back(resolve(signal));
+            for (size_t i = 0; i < args[k].size(); ++i) {
+                for (size_t j = i + 1; j < args[k].size(); ++j) {
+                    if (args[k][i] == args[k][j])
+                        OPENFHE_THROW("Netlist input ciphertexts should be independent");
+                }
+            }
+        }
+
+        ParallelFor(0, length, OpenFHEParallelControls.GetThreadLimit(length), [&](size_t k) {
+            const BINGATE gate = schedule.steps[level[k]].gate;
+            values[level[k]] =
+                (args[k].size() == 2) ? cc.EvalBinGate(gate, args[k][0], args[k][1]) : cc.EvalBinGate(gate, args[k]);
+        });
+    }
+
+    std::vector<LWECiphertext> outputs;
+    outputs.reserve(schedule.outputs.size());
+    for (const auto& signal : schedule.outputs)
+        outputs.push_back(resolve(signal));
+    return outputs;
+}
+
+uint32_t BinFHENetlist::GetNumBootstraps() const {
+    return GetSchedule()->steps.size();
+}
+
+uint32_t BinFHENetlist::GetDepth() const {
+    return GetSchedule()->levels.size();
+}
+
+std::shared_ptr<const BinFHENetlist::Schedule> BinFHENetlist::GetSchedule() const {
+    auto schedule = std::atomic_load(&m_schedule);
+    if (schedule == nullptr) {
+        schedule = std::make_shared<const Schedule>(Compile());
+        std::atomic_store(&m_schedule, schedule);
+    }
+    return schedule;
+}
+
+BinFHENetlist::Schedule BinFHENetlist::Compile() const {
+    std::vector<Step> steps;
+    std::vector<Signal> signals(m_nodes.size());
+    for (size_t k = 0; k < m_nodes.size(); ++k) {
+        const auto& node = m_nodes[k];
+        switch (node.type) {
+            case INPUT_NODE:
+                signals[k] = Signal{INPUT_SIGNAL, node.index, false};
+                break;
+            case CONSTANT_NODE:
+                signals[k] = Signal{CONSTANT_SIGNAL, node.index, false};
+                break;
+            case NOT_NODE:
+                signals[k] = Negate(signals[node.wires[0]]);
+                break;
+            case GATE_NODE: {
+                std::vector<Signal> inputs;
+                for (uint32_t wire : node.wires)
+                    inputs.push_back(signals[wire]);
+                signals[k] = Fold(steps, node.gate, inputs);
+                break;
+            }
+        }
+    }
+    std::vector<Signal> outputs;
+    for (uint32_t wire : m_outputs)
+        outputs.push_back(signals[wire]);
+
+    // only gates that reach an output are evaluated; steps only read earlier steps
+    const uint32_t numSteps = steps.size();
+    std::vector<bool> live(numSteps, false);
+    for (const auto& signal : outputs) {
+        if (signal.source == GATE_SIGNAL)
+            live[signal.index] = true;
+    }
+    for (uint32_t i = numSteps; i-- > 0;) {
+        if (!live[i])
+            continue;
+        for (const auto& signal : steps[i].inputs) {
+            if (signal.source == GATE_SIGNAL)
+                live[signal.index] = true;
+        }
+    }
+
+    // a gate whose result is only used negated is replaced by its complement
+    std::vector<uint32_t> uses(numSteps, 0), negatedUses(numSteps, 0);
+    auto countUse = [&](const Signal& signal) {
+        if (signal.source == GATE_SIGNAL) {
+            ++uses[signal.index];
+            negatedUses[signal.index] += signal.negated ? 1 : 0;
+        }
+    };
+    for (uint32_t i = 0; i < numSteps; ++i) {
+        if (live[i]) {
+            for (const auto& signal : steps[i].inputs)
+                countUse(signal);
+        }
+    }
+    for (const auto& signal : outputs)
+        countUse(signal);
+
+    std::vector<bool> flipped(numSteps, false);
+    for (uint32_t i = 0; i < numSteps; ++i) {
+        if (!live[i] || uses[i] != negatedUses[i] || steps[i].gate == MAJORITY)
+            continue;
+        flipped[i]    = true;
+        steps[i].gate = (steps[i].gate == AND) ? NAND : ((steps[i].gate == OR) ? NOR : XNOR);
+    }
+    auto clearFlipped = [&flipped](Signal& signal) {
+        if (signal.source == GATE_SIGNAL && flipped[signal.index])
+            signal.negated = false;
+    };
+
+    // compact the live gates and assign their levels
+    Schedule schedule;
+    std::vector<uint32_t> remap(numSteps), levelOf;
+    for (uint32_t i = 0; i < numSteps; ++i) {
+        if (!live[i])
+            continue;
+        Step step = std::move(steps[i]);
+        uint32_t level = 0;
+        for (auto& signal : step.inputs) {
+            clearFlipped(signal);
+            if (signal.source == GATE_SIGNAL) {
+                signal.index = remap[signal.index];
+                level        = std::max(level, levelOf[signal.index] + 1);
+            }
+        }
+        remap[i] = schedule.steps.size();
+        schedule.steps.push_back(std::move(step));
+        levelOf.push_back(level);
+        if (level >= schedule.levels.size())
+            schedule.levels.resize(level + 1);
+        schedule.levels[level].push_back(remap[i]);
+    }
+    for (auto& signal : outputs) {
+        clearFlipped(signal);
+        if (signal.source == GATE_SIGNAL)
+            signal.index = remap[signal.index];
+    }
+    schedule.outputs = std::move(outputs);
+    return schedule;
+}
+
+BinFHENetlist::Signal BinFHENetlist::Negate(Signal signal) {
+    if (signal.source == CONSTANT_SIGNAL)
+        signal.index ^= 1;
+    else
+        signal.negated = !signal.negated;
+    return signal;
+}
+
+BinFHENetlist::Signal BinFHENetlist::Fold(std::vector<Step>& steps, BINGATE gate, const std::vector<Signal>& inputs) {
+    auto isConstant = [](const Signal& signal) {
+        return signal.source == CONSTANT_SIGNAL;
+    };
+    auto sameWire = [](const Signal& a, const Signal& b) {
+        return a.source == b.source && a.index == b.index;
+    };
+    auto addStep = [&steps](BINGATE stepGate, std::vector<Signal> stepInputs) {
+        steps.push_back(Step{stepGate, std::move(stepInputs)});
+        return Signal{GATE_SIGNAL, static_cast<uint32_t>(steps.size() - 1), false};
+    };
+
+    if (gate == CMUX) {
+        // (in0 AND NOT sel) OR (in1 AND sel) as three NANDs; the first two share a level
+        const Signal& sel = inputs[2];
+        if (isConstant(sel))
+            return inputs[sel.index];
+        auto nand0 = Fold(steps, NAND, {inputs[0], Negate(sel)});
+        auto nand1 = Fold(steps, NAND, {inputs[1], sel});
+        return Fold(steps, NAND, {nand0, nand1});
+    }
+    if (gate == MAJORITY) {
+        for (uint32_t i = 0; i < 3; ++i) {
+            const Signal& a = inputs[(i + 1) % 3];
+            const Signal& b = inputs[(i + 2) % 3];
+            // MAJORITY(a, b, 0) = AND(a, b), MAJORITY(a, b, 1) = OR(a, b)
+            if (isConstant(inputs[i]))
+                return Fold(steps, (inputs[i].index != 0) ? OR : AND, {a, b});
+            // MAJORITY(x, x, c) = x, MAJORITY(x, NOT x, c) = c
+            if (!isConstant(a) && !isConstant(b) && sameWire(a, b))
+                return (a.negated == b.negated) ? a : inputs[i];
+        }
+        return addStep(MAJORITY, inputs);
+    }
+
+    // two-input gates are folded as AND, OR or XOR followed by an optional negation
+    const bool negateResult = (gate == NAND) || (gate == NOR) || (gate == XNOR) || (gate == XNOR_FAST);
+    const BINGATE base      = (gate == AND || gate == NAND) ? AND : ((gate == OR || gate == NOR) ? OR : XOR);
+
+    Signal a = inputs[0], b = inputs[1];
+    if (isConstant(a))
+        std::swap(a, b);
+
+    Signal result{CONSTANT_SIGNAL, 0, false};
+    if (base == XOR) {
+        if (isConstant(b)) {
+            result = (b.index != 0) ? Negate(a) : a;
+        }
+        else if (sameWire(a, b)) {
+            result = Signal{CONSTANT_SIGNAL, (a.negated != b.negated) ? 1u : 0u, false};
+        }
+        else {
+            // XOR(NOT a, b) = NOT XOR(a, b)
+            const bool negated = a.negated != b.negated;
+            a.negated = b.negated = false;
+            result                = addStep(XOR, {a, b});
+            result.negated        = negated;
+        }
+    }
+    else {
+        // 0 absorbs AND and 1 absorbs OR
+        const uint32_t absorbing = (base == AND) ? 0 : 1;
+        if (isConstant(b)) {
+            result = (b.index == absorbing) ? b : a;
+        }
+        else if (sameWire(a, b)) {
+            result = (a.negated == b.negated) ? a : Signal{CONSTANT_SIGNAL, absorbing, false};
+        }
+        else if (a.negated && b.negated) {
+            // De Morgan: AND(NOT a, NOT b) = NOT OR(a, b)
+            result = Negate(addStep((base == AND) ? OR : AND, {Negate(a), Negate(b)}));
+        }
+        else {
+            result = addStep(base, {a, b});
+        }
+    }
+    return negateResult ? Negate(result) : result;
+}
+
+void BinFHENetlist::ValidateWire(uint32_t wire) const {
+    if (wire >= m_nodes.size())
+        OPENFHE_THROW("Wire " + std::to_string(wire) + " does not exist");
+}
+
+}  // namespace lbcrypto
@@ -320,6 +320,17 @@ LWECiphertext BinFHEContext::Bootstrap(ConstLWECiphertext& ct, bool extended) co
     return m_binfhescheme->Bootstrap(m_params, m_BTKey, ct, extended);
 }
 
+std::vector<LWECiphertext> BinFHEContext::EvalBinGateBatch(const std::vector<BINGATE>& gates,
+                                                           const std::vector<LWECiphertext>& ct1s,
+                                                           const std::vector<LWECiphertext>& ct2s,
+                                                           bool extended) const {
+    return m_binfhescheme->EvalBinGateBatch(m_params, gates, m_BTKey, ct1s, ct2s, extended);
+}
+
+std::vector<LWECiphertext> BinFHEContext::BootstrapBatch(const std::vector<LWECiphertext>& cts, bool extended) const {
+    return m_binfhescheme->BootstrapBatch(m_params, m_BTKey, cts, extended);
+}
+
 LWECiphertext BinFHEContext::EvalNOT(ConstLWECiphertext& ct) const {
     if (ct == nullptr)
         OPENFHE_THROW("Ciphertext is empty");
@@ -336,6 +347,13 @@ LWECiphertext BinFHEContext::EvalFunc(ConstLWECiphertext& ct, const std::vector<
     return m_binfhescheme->EvalFunc(m_params, m_BTKey, ct, LUT, GetBeta());
 }
 
+std::vector<LWECiphertext> BinFHEContext::EvalFuncMulti(ConstLWECiphertext& ct,
+                                                        const std::vector<std::vector<NativeInteger>>& LUTs) const {
+    if (ct == nullptr)
+        OPENFHE_THROW("Ciphertext is empty");
+    return m_binfhescheme->EvalFuncMulti(m_params, m_BTKey, ct, LUTs, GetBeta());
+}
+
 LWECiphertext BinFHEContext::EvalFloor(ConstLWECiphertext& ct, uint32_t roundbits) const {
     //    auto q = m_params->GetLWEParams()->Getq().ConvertToInt();
     //    if (roundbits != 0) {
@@ -34,6 +34,11 @@
 #include "math/binaryuniformgenerator.h"
 #include "math/discreteuniformgenerator.h"
 #include "math/ternaryuniformgenerator.h"
+#include "utils/parallel.h"
+
+#include <limits>
+#include <memory>
+#include <vector>
 
 namespace lbcrypto {
 // the main rounding operation used in ModSwitch (as described in Section 3 of
@@ -298,28 +303,14 @@ LWESwitchingKey LWEEncryptionScheme::KeySwitchGen(const std::shared_ptr<LWECrypt
 
     NativeInteger mu(qKS.ComputeMu());
 
-    std::vector<std::vector<std::vector<NativeVector>>> resultVecA(N);
-    std::vector<std::vector<std::vector<NativeInteger>>> resultVecB(N);
+    // the key is generated directly in the flat transposed layout (see LWESwitchingKeyImpl::GetFlatA)
+    auto keyA = std::make_shared<FlatKey<NativeInteger>>(N, digitCount, baseKS, 1, n);
+    std::vector<NativeInteger> keyB(N * digitCount * baseKS);
 
-    // TODO (cpascoe/dsuponit): this pragma needs to be revised as it may have to be removed completely
-    // #if !defined(__MINGW32__) && !defined(__MINGW64__)
-    // #pragma omp parallel for num_threads(N)
-    // #pragma omp parallel for num_threads(OpenFHEParallelControls.GetThreadLimit(N))
-    // #endif
     for (size_t i = 0; i < N; ++i) {
-        std::vector<std::vector<NativeVector>> vector1A;
-        vector1A.reserve(baseKS);
-        std::vector<std::vector<NativeInteger>> vector1B;
-        vector1B.reserve(baseKS);
-
         for (size_t j = 0; j < baseKS; ++j) {
-            std::vector<NativeVector> vector2A;
-            vector2A.reserve(digitCount);
-            std::vector<NativeInteger> vector2B;
-            vector2B.reserve(digitCount);
             for (size_t k = 0; k < digitCount; ++k) {
-                vector2A.emplace_back(dug.GenerateVector(n));
-                NativeVector& a = vector2A.back();
+                NativeVector a = dug.GenerateVector(n);
                 NativeInteger b =
                     (params->GetDggKS().GenerateInteger(qKS)).ModAdd(svN[i].ModMul(j * digitsKS[k], qKS), qKS);
 #if NATIVEINT == 32
@@ -332,15 +323,14 @@ LWESwitchingKey LWEEncryptionScheme::KeySwitchGen(const std::shared_ptr<LWECrypt
                 }
                 b.ModEq(qKS);
 #endif
-                vector2B.emplace_back(b);
+                NativeInteger* row{keyA->Get(i, k, j, 0)};
+                for (size_t l = 0; l < n; ++l)
+                    row[l] = a[l];
+                keyB[(i * digitCount + k) * baseKS + j] = b;
             }
-            vector1A.push_back(std::move(vector2A));
-            vector1B.push_back(std::move(vector2B));
         }
-        resultVecA[i] = std::move(vector1A);
-        resultVecB[i] = std::move(vector1B);
     }
-    return std::make_shared<LWESwitchingKeyImpl>(std::move(resultVecA), std::move(resultVecB));
+    return std::make_shared<LWESwitchingKeyImpl>(std::move(keyA), std::move(keyB));
 }
 
 // the key switching operation as described in Section 3 of
@@ -353,6 +343,10 @@ LWECiphertext LWEEncryptionScheme::KeySwitch(const std::shared_ptr<LWECryptoPara
     NativeInteger::Integer baseKS(params->GetBaseKS());
     const auto digitCount = static_cast<size_t>(std::ceil(log(Q.ConvertToDouble()) / log(static_cast<double>(baseKS))));
 
+    if (K->GetFlatA() != nullptr)
+        return KeySwitchFlat(params, *K, ctQN);
+
+    // keys in the nested layout (e.g., deserialized from earlier versions of the library)
     NativeVector a(n, Q);
     NativeInteger b(ctQN->GetB());
     for (size_t i = 0; i < N; ++i) {
@@ -371,6 +365,75 @@ LWECiphertext LWEEncryptionScheme::KeySwitch(const std::shared_ptr<LWECryptoPara
     return std::make_shared<LWECiphertextImpl>(std::move(a), b);
 }
 
+// Key switching for keys in the flat transposed layout. The rows selected by the digits are summed
+// without modular reduction (a reduction pass is inserted only when the sums could overflow), the
+// inner loop over n is a plain integer addition that the compiler vectorizes, and the input
+// coefficients are split between threads that keep partial sums, combined once at the end.
+LWECiphertext LWEEncryptionScheme::KeySwitchFlat(const std::shared_ptr<LWECryptoParams>& params,
+                                                 const LWESwitchingKeyImpl& K, ConstLWECiphertext& ctQN) const {
+    using Integer = NativeInteger::Integer;
+
+    const auto& flatA = *K.GetFlatA();
+    const auto& flatB = K.GetFlatB();
+    const size_t n(params->Getn());
+    const size_t N(params->GetN());
+    const uint32_t digitCount(flatA.GetNumVariants());
+    const uint32_t baseKS(flatA.GetRows());
+    if (flatA.GetNumKeys() != N || flatA.GetPolySize() != n || baseKS != params->GetBaseKS())
+        OPENFHE_THROW("The switching key does not match the parameters");
+
+    NativeInteger Q(params->GetqKS());
+    const Integer Qi(Q.ConvertToInt<Integer>());
+    // number of rows (each < Q) that can be added to a reduced sum without overflow
+    const size_t lazy(std::numeric_limits<Integer>::max() / Qi - 1);
+
+    std::vector<Integer> sumA(n, 0);
+    Integer sumB(0);
+
+#pragma omp parallel num_threads(OpenFHEParallelControls.GetThreadLimit(N))
+    {
+        // the partial sums of a thread are reused by its later key switches
+        thread_local std::vector<Integer> partA;
+        partA.assign(n, 0);
+        Integer partB(0);
+        size_t pending(0);
+#pragma omp for schedule(static)
+        for (size_t i = 0; i < N; ++i) {
+            Integer atmp(ctQN->GetA(i).ConvertToInt<Integer>());
+            for (uint32_t j = 0; j < digitCount; ++j) {
+                const auto a0 = static_cast<uint32_t>(atmp % baseKS);
+                atmp /= baseKS;
+                if (pending == lazy) {
+                    for (size_t k = 0; k < n; ++k)
+                        partA[k] %= Qi;
+                    partB %= Qi;
+                    pending = 0;
+                }
+                ++pending;
+                partB += flatB[(i * digitCount + j) * baseKS + a0].ConvertToInt<Integer>();
+                const NativeInteger* row{flatA.Get(i, j, a0, 0)};
+                Integer* acc{partA.data()};
+                for (size_t k = 0; k < n; ++k)
+                    acc[k] += row[k].ConvertToInt<Integer>();
+            }
+        }
+#pragma omp critical
+        {
+            for (size_t k = 0; k < n; ++k)
+                sumA[k] = (sumA[k] + partA[k] % Qi) % Qi;
+            sumB = (sumB + partB % Qi) % Qi;
+        }
+    }
+
+    // (a, b) = (0, b) - sum of the selected rows
+    NativeVector a(n, Q);
+    for (size_t k = 0; k < n; ++k)
+        a[k] = NativeInteger(0).ModSubFast(NativeInteger(sumA[k]), Q);
+    NativeInteger b(ctQN->GetB());
+    b.ModSubFastEq(NativeInteger(sumB), Q);
+    return std::make_shared<LWECiphertextImpl>(std::move(a), b);
+}
+
 // noiseless LWE embedding
 // a is a zero vector of dimension n; with integers mod q
 // b = m floor(q/4) is an integer mod q
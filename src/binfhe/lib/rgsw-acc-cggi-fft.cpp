@@ -0,0 +1,247 @@
+//==================================================================================
+// BSD 2-Clause License
+//
+// Copyright (c) 2014-2023, NJIT, Duality Technologies Inc. and other contributors
+//
+// All rights reserved.
+//
+// Author TPOC: contact@openfhe.org
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice, this
+//    list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+//    this list of conditions and the following disclaimer in the documentation
+//    and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+// OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//==================================================================================
+
+#include "rgsw-acc-cggi-fft.h"
+
+#include <algorithm>
+#include <cmath>
+#include <memory>
+#include <vector>
+
+namespace lbcrypto {
+
+// the FFT accumulator does not use the NTT scratch space of RingGSWAccumulator::Workspace
+struct RingGSWAccumulatorCGGIFFT::CGGIFFTWorkspace {
+    // signed gadget digits of the accumulator and their spectra (digitsG2 x N doubles each)
+    std::vector<double> digits;
+    std::vector<double> spectra;
+
+    // products with ek1 and ek2, their combination with the spectra of X^a - 1 and X^-a - 1,
+    // and the inverse transform (N doubles each)
+    std::vector<double> prod1;
+    std::vector<double> prod2;
+    std::vector<double> prod;
+    std::vector<double> monoPos;
+    std::vector<double> monoNeg;
+    std::vector<double> coeffs;
+
+    void Prepare(uint32_t N, uint32_t digitsG2) {
+        digits.resize(digitsG2 * N);
+        spectra.resize(digitsG2 * N);
+        prod1.resize(N);
+        prod2.resize(N);
+        prod.resize(N);
+        monoPos.resize(N);
+        monoNeg.resize(N);
+        coeffs.resize(N);
+    }
+};
+
+namespace {
+
+// out = spectrum of the centered representative of p (p in the COEFFICIENT representation)
+void ForwardCentered(const NegacyclicFFT& fft, const NativePoly& p, std::vector<double>& tmp, double* out) {
+    auto Q{p.GetModulus().ConvertToInt<int64_t>()};
+    auto QHalf{Q >> 1};
+    for (uint32_t k = 0, N = p.GetLength(); k < N; ++k) {
+        auto v{p[k].ConvertToInt<int64_t>()};
+        tmp[k] = static_cast<double>(v > QHalf ? v - Q : v);
+    }
+    fft.Forward(tmp.data(), out);
+}
+
+// out += a * b slot-wise for spectra of length N (M real parts followed by M imaginary parts)
+void MultiplyAccumulateSpectra(double* out, const double* a, const double* b, uint32_t M) {
+    const double* aIm{a + M};
+    const double* bIm{b + M};
+    double* outIm{out + M};
+    for (uint32_t p = 0; p < M; ++p) {
+        out[p] += a[p] * b[p] - aIm[p] * bIm[p];
+        outIm[p] += a[p] * bIm[p] + aIm[p] * b[p];
+    }
+}
+
+}  // namespace
+
+// Key generation as described in Section 4 of https://eprint.iacr.org/2014/816
+RingGSWACCKey RingGSWAccumulatorCGGIFFT::KeyGenAcc(const std::shared_ptr<RingGSWCryptoParams>& params,
+                                                   const NativePoly& skNTT, ConstLWEPrivateKey& LWEsk) const {
+    auto sv    = LWEsk->GetElement();
+    auto neg   = sv.GetModulus().ConvertToInt() - 1;
+    uint32_t n = sv.GetLength();
+
+    // approximate gadget decomposition is used; the first digit is ignored
+    uint32_t digitsG2{(params->GetDigitsG() - 1) << 1};
+    auto fourier = std::make_shared<FlatKey<double>>(n, 2, digitsG2, 2, params->GetN());
+
+    // handles ternary secrets using signed mod 3 arithmetic
+    // 0 -> {0,0}, 1 -> {1,0}, -1 -> {0,1}
+#pragma omp parallel for num_threads(OpenFHEParallelControls.GetThreadLimit(n))
+    for (uint32_t i = 0; i < n; ++i) {
+        auto s = sv[i].ConvertToInt();
+        KeyGenCGGIFFT(params, skNTT, s == 1 ? 1 : 0, fourier->Get(i, 0, 0, 0));
+        KeyGenCGGIFFT(params, skNTT, s == neg ? 1 : 0, fourier->Get(i, 1, 0, 0));
+    }
+
+    auto ek = std::make_shared<RingGSWACCKeyImpl>();
+    ek->SetFourierKey(std::move(fourier));
+    return ek;
+}
+
+void RingGSWAccumulatorCGGIFFT::EvalAcc(const std::shared_ptr<RingGSWCryptoParams>& params, ConstRingGSWACCKey& ek,
+                                        RLWECiphertext& acc, const NativeVector& a) const {
+    size_t n{a.GetLength()};
+    uint32_t N{params->GetN()};
+    uint32_t digitsG2{(params->GetDigitsG() - 1) << 1};
+
+    const auto& fourier = ek->GetFourierKey();
+    if (fourier == nullptr || fourier->GetNumKeys() != n || fourier->GetRows() != digitsG2 ||
+        fourier->GetPolySize() != N)
+        OPENFHE_THROW("The accumulator key was not generated for GINX_FFT bootstrapping");
+
+    auto& ws = GetWorkspace<CGGIFFTWorkspace>(N, digitsG2);
+
+    // the accumulator stays in the COEFFICIENT representation between the external products
+    auto& accVec = acc->GetElements();
+    accVec[0].SetFormat(Format::COEFFICIENT);
+    accVec[1].SetFormat(Format::COEFFICIENT);
+
+    auto mod{a.GetModulus()};
+    auto MbyMod{NativeInteger(2 * N) / mod};
+    for (size_t i = 0; i < n; ++i) {
+        // handles -a*E(1) and handles -a*E(-1) = a*E(1)
+        auto index{(NativeInteger(0).ModSubFast(a[i], mod) * MbyMod).ConvertToInt<uint32_t>()};
+        // X^0 - 1 = 0, so a zero index leaves the accumulator unchanged
+        if (index != 0)
+            AddToAccCGGIFFT(params, *fourier, i, index, acc, ws);
+    }
+
+    accVec[0].SetFormat(Format::EVALUATION);
+    accVec[1].SetFormat(Format::EVALUATION);
+}
+
+// Encryption for the CGGI variant, as described in https://eprint.iacr.org/2020/086
+void RingGSWAccumulatorCGGIFFT::KeyGenCGGIFFT(const std::shared_ptr<RingGSWCryptoParams>& params,
+                                              const NativePoly& skNTT, LWEPlaintext m, double* out) const {
+    const auto& Gpow       = params->GetGPower();
+    const auto& polyParams = params->GetPolyParams();
+    const auto& fft        = params->GetFFT();
+
+    DiscreteUniformGeneratorImpl<NativeVector> dug;
+    NativeInteger Q{params->GetQ()};
+    uint32_t N{params->GetN()};
+    std::vector<double> tmp(N);
+
+    // approximate gadget decomposition is used; the first digit is ignored
+    uint32_t digitsG2{(params->GetDigitsG() - 1) << 1};
+
+    for (uint32_t i = 0; i < digitsG2; ++i) {
+        NativePoly a(dug, polyParams, Format::COEFFICIENT);
+        NativePoly b(params->GetDgg(), polyParams, Format::COEFFICIENT);
+        NativePoly as(a);
+        as.SetFormat(Format::EVALUATION);
+        as *= skNTT;
+        as.SetFormat(Format::COEFFICIENT);
+        b += as;
+        if (m)
+            (i & 0x1 ? b : a)[0].ModAddFastEq(Gpow[(i >> 1) + 1], Q);
+        ForwardCentered(fft, a, tmp, out + (2 * i) * N);
+        ForwardCentered(fft, b, tmp, out + (2 * i + 1) * N);
+    }
+}
+
+// CGGI Accumulation as described in https://eprint.iacr.org/2020/086
+// Added ternary MUX introduced in paper https://eprint.iacr.org/2022/074.pdf section 5
+// Both monomials are applied slot-wise in the FFT domain, so only two inverse transforms are needed
+void RingGSWAccumulatorCGGIFFT::AddToAccCGGIFFT(const std::shared_ptr<RingGSWCryptoParams>& params,
+                                                const FlatKey<double>& ek, uint32_t i, uint32_t a, RLWECiphertext& acc,
+                                                CGGIFFTWorkspace& ws) const {
+    const auto& fft = params->GetFFT();
+    uint32_t N{params->GetN()};
+    uint32_t M{N >> 1};
+    uint32_t digitsG2{(params->GetDigitsG() - 1) << 1};
+    auto& accVec = acc->GetElements();
+
+    // signed digit decomposition (see RingGSWAccumulator::SignedDigitDecompose) into centered digits
+    NativeInteger Q{params->GetQ()};
+    auto Q_int{Q.ConvertToInt<int64_t>()};
+    auto QHalf{Q_int >> 1};
+    auto gBits{static_cast<int64_t>(__builtin_ctz(params->GetBaseG()))};
+    auto gBitsMaxBits{static_cast<int64_t>(64 - gBits)};
+    double* digits{ws.digits.data()};
+    for (uint32_t k = 0; k < N; ++k) {
+        for (uint32_t j = 0; j < 2; ++j) {
+            auto t{accVec[j][k].ConvertToInt<int64_t>()};
+            auto d{t < QHalf ? t : t - Q_int};
+            auto r{(d << gBitsMaxBits) >> gBitsMaxBits};
+            d = (d - r) >> gBits;
+            for (uint32_t l = j; l < digitsG2; l += 2) {
+                r = (d << gBitsMaxBits) >> gBitsMaxBits;
+                d = (d - r) >> gBits;
+                digits[l * N + k] = static_cast<double>(r);
+            }
+        }
+    }
+
+    for (uint32_t l = 0; l < digitsG2; ++l)
+        fft.Forward(digits + l * N, ws.spectra.data() + l * N);
+
+    // obtain both monomial(index) for sk = 1 and monomial(-index) for sk = -1
+    fft.GetMonomial(a, ws.monoPos.data());
+    fft.GetMonomial(2 * N - a, ws.monoNeg.data());
+
+    for (uint32_t j = 0; j < 2; ++j) {
+        std::fill(ws.prod1.begin(), ws.prod1.end(), 0.0);
+        std::fill(ws.prod2.begin(), ws.prod2.end(), 0.0);
+        for (uint32_t l = 0; l < digitsG2; ++l) {
+            const double* dl{ws.spectra.data() + l * N};
+            MultiplyAccumulateSpectra(ws.prod1.data(), dl, ek.Get(i, 0, l, j), M);
+            MultiplyAccumulateSpectra(ws.prod2.data(), dl, ek.Get(i, 1, l, j), M);
+        }
+
+        // prod = prod1 * (X^a - 1) + prod2 * (X^-a - 1)
+        std::fill(ws.prod.begin(), ws.prod.end(), 0.0);
+        MultiplyAccumulateSpectra(ws.prod.data(), ws.prod1.data(), ws.monoPos.data(), M);
+        MultiplyAccumulateSpectra(ws.prod.data(), ws.prod2.data(), ws.monoNeg.data(), M);
+        fft.Inverse(ws.prod.data(), ws.coeffs.data());
+
+        // the exact result is an integer; rounding absorbs the floating-point error
+        auto& accj = accVec[j];
+        for (uint32_t k = 0; k < N; ++k) {
+            int64_t v{std::llround(ws.coeffs[k]) % Q_int};
+            if (v < 0)
+                v += Q_int;
+            accj[k].ModAddFastEq(NativeInteger(static_cast<uint64_t>(v)), Q);
+        }
+    }
+}
+
+};  // namespace lbcrypto
@@ -31,7 +31,9 @@
 
 #include "rgsw-acc-cggi.h"
 
+#include <memory>
 #include <string>
+#include <vector>
 
 namespace lbcrypto {
 
@@ -41,18 +43,34 @@ RingGSWACCKey RingGSWAccumulatorCGGI::KeyGenAcc(const std::shared_ptr<RingGSWCry
     auto sv    = LWEsk->GetElement();
     auto neg   = sv.GetModulus().ConvertToInt() - 1;
     uint32_t n = sv.GetLength();
-    auto ek    = std::make_shared<RingGSWACCKeyImpl>(1, 2, n);
-    auto& ek00 = (*ek)[0][0];
-    auto& ek01 = (*ek)[0][1];
+    uint32_t N = params->GetN();
+
+    // the key is generated directly in the flat layout: (i, 0) encrypts [s_i = 1], (i, 1) encrypts [s_i = -1]
+    // approximate gadget decomposition is used; the first digit is ignored
+    uint32_t digitsG2{(params->GetDigitsG() - 1) << 1};
+    auto flat = std::make_shared<FlatKey<NativeInteger>>(n, 2, digitsG2, 2, N);
 
     // handles ternary secrets using signed mod 3 arithmetic
     // 0 -> {0,0}, 1 -> {1,0}, -1 -> {0,1}
 #pragma omp parallel for num_threads(OpenFHEParallelControls.GetThreadLimit(n))
     for (uint32_t i = 0; i < n; ++i) {
-        auto s  = sv[i].ConvertToInt();
-        ek00[i] = KeyGenCGGI(params, skNTT, s == 1 ? 1 : 0);
-        ek01[i] = KeyGenCGGI(params, skNTT, s == neg ? 1 : 0);
+        auto s = sv[i].ConvertToInt();
+        for (uint32_t v = 0; v < 2; ++v) {
+            auto evk{KeyGenCGGI(params, skNTT, s == (v == 0 ? 1 : neg) ? 1 : 0)};
+            const auto& elements = evk->GetElements();
+            for (uint32_t r = 0; r < digitsG2; ++r) {
+                for (uint32_t c = 0; c < 2; ++c) {
+                    const auto& poly = elements[r][c];
+                    NativeInteger* dst{flat->Get(i, v, r, c)};
+                    for (uint32_t k = 0; k < N; ++k)
+                        dst[k] = poly[k];
+                }
+            }
+        }
     }
+
+    auto ek = std::make_shared<RingGSWACCKeyImpl>();
+    ek->SetFlatKey(std::move(flat));
     return ek;
 }
 
@@ -61,6 +79,20 @@ void RingGSWAccumulatorCGGI::EvalAcc(const std::shared_ptr<RingGSWCryptoParams>&
     size_t n{a.GetLength()};
     auto mod{a.GetModulus()};
     auto MbyMod{NativeInteger(2 * params->GetN()) / mod};
+
+    const auto& flat = ek->GetFlatKey();
+    if (flat != nullptr) {
+        if (flat->GetNumKeys() != n || flat->GetPolySize() != params->GetN())
+            OPENFHE_THROW("The flat accumulator key does not match the parameters");
+        auto& ws = GetWorkspace<Workspace>(params);
+        for (size_t i = 0; i < n; ++i) {
+            // handles -a*E(1) and handles -a*E(-1) = a*E(1)
+            AddToAccCGGI(params, *flat, i, NativeInteger(0).ModSubFast(a[i], mod) * MbyMod, acc, ws);
+        }
+        return;
+    }
+
+    // keys in the nested layout (e.g., deserialized from earlier versions of the library)
     for (size_t i = 0; i < n; ++i) {
         // handles -a*E(1) and handles -a*E(-1) = a*E(1)
         AddToAccCGGI(params, (*ek)[0][0][i], (*ek)[0][1][i], NativeInteger(0).ModSubFast(a[i], mod) * MbyMod, acc);
@@ -150,4 +182,47 @@ void RingGSWAccumulatorCGGI::AddToAccCGGI(const std::shared_ptr<RingGSWCryptoPar
     acc->GetElements()[1] += (tmp *= monomialNeg);
 }
 
+// Same as above for keys in the flat layout; all temporaries come from the thread's workspace
+void RingGSWAccumulatorCGGI::AddToAccCGGI(const std::shared_ptr<RingGSWCryptoParams>& params,
+                                          const FlatKey<NativeInteger>& ek, uint32_t i, const NativeInteger& a,
+                                          RLWECiphertext& acc, Workspace& ws) const {
+    auto& accVec = acc->GetElements();
+    ws.ct[0]     = accVec[0];
+    ws.ct[1]     = accVec[1];
+    ws.ct[0].SetFormat(Format::COEFFICIENT);
+    ws.ct[1].SetFormat(Format::COEFFICIENT);
+
+    // approximate gadget decomposition is used; the first digit is ignored
+    uint32_t digitsG2{(params->GetDigitsG() - 1) << 1};
+    for (auto& d : ws.dct)
+        ZeroPoly(d, Format::COEFFICIENT);
+
+    SignedDigitDecompose(params, ws.ct, ws.dct);
+
+#pragma omp parallel for num_threads(OpenFHEParallelControls.GetThreadLimit(digitsG2))
+    for (uint32_t l = 0; l < digitsG2; ++l)
+        ws.dct[l].SetFormat(Format::EVALUATION);
+
+    // obtain both monomial(index) for sk = 1 and monomial(-index) for sk = -1
+    // index is in range [0,m] - so we need to adjust the edge case when index == m to index = 0
+    uint32_t MInt{2 * params->GetN()};
+    NativeInteger M{MInt};
+    uint32_t indexPos{a.ConvertToInt<uint32_t>()};
+    const NativePoly& monomial = params->GetMonomial(indexPos == MInt ? 0 : indexPos);
+    uint32_t indexNeg{NativeInteger(0).ModSubFast(a, M).ConvertToInt<uint32_t>()};
+    const NativePoly& monomialNeg = params->GetMonomial(indexNeg == MInt ? 0 : indexNeg);
+
+    // acc = acc + dct * ek(i, 0) * monomial + dct * ek(i, 1) * negative_monomial
+    const auto& Q{params->GetQ()};
+    for (uint32_t v = 0; v < 2; ++v) {
+        const NativePoly& mono = (v == 0) ? monomial : monomialNeg;
+        for (uint32_t c = 0; c < 2; ++c) {
+            ZeroPoly(ws.tmp, Format::EVALUATION);
+            for (uint32_t l = 0; l < digitsG2; ++l)
+                MultiplyAccumulate(ws.tmp, ws.dct[l], ek.Get(i, v, l, c), Q, ws.mu);
+            accVec[c] += (ws.tmp *= mono);
+        }
+    }
+}
+
 };  // namespace lbcrypto
@@ -31,7 +31,10 @@
 
 #include "rgsw-acc-lmkcdey.h"
 
+#include <algorithm>
+#include <memory>
 #include <string>
+#include <vector>
 
 namespace lbcrypto {
 
@@ -41,7 +44,6 @@ RingGSWACCKey RingGSWAccumulatorLMKCDEY::KeyGenAcc(const std::shared_ptr<RingGSW
     auto sv{LWEsk->GetElement()};
     auto mod{sv.GetModulus().ConvertToInt<int32_t>()};
     auto modHalf{mod >> 1};
-    uint32_t N{params->GetN()};
     size_t n{sv.GetLength()};
     uint32_t numAutoKeys{params->GetNumAutoKeys()};
 
@@ -56,105 +58,120 @@ RingGSWACCKey RingGSWAccumulatorLMKCDEY::KeyGenAcc(const std::shared_ptr<RingGSW
         (*ek)[0][0][i] = KeyGenLMKCDEY(params, skNTT, s > modHalf ? s - mod : s);
     }
 
-    NativeInteger gen = NativeInteger(5);
-
-    (*ek)[0][1][0] = KeyGenAuto(params, skNTT, 2 * N - gen.ConvertToInt());
-
+    // automorphism keys for -5 and 5^i (mod 2N), i = 1..numAutoKeys
     // m_window: window size, consider parameterization in the future
-#pragma omp parallel for num_threads(OpenFHEParallelControls.GetThreadLimit(numAutoKeys))
-    for (uint32_t i = 1; i <= numAutoKeys; ++i)
-        (*ek)[0][1][i] = KeyGenAuto(params, skNTT, gen.ModExp(i, 2 * N).ConvertToInt<LWEPlaintext>());
+#pragma omp parallel for num_threads(OpenFHEParallelControls.GetThreadLimit(numAutoKeys + 1))
+    for (uint32_t i = 0; i <= numAutoKeys; ++i)
+        (*ek)[0][1][i] = KeyGenAuto(params, skNTT, params->GetAutoExponent(i));
     return ek;
 }
 
+// counting-sort schedule of the a_i in addition to the NTT scratch space
+struct RingGSWAccumulatorLMKCDEY::LMKCDEYWorkspace : public Workspace {
+    // the indices with bucket b are schedule[offsets[b]], ..., schedule[offsets[b + 1] - 1]
+    std::vector<uint32_t> offsets;
+    std::vector<uint32_t> cursor;
+    std::vector<uint32_t> buckets;
+    std::vector<uint32_t> schedule;
+
+    void Prepare(const std::shared_ptr<RingGSWCryptoParams>& params, size_t n) {
+        Workspace::Prepare(params);
+        offsets.resize(params->GetN() + 1);
+        cursor.resize(params->GetN());
+        buckets.resize(n);
+        schedule.resize(n);
+    }
+};
+
 void RingGSWAccumulatorLMKCDEY::EvalAcc(const std::shared_ptr<RingGSWCryptoParams>& params, ConstRingGSWACCKey& ek,
                                         RLWECiphertext& acc, const NativeVector& a) const {
     // assume a is all-odd ciphertext (using round-to-odd technique)
     size_t n             = a.GetLength();
-    uint32_t Nh          = params->GetN() / 2;
-    uint32_t M           = 2 * params->GetN();
+    uint32_t N           = params->GetN();
+    uint32_t Nh          = N / 2;
+    uint32_t M           = 2 * N;
     uint32_t numAutoKeys = params->GetNumAutoKeys();
 
     NativeInteger MNative(M);
 
-    auto logGen = params->GetLogGen();
-    std::unordered_map<int32_t, std::vector<int32_t>> permuteMap;
+    auto& ws     = GetWorkspace<LMKCDEYWorkspace>(params, n);
+    auto& logGen = params->GetLogGen();
 
-    for (size_t i = 0; i < n; i++) {  // put ail a_i in the permuteMap
+    // counting sort of the a_i by discrete log: bucket Nh - 1 + l for log l in (-Nh, Nh), N - 1 for -1
+    std::fill(ws.offsets.begin(), ws.offsets.end(), 0);
+    for (size_t i = 0; i < n; ++i) {
         // make it odd; round-to-odd(https://eprint.iacr.org/2022/198) will improve error.
         int32_t aIOdd = NativeInteger(0).ModSubFast(a[i], MNative).ConvertToInt<uint32_t>() | 0x1;
         int32_t index = logGen[aIOdd];
-
-        if (permuteMap.find(index) == permuteMap.end()) {
-            std::vector<int32_t> indexVec;
-            permuteMap[index] = indexVec;
-        }
-        auto& indexVec = permuteMap[index];
-        indexVec.push_back(i);
+        ws.buckets[i] = (index == static_cast<int32_t>(M)) ? N - 1 : static_cast<uint32_t>(index + Nh - 1);
+        ++ws.offsets[ws.buckets[i] + 1];
+    }
+    for (uint32_t b = 0; b < N; ++b) {
+        ws.offsets[b + 1] += ws.offsets[b];
+        ws.cursor[b] = ws.offsets[b];
+    }
+    for (size_t i = 0; i < n; ++i)
+        ws.schedule[ws.cursor[ws.buckets[i]]++] = i;
+
+    auto addBucket = [&](uint32_t b) {
+        for (uint32_t j = ws.offsets[b]; j < ws.offsets[b + 1]; ++j)
+            AddToAccLMKCDEY(params, (*ek)[0][0][ws.schedule[j]], acc, ws);
+    };
+    auto isEmpty = [&](uint32_t b) {
+        return ws.offsets[b] == ws.offsets[b + 1];
+    };
+
+    // acc_1 <- sigma_{-5}(acc_1), in place
+    {
+        auto& acc1      = acc->GetElements()[1];
+        const auto& vec = params->GetAutoMap(0);
+        ws.tmp          = acc1;
+        for (uint32_t j = 0; j < N; ++j)
+            acc1[j] = ws.tmp[vec[j]];
     }
 
-    NativeInteger gen(5);
-    uint32_t genInt       = 5;
-    uint32_t nSkips       = 0;
-    acc->GetElements()[1] = (acc->GetElements()[1]).AutomorphismTransform(M - genInt);
+    uint32_t nSkips = 0;
 
     // for a_j = -5^i
     for (uint32_t i = Nh - 1; i > 0; i--) {
-        if (permuteMap.find(-i) != permuteMap.end()) {
+        if (!isEmpty(Nh - 1 - i)) {
             if (nSkips != 0) {  // Rotation by 5^nSkips
-                Automorphism(params, gen.ModExp(nSkips, M), (*ek)[0][1][nSkips], acc);
+                Automorphism(params, nSkips, (*ek)[0][1][nSkips], acc, ws);
                 nSkips = 0;
             }
-            auto& indexVec = permuteMap[-i];
-            for (size_t j = 0; j < indexVec.size(); j++) {
-                AddToAccLMKCDEY(params, (*ek)[0][0][indexVec[j]], acc);
-            }
+            addBucket(Nh - 1 - i);
         }
         nSkips++;
 
         if (nSkips == numAutoKeys || i == 1) {
-            Automorphism(params, gen.ModExp(nSkips, M), (*ek)[0][1][nSkips], acc);
+            Automorphism(params, nSkips, (*ek)[0][1][nSkips], acc, ws);
             nSkips = 0;
         }
     }
 
     // for -1
-    if (permuteMap.find(M) != permuteMap.end()) {
-        auto& indexVec = permuteMap[M];
-        for (size_t j = 0; j < indexVec.size(); j++) {
-            AddToAccLMKCDEY(params, (*ek)[0][0][indexVec[j]], acc);
-        }
-    }
+    addBucket(N - 1);
 
-    Automorphism(params, NativeInteger(M - genInt), (*ek)[0][1][0], acc);
+    Automorphism(params, 0, (*ek)[0][1][0], acc, ws);
     // for a_j = 5^i
-    for (size_t i = Nh - 1; i > 0; i--) {
-        if (permuteMap.find(i) != permuteMap.end()) {
+    for (uint32_t i = Nh - 1; i > 0; i--) {
+        if (!isEmpty(Nh - 1 + i)) {
             if (nSkips != 0) {  // Rotation by 5^nSkips
-                Automorphism(params, gen.ModExp(nSkips, M), (*ek)[0][1][nSkips], acc);
+                Automorphism(params, nSkips, (*ek)[0][1][nSkips], acc, ws);
                 nSkips = 0;
             }
-
-            auto& indexVec = permuteMap[i];
-            for (size_t j = 0; j < indexVec.size(); j++) {
-                AddToAccLMKCDEY(params, (*ek)[0][0][indexVec[j]], acc);
-            }
+            addBucket(Nh - 1 + i);
         }
         nSkips++;
 
         if (nSkips == numAutoKeys || i == 1) {
-            Automorphism(params, gen.ModExp(nSkips, M), (*ek)[0][1][nSkips], acc);
+            Automorphism(params, nSkips, (*ek)[0][1][nSkips], acc, ws);
             nSkips = 0;
         }
     }
 
     // for 0
-    if (permuteMap.find(0) != permuteMap.end()) {
-        auto& indexVec = permuteMap[0];
-        for (size_t j = 0; j < indexVec.size(); j++) {
-            AddToAccLMKCDEY(params, (*ek)[0][0][indexVec[j]], acc);
-        }
-    }
+    addBucket(Nh - 1);
 }
 
 // Encryption as described in Section 5 of https://eprint.iacr.org/2022/198
@@ -226,64 +243,75 @@ RingGSWEvalKey RingGSWAccumulatorLMKCDEY::KeyGenAuto(const std::shared_ptr<RingG
 // LMKCDEY Accumulation as described in https://eprint.iacr.org/2022/198
 // Same as AP, but multiplied once
 void RingGSWAccumulatorLMKCDEY::AddToAccLMKCDEY(const std::shared_ptr<RingGSWCryptoParams>& params,
-                                                ConstRingGSWEvalKey& ek, RLWECiphertext& acc) const {
-    std::vector<NativePoly> ct(acc->GetElements());
-    ct[0].SetFormat(Format::COEFFICIENT);
-    ct[1].SetFormat(Format::COEFFICIENT);
+                                                ConstRingGSWEvalKey& ek, RLWECiphertext& acc,
+                                                LMKCDEYWorkspace& ws) const {
+    auto& accVec = acc->GetElements();
+    ws.ct[0]     = accVec[0];
+    ws.ct[1]     = accVec[1];
+    ws.ct[0].SetFormat(Format::COEFFICIENT);
+    ws.ct[1].SetFormat(Format::COEFFICIENT);
 
     // approximate gadget decomposition is used; the first digit is ignored
     uint32_t digitsG2{(params->GetDigitsG() - 1) << 1};
 
-    std::vector<NativePoly> dct(digitsG2, NativePoly(params->GetPolyParams(), Format::COEFFICIENT, true));
+    for (uint32_t d = 0; d < digitsG2; ++d)
+        ZeroPoly(ws.dct[d], Format::COEFFICIENT);
 
-    SignedDigitDecompose(params, ct, dct);
+    SignedDigitDecompose(params, ws.ct, ws.dct);
 
     // calls digitsG2 NTTs
 #pragma omp parallel for num_threads(OpenFHEParallelControls.GetThreadLimit(digitsG2))
     for (uint32_t d = 0; d < digitsG2; ++d)
-        dct[d].SetFormat(Format::EVALUATION);
+        ws.dct[d].SetFormat(Format::EVALUATION);
 
     // acc = dct * ek (matrix product);
+    const NativeInteger& Q{params->GetQ()};
     const std::vector<std::vector<NativePoly>>& ev = ek->GetElements();
-    acc->GetElements()[0]                          = (dct[0] * ev[0][0]);
-    for (uint32_t d = 1; d < digitsG2; ++d)
-        acc->GetElements()[0] += (dct[d] * ev[d][0]);
-    acc->GetElements()[1] = (dct[0] *= ev[0][1]);
-    for (uint32_t d = 1; d < digitsG2; ++d)
-        acc->GetElements()[1] += (dct[d] *= ev[d][1]);
+    ZeroPoly(accVec[0], Format::EVALUATION);
+    ZeroPoly(accVec[1], Format::EVALUATION);
+    for (uint32_t d = 0; d < digitsG2; ++d) {
+        MultiplyAccumulate(accVec[0], ws.dct[d], &ev[d][0][0], Q, ws.mu);
+        MultiplyAccumulate(accVec[1], ws.dct[d], &ev[d][1][0], Q, ws.mu);
+    }
 }
 
 // Automorphism
-void RingGSWAccumulatorLMKCDEY::Automorphism(const std::shared_ptr<RingGSWCryptoParams>& params, const NativeInteger& a,
-                                             ConstRingGSWEvalKey& ak, RLWECiphertext& acc) const {
-    // precompute bit reversal for the automorphism into vec
+void RingGSWAccumulatorLMKCDEY::Automorphism(const std::shared_ptr<RingGSWCryptoParams>& params, uint32_t k,
+                                             ConstRingGSWEvalKey& ak, RLWECiphertext& acc,
+                                             LMKCDEYWorkspace& ws) const {
+    // precomputed bit-reversed index map of the automorphism
     uint32_t N{params->GetN()};
-    std::vector<usint> vec(N);
-    PrecomputeAutoMap(N, a.ConvertToInt<usint>(), &vec);
+    const auto& vec = params->GetAutoMap(k);
+    auto& accVec    = acc->GetElements();
 
-    acc->GetElements()[1] = acc->GetElements()[1].AutomorphismTransform(a.ConvertToInt<usint>(), vec);
+    ws.tmp = accVec[1];
+    for (uint32_t j = 0; j < N; ++j)
+        accVec[1][j] = ws.tmp[vec[j]];
 
-    NativePoly cta(acc->GetElements()[0]);
-    acc->GetElements()[0].SetValuesToZero();
-    cta = cta.AutomorphismTransform(a.ConvertToInt<usint>(), vec);
-    cta.SetFormat(COEFFICIENT);
+    // tmp is still in EVALUATION representation
+    for (uint32_t j = 0; j < N; ++j)
+        ws.tmp[j] = accVec[0][vec[j]];
+    ws.tmp.SetFormat(COEFFICIENT);
 
     // approximate gadget decomposition is used; the first digit is ignored
     uint32_t digitsG{params->GetDigitsG() - 1};
-    std::vector<NativePoly> dcta(digitsG, NativePoly(params->GetPolyParams(), Format::COEFFICIENT, true));
+    for (uint32_t d = 0; d < digitsG; ++d)
+        ZeroPoly(ws.dct[d], Format::COEFFICIENT);
 
-    SignedDigitDecompose(params, cta, dcta);
+    SignedDigitDecompose(params, ws.tmp, ws.dct);
 
 #pragma omp parallel for num_threads(OpenFHEParallelControls.GetThreadLimit(digitsG))
     for (uint32_t d = 0; d < digitsG; ++d)
-        dcta[d].SetFormat(Format::EVALUATION);
+        ws.dct[d].SetFormat(Format::EVALUATION);
 
     // acc = dct * input (matrix product);
+    const NativeInteger& Q{params->GetQ()};
     const std::vector<std::vector<NativePoly>>& ev = ak->GetElements();
-    for (uint32_t d = 0; d < digitsG; ++d)
-        acc->GetElements()[0] += (dcta[d] * ev[d][0]);
-    for (uint32_t d = 0; d < digitsG; ++d)
-        acc->GetElements()[1] += (dcta[d] *= ev[d][1]);
+    ZeroPoly(accVec[0], Format::EVALUATION);
+    for (uint32_t d = 0; d < digitsG; ++d) {
+        MultiplyAccumulate(accVec[0], ws.dct[d], &ev[d][0][0], Q, ws.mu);
+        MultiplyAccumulate(accVec[1], ws.dct[d], &ev[d][1][0], Q, ws.mu);
+    }
 }
 
 };  // namespace lbcrypto
@@ -51,6 +51,30 @@
 
 namespace lbcrypto {
 
+void RingGSWAccumulator::Workspace::Prepare(const std::shared_ptr<RingGSWCryptoParams>& params) {
+    uint32_t digitsG2{(params->GetDigitsG() - 1) << 1};
+    const auto& pp{params->GetPolyParams()};
+    if (pp != polyParams || dct.size() != digitsG2) {
+        polyParams = pp;
+        ct.assign(2, NativePoly(pp, Format::COEFFICIENT, true));
+        dct.assign(digitsG2, NativePoly(pp, Format::COEFFICIENT, true));
+        tmp = NativePoly(pp, Format::EVALUATION, true);
+        mu  = params->GetQ().ComputeMu();
+    }
+}
+
+void RingGSWAccumulator::ZeroPoly(NativePoly& p, Format format) {
+    for (uint32_t i = 0, N = p.GetLength(); i < N; ++i)
+        p[i] = 0;
+    p.OverrideFormat(format);
+}
+
+void RingGSWAccumulator::MultiplyAccumulate(NativePoly& out, const NativePoly& a, const NativeInteger* b,
+                                            const NativeInteger& Q, const NativeInteger& mu) {
+    for (uint32_t i = 0, N = out.GetLength(); i < N; ++i)
+        out[i].ModAddFastEq(a[i].ModMulFast(b[i], Q, mu), Q);
+}
+
 void RingGSWAccumulator::SignedDigitDecompose(const std::shared_ptr<RingGSWCryptoParams>& params,
                                               const std::vector<NativePoly>& input,
                                               std::vector<NativePoly>& output) const {
@@ -34,6 +34,9 @@
 namespace lbcrypto {
 
 void RingGSWCryptoParams::PreCompute(bool signEval) {
+    // the NTT tables of the ring, held by the params
+    m_polyParams->PrecomputeNTTTables();
+
     // Computes baseR^i (only for AP bootstrapping)
     if (m_method == BINFHE_METHOD::AP) {
         auto&& logq = std::log(m_q.ConvertToDouble());
@@ -112,6 +115,14 @@ void RingGSWCryptoParams::PreCompute(bool signEval) {
         }
     }
 
+    // The double-precision external product is exact up to small rounding noise only while
+    // the products of digits and key coefficients fit in the 53-bit mantissa
+    if (m_method == GINX_FFT) {
+        if (m_Q.GetMSB() > 32)
+            OPENFHE_THROW("GINX_FFT supports moduli Q up to 2^32 only");
+        m_fft = NegacyclicFFT(m_N);
+    }
+
     if (m_method == LMKCDEY) {
         constexpr uint32_t gen{5};
         m_logGen.clear();
@@ -124,6 +135,19 @@ void RingGSWCryptoParams::PreCompute(bool signEval) {
             m_logGen[gPow]     = i;
             m_logGen[M - gPow] = -i;
         }
+
+        m_autoExp.resize(m_numAutoKeys + 1);
+        m_autoMap.resize(m_numAutoKeys + 1);
+        m_autoExp[0] = M - gen;
+        gPow         = 1;
+        for (uint32_t k = 1; k <= m_numAutoKeys; ++k) {
+            gPow         = (gPow * gen) % M;
+            m_autoExp[k] = gPow;
+        }
+        for (uint32_t k = 0; k <= m_numAutoKeys; ++k) {
+            m_autoMap[k].resize(m_N);
+            PrecomputeAutoMap(m_N, m_autoExp[k], &m_autoMap[k]);
+        }
     }
 }
 
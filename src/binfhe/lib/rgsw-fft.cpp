@@ -0,0 +1,157 @@
+//==================================================================================
+// BSD 2-Clause License
+//
+// Copyright (c) 2014-2023, NJIT, Duality Technologies Inc. and other contributors
+//
+// All rights reserved.
+//
+// Author TPOC: contact@openfhe.org
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice, this
+//    list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+//    this list of conditions and the following disclaimer in the documentation
+//    and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+// OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//==================================================================================
+
+#include "rgsw-fft.h"
+
+#include "math/nbtheory.h"
+#include "utils/exception.h"
+#include "utils/utilities.h"
+
+#include <cmath>
+
+namespace lbcrypto {
+
+NegacyclicFFT::NegacyclicFFT(uint32_t N) : m_N(N) {
+    if (N < 4 || !IsPowerOfTwo(N))
+        OPENFHE_THROW("NegacyclicFFT: the ring dimension should be a power of two greater than 2");
+
+    uint32_t M{N >> 1};
+    uint32_t M2{N << 1};
+    m_rootRe.resize(M2);
+    m_rootIm.resize(M2);
+    for (uint32_t t = 0; t < M2; ++t) {
+        double theta{M_PI * static_cast<double>(t) / static_cast<double>(N)};
+        m_rootRe[t] = std::cos(theta);
+        m_rootIm[t] = std::sin(theta);
+    }
+
+    m_twiddleRe.resize(M - 1);
+    m_twiddleIm.resize(M - 1);
+    for (uint32_t h = 1; h < M; h <<= 1) {
+        // exp(2 * pi * i * k / (2h)) = zeta^(k * N / h)
+        uint32_t step{N / h};
+        for (uint32_t k = 0; k < h; ++k) {
+            m_twiddleRe[h - 1 + k] = m_rootRe[k * step];
+            m_twiddleIm[h - 1 + k] = m_rootIm[k * step];
+        }
+    }
+
+    uint32_t logM{GetMSB(M) - 1};
+    m_slotExp.resize(M);
+    for (uint32_t p = 0; p < M; ++p)
+        m_slotExp[p] = (4 * ReverseBits(p, logM) + 1) % M2;
+}
+
+// Decimation in frequency: natural order in, bit-reversed order out
+void NegacyclicFFT::Forward(const double* in, double* out) const {
+    uint32_t M{m_N >> 1};
+    double* re{out};
+    double* im{out + M};
+    const double* tRe{m_rootRe.data()};
+    const double* tIm{m_rootIm.data()};
+
+    // fold and twist: z_k = (p_k + i * p_{k + M}) * zeta^k
+    for (uint32_t k = 0; k < M; ++k) {
+        double a{in[k]};
+        double b{in[k + M]};
+        re[k] = a * tRe[k] - b * tIm[k];
+        im[k] = a * tIm[k] + b * tRe[k];
+    }
+
+    for (uint32_t h = M >> 1; h > 0; h >>= 1) {
+        const double* wRe{m_twiddleRe.data() + h - 1};
+        const double* wIm{m_twiddleIm.data() + h - 1};
+        for (uint32_t s = 0; s < M; s += 2 * h) {
+            double* xRe{re + s};
+            double* xIm{im + s};
+            double* yRe{re + s + h};
+            double* yIm{im + s + h};
+            for (uint32_t k = 0; k < h; ++k) {
+                double dRe{xRe[k] - yRe[k]};
+                double dIm{xIm[k] - yIm[k]};
+                xRe[k] += yRe[k];
+                xIm[k] += yIm[k];
+                yRe[k] = dRe * wRe[k] - dIm * wIm[k];
+                yIm[k] = dRe * wIm[k] + dIm * wRe[k];
+            }
+        }
+    }
+}
+
+// Decimation in time: bit-reversed order in, natural order out
+void NegacyclicFFT::Inverse(double* in, double* out) const {
+    uint32_t M{m_N >> 1};
+    double* re{in};
+    double* im{in + M};
+
+    for (uint32_t h = 1; h < M; h <<= 1) {
+        const double* wRe{m_twiddleRe.data() + h - 1};
+        const double* wIm{m_twiddleIm.data() + h - 1};
+        for (uint32_t s = 0; s < M; s += 2 * h) {
+            double* xRe{re + s};
+            double* xIm{im + s};
+            double* yRe{re + s + h};
+            double* yIm{im + s + h};
+            for (uint32_t k = 0; k < h; ++k) {
+                // multiply by the conjugate twiddle
+                double vRe{yRe[k] * wRe[k] + yIm[k] * wIm[k]};
+                double vIm{yIm[k] * wRe[k] - yRe[k] * wIm[k]};
+                yRe[k] = xRe[k] - vRe;
+                yIm[k] = xIm[k] - vIm;
+                xRe[k] += vRe;
+                xIm[k] += vIm;
+            }
+        }
+    }
+
+    // untwist, scale by 1/M and unfold
+    const double* tRe{m_rootRe.data()};
+    const double* tIm{m_rootIm.data()};
+    double scale{1.0 / static_cast<double>(M)};
+    for (uint32_t k = 0; k < M; ++k) {
+        double zRe{re[k] * scale};
+        double zIm{im[k] * scale};
+        out[k]     = zRe * tRe[k] + zIm * tIm[k];
+        out[k + M] = zIm * tRe[k] - zRe * tIm[k];
+    }
+}
+
+void NegacyclicFFT::GetMonomial(uint32_t a, double* out) const {
+    uint32_t M{m_N >> 1};
+    uint64_t M2{m_N << 1};
+    for (uint32_t p = 0; p < M; ++p) {
+        auto t{static_cast<uint32_t>((static_cast<uint64_t>(m_slotExp[p]) * a) % M2)};
+        out[p]     = m_rootRe[t] - 1.0;
+        out[p + M] = m_rootIm[t];
+    }
+}
+
+}  // namespace lbcrypto
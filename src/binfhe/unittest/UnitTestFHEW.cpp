@@ -34,6 +34,7 @@
  */
 
 #include "binfhecontext.h"
+#include "binfhe-netlist.h"
 #include "utils/demangle.h"
 
 #include "gtest/gtest.h"
@@ -59,6 +60,8 @@ enum TEST_CASE_TYPE {
     FHEW_OR4,
     FHEW_MAJORITY,
     FHEW_CMUX,
+    FHEW_BATCH,
+    FHEW_NETLIST,
 };
 
 static std::ostream& operator<<(std::ostream& os, const TEST_CASE_TYPE& type) {
@@ -112,6 +115,12 @@ static std::ostream& operator<<(std::ostream& os, const TEST_CASE_TYPE& type) {
         case FHEW_CMUX:
             typeName = "FHEW_CMUX";
             break;
+        case FHEW_BATCH:
+            typeName = "FHEW_BATCH";
+            break;
+        case FHEW_NETLIST:
+            typeName = "FHEW_NETLIST";
+            break;
         default:
             typeName = "UNKNOWN_TESTTYPE";
             break;
@@ -165,27 +174,33 @@ static std::vector<TEST_CASE_UTGENERAL_FHEW> testCasesUTGENERAL_FHEW = {
     { FHEW_AND,  "01",   TOY,      GINX,    2,              4,        AND,   {1, 0, 0, 0} },
     { FHEW_AND,  "02",   TOY,      AP,      2,              4,        AND,   {1, 0, 0, 0} },
     { FHEW_AND,  "03",   TOY,      LMKCDEY, 2,              4,        AND,   {1, 0, 0, 0} },
+    { FHEW_AND,  "04",   TOY,      GINX_FFT, 2,             4,        AND,   {1, 0, 0, 0} },
     // ==========================================
     { FHEW_NAND, "01",   TOY,      GINX,    2,              4,        NAND,  {0, 1, 1, 1} },
     { FHEW_NAND, "02",   TOY,      AP,      2,              4,        NAND,  {0, 1, 1, 1} },
     { FHEW_NAND, "03",   TOY,      LMKCDEY, 2,              4,        NAND,  {0, 1, 1, 1} },
+    { FHEW_NAND, "04",   TOY,      GINX_FFT, 2,             4,        NAND,  {0, 1, 1, 1} },
     // ==========================================
     { FHEW_OR,   "01",   TOY,      GINX,    2,              4,        OR,    {1, 1, 1, 0} },
     { FHEW_OR,   "02",   TOY,      AP,      2,              4,        OR,    {1, 1, 1, 0} },
     { FHEW_OR,   "03",   TOY,      LMKCDEY, 2,              4,        OR,    {1, 1, 1, 0} },
+    { FHEW_OR,   "04",   TOY,      GINX_FFT, 2,             4,        OR,    {1, 1, 1, 0} },
     // ==========================================
     { FHEW_NOR,  "01",   TOY,      GINX,    2,              4,        NOR,   {0, 0, 0, 1} },
     { FHEW_NOR,  "02",   TOY,      AP,      2,              4,        NOR,   {0, 0, 0, 1} },
     { FHEW_NOR,  "03",   TOY,      LMKCDEY, 2,              4,        NOR,   {0, 0, 0, 1} },
+    { FHEW_NOR,  "04",   TOY,      GINX_FFT, 2,             4,        NOR,   {0, 0, 0, 1} },
     // ==========================================
     { FHEW_XOR,  "01",   TOY,      GINX,    2,              4,        XOR,   {0, 1, 1, 0} },
     { FHEW_XOR,  "02",   TOY,      AP,      2,              4,        XOR,   {0, 1, 1, 0} },
     { FHEW_XOR,  "03",   TOY,      LMKCDEY, 2,              4,        XOR,   {0, 1, 1, 0} },
+    { FHEW_XOR,  "04",   TOY,      GINX_FFT, 2,             4,        XOR,   {0, 1, 1, 0} },
     // ==========================================
 
     { FHEW_XNOR,  "01",  TOY,      GINX,    2,              4,        XNOR,  {1, 0, 0, 1} },
     { FHEW_XNOR,  "02",  TOY,      AP,      2,              4,        XNOR,  {1, 0, 0, 1} },
     { FHEW_XNOR,  "03",  TOY,      LMKCDEY, 2,              4,        XNOR,  {1, 0, 0, 1} },
+    { FHEW_XNOR,  "04",  TOY,      GINX_FFT, 2,             4,        XNOR,  {1, 0, 0, 1} },
     // ==========================================
     { FHEW_AND3, "01", TOY,      GINX,         3,           6,        AND3,      {0} },
     { FHEW_AND3, "02", TOY,      AP,           3,           6,        AND3,      {0} },
@@ -206,6 +221,7 @@ static std::vector<TEST_CASE_UTGENERAL_FHEW> testCasesUTGENERAL_FHEW = {
     { FHEW_MAJORITY, "01", TOY,      GINX,       3,         4,        MAJORITY,      {1} },
     { FHEW_MAJORITY, "02", TOY,      AP,         3,         4,        MAJORITY,      {1} },
     { FHEW_MAJORITY, "03", TOY,      LMKCDEY,    3,         4,        MAJORITY,      {1} },
+    { FHEW_MAJORITY, "04", TOY,      GINX_FFT,   3,         4,        MAJORITY,      {1} },
     // ==========================================
     { FHEW_CMUX, "01", TOY,      GINX,         3,           4,        CMUX,      {1, 0} },
     { FHEW_CMUX, "02", TOY,      AP,           3,           4,        CMUX,      {1, 0} },
@@ -224,6 +240,14 @@ static std::vector<TEST_CASE_UTGENERAL_FHEW> testCasesUTGENERAL_FHEW = {
     { FHEW_NOT, "01", TOY,      GINX,    2,                 4,        OR, {0, 1} },  // OR is not needed; added as a random value
     { FHEW_NOT, "02", TOY,      AP,      2,                 4,        OR, {0, 1} },  // OR is not needed; added as a random value
     { FHEW_NOT, "03", TOY,      LMKCDEY, 2,                 4,        OR, {0, 1} },  // OR is not needed; added as a random value
+    // ==========================================
+    { FHEW_BATCH, "01", TOY,    GINX,    2,                 4,        NAND,  {0, 1, 1, 1} },
+    { FHEW_BATCH, "02", TOY,    AP,      2,                 4,        NAND,  {0, 1, 1, 1} },
+    { FHEW_BATCH, "03", TOY,    LMKCDEY, 2,                 4,        XOR,   {0, 1, 1, 0} },
+    { FHEW_BATCH, "04", TOY,    GINX_FFT, 2,                4,        AND,   {1, 0, 0, 0} },
+    // ==========================================
+    { FHEW_NETLIST, "01", TOY,  GINX,    3,                 4,        MAJORITY, {} },  // MAJORITY is not needed; added as a random value
+    { FHEW_NETLIST, "02", TOY,  LMKCDEY, 3,                 4,        MAJORITY, {} },  // MAJORITY is not needed; added as a random value
 };
 // clang-format on
 //===========================================================================================================
@@ -532,6 +556,170 @@ protected:
             std::string name("EMSCRIPTEN_UNKNOWN");
 #else
             std::string name(demangle(__cxxabiv1::__cxa_current_exception_type()->name()));
+#endif
+            std::cerr << "Unknown exception of type \"" << name << "\" thrown from " << __func__ << "()" << std::endl;
+            // make it fail
+            EXPECT_TRUE(0 == 1) << failmsg;
+        }
+    }
+
+    void UnitTest_FHEW_Batch(const TEST_CASE_UTGENERAL_FHEW& testData, const std::string& failmsg = std::string()) {
+        try {
+            auto cc = BinFHEContext();
+            cc.GenerateBinFHEContext(testData.securityLevel, testData.method);
+
+            auto sk = cc.KeyGen();
+
+            // without bootstrapping keys the batches throw like the single-gate calls, before any bootstrap
+            std::vector<LWECiphertext> noKey1{cc.Encrypt(sk, 1)}, noKey2{cc.Encrypt(sk, 0)};
+            EXPECT_THROW(cc.EvalBinGateBatch({testData.gate}, noKey1, noKey2), OpenFHEException);
+            EXPECT_THROW(cc.BootstrapBatch(noKey1), OpenFHEException);
+
+            cc.BTKeyGen(sk);
+
+            // the four input combinations (1,1), (1,0), (0,1), (0,0), each repeated several times
+            const uint32_t repeats = 4;
+            const std::vector<LWEPlaintext> m1{1, 1, 0, 0};
+            const std::vector<LWEPlaintext> m2{1, 0, 1, 0};
+            std::vector<LWECiphertext> ct1s;
+            std::vector<LWECiphertext> ct2s;
+            for (uint32_t r = 0; r < repeats; ++r) {
+                for (size_t i = 0; i < m1.size(); ++i) {
+                    ct1s.push_back(cc.Encrypt(sk, m1[i]));
+                    ct2s.push_back(cc.Encrypt(sk, m2[i]));
+                }
+            }
+
+            auto ctGates     = cc.EvalBinGateBatch({testData.gate}, ct1s, ct2s);
+            auto ctBootstrap = cc.BootstrapBatch(ct1s);
+
+            std::string failed = testData.toString() + " failed";
+            ASSERT_EQ(ctGates.size(), ct1s.size()) << failed;
+            ASSERT_EQ(ctBootstrap.size(), ct1s.size()) << failed;
+            for (size_t i = 0; i < ct1s.size(); ++i) {
+                LWEPlaintext result;
+                cc.Decrypt(sk, ctGates[i], &result);
+                EXPECT_EQ(testData.results[i % m1.size()], result) << failed << " for gate " << i;
+
+                cc.Decrypt(sk, ctBootstrap[i], &result);
+                EXPECT_EQ(m1[i % m1.size()], result) << failed << " for bootstrap " << i;
+            }
+
+            // per-pair gates must match the single-gate evaluations
+            std::vector<BINGATE> gates{AND, OR, NOR, XNOR};
+            std::vector<LWECiphertext> ct1sMixed(ct1s.begin(), ct1s.begin() + gates.size());
+            std::vector<LWECiphertext> ct2sMixed(ct2s.begin(), ct2s.begin() + gates.size());
+            auto ctMixed = cc.EvalBinGateBatch(gates, ct1sMixed, ct2sMixed);
+            for (size_t i = 0; i < gates.size(); ++i) {
+                LWEPlaintext expected;
+                cc.Decrypt(sk, cc.EvalBinGate(gates[i], ct1sMixed[i], ct2sMixed[i]), &expected);
+                LWEPlaintext result;
+                cc.Decrypt(sk, ctMixed[i], &result);
+                EXPECT_EQ(expected, result) << failed << " for mixed gate " << i;
+            }
+
+            // an exception thrown while a gate is bootstrapped reaches the caller: the flat GINX accumulator
+            // rejects a ciphertext of the wrong dimension
+            if (testData.method == GINX) {
+                const auto& a = ct1s[0]->GetA();
+                NativeVector aLong(a.GetLength() + 1, a.GetModulus());
+                auto ctLong1 = std::make_shared<LWECiphertextImpl>(NativeVector(aLong), ct1s[0]->GetB());
+                auto ctLong2 = std::make_shared<LWECiphertextImpl>(std::move(aLong), ct2s[0]->GetB());
+                std::vector<LWECiphertext> ct1sLong(ct1s.begin(), ct1s.end()), ct2sLong(ct2s.begin(), ct2s.end());
+                ct1sLong.back() = ctLong1;
+                ct2sLong.back() = ctLong2;
+                EXPECT_THROW(cc.EvalBinGateBatch({testData.gate}, ct1sLong, ct2sLong), OpenFHEException) << failed;
+                EXPECT_THROW(cc.BootstrapBatch(ct1sLong), OpenFHEException) << failed;
+            }
+        }
+        catch (std::exception& e) {
+            std::cerr << "Exception thrown from " << __func__ << "(): " << e.what() << std::endl;
+            // make it fail
+            EXPECT_TRUE(0 == 1) << failmsg;
+        }
+        catch (...) {
+#if defined EMSCRIPTEN
+            std::string name("EMSCRIPTEN_UNKNOWN");
+#else
+            std::string name(demangle(__cxxabiv1::__cxa_current_exception_type()->name()));
+#endif
+            std::cerr << "Unknown exception of type \"" << name << "\" thrown from " << __func__ << "()" << std::endl;
+            // make it fail
+            EXPECT_TRUE(0 == 1) << failmsg;
+        }
+    }
+
+    void UnitTest_FHEW_Netlist(const TEST_CASE_UTGENERAL_FHEW& testData, const std::string& failmsg = std::string()) {
+        try {
+            auto cc = BinFHEContext();
+            cc.GenerateBinFHEContext(testData.securityLevel, testData.method);
+
+            auto sk = cc.KeyGen();
+            cc.BTKeyGen(sk);
+
+            // full adder plus AND(a, b) written with a constant XOR, a double negation and a negated NAND,
+            // which all fold into a single AND gate
+            std::istringstream text(
+                "# full adder\n"
+                "INPUT a b cin\n"
+                "one = CONST 1\n"
+                "t = XOR a b\n"
+                "s = XOR t cin\n"
+                "c = MAJORITY a b cin\n"
+                "na = XOR a one  # NOT a\n"
+                "nn = NOT na\n"
+                "n = NAND nn b\n"
+                "k = NOT n\n"
+                "unused = OR a b\n"
+                "OUTPUT s c k\n");
+            auto netlist = BinFHENetlist::Load(text);
+
+            std::string failed = testData.toString() + " failed";
+            ASSERT_EQ(netlist.GetNumInputs(), testData.num_of_inputs) << failed;
+            ASSERT_EQ(netlist.GetNumOutputs(), 3u) << failed;
+            EXPECT_EQ(netlist.GetNumBootstraps(), 4u) << failed;
+            EXPECT_EQ(netlist.GetDepth(), 2u) << failed;
+
+            for (uint32_t m = 0; m < 8; ++m) {
+                const LWEPlaintext a = m & 1, b = (m >> 1) & 1, cin = (m >> 2) & 1;
+                auto outputs = netlist.Evaluate(cc, {cc.Encrypt(sk, a), cc.Encrypt(sk, b), cc.Encrypt(sk, cin)});
+                ASSERT_EQ(outputs.size(), 3u) << failed;
+
+                LWEPlaintext result;
+                cc.Decrypt(sk, outputs[0], &result);
+                EXPECT_EQ(a ^ b ^ cin, result) << failed << " for sum " << m;
+                cc.Decrypt(sk, outputs[1], &result);
+                EXPECT_EQ((a + b + cin) >= 2 ? 1 : 0, result) << failed << " for carry " << m;
+                cc.Decrypt(sk, outputs[2], &result);
+                EXPECT_EQ(a & b, result) << failed << " for and " << m;
+            }
+
+            // errors raised while a level is bootstrapped reach the caller
+            if (testData.method == GINX) {
+                std::vector<LWECiphertext> longInputs;
+                for (LWEPlaintext m = 0; m < 3; ++m) {
+                    auto ct = cc.Encrypt(sk, m & 1);
+                    NativeVector aLong(ct->GetA().GetLength() + 1, ct->GetA().GetModulus());
+                    longInputs.push_back(std::make_shared<LWECiphertextImpl>(std::move(aLong), ct->GetB()));
+                }
+                EXPECT_THROW(netlist.Evaluate(cc, longInputs), OpenFHEException) << failed;
+            }
+
+            // the cached schedule is recompiled after the netlist is modified
+            netlist.AddOutput(netlist.AddGate(OR, {0, 2}));
+            EXPECT_EQ(netlist.GetNumBootstraps(), 5u) << failed;
+            EXPECT_EQ(netlist.GetDepth(), 2u) << failed;
+        }
+        catch (std::exception& e) {
+            std::cerr << "Exception thrown from " << __func__ << "(): " << e.what() << std::endl;
+            // make it fail
+            EXPECT_TRUE(0 == 1) << failmsg;
+        }
+        catch (...) {
+#if defined EMSCRIPTEN
+            std::string name("EMSCRIPTEN_UNKNOWN");
+#else
+            std::string name(demangle(__cxxabiv1::__cxa_current_exception_type()->name()));
 #endif
             std::cerr << "Unknown exception of type \"" << name << "\" thrown from " << __func__ << "()" << std::endl;
             // make it fail
@@ -573,6 +761,12 @@ TEST_P(UTGENERAL_FHEW, BINFHE) {
         case FHEW_NOT:
             UnitTest_FHEW_NOT(test, test.buildTestName());
             break;
+        case FHEW_BATCH:
+            UnitTest_FHEW_Batch(test, test.buildTestName());
+            break;
+        case FHEW_NETLIST:
+            UnitTest_FHEW_Netlist(test, test.buildTestName());
+            break;
         default:
             break;
     }
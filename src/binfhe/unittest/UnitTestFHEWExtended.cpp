@@ -151,3 +151,110 @@ TEST(UNITTestFHEWExtended, BootStrap) {
     auto ct0 = cc.Bootstrap(cc.Encrypt(pk, 0, LARGE_DIM, 4), true);
     EXPECT_EQ(Q, ct0->GetModulus());
 }
+
+// refresh keys in the nested layout (deserialized from version 1) give the same results as flat keys
+TEST(UNITTestFHEWExtended, NestedRefreshKey) {
+    auto cc = BinFHEContext();
+    cc.GenerateBinFHEContext(TOY, GINX);
+
+    auto sk = cc.KeyGen();
+    cc.BTKeyGen(sk);
+
+    const auto& flat = cc.GetRefreshKey()->GetFlatKey();
+    ASSERT_NE(nullptr, flat);
+    auto polyParams = cc.GetParams()->GetRingGSWParams()->GetPolyParams();
+    auto nested     = std::make_shared<RingGSWACCKeyImpl>(1, flat->GetNumVariants(), flat->GetNumKeys());
+    for (uint32_t i = 0; i < flat->GetNumKeys(); ++i) {
+        for (uint32_t v = 0; v < flat->GetNumVariants(); ++v) {
+            auto evk = std::make_shared<RingGSWEvalKeyImpl>(flat->GetRows(), flat->GetCols());
+            for (uint32_t r = 0; r < flat->GetRows(); ++r) {
+                for (uint32_t c = 0; c < flat->GetCols(); ++c) {
+                    NativePoly poly(polyParams, Format::EVALUATION, true);
+                    const NativeInteger* src = flat->Get(i, v, r, c);
+                    for (uint32_t k = 0; k < flat->GetPolySize(); ++k)
+                        poly[k] = src[k];
+                    (*evk)[r][c] = std::move(poly);
+                }
+            }
+            (*nested)[0][v][i] = std::move(evk);
+        }
+    }
+
+    auto ct1       = cc.Encrypt(sk, 1);
+    auto ct0       = cc.Encrypt(sk, 0);
+    auto ctFlatAND = cc.EvalBinGate(AND, ct1, ct0);
+    auto ctFlatOR  = cc.EvalBinGate(OR, ct0, ct1);
+
+    RingGSWBTKey key{nested, cc.GetSwitchKey(), cc.GetPublicKey()};
+    cc.BTKeyLoad(key);
+    ASSERT_EQ(nullptr, cc.GetRefreshKey()->GetFlatKey());
+    auto ctNestedAND = cc.EvalBinGate(AND, ct1, ct0);
+    auto ctNestedOR  = cc.EvalBinGate(OR, ct0, ct1);
+
+    EXPECT_EQ(*ctFlatAND, *ctNestedAND);
+    EXPECT_EQ(*ctFlatOR, *ctNestedOR);
+
+    LWEPlaintext result;
+    cc.Decrypt(sk, ctNestedAND, &result);
+    EXPECT_EQ(0, result);
+    cc.Decrypt(sk, ctNestedOR, &result);
+    EXPECT_EQ(1, result);
+}
+
+// switching keys in the nested layout (deserialized from version 1) give the same results as flat keys for the
+// key switching parameters (n, qKS, baseKS) of all parameter sets; the ring dimension N only sets the number of
+// input coefficients, so it is reduced to keep the keys small
+TEST(UNITTestFHEWExtended, KeySwitchFlatVsNested) {
+    constexpr uint32_t N = 64;
+    LWEEncryptionScheme scheme;
+    for (int set = TOY; set <= SIGNED_MOD_TEST; ++set) {
+        auto cc = BinFHEContext();
+        cc.GenerateBinFHEContext(static_cast<BINFHE_PARAMSET>(set), GINX);
+        const auto& lweParams = cc.GetParams()->GetLWEParams();
+
+        auto params = std::make_shared<LWECryptoParams>(lweParams->Getn(), N, lweParams->Getq(), lweParams->GetQ(),
+                                                        lweParams->GetqKS(), lweParams->GetDgg().GetStd(),
+                                                        lweParams->GetBaseKS());
+        const uint32_t n        = params->Getn();
+        const uint32_t baseKS   = params->GetBaseKS();
+        const NativeInteger qKS = params->GetqKS();
+
+        auto sk  = scheme.KeyGen(n, qKS);
+        auto skN = scheme.KeyGen(N, qKS);
+        auto K   = scheme.KeySwitchGen(params, sk, skN);
+
+        const auto& flatA = K->GetFlatA();
+        ASSERT_NE(nullptr, flatA);
+        const auto& flatB         = K->GetFlatB();
+        const uint32_t digitCount = flatA->GetNumVariants();
+        std::vector<std::vector<std::vector<NativeVector>>> keyA(
+            N, std::vector<std::vector<NativeVector>>(baseKS, std::vector<NativeVector>(digitCount)));
+        std::vector<std::vector<std::vector<NativeInteger>>> keyB(
+            N, std::vector<std::vector<NativeInteger>>(baseKS, std::vector<NativeInteger>(digitCount)));
+        for (uint32_t i = 0; i < N; ++i) {
+            for (uint32_t v = 0; v < baseKS; ++v) {
+                for (uint32_t j = 0; j < digitCount; ++j) {
+                    NativeVector row(n, qKS);
+                    const NativeInteger* src = flatA->Get(i, j, v, 0);
+                    for (uint32_t k = 0; k < n; ++k)
+                        row[k] = src[k];
+                    keyA[i][v][j] = std::move(row);
+                    keyB[i][v][j] = flatB[(i * digitCount + j) * baseKS + v];
+                }
+            }
+        }
+        auto nested = std::make_shared<LWESwitchingKeyImpl>(std::move(keyA), std::move(keyB));
+
+        std::string failed = "parameter set " + std::to_string(set) + " failed";
+        for (LWEPlaintext m = 0; m < 2; ++m) {
+            auto ct       = scheme.Encrypt(params, skN, m, 4, qKS);
+            auto ctFlat   = scheme.KeySwitch(params, K, ct);
+            auto ctNested = scheme.KeySwitch(params, nested, ct);
+            EXPECT_EQ(*ctFlat, *ctNested) << failed;
+
+            LWEPlaintext result;
+            scheme.Decrypt(params, sk, ctNested, &result, 4);
+            EXPECT_EQ(m, result) << failed;
+        }
+    }
+}
@@ -141,3 +141,8 @@ TEST(UnitTestFHEWSerialLMKCDEY, BINARY) {
     std::string msg = "UnitTestFHEWSerialGINX.BINARY serialization test failed: ";
     UnitTestFHEWSerial(SerType::BINARY, TOY, LMKCDEY, SMALL_DIM, msg);
 }
+
+TEST(UnitTestFHEWSerialGINX_FFT, BINARY) {
+    std::string msg = "UnitTestFHEWSerialGINX_FFT.BINARY serialization test failed: ";
+    UnitTestFHEWSerial(SerType::BINARY, TOY, GINX_FFT, SMALL_DIM, msg);
+}
@@ -34,6 +34,7 @@
  */
 
 #include "binfhecontext.h"
+#include "binfhe-integer.h"
 #include "gtest/gtest.h"
 
 using namespace lbcrypto;
@@ -70,6 +71,87 @@ TEST(UnitTestFHEWGINX, EvalArbFunc) {
     }
 }
 
+// Checks the evaluation of several functions with one blind rotation per bootstrapping stage
+TEST(UnitTestFHEWGINX, EvalArbFuncMulti) {
+    auto cc = BinFHEContext();
+    cc.GenerateBinFHEContext(TOY, true, 12);
+    auto sk = cc.KeyGen();
+    cc.BTKeyGen(sk);
+    int p   = cc.GetMaxPlaintextSpace().ConvertToInt();
+    auto fp = [](NativeInteger m, NativeInteger p1) -> NativeInteger {
+        if (m < p1)
+            return (m * m * m) % p1;
+        else
+            return ((m - p1 / 2) * (m - p1 / 2) * (m - p1 / 2)) % p1;
+    };
+    auto fid = [](NativeInteger m, NativeInteger p1) -> NativeInteger {
+        return m % p1;
+    };
+    std::vector<std::vector<NativeInteger>> luts{cc.GenerateLUTviaFunction(fp, p),
+                                                 cc.GenerateLUTviaFunction(fid, p)};
+
+    std::string failed = "Multi-value Function Evaluation failed";
+    for (int i = 0; i < p; i++) {
+        auto ct1 = cc.Encrypt(sk, i % p, LARGE_DIM, p);
+
+        auto cts = cc.EvalFuncMulti(ct1, luts);
+        ASSERT_EQ(cts.size(), luts.size()) << failed;
+
+        LWEPlaintext result;
+        cc.Decrypt(sk, cts[0], &result, p);
+        EXPECT_EQ(usint(fp(i, p).ConvertToInt()), result) << failed;
+        cc.Decrypt(sk, cts[1], &result, p);
+        EXPECT_EQ(usint(fid(i, p).ConvertToInt()), result) << failed;
+    }
+}
+
+// Checks the radix-decomposed integer arithmetic, including the lazy carry propagation of repeated additions
+TEST(UnitTestFHEWGINX, EvalInteger) {
+    auto cc = BinFHEContext();
+    cc.GenerateBinFHEContext(TOY, false, 12);
+    auto sk = cc.KeyGen();
+    cc.BTKeyGen(sk);
+
+    BinFHEIntegerEvaluator eval(cc, 4);
+    const LWEPlaintextModulus p = eval.GetPlaintextModulus();
+    const uint64_t a = 13, b = 6;
+    auto ct1 = eval.Encrypt(sk, a);
+    auto ct2 = eval.Encrypt(sk, b);
+
+    std::string failed = "Integer Evaluation failed";
+    EXPECT_EQ((a + b) % 16, eval.Decrypt(sk, eval.EvalAdd(ct1, ct2))) << failed;
+    EXPECT_EQ((a - b) % 16, eval.Decrypt(sk, eval.EvalSub(ct1, ct2))) << failed;
+    EXPECT_EQ((b - a) % 16, eval.Decrypt(sk, eval.EvalSub(ct2, ct1))) << failed;
+    EXPECT_EQ((a * b) % 16, eval.Decrypt(sk, eval.EvalMult(ct1, ct2))) << failed;
+    EXPECT_EQ((a << 1) % 16, eval.Decrypt(sk, eval.EvalShiftLeft(ct1, 1))) << failed;
+    EXPECT_EQ(a >> 2, eval.Decrypt(sk, eval.EvalShiftRight(ct1, 2))) << failed;
+
+    auto sum = ct1;
+    for (uint64_t i = 2; i <= 9; ++i) {
+        sum = eval.EvalAdd(sum, ct1);
+        EXPECT_EQ((i * a) % 16, eval.Decrypt(sk, sum)) << failed;
+    }
+    EXPECT_EQ((9 * a) % 16, eval.Decrypt(sk, eval.EvalCarry(sum))) << failed;
+
+    LWEPlaintext result;
+    cc.Decrypt(sk, eval.EvalLessThan(ct2, ct1), &result, p);
+    EXPECT_EQ(1, result) << failed;
+    cc.Decrypt(sk, eval.EvalLessThan(ct1, ct2), &result, p);
+    EXPECT_EQ(0, result) << failed;
+    cc.Decrypt(sk, eval.EvalEqual(ct1, eval.EvalSub(eval.EvalAdd(ct1, ct2), ct2)), &result, p);
+    EXPECT_EQ(1, result) << failed;
+
+    // an exception thrown by one of the parallel bootstraps reaches the caller: the accumulator rejects a digit
+    // of the wrong dimension, which has to be bootstrapped as its bound is the radix
+    auto digits = ct1->GetDigits();
+    auto bounds = ct1->GetBounds();
+    digits[0]   = std::make_shared<LWECiphertextImpl>(NativeVector(digits[0]->GetLength() + 1, digits[0]->GetModulus()),
+                                                      digits[0]->GetB());
+    bounds[0]   = 1u << eval.GetDigitBits();
+    auto bad    = std::make_shared<LWEIntegerImpl>(std::move(digits), std::move(bounds));
+    EXPECT_THROW(eval.EvalCarry(bad), OpenFHEException) << failed;
+}
+
 // Checks the rounding down evaluation
 TEST(UnitTestFHEWGINX, EvalFloorFunc) {
     auto cc = BinFHEContext();
@@ -929,6 +929,27 @@ public:
                                              const std::vector<std::vector<NativeInteger>>& QHatModp,
                                              const std::vector<DoubleNativeInt>& modpBarrettMu) const = 0;
 
+    /**
+   * @brief Same as ApproxSwitchCRTBasis(), but for a polynomial in either format and with the result in
+   * EVALUATION format, i.e., the modulus raising step of hybrid key switching. For power-of-two cyclotomics
+   * the inverse NTTs, the basis conversion and the NTTs of the result run as one cache-blocked pass instead of
+   * three passes over the towers; the input is left unchanged.
+   *
+   * @param &paramsQ parameters for the CRT basis {q_1,...,q_l}
+   * @param &paramsP parameters for the CRT basis {p_1,...,p_k}
+   * @param &QHatinvModq precomputed values for [(Q/q_i)^{-1}]_{q_i}
+   * @param &QHatinvModqPrecon NTL-specific precomputations
+   * @param &QHatModp precomputed values for [Q/q_i]_{p_j}
+   * @param &modpBarrettMu 128-bit Barrett reduction precomputed values
+   * @return the representation of {X + alpha*Q} in basis {P}, in EVALUATION format.
+   */
+    virtual DerivedType ApproxSwitchCRTBasisEval(const std::shared_ptr<Params>& paramsQ,
+                                                 const std::shared_ptr<Params>& paramsP,
+                                                 const std::vector<NativeInteger>& QHatInvModq,
+                                                 const std::vector<NativeInteger>& QHatInvModqPrecon,
+                                                 const std::vector<std::vector<NativeInteger>>& QHatModp,
+                                                 const std::vector<DoubleNativeInt>& modpBarrettMu) const = 0;
+
     /**
    * @brief Performs approximate modulus raising:
    * {X}_{Q} -> {X'}_{Q,P}.
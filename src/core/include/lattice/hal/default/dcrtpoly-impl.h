@@ -40,6 +40,7 @@
 
 #include "lattice/hal/default/poly-impl.h"
 #include "lattice/hal/default/dcrtpoly.h"
+#include "math/hal/intnat/basisconvnat-simd.h"
 
 #include "utils/exception.h"
 #include "utils/inttypes.h"
@@ -369,9 +370,9 @@ template <typename VecType>
 DCRTPolyImpl<VecType> DCRTPolyImpl<VecType>::Negate() const {
     DCRTPolyImpl<VecType> tmp(m_params, m_format);
     size_t size{m_vectors.size()};
-#pragma omp parallel for num_threads(OpenFHEParallelControls.GetThreadLimit(size))
-    for (size_t i = 0; i < size; ++i)
+    ParallelFor(0, size, OpenFHEParallelControls.GetThreadLimit(size), [&](size_t i) {
         tmp.m_vectors[i] = m_vectors[i].Negate();
+    });
     return tmp;
 }
 
@@ -386,18 +387,18 @@ DCRTPolyImpl<VecType> DCRTPolyImpl<VecType>::Minus(const DCRTPolyImpl& rhs) cons
         OPENFHE_THROW("tower size mismatch; cannot subtract");
     DCRTPolyImpl<VecType> tmp(m_params, m_format);
     size_t size{m_vectors.size()};
-#pragma omp parallel for num_threads(OpenFHEParallelControls.GetThreadLimit(size))
-    for (size_t i = 0; i < size; ++i)
+    ParallelFor(0, size, OpenFHEParallelControls.GetThreadLimit(size), [&](size_t i) {
         tmp.m_vectors[i] = m_vectors[i].Minus(rhs.m_vectors[i]);
+    });
     return tmp;
 }
 
 template <typename VecType>
 DCRTPolyImpl<VecType>& DCRTPolyImpl<VecType>::operator+=(const DCRTPolyImpl& rhs) {
     size_t size{m_vectors.size()};
-#pragma omp parallel for num_threads(OpenFHEParallelControls.GetThreadLimit(size))
-    for (size_t i = 0; i < size; ++i)
+    ParallelFor(0, size, OpenFHEParallelControls.GetThreadLimit(size), [&](size_t i) {
         m_vectors[i] += rhs.m_vectors[i];
+    });
     return *this;
 }
 
@@ -405,27 +406,23 @@ template <typename VecType>
 DCRTPolyImpl<VecType>& DCRTPolyImpl<VecType>::operator+=(const Integer& rhs) {
     NativeInteger val{rhs};
     size_t size{m_vectors.size()};
-#pragma omp parallel for num_threads(OpenFHEParallelControls.GetThreadLimit(size))
-    for (size_t i = 0; i < size; ++i)
-        m_vectors[i] += val;
+    ParallelFor(0, size, OpenFHEParallelControls.GetThreadLimit(size), [&](size_t i) { m_vectors[i] += val; });
     return *this;
 }
 
 template <typename VecType>
 DCRTPolyImpl<VecType>& DCRTPolyImpl<VecType>::operator+=(const NativeInteger& rhs) {
     size_t size{m_vectors.size()};
-#pragma omp parallel for num_threads(OpenFHEParallelControls.GetThreadLimit(size))
-    for (size_t i = 0; i < size; ++i)
-        m_vectors[i] += rhs;
+    ParallelFor(0, size, OpenFHEParallelControls.GetThreadLimit(size), [&](size_t i) { m_vectors[i] += rhs; });
     return *this;
 }
 
 template <typename VecType>
 DCRTPolyImpl<VecType>& DCRTPolyImpl<VecType>::operator-=(const DCRTPolyImpl& rhs) {
     size_t size{m_vectors.size()};
-#pragma omp parallel for num_threads(OpenFHEParallelControls.GetThreadLimit(size))
-    for (size_t i = 0; i < size; ++i)
+    ParallelFor(0, size, OpenFHEParallelControls.GetThreadLimit(size), [&](size_t i) {
         m_vectors[i] -= rhs.m_vectors[i];
+    });
     return *this;
 }
 
@@ -433,18 +430,14 @@ template <typename VecType>
 DCRTPolyImpl<VecType>& DCRTPolyImpl<VecType>::operator-=(const Integer& rhs) {
     NativeInteger val{rhs};
     size_t size{m_vectors.size()};
-#pragma omp parallel for num_threads(OpenFHEParallelControls.GetThreadLimit(size))
-    for (size_t i = 0; i < size; ++i)
-        m_vectors[i] -= val;
+    ParallelFor(0, size, OpenFHEParallelControls.GetThreadLimit(size), [&](size_t i) { m_vectors[i] -= val; });
     return *this;
 }
 
 template <typename VecType>
 DCRTPolyImpl<VecType>& DCRTPolyImpl<VecType>::operator-=(const NativeInteger& rhs) {
     size_t size{m_vectors.size()};
-#pragma omp parallel for num_threads(OpenFHEParallelControls.GetThreadLimit(size))
-    for (size_t i = 0; i < size; ++i)
-        m_vectors[i] -= rhs;
+    ParallelFor(0, size, OpenFHEParallelControls.GetThreadLimit(size), [&](size_t i) { m_vectors[i] -= rhs; });
     return *this;
 }
 
@@ -532,9 +525,9 @@ DCRTPolyImpl<VecType> DCRTPolyImpl<VecType>::Plus(const Integer& rhs) const {
     NativeInteger val{rhs};
     DCRTPolyImpl<VecType> tmp(m_params, m_format);
     size_t size{m_vectors.size()};
-#pragma omp parallel for num_threads(OpenFHEParallelControls.GetThreadLimit(size))
-    for (size_t i = 0; i < size; ++i)
+    ParallelFor(0, size, OpenFHEParallelControls.GetThreadLimit(size), [&](size_t i) {
         tmp.m_vectors[i] = m_vectors[i].Plus(val);
+    });
     return tmp;
 }
 
@@ -542,9 +535,9 @@ template <typename VecType>
 DCRTPolyImpl<VecType> DCRTPolyImpl<VecType>::Plus(const std::vector<Integer>& crtElement) const {
     DCRTPolyImpl<VecType> tmp(m_params, m_format);
     size_t size{m_vectors.size()};
-#pragma omp parallel for num_threads(OpenFHEParallelControls.GetThreadLimit(size))
-    for (size_t i = 0; i < size; ++i)
+    ParallelFor(0, size, OpenFHEParallelControls.GetThreadLimit(size), [&](size_t i) {
         tmp.m_vectors[i] = m_vectors[i].Plus(NativeInteger(crtElement[i]));
+    });
     return tmp;
 }
 
@@ -553,9 +546,9 @@ DCRTPolyImpl<VecType> DCRTPolyImpl<VecType>::Minus(const Integer& rhs) const {
     NativeInteger val{rhs};
     DCRTPolyImpl<VecType> tmp(m_params, m_format);
     size_t size{m_vectors.size()};
-#pragma omp parallel for num_threads(OpenFHEParallelControls.GetThreadLimit(size))
-    for (size_t i = 0; i < size; ++i)
+    ParallelFor(0, size, OpenFHEParallelControls.GetThreadLimit(size), [&](size_t i) {
         tmp.m_vectors[i] = m_vectors[i].Minus(val);
+    });
     return tmp;
 }
 
@@ -563,9 +556,9 @@ template <typename VecType>
 DCRTPolyImpl<VecType> DCRTPolyImpl<VecType>::Minus(const std::vector<Integer>& crtElement) const {
     DCRTPolyImpl<VecType> tmp(m_params, m_format);
     size_t size{m_vectors.size()};
-#pragma omp parallel for num_threads(OpenFHEParallelControls.GetThreadLimit(size))
-    for (size_t i = 0; i < size; ++i)
+    ParallelFor(0, size, OpenFHEParallelControls.GetThreadLimit(size), [&](size_t i) {
         tmp.m_vectors[i] = m_vectors[i].Minus(NativeInteger(crtElement[i]));
+    });
     return tmp;
 }
 
@@ -574,9 +567,9 @@ DCRTPolyImpl<VecType> DCRTPolyImpl<VecType>::Times(const Integer& rhs) const {
     NativeInteger val{rhs};
     DCRTPolyImpl<VecType> tmp(m_params, m_format);
     size_t size{m_vectors.size()};
-#pragma omp parallel for num_threads(OpenFHEParallelControls.GetThreadLimit(size))
-    for (size_t i = 0; i < size; ++i)
+    ParallelFor(0, size, OpenFHEParallelControls.GetThreadLimit(size), [&](size_t i) {
         tmp.m_vectors[i] = m_vectors[i].Times(val);
+    });
     return tmp;
 }
 
@@ -584,9 +577,9 @@ template <typename VecType>
 DCRTPolyImpl<VecType> DCRTPolyImpl<VecType>::Times(NativeInteger::SignedNativeInt rhs) const {
     DCRTPolyImpl<VecType> tmp(m_params, m_format);
     size_t size{m_vectors.size()};
-#pragma omp parallel for num_threads(OpenFHEParallelControls.GetThreadLimit(size))
-    for (size_t i = 0; i < size; ++i)
+    ParallelFor(0, size, OpenFHEParallelControls.GetThreadLimit(size), [&](size_t i) {
         tmp.m_vectors[i] = m_vectors[i].Times(rhs);
+    });
     return tmp;
 }
 
@@ -594,9 +587,9 @@ template <typename VecType>
 DCRTPolyImpl<VecType> DCRTPolyImpl<VecType>::Times(const std::vector<Integer>& crtElement) const {
     DCRTPolyImpl<VecType> tmp(m_params, m_format);
     size_t size{m_vectors.size()};
-#pragma omp parallel for num_threads(OpenFHEParallelControls.GetThreadLimit(size))
-    for (size_t i = 0; i < size; ++i)
+    ParallelFor(0, size, OpenFHEParallelControls.GetThreadLimit(size), [&](size_t i) {
         tmp.m_vectors[i] = m_vectors[i].Times(NativeInteger(crtElement[i]));
+    });
     return tmp;
 }
 
@@ -606,9 +599,9 @@ DCRTPolyImpl<VecType> DCRTPolyImpl<VecType>::Times(const std::vector<NativeInteg
         OPENFHE_THROW("tower size mismatch; cannot multiply");
     DCRTPolyImpl<VecType> tmp(m_params, m_format);
     size_t size{m_vectors.size()};
-#pragma omp parallel for num_threads(OpenFHEParallelControls.GetThreadLimit(size))
-    for (size_t i = 0; i < size; ++i)
+    ParallelFor(0, size, OpenFHEParallelControls.GetThreadLimit(size), [&](size_t i) {
         tmp.m_vectors[i] = m_vectors[i].Times(rhs[i]);
+    });
     return tmp;
 }
 
@@ -616,9 +609,9 @@ template <typename VecType>
 DCRTPolyImpl<VecType> DCRTPolyImpl<VecType>::TimesNoCheck(const std::vector<NativeInteger>& rhs) const {
     size_t vecSize = m_vectors.size() < rhs.size() ? m_vectors.size() : rhs.size();
     DCRTPolyImpl<VecType> tmp(m_params, m_format);
-#pragma omp parallel for num_threads(OpenFHEParallelControls.GetThreadLimit(vecSize))
-    for (size_t i = 0; i < vecSize; ++i)
+    ParallelFor(0, vecSize, OpenFHEParallelControls.GetThreadLimit(vecSize), [&](size_t i) {
         tmp.m_vectors[i] = m_vectors[i].Times(rhs[i]);
+    });
     return tmp;
 }
 
@@ -626,18 +619,14 @@ template <typename VecType>
 DCRTPolyImpl<VecType>& DCRTPolyImpl<VecType>::operator*=(const Integer& rhs) {
     NativeInteger val{rhs};
     size_t size{m_vectors.size()};
-#pragma omp parallel for num_threads(OpenFHEParallelControls.GetThreadLimit(size))
-    for (size_t i = 0; i < size; ++i)
-        m_vectors[i] *= val;
+    ParallelFor(0, size, OpenFHEParallelControls.GetThreadLimit(size), [&](size_t i) { m_vectors[i] *= val; });
     return *this;
 }
 
 template <typename VecType>
 DCRTPolyImpl<VecType>& DCRTPolyImpl<VecType>::operator*=(const NativeInteger& rhs) {
     size_t size{m_vectors.size()};
-#pragma omp parallel for num_threads(OpenFHEParallelControls.GetThreadLimit(size))
-    for (size_t i = 0; i < size; ++i)
-        m_vectors[i] *= rhs;
+    ParallelFor(0, size, OpenFHEParallelControls.GetThreadLimit(size), [&](size_t i) { m_vectors[i] *= rhs; });
     return *this;
 }
 
@@ -719,8 +708,7 @@ void DCRTPolyImpl<VecType>::DropLastElementAndScale(const std::vector<NativeInte
     this->DropLastElement();
     size_t size{m_vectors.size()};
 
-#pragma omp parallel for num_threads(OpenFHEParallelControls.GetThreadLimit(size))
-    for (size_t i = 0; i < size; ++i) {
+    ParallelFor(0, size, OpenFHEParallelControls.GetThreadLimit(size), [&](size_t i) {
         auto tmp = lastPoly;
         tmp.SwitchModulus(m_vectors[i].GetModulus(), m_vectors[i].GetRootOfUnity(), 0, 0);
         tmp *= QlQlInvModqlDivqlModq[i];
@@ -730,7 +718,7 @@ void DCRTPolyImpl<VecType>::DropLastElementAndScale(const std::vector<NativeInte
         m_vectors[i] += tmp;
         if (m_format == Format::COEFFICIENT)
             m_vectors[i].SwitchFormat();
-    }
+    });
 }
 
 /**
@@ -765,15 +753,14 @@ void DCRTPolyImpl<VecType>::ModReduce(const NativeInteger& t, const std::vector<
     this->DropLastElement();
     size_t size{m_vectors.size()};
 
-#pragma omp parallel for num_threads(OpenFHEParallelControls.GetThreadLimit(size))
-    for (size_t i = 0; i < size; ++i) {
+    ParallelFor(0, size, OpenFHEParallelControls.GetThreadLimit(size), [&](size_t i) {
         auto tmp{delta};
         tmp.SwitchModulus(m_vectors[i].GetModulus(), m_vectors[i].GetRootOfUnity(), 0, 0);
         if (m_format == Format::EVALUATION)
             tmp.SwitchFormat();
         m_vectors[i] += (tmp *= t);
         m_vectors[i] *= qlInvModq[i];
-    }
+    });
 }
 
 /*
@@ -915,25 +902,19 @@ DCRTPolyImpl<VecType> DCRTPolyImpl<VecType>::ApproxSwitchCRTBasis(
     uint32_t sizeQ = (m_vectors.size() > paramsQ->GetParams().size()) ? paramsQ->GetParams().size() : m_vectors.size();
     uint32_t sizeP = ans.m_vectors.size();
 #if defined(HAVE_INT128) && NATIVEINT == 64
+    std::vector<const NativeVector*> x(sizeQ);
+    for (uint32_t i = 0; i < sizeQ; ++i)
+        x[i] = m_vectors[i].m_values.get();
+    std::vector<NativeVector*> y(sizeP);
+    for (uint32_t j = 0; j < sizeP; ++j)
+        y[j] = ans.m_vectors[j].m_values.get();
+
+    const ApproxSwitchCRTBasisPlan plan(std::move(x), std::move(y), QHatInvModq, QHatInvModqPrecon, QHatModp,
+                                        modpBarrettMu);
+
     uint32_t ringDim = m_params->GetRingDimension();
-    std::vector<DoubleNativeInt> sum(sizeP);
-    #pragma omp parallel for firstprivate(sum) num_threads(OpenFHEParallelControls.GetThreadLimit(8))
-    for (uint32_t ri = 0; ri < ringDim; ++ri) {
-        std::fill(sum.begin(), sum.end(), 0);
-        for (uint32_t i = 0; i < sizeQ; ++i) {
-            const auto& qi        = m_vectors[i].GetModulus();
-            const auto& xi        = m_vectors[i][ri];
-            const auto& QHatModpi = QHatModp[i];
-            const auto xQHatInvModqi =
-                xi.ModMulFastConst(QHatInvModq[i], qi, QHatInvModqPrecon[i]).template ConvertToInt<uint64_t>();
-            for (uint32_t j = 0; j < sizeP; ++j)
-                sum[j] += Mul128(xQHatInvModqi, QHatModpi[j].ConvertToInt<uint64_t>());
-        }
-        for (uint32_t j = 0; j < sizeP; ++j) {
-            const auto& pj       = ans.m_vectors[j].GetModulus();
-            ans.m_vectors[j][ri] = BarrettUint128ModUint64(sum[j], pj.ConvertToInt(), modpBarrettMu[j]);
-        }
-    }
+    ParallelForRange(0, ringDim, OpenFHEParallelControls.GetThreadLimit(8),
+                     [&](size_t first, size_t last) { ApproxSwitchCRTBasisRange(plan, first, last); });
 #else
     for (uint32_t i = 0; i < sizeQ; ++i) {
         auto xQHatInvModqi = m_vectors[i] * QHatInvModq[i];
@@ -947,6 +928,156 @@ DCRTPolyImpl<VecType> DCRTPolyImpl<VecType>::ApproxSwitchCRTBasis(
     return ans;
 }
 
+template <typename VecType>
+DCRTPolyImpl<VecType> DCRTPolyImpl<VecType>::ApproxSwitchCRTBasisEval(
+    const std::shared_ptr<Params>& paramsQ, const std::shared_ptr<Params>& paramsP,
+    const std::vector<NativeInteger>& QHatInvModq, const std::vector<NativeInteger>& QHatInvModqPrecon,
+    const std::vector<std::vector<NativeInteger>>& QHatModp, const std::vector<DoubleNativeInt>& modpBarrettMu) const {
+#if defined(HAVE_INT128) && NATIVEINT == 64
+    if (m_format == Format::EVALUATION) {
+        DCRTPolyImpl<VecType> ans(paramsP, Format::EVALUATION, true);
+        uint32_t sizeQ = std::min(m_vectors.size(), paramsQ->GetParams().size());
+        if (ApproxSwitchCRTBasisFused(0, sizeQ, ans, QHatInvModq, QHatInvModqPrecon, QHatModp, modpBarrettMu))
+            return ans;
+    }
+#endif
+    if (m_format == Format::COEFFICIENT) {
+        auto ans = ApproxSwitchCRTBasis(paramsQ, paramsP, QHatInvModq, QHatInvModqPrecon, QHatModp, modpBarrettMu);
+        ans.SetFormat(Format::EVALUATION);
+        return ans;
+    }
+    auto coef = this->Clone();
+    coef.SetFormat(Format::COEFFICIENT);
+    auto ans = coef.ApproxSwitchCRTBasis(paramsQ, paramsP, QHatInvModq, QHatInvModqPrecon, QHatModp, modpBarrettMu);
+    ans.SetFormat(Format::EVALUATION);
+    return ans;
+}
+
+#if defined(HAVE_INT128) && NATIVEINT == 64
+template <typename VecType>
+DCRTPolyImpl<VecType>::ApproxSwitchCRTBasisPlan::ApproxSwitchCRTBasisPlan(
+    std::vector<const NativeVector*> x, std::vector<NativeVector*> ans, const std::vector<NativeInteger>& QHatInvModq,
+    const std::vector<NativeInteger>& QHatInvModqPrecon, const std::vector<std::vector<NativeInteger>>& QHatModp,
+    const std::vector<DoubleNativeInt>& modpBarrettMu)
+    : x(std::move(x)),
+      ans(std::move(ans)),
+      QHatInvModq(QHatInvModq),
+      QHatInvModqPrecon(QHatInvModqPrecon),
+      modpBarrettMu(modpBarrettMu) {
+    const uint32_t sizeQ = this->x.size();
+    const uint32_t sizeP = this->ans.size();
+    moduliQ.resize(sizeQ);
+    moduliP.resize(sizeP);
+    QHatModpT.resize(sizeP * sizeQ);
+    for (uint32_t i = 0; i < sizeQ; ++i)
+        moduliQ[i] = this->x[i]->GetModulus().template ConvertToInt<uint64_t>();
+    for (uint32_t j = 0; j < sizeP; ++j) {
+        moduliP[j] = this->ans[j]->GetModulus().template ConvertToInt<uint64_t>();
+        for (uint32_t i = 0; i < sizeQ; ++i)
+            QHatModpT[j * sizeQ + i] = QHatModp[i][j].ConvertToInt<uint64_t>();
+    }
+    kernel = intnat::SelectFastBaseConvKernel(moduliQ.data(), sizeQ, moduliP.data(), sizeP);
+}
+
+template <typename VecType>
+void DCRTPolyImpl<VecType>::ApproxSwitchCRTBasisRange(const ApproxSwitchCRTBasisPlan& plan, uint32_t first,
+                                                      uint32_t last) {
+    // coefficients are processed in small blocks, so that the inner loops run over contiguous coefficients and
+    // the scaled inputs [x_i * QHatInvModq_i]_{q_i} of a block stay in L1
+    constexpr uint32_t BLOCK{64};
+    const uint32_t sizeQ = plan.x.size();
+    const uint32_t sizeP = plan.ans.size();
+    DoubleNativeInt sum[BLOCK];
+
+    // scaled inputs of a block and the rows of the vectorized inner products, kept per thread across calls
+    thread_local std::vector<uint64_t> xQHatInvModq;
+    thread_local std::vector<const uint64_t*> in;
+    thread_local std::vector<uint64_t*> out;
+    if (xQHatInvModq.size() < sizeQ * BLOCK)
+        xQHatInvModq.resize(sizeQ * BLOCK);
+    in.resize(sizeQ);
+    out.resize(sizeP);
+    for (uint32_t i = 0; i < sizeQ; ++i)
+        in[i] = &xQHatInvModq[i * BLOCK];
+    const auto* modpBarrettMuWords = reinterpret_cast<const uint64_t*>(plan.modpBarrettMu.data());
+
+    for (uint32_t b = first; b < last; b += BLOCK) {
+        const uint32_t len = std::min(BLOCK, last - b);
+        for (uint32_t i = 0; i < sizeQ; ++i) {
+            const auto& qi           = plan.x[i]->GetModulus();
+            const auto& xi           = *plan.x[i];
+            const auto& QHatInvModqi = plan.QHatInvModq[i];
+            const auto& precon       = plan.QHatInvModqPrecon[i];
+            uint64_t* yi             = &xQHatInvModq[i * BLOCK];
+            for (uint32_t k = 0; k < len; ++k)
+                yi[k] = xi[b + k].ModMulFastConst(QHatInvModqi, qi, precon).template ConvertToInt<uint64_t>();
+        }
+        for (uint32_t j = 0; j < sizeP; ++j)
+            out[j] = reinterpret_cast<uint64_t*>(&(*plan.ans[j])[b]);
+        if (intnat::FastBaseConvSIMD(plan.kernel, in.data(), sizeQ, plan.QHatModpT.data(), plan.moduliP.data(),
+                                     modpBarrettMuWords, out.data(), sizeP, len))
+            continue;
+        for (uint32_t j = 0; j < sizeP; ++j) {
+            const uint64_t* QHatModpj = &plan.QHatModpT[j * sizeQ];
+            std::fill(sum, sum + len, 0);
+            for (uint32_t i = 0; i < sizeQ; ++i) {
+                const uint64_t* yi = &xQHatInvModq[i * BLOCK];
+                for (uint32_t k = 0; k < len; ++k)
+                    sum[k] += Mul128(yi[k], QHatModpj[i]);
+            }
+            auto& ansj = *plan.ans[j];
+            for (uint32_t k = 0; k < len; ++k)
+                ansj[b + k] = BarrettUint128ModUint64(sum[k], plan.moduliP[j], plan.modpBarrettMu[j]);
+        }
+    }
+}
+
+template <typename VecType>
+bool DCRTPolyImpl<VecType>::ApproxSwitchCRTBasisFused(uint32_t begin, uint32_t size, DCRTPolyType& ans,
+                                                      const std::vector<NativeInteger>& QHatInvModq,
+                                                      const std::vector<NativeInteger>& QHatInvModqPrecon,
+                                                      const std::vector<std::vector<NativeInteger>>& QHatModp,
+                                                      const std::vector<DoubleNativeInt>& modpBarrettMu) const {
+    const uint32_t ringDim = m_params->GetRingDimension();
+    if (size == 0 || ringDim != (m_params->GetCyclotomicOrder() >> 1))
+        return false;
+
+    std::vector<const NTTTables<NativeInteger>*> inTables(size);
+    std::vector<const NativeVector*> in(size);
+    for (uint32_t i = 0; i < size; ++i) {
+        const auto& tower = m_vectors[begin + i];
+        if (!tower.m_values)
+            OPENFHE_THROW("Poly switch format to empty values");
+        if ((inTables[i] = GetTowerNTTTables(tower)) == nullptr)
+            return false;
+        in[i] = tower.m_values.get();
+    }
+    const uint32_t sizeP = ans.m_vectors.size();
+    std::vector<const NTTTables<NativeInteger>*> outTables(sizeP);
+    std::vector<NativeVector*> out(sizeP);
+    for (uint32_t j = 0; j < sizeP; ++j) {
+        if ((outTables[j] = GetTowerNTTTables(ans.m_vectors[j])) == nullptr)
+            return false;
+        out[j] = ans.m_vectors[j].m_values.get();
+    }
+
+    std::vector<NativeVector> work;
+    work.reserve(size);
+    for (uint32_t i = 0; i < size; ++i)
+        work.emplace_back(ringDim, in[i]->GetModulus());
+    std::vector<NativeVector*> workPtrs(size);
+    std::vector<const NativeVector*> x(size);
+    for (uint32_t i = 0; i < size; ++i)
+        x[i] = workPtrs[i] = &work[i];
+    const ApproxSwitchCRTBasisPlan plan(std::move(x), out, QHatInvModq, QHatInvModqPrecon, QHatModp, modpBarrettMu);
+
+    ChineseRemainderTransformFTT<NativeVector>().InverseTransformMapForward(
+        inTables, in, workPtrs, outTables, out,
+        [&](uint32_t first, uint32_t last) { ApproxSwitchCRTBasisRange(plan, first, last); });
+    return true;
+}
+#endif
+
 template <typename VecType>
 void DCRTPolyImpl<VecType>::ApproxModUp(const std::shared_ptr<Params>& paramsQ, const std::shared_ptr<Params>& paramsP,
                                         const std::shared_ptr<Params>& paramsQP,
@@ -954,28 +1085,27 @@ void DCRTPolyImpl<VecType>::ApproxModUp(const std::shared_ptr<Params>& paramsQ,
                                         const std::vector<NativeInteger>& QHatInvModqPrecon,
                                         const std::vector<std::vector<NativeInteger>>& QHatModp,
                                         const std::vector<DoubleNativeInt>& modpBarrettMu) {
-    // if input polynomial in evaluation representation, store for later use to reduce number of NTTs
-    std::vector<DCRTPolyImpl::PolyType> polyInNTT;
+    size_t sizeQP = paramsQP->GetParams().size();
+
+    // input in evaluation representation: the towers of P are computed by the fused kernel (if possible) and the
+    // towers of Q are kept as they are
     if (m_format == Format::EVALUATION) {
-        polyInNTT = m_vectors;
-        this->SetFormat(Format::COEFFICIENT);
+        auto partP =
+            ApproxSwitchCRTBasisEval(paramsQ, paramsP, QHatInvModq, QHatInvModqPrecon, QHatModp, modpBarrettMu);
+        m_vectors.reserve(sizeQP);
+        m_vectors.insert(m_vectors.end(), std::make_move_iterator(partP.m_vectors.begin()),
+                         std::make_move_iterator(partP.m_vectors.end()));
+        m_params = paramsQP;
+        return;
     }
 
     auto partP = ApproxSwitchCRTBasis(paramsQ, paramsP, QHatInvModq, QHatInvModqPrecon, QHatModp, modpBarrettMu);
 
-    if (polyInNTT.size() > 0)
-        m_vectors = std::move(polyInNTT);
-
-    size_t sizeQP = paramsQP->GetParams().size();
     m_vectors.reserve(sizeQP);
     m_vectors.insert(m_vectors.end(), std::make_move_iterator(partP.m_vectors.begin()),
                      std::make_move_iterator(partP.m_vectors.end()));
-
-#pragma omp parallel for num_threads(OpenFHEParallelControls.GetThreadLimit(sizeQP))
-    for (size_t i = 0; i < sizeQP; ++i)
-        m_vectors[i].SetFormat(Format::EVALUATION);
-    m_format = Format::EVALUATION;
     m_params = paramsQP;
+    this->SetFormat(Format::EVALUATION);
 }
 
 template <typename VecType>
@@ -986,18 +1116,57 @@ DCRTPolyImpl<VecType> DCRTPolyImpl<VecType>::ApproxModDown(
     const std::vector<std::vector<NativeInteger>>& PHatModq, const std::vector<DoubleNativeInt>& modqBarrettMu,
     const std::vector<NativeInteger>& tInvModp, const std::vector<NativeInteger>& tInvModpPrecon,
     const NativeInteger& t, const std::vector<NativeInteger>& tModqPrecon) const {
-    DCRTPolyImpl<VecType> partP(paramsP, m_format, true);
     size_t sizeP = paramsP->GetParams().size();
     size_t sizeQ = m_vectors.size() - sizeP;
+    uint32_t diffQ = paramsQ->GetParams().size() - sizeQ;
+
+#if defined(HAVE_INT128) && NATIVEINT == 64
+    if (m_format == Format::EVALUATION) {
+        // the multiplications by -t^(-1) mod P and t mod Q (BGVrns only) are folded into the constants of the
+        // basis conversion, so that the fused kernel computes [X' * t]_{Q} from the towers of P in one pass
+        const std::vector<NativeInteger>* PHatInvModpScaled       = &PHatInvModp;
+        const std::vector<NativeInteger>* PHatInvModpScaledPrecon = &PHatInvModpPrecon;
+        const std::vector<std::vector<NativeInteger>>* PHatModqScaled = &PHatModq;
+        std::vector<NativeInteger> tPHatInvModp, tPHatInvModpPrecon;
+        std::vector<std::vector<NativeInteger>> tPHatModq;
+        if (t > 0) {
+            tPHatInvModp.resize(sizeP);
+            tPHatInvModpPrecon.resize(sizeP);
+            tPHatModq.resize(sizeP, std::vector<NativeInteger>(sizeQ));
+            for (size_t j = 0; j < sizeP; ++j) {
+                const auto& pj        = m_vectors[sizeQ + j].GetModulus();
+                tPHatInvModp[j]       = PHatInvModp[j].ModMulFastConst(tInvModp[j], pj, tInvModpPrecon[j]);
+                tPHatInvModpPrecon[j] = tPHatInvModp[j].PrepModMulConst(pj);
+                for (size_t i = 0; i < sizeQ; ++i)
+                    tPHatModq[j][i] = PHatModq[j][i].ModMul(t, m_vectors[i].GetModulus());
+            }
+            PHatInvModpScaled       = &tPHatInvModp;
+            PHatInvModpScaledPrecon = &tPHatInvModpPrecon;
+            PHatModqScaled          = &tPHatModq;
+        }
 
-#pragma omp parallel for num_threads(OpenFHEParallelControls.GetThreadLimit(sizeP))
-    for (size_t j = 0; j < sizeP; ++j) {
+        DCRTPolyImpl<VecType> partPSwitchedToQ(paramsQ, Format::EVALUATION, true);
+        if (diffQ > 0)
+            partPSwitchedToQ.DropLastElements(diffQ);
+        if (ApproxSwitchCRTBasisFused(sizeQ, sizeP, partPSwitchedToQ, *PHatInvModpScaled, *PHatInvModpScaledPrecon,
+                                      *PHatModqScaled, modqBarrettMu)) {
+            ParallelFor(0, sizeQ, OpenFHEParallelControls.GetThreadLimit(sizeQ), [&](size_t i) {
+                auto& yi = partPSwitchedToQ.m_vectors[i];
+                yi       = (m_vectors[i] - yi) * PInvModq[i];
+            });
+            return partPSwitchedToQ;
+        }
+    }
+#endif
+
+    DCRTPolyImpl<VecType> partP(paramsP, m_format, true);
+    ParallelFor(0, sizeP, OpenFHEParallelControls.GetThreadLimit(sizeP), [&](size_t j) {
         partP.m_vectors[j] = m_vectors[sizeQ + j];
         partP.m_vectors[j].SetFormat(Format::COEFFICIENT);
         // Multiply everything by -t^(-1) mod P (BGVrns only)
         if (t > 0)
             partP.m_vectors[j] *= tInvModp[j];
-    }
+    });
     partP.OverrideFormat(Format::COEFFICIENT);
 
     auto partPSwitchedToQ =
@@ -1005,18 +1174,16 @@ DCRTPolyImpl<VecType> DCRTPolyImpl<VecType>::ApproxModDown(
 
     // Combine the switched DCRTPoly with the Q part of this to get the result
     DCRTPolyImpl<VecType> ans(paramsQ, Format::EVALUATION, true);
-    uint32_t diffQ = paramsQ->GetParams().size() - sizeQ;
     if (diffQ > 0)
         ans.DropLastElements(diffQ);
 
-#pragma omp parallel for num_threads(OpenFHEParallelControls.GetThreadLimit(sizeQ))
-    for (size_t i = 0; i < sizeQ; ++i) {
+    ParallelFor(0, sizeQ, OpenFHEParallelControls.GetThreadLimit(sizeQ), [&](size_t i) {
         // Multiply everything by t mod Q (BGVrns only)
         if (t > 0)
             partPSwitchedToQ.m_vectors[i] *= t;
         partPSwitchedToQ.m_vectors[i].SetFormat(Format::EVALUATION);
         ans.m_vectors[i] = (m_vectors[i] - partPSwitchedToQ.m_vectors[i]) * PInvModq[i];
-    }
+    });
     return ans;
 }
 
@@ -1123,9 +1290,9 @@ void DCRTPolyImpl<VecType>::ExpandCRTBasis(
     m_vectors.insert(m_vectors.end(), std::make_move_iterator(partP.m_vectors.begin()),
                      std::make_move_iterator(partP.m_vectors.end()));
 
-#pragma omp parallel for num_threads(OpenFHEParallelControls.GetThreadLimit(sizeQP))
-    for (size_t i = 0; i < sizeQP; ++i)
+    ParallelFor(0, sizeQP, OpenFHEParallelControls.GetThreadLimit(sizeQP), [&](size_t i) {
         m_vectors[i].SetFormat(resultFormat);
+    });
     m_format = resultFormat;
     m_params = paramsQP;
 }
@@ -1154,9 +1321,9 @@ void DCRTPolyImpl<VecType>::ExpandCRTBasisReverseOrder(
                            std::make_move_iterator(m_vectors.end()));
     m_vectors = std::move(partP.m_vectors);
 
-#pragma omp parallel for num_threads(OpenFHEParallelControls.GetThreadLimit(sizeQP))
-    for (size_t i = 0; i < sizeQP; ++i)
+    ParallelFor(0, sizeQP, OpenFHEParallelControls.GetThreadLimit(sizeQP), [&](size_t i) {
         m_vectors[i].SetFormat(resultFormat);
+    });
     m_format = resultFormat;
     m_params = paramsQP;
 }
@@ -1794,6 +1961,23 @@ void DCRTPolyImpl<VecType>::FastBaseConvqToBskMontgomery(
         result_mtilde[k] &= mtilde_minus_1;
     }
 
+#if defined(HAVE_INT128) && NATIVEINT == 64
+    // operands of the vectorized inner products
+    std::vector<const uint64_t*> ximtildeQHatModqiRows(numQ);
+    std::vector<uint64_t> moduliQWords(numQ), moduliBskWords(numBsk), QHatModbskT(numBsk * numQ);
+    for (uint32_t i = 0; i < numQ; ++i) {
+        ximtildeQHatModqiRows[i] = reinterpret_cast<const uint64_t*>(&ximtildeQHatModqi[i * n]);
+        moduliQWords[i]          = moduliQ[i].ConvertToInt<uint64_t>();
+    }
+    for (uint32_t j = 0; j < numBsk; ++j) {
+        moduliBskWords[j] = moduliBsk[j].ConvertToInt<uint64_t>();
+        for (uint32_t i = 0; i < numQ; ++i)
+            QHatModbskT[j * numQ + i] = QHatModbsk[i][j].ConvertToInt<uint64_t>();
+    }
+    const auto* modbskBarrettMuWords = reinterpret_cast<const uint64_t*>(modbskBarrettMu.data());
+    const auto kernel = intnat::SelectFastBaseConvKernel(moduliQWords.data(), numQ, moduliBskWords.data(), numBsk);
+#endif
+
 #pragma omp parallel for num_threads(OpenFHEParallelControls.GetThreadLimit(numBsk))
     for (uint32_t j = 0; j < numBsk; ++j) {
         const auto& moduliBskj             = moduliBsk[j];
@@ -1801,13 +1985,22 @@ void DCRTPolyImpl<VecType>::FastBaseConvqToBskMontgomery(
         const auto& mtildeInvModbskPreconj = mtildeInvModbskPrecon[j];
         const auto& qModBskj               = QModbsk[j];
         const auto& qModBskjPrecon         = QModbskPrecon[j];
+#if defined(HAVE_INT128) && NATIVEINT == 64
+        // vectorized inner products for all coefficients, if a SIMD kernel applies
+        uint64_t* bskj = reinterpret_cast<uint64_t*>(&m_vectors[numQ + j][0]);
+        const bool simd = intnat::FastBaseConvSIMD(kernel, ximtildeQHatModqiRows.data(), numQ, &QHatModbskT[j * numQ],
+                                                   &moduliBskWords[j], modbskBarrettMuWords + 2 * j, &bskj, 1, n);
+#endif
         for (uint32_t k = 0; k < n; ++k) {
 #if defined(HAVE_INT128) && NATIVEINT == 64
-            DoubleNativeInt result = 0;
-            for (uint32_t i = 0; i < numQ; ++i)
-                result += Mul128(ximtildeQHatModqi[i * n + k].ConvertToInt<uint64_t>(),
-                                 QHatModbsk[i][j].ConvertToInt<uint64_t>());
-            m_vectors[numQ + j][k] = BarrettUint128ModUint64(result, moduliBskj.ConvertToInt(), modbskBarrettMu[j]);
+            if (!simd) {
+                DoubleNativeInt result = 0;
+                for (uint32_t i = 0; i < numQ; ++i)
+                    result += Mul128(ximtildeQHatModqi[i * n + k].ConvertToInt<uint64_t>(),
+                                     QHatModbsk[i][j].ConvertToInt<uint64_t>());
+                m_vectors[numQ + j][k] =
+                    BarrettUint128ModUint64(result, moduliBskj.ConvertToInt(), modbskBarrettMu[j]);
+            }
 #else
             for (uint32_t i = 0; i < numQ; ++i)
                 m_vectors[numQ + j][k].ModAddFastEq(
@@ -1936,19 +2129,44 @@ void DCRTPolyImpl<VecType>::FastBaseConvSK(
         alphaskxVector[k].ModMulFastConstEq(BInvModmsk, moduliBsk[sizeBskm1], BInvModmskPrecon);
     }
 
+#if defined(HAVE_INT128) && NATIVEINT == 64
+    // operands of the vectorized inner products (the msk residue is excluded)
+    std::vector<const uint64_t*> bskRows(sizeBskm1);
+    std::vector<uint64_t> moduliBskWords(sizeBskm1), moduliQWords(sizeQ), BHatModqT(sizeQ * sizeBskm1);
+    for (uint32_t i = 0; i < sizeBskm1; ++i) {
+        bskRows[i]        = reinterpret_cast<const uint64_t*>(&m_vectors[sizeQ + i][0]);
+        moduliBskWords[i] = moduliBsk[i].ConvertToInt<uint64_t>();
+    }
+    for (uint32_t j = 0; j < sizeQ; ++j) {
+        moduliQWords[j] = moduliQ[j].ConvertToInt<uint64_t>();
+        for (uint32_t i = 0; i < sizeBskm1; ++i)
+            BHatModqT[j * sizeBskm1 + i] = BHatModq[i][j].ConvertToInt<uint64_t>();
+    }
+    const auto* modqBarrettMuWords = reinterpret_cast<const uint64_t*>(modqBarrettMu.data());
+    const auto kernel = intnat::SelectFastBaseConvKernel(moduliBskWords.data(), sizeBskm1, moduliQWords.data(), sizeQ);
+#endif
+
 #pragma omp parallel for num_threads(OpenFHEParallelControls.GetThreadLimit(sizeQ))
     for (uint32_t j = 0; j < sizeQ; ++j) {
         const auto& moduliQj     = moduliQ[j];
         const auto& bModqj       = BModq[j];
         const auto& bModqjPrecon = BModqPrecon[j];
+#if defined(HAVE_INT128) && NATIVEINT == 64
+        // vectorized inner products for all coefficients, if a SIMD kernel applies
+        uint64_t* qj = reinterpret_cast<uint64_t*>(&m_vectors[j][0]);
+        const bool simd = intnat::FastBaseConvSIMD(kernel, bskRows.data(), sizeBskm1, &BHatModqT[j * sizeBskm1],
+                                                   &moduliQWords[j], modqBarrettMuWords + 2 * j, &qj, 1, n);
+#endif
         for (uint32_t k = 0; k < n; ++k) {
 #if defined(HAVE_INT128) && NATIVEINT == 64
-            DoubleNativeInt result = 0;
-            for (uint32_t i = 0; i < sizeBskm1; ++i) {  // exclude msk residue
-                const auto& xi = m_vectors[sizeQ + i][k];
-                result += Mul128(xi.template ConvertToInt<uint64_t>(), BHatModq[i][j].ConvertToInt<uint64_t>());
+            if (!simd) {
+                DoubleNativeInt result = 0;
+                for (uint32_t i = 0; i < sizeBskm1; ++i) {  // exclude msk residue
+                    const auto& xi = m_vectors[sizeQ + i][k];
+                    result += Mul128(xi.template ConvertToInt<uint64_t>(), BHatModq[i][j].ConvertToInt<uint64_t>());
+                }
+                m_vectors[j][k] = BarrettUint128ModUint64(result, moduliQj.ConvertToInt(), modqBarrettMu[j]);
             }
-            m_vectors[j][k] = BarrettUint128ModUint64(result, moduliQj.ConvertToInt(), modqBarrettMu[j]);
 #else
             NativeInteger result(0);
             for (uint32_t i = 0; i < sizeBskm1; ++i) {  // exclude msk residue
@@ -1982,9 +2200,71 @@ template <typename VecType>
 void DCRTPolyImpl<VecType>::SwitchFormat() {
     m_format = (m_format == Format::COEFFICIENT) ? Format::EVALUATION : Format::COEFFICIENT;
     size_t size{m_vectors.size()};
-#pragma omp parallel for num_threads(OpenFHEParallelControls.GetThreadLimit(size))
-    for (size_t i = 0; i < size; ++i)
-        m_vectors[i].SwitchFormat();
+    if (size == 0)
+        return;
+
+    const auto& co{m_params->GetCyclotomicOrder()};
+    if (m_params->GetRingDimension() != (co >> 1)) {
+        ParallelFor(0, size, OpenFHEParallelControls.GetThreadLimit(size), [&](size_t i) {
+            m_vectors[i].SwitchFormat();
+        });
+        return;
+    }
+
+    // power-of-two cyclotomics: all towers are transformed by one batched, cache-blocked NTT, with the tables
+    // held by the tower parameters (looked up by modulus only for parameters that do not hold them)
+    struct Batch {
+        std::vector<const NTTTables<NativeInteger>*> fwdTables, invTables;
+        std::vector<typename PolyType::Vector*> fwdTowers, invTowers;
+        bool inUse{false};
+    };
+    // kept per thread across calls; a call nested in the transform, from a task this thread runs while it
+    // waits, uses its own vectors
+    thread_local Batch cached;
+    Batch nested;
+    Batch& batch = cached.inUse ? nested : cached;
+    batch.fwdTables.clear();
+    batch.invTables.clear();
+    batch.fwdTowers.clear();
+    batch.invTowers.clear();
+    struct InUse {
+        bool& flag;
+        explicit InUse(bool& f) : flag(f) {
+            flag = true;
+        }
+        ~InUse() {
+            flag = false;
+        }
+    } inUse(batch.inUse);
+
+    for (auto& v : m_vectors) {
+        if (!v.m_values)
+            OPENFHE_THROW("Poly switch format to empty values");
+        const bool toCoefficient{v.m_format != Format::COEFFICIENT};
+        v.m_format = toCoefficient ? Format::COEFFICIENT : Format::EVALUATION;
+
+        const auto* tables = GetTowerNTTTables(v);
+        if (tables == nullptr)
+            continue;
+        (toCoefficient ? batch.invTables : batch.fwdTables).push_back(tables);
+        (toCoefficient ? batch.invTowers : batch.fwdTowers).push_back(v.m_values.get());
+    }
+    using CRT = ChineseRemainderTransformFTT<typename PolyType::Vector>;
+    if (!batch.fwdTowers.empty())
+        CRT().ForwardTransformToBitReverseInPlace(batch.fwdTables, batch.fwdTowers);
+    if (!batch.invTowers.empty())
+        CRT().InverseTransformFromBitReverseInPlace(batch.invTables, batch.invTowers);
+}
+
+template <typename VecType>
+const NTTTables<NativeInteger>* DCRTPolyImpl<VecType>::GetTowerNTTTables(const PolyType& tower) {
+    if (const auto* tables = tower.m_params->GetNTTTables().get())
+        return tables;
+    const auto& root = tower.m_params->GetRootOfUnity();
+    if (root == typename PolyType::Integer(0) || root == typename PolyType::Integer(1))
+        return nullptr;
+    return &ChineseRemainderTransformFTT<typename PolyType::Vector>::GetTables(
+        root, tower.m_params->GetCyclotomicOrder(), tower.m_params->GetModulus());
 }
 
 template <typename VecType>
@@ -42,6 +42,7 @@
 
 #include "math/math-hal.h"
 #include "math/distrgen.h"
+#include "math/hal/intnat/basisconvnat-simd.h"
 
 #include "utils/exception.h"
 #include "utils/inttypes.h"
@@ -130,9 +131,9 @@ public:
     DCRTPolyType& operator-=(const NativeInteger& rhs) override;
     DCRTPolyType& operator*=(const DCRTPolyType& rhs) override {
         size_t size{m_vectors.size()};
-#pragma omp parallel for num_threads(OpenFHEParallelControls.GetThreadLimit(size))
-        for (size_t i = 0; i < size; ++i)
+        ParallelFor(0, size, OpenFHEParallelControls.GetThreadLimit(size), [&](size_t i) {
             m_vectors[i] *= rhs.m_vectors[i];
+        });
         return *this;
     }
     DCRTPolyType& operator*=(const Integer& rhs) override;
@@ -161,9 +162,9 @@ public:
         if (m_vectors[0].GetModulus() != rhs.m_vectors[0].GetModulus())
             OPENFHE_THROW("Modulus missmatch");
         DCRTPolyType tmp(m_params, m_format);
-#pragma omp parallel for num_threads(OpenFHEParallelControls.GetThreadLimit(size))
-        for (size_t i = 0; i < size; ++i)
+        ParallelFor(0, size, OpenFHEParallelControls.GetThreadLimit(size), [&](size_t i) {
             tmp.m_vectors[i] = m_vectors[i].PlusNoCheck(rhs.m_vectors[i]);
+        });
         return tmp;
     }
 
@@ -182,9 +183,9 @@ public:
         if (m_vectors[0].GetModulus() != rhs.m_vectors[0].GetModulus())
             OPENFHE_THROW("Modulus missmatch");
         DCRTPolyType tmp(m_params, m_format);
-#pragma omp parallel for num_threads(OpenFHEParallelControls.GetThreadLimit(size))
-        for (size_t i = 0; i < size; ++i)
+        ParallelFor(0, size, OpenFHEParallelControls.GetThreadLimit(size), [&](size_t i) {
             tmp.m_vectors[i] = m_vectors[i].TimesNoCheck(rhs.m_vectors[i]);
+        });
         return tmp;
     }
     DCRTPolyType Times(const Integer& rhs) const override;
@@ -234,6 +235,13 @@ public:
                                       const std::vector<std::vector<NativeInteger>>& QHatModp,
                                       const std::vector<DoubleNativeInt>& modpBarrettMu) const override;
 
+    DCRTPolyType ApproxSwitchCRTBasisEval(const std::shared_ptr<Params>& paramsQ,
+                                          const std::shared_ptr<Params>& paramsP,
+                                          const std::vector<NativeInteger>& QHatInvModq,
+                                          const std::vector<NativeInteger>& QHatInvModqPrecon,
+                                          const std::vector<std::vector<NativeInteger>>& QHatModp,
+                                          const std::vector<DoubleNativeInt>& modpBarrettMu) const override;
+
     void ApproxModUp(const std::shared_ptr<Params>& paramsQ, const std::shared_ptr<Params>& paramsP,
                      const std::shared_ptr<Params>& paramsQP, const std::vector<NativeInteger>& QHatInvModq,
                      const std::vector<NativeInteger>& QHatInvModqPrecon,
@@ -392,6 +400,45 @@ public:
     }
 
 protected:
+    // NTT tables of a power-of-two tower: the handle held by its parameters or, for parameters without one,
+    // the tables looked up by modulus; nullptr if the tower has no root of unity
+    static const NTTTables<NativeInteger>* GetTowerNTTTables(const PolyType& tower);
+
+#if defined(HAVE_INT128) && NATIVEINT == 64
+    // operands of the approximate basis conversion of the towers x (COEFFICIENT format) into the towers ans,
+    // ans_j = [sum_i [x_i * QHatInvModq_i]_{q_i} * QHatModp_ij]_{p_j}; prepared once per conversion and shared
+    // by all ranges of coefficients
+    struct ApproxSwitchCRTBasisPlan {
+        ApproxSwitchCRTBasisPlan(std::vector<const NativeVector*> x, std::vector<NativeVector*> ans,
+                                 const std::vector<NativeInteger>& QHatInvModq,
+                                 const std::vector<NativeInteger>& QHatInvModqPrecon,
+                                 const std::vector<std::vector<NativeInteger>>& QHatModp,
+                                 const std::vector<DoubleNativeInt>& modpBarrettMu);
+
+        std::vector<const NativeVector*> x;
+        std::vector<NativeVector*> ans;
+        const std::vector<NativeInteger>& QHatInvModq;
+        const std::vector<NativeInteger>& QHatInvModqPrecon;
+        const std::vector<DoubleNativeInt>& modpBarrettMu;
+        // moduli of x and ans and the constants QHatModp stored per output modulus, as machine words
+        std::vector<uint64_t> moduliQ;
+        std::vector<uint64_t> moduliP;
+        std::vector<uint64_t> QHatModpT;
+        lbcrypto::SIMDLevel kernel;
+    };
+
+    // coefficients [first, last) of the approximate basis conversion described by plan
+    static void ApproxSwitchCRTBasisRange(const ApproxSwitchCRTBasisPlan& plan, uint32_t first, uint32_t last);
+
+    // fused ApproxSwitchCRTBasis() of the towers [begin, begin + size) (EVALUATION format) into all towers of ans
+    // (EVALUATION format) for power-of-two cyclotomics; false, with ans unchanged, if a tower has no NTT tables
+    bool ApproxSwitchCRTBasisFused(uint32_t begin, uint32_t size, DCRTPolyType& ans,
+                                   const std::vector<NativeInteger>& QHatInvModq,
+                                   const std::vector<NativeInteger>& QHatInvModqPrecon,
+                                   const std::vector<std::vector<NativeInteger>>& QHatModp,
+                                   const std::vector<DoubleNativeInt>& modpBarrettMu) const;
+#endif
+
     std::shared_ptr<Params> m_params{std::make_shared<DCRTPolyImpl::Params>()};
     Format m_format{Format::EVALUATION};
     std::vector<PolyType> m_vectors;
@@ -88,6 +88,7 @@ public:
         while ((compositeModulus *= IntType(q.template ConvertToInt<BasicInteger>())) < modulus)
             m_params.push_back(std::make_shared<ILNativeParams>(corder, (q = PreviousPrime(q, corder))));
         ElemParams<IntType>::m_ciphertextModulus = compositeModulus;
+        PrecomputeNTTTables();
     }
 
     /**
@@ -114,6 +115,7 @@ public:
             compositeModulus *= IntType(q.template ConvertToInt<BasicInteger>());
         }
         ElemParams<IntType>::m_ciphertextModulus = compositeModulus;
+        PrecomputeNTTTables();
     }
 
     /**
@@ -142,6 +144,7 @@ public:
             compositeModulus *= IntType(moduli[i].template ConvertToInt<BasicInteger>());
         }
         ElemParams<IntType>::m_ciphertextModulus = compositeModulus;
+        PrecomputeNTTTables();
     }
 
     ILDCRTParams(uint32_t corder, const std::vector<NativeInteger>& moduli,
@@ -160,6 +163,7 @@ public:
             compositeModulus *= IntType(moduli[i].template ConvertToInt<BasicInteger>());
         }
         ElemParams<IntType>::m_ciphertextModulus = compositeModulus;
+        PrecomputeNTTTables();
     }
 
     /**
@@ -179,6 +183,7 @@ public:
             compositeModulus *= IntType(moduli[i].template ConvertToInt<BasicInteger>());
         }
         ElemParams<IntType>::m_ciphertextModulus = compositeModulus;
+        PrecomputeNTTTables();
     }
 
     /**
@@ -253,6 +258,15 @@ public:
         return m_params[i];
     }
 
+    /**
+   * @brief Gives the towers handles to their precomputed NTT tables, see ILParamsImpl::PrecomputeNTTTables().
+   * Called by the constructors that create the towers and after deserialization.
+   */
+    void PrecomputeNTTTables() {
+        for (auto& params : m_params)
+            params->PrecomputeNTTTables();
+    }
+
     /**
    * @brief Removes the last parameter set and adjust the multiplied moduli.
    *
@@ -336,6 +350,7 @@ public:
         }
         ar(::cereal::base_class<ElemParams<IntType>>(this));
         ar(::cereal::make_nvp("p", m_params));
+        PrecomputeNTTTables();
     }
 
     std::string SerializedObjectName() const override {
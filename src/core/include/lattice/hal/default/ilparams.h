@@ -44,8 +44,11 @@
 
 #include "utils/exception.h"
 #include "utils/inttypes.h"
+#include "utils/utilities.h"
 
+#include <memory>
 #include <string>
+#include <type_traits>
 #include <utility>
 
 namespace lbcrypto {
@@ -93,7 +96,7 @@ public:
    *
    * @param &rhs the input set of parameters which is copied.
    */
-    ILParamsImpl(const ILParamsImpl& rhs) : ElemParams<IntType>(rhs) {}
+    ILParamsImpl(const ILParamsImpl& rhs) : ElemParams<IntType>(rhs), m_nttTables(rhs.m_nttTables) {}
 
     /**
    * @brief Copy Assignment Operator.
@@ -103,6 +106,7 @@ public:
    */
     ILParamsImpl& operator=(const ILParamsImpl& rhs) {
         ElemParams<IntType>::operator=(rhs);
+        m_nttTables = rhs.m_nttTables;
         return *this;
     }
 
@@ -111,13 +115,41 @@ public:
    *
    * @param &rhs the input set of parameters which is copied.
    */
-    ILParamsImpl(ILParamsImpl&& rhs) noexcept : ElemParams<IntType>(std::move(rhs)) {}
+    ILParamsImpl(ILParamsImpl&& rhs) noexcept
+        : ElemParams<IntType>(std::move(rhs)), m_nttTables(std::move(rhs.m_nttTables)) {}
 
     ILParamsImpl& operator=(ILParamsImpl&& rhs) noexcept {
         ElemParams<IntType>::operator=(std::move(rhs));
+        m_nttTables = std::move(rhs.m_nttTables);
         return *this;
     }
 
+    /**
+   * @brief Gets a handle to the precomputed NTT tables of the modulus and cyclotomic order so that the
+   * transforms need no lookup of the tables by modulus. The native power-of-two parameters have them once
+   * PrecomputeNTTTables() has run, e.g. for the towers of ILDCRTParams; otherwise the handle is empty.
+   *
+   * @return the tables or nullptr
+   */
+    const std::shared_ptr<const NTTTables<IntType>>& GetNTTTables() const {
+        return m_nttTables;
+    }
+
+    /**
+   * @brief Precomputes (or looks up) the NTT tables of the modulus and cyclotomic order and keeps a handle to
+   * them. It does nothing for arbitrary cyclotomics, for the big-integer backends and when there is no root of
+   * unity. The parameters must not be shared with other threads yet.
+   */
+    void PrecomputeNTTTables() {
+        if constexpr (std::is_same_v<IntType, NativeInteger>) {
+            const auto& order = ElemParams<IntType>::m_cyclotomicOrder;
+            const auto& root  = ElemParams<IntType>::m_rootOfUnity;
+            if (IsPowerOfTwo(order) && root != IntType(0) && root != IntType(1))
+                m_nttTables = ChineseRemainderTransformFTT<NativeVector>::GetSharedTables(
+                    root, order, ElemParams<IntType>::m_ciphertextModulus);
+        }
+    }
+
     /**
    * @brief Equality operator compares ElemParams (which will be dynamic casted)
    *
@@ -158,6 +190,9 @@ private:
         ElemParams<IntType>::doprint(out);
         return out << std::endl;
     }
+
+    // shared with the transform's registry; keeps the tables alive while these parameters are in use
+    std::shared_ptr<const NTTTables<IntType>> m_nttTables;
 };
 
 }  // namespace lbcrypto
@@ -47,6 +47,7 @@
 #include <limits>
 #include <memory>
 #include <string>
+#include <type_traits>
 #include <utility>
 #include <vector>
 
@@ -297,6 +298,16 @@ PolyImpl<VecType>& PolyImpl<VecType>::operator-=(const PolyImpl& element) {
     return *this;
 }
 
+template <typename VecType>
+PolyImpl<VecType>& PolyImpl<VecType>::AddProductEq(const PolyImpl& a, const PolyImpl& b) {
+    if (m_format != Format::EVALUATION || a.m_format != Format::EVALUATION || b.m_format != Format::EVALUATION)
+        OPENFHE_THROW("AddProductEq for PolyImpl supported only in Format::EVALUATION");
+    if (!m_values)
+        m_values = std::make_unique<VecType>(m_params->GetRingDimension(), m_params->GetModulus());
+    m_values->ModMulAddEq(*a.m_values, *b.m_values);
+    return *this;
+}
+
 template <typename VecType>
 void PolyImpl<VecType>::AddILElementOne() {
     static const Integer ONE(1);
@@ -420,6 +431,20 @@ void PolyImpl<VecType>::SwitchFormat() {
     if (!m_values)
         OPENFHE_THROW("Poly switch format to empty values");
 
+    if constexpr (std::is_same_v<VecType, NativeVector>) {
+        // tables held by the parameters: no lookup by modulus
+        if (const auto& tables = m_params->GetNTTTables()) {
+            if (m_format != Format::COEFFICIENT) {
+                m_format = Format::COEFFICIENT;
+                ChineseRemainderTransformFTT<VecType>().InverseTransformFromBitReverseInPlace(*tables, &(*m_values));
+                return;
+            }
+            m_format = Format::EVALUATION;
+            ChineseRemainderTransformFTT<VecType>().ForwardTransformToBitReverseInPlace(*tables, &(*m_values));
+            return;
+        }
+    }
+
     if (m_format != Format::COEFFICIENT) {
         m_format = Format::COEFFICIENT;
         ChineseRemainderTransformFTT<VecType>().InverseTransformFromBitReverseInPlace(ru, co, &(*m_values));
@@ -56,6 +56,9 @@
 
 namespace lbcrypto {
 
+template <typename VecType>
+class DCRTPolyImpl;
+
 /**
  * @class PolyImpl
  * @file poly.h
@@ -282,6 +285,9 @@ public:
         return *this;
     }
 
+    // *this += a * b in a single pass over the values, as in the inner products of key switching
+    PolyImpl& AddProductEq(const PolyImpl& a, const PolyImpl& b);
+
     PolyImpl Times(const Integer& element) const override;
     PolyImpl& operator*=(const Integer& element) override {
         m_values->ModMulEq(element);
@@ -355,6 +361,10 @@ public:
     }
 
 protected:
+    // DCRTPolyImpl transforms all of its towers in a single batched NTT
+    template <typename>
+    friend class DCRTPolyImpl;
+
     Format m_format{Format::EVALUATION};
     std::shared_ptr<Params> m_params{nullptr};
     std::unique_ptr<VecType> m_values{nullptr};
@@ -40,6 +40,9 @@
 #include "math/discreteuniformgenerator.h"
 #include "math/distributiongenerator.h"
 #include "utils/exception.h"
+#include "utils/prng/blake2engine.h"
+
+#include <algorithm>
 
 namespace lbcrypto {
 
@@ -60,6 +63,27 @@ void DiscreteUniformGeneratorImpl<VecType>::SetModulus(const typename VecType::I
 
     m_bound =
         std::uniform_int_distribution<uint32_t>::param_type(DUG_CHUNK_MIN, (m_modulus >> m_shiftChunk).ConvertToInt());
+
+    // smallest all-ones mask covering the last chunk
+    m_topMask = m_bound.b();
+    for (uint32_t shift = 1; shift < DUG_CHUNK_WIDTH; shift <<= 1)
+        m_topMask |= m_topMask >> shift;
+}
+
+template <typename VecType>
+void DiscreteUniformGeneratorImpl<VecType>::SetSeed(const PRNGSeed& seed) {
+    default_prng::Blake2Engine::blake2_seed_array_t key{};
+    std::copy(seed.begin(), seed.end(), key.begin());
+    m_prng = std::make_shared<default_prng::Blake2Engine>(key, 0);
+}
+
+template <typename VecType>
+PRNGSeed DiscreteUniformGeneratorImpl<VecType>::GenerateSeed() {
+    PRNGSeed seed;
+    PRNG& prng = PseudoRandomNumberGenerator::GetPRNG();
+    for (auto& word : seed)
+        word = prng();
+    return seed;
 }
 
 template <typename VecType>
@@ -67,6 +91,20 @@ typename VecType::Integer DiscreteUniformGeneratorImpl<VecType>::GenerateInteger
     if (m_modulus == typename VecType::Integer(0))
         OPENFHE_THROW("0 modulus?");
 
+    if (m_prng != nullptr) {
+        // seeded samples must be reproducible with any standard library, so plain rejection sampling
+        // is used instead of std::uniform_int_distribution
+        while (true) {
+            typename VecType::Integer result{};
+            for (uint32_t i{0}, shift{0}; i < m_chunksPerValue; ++i, shift += DUG_CHUNK_WIDTH)
+                result += typename VecType::Integer{(*m_prng)()} << shift;
+            result += typename VecType::Integer{(*m_prng)() & m_topMask} << m_shiftChunk;
+
+            if (result < m_modulus)
+                return result;
+        }
+    }
+
     std::uniform_int_distribution<uint32_t> dist(DUG_CHUNK_MIN, DUG_CHUNK_MAX);
     while (true) {
         typename VecType::Integer result{};
@@ -39,7 +39,9 @@
 
 #include "math/distributiongenerator.h"
 
+#include <array>
 #include <limits>
+#include <memory>
 #include <random>
 
 namespace lbcrypto {
@@ -48,6 +50,11 @@ constexpr uint32_t DUG_CHUNK_MIN{0};
 constexpr uint32_t DUG_CHUNK_WIDTH{std::numeric_limits<uint32_t>::digits};
 constexpr uint32_t DUG_CHUNK_MAX{std::numeric_limits<uint32_t>::max()};
 
+/**
+ * @brief 256-bit seed from which a DiscreteUniformGenerator can deterministically expand its samples
+ */
+using PRNGSeed = std::array<PRNG::result_type, 8>;
+
 /**
  * @brief The class for Discrete Uniform Distribution generator over Zq.
  */
@@ -64,6 +71,19 @@ public:
    */
     void SetModulus(const typename VecType::Integer& modulus);
 
+    /**
+   * @brief      Makes the generator deterministic: all subsequent samples are drawn from a BLAKE2 engine
+   *             keyed with the seed instead of the thread's PRNG. Generators with the same seed produce
+   *             the same sequence of samples.
+   * @param seed the seed, typically obtained from GenerateSeed()
+   */
+    void SetSeed(const PRNGSeed& seed);
+
+    /**
+   * @brief Draws a fresh seed from the thread's PRNG
+   */
+    static PRNGSeed GenerateSeed();
+
     /**
    * @brief Generates a random integer based on the modulus set for the Discrete
    * Uniform Generator object. Required by DistributionGenerator.
@@ -81,6 +101,9 @@ private:
     uint32_t m_chunksPerValue{};
     uint32_t m_shiftChunk{};
     std::uniform_int_distribution<uint32_t>::param_type m_bound{DUG_CHUNK_MIN, DUG_CHUNK_MAX};
+    uint32_t m_topMask{DUG_CHUNK_MAX};
+    // engine set by SetSeed(); nullptr if the thread's PRNG is used
+    std::shared_ptr<PRNG> m_prng;
 };
 
 }  // namespace lbcrypto
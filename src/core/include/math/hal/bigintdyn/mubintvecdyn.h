@@ -463,6 +463,17 @@ public:
     mubintvec& ModMulEq(const mubintvec& b);
     mubintvec& ModMulNoCheckEq(const mubintvec& b);
 
+    /**
+   * Vector component wise modulus multiply-add: adds b * c to this vector.
+   * In-place variant.
+   *
+   * @param &b is the first vector to multiply.
+   * @param &c is the second vector to multiply.
+   * @return is the result of the component wise modulus multiply-add
+   * operation.
+   */
+    mubintvec& ModMulAddEq(const mubintvec& b, const mubintvec& c);
+
     /**
    * Scalar modulus exponentiation operation.
    *
@@ -389,6 +389,17 @@ public:
     BigVectorFixedT& ModMulEq(const BigVectorFixedT& b);
     BigVectorFixedT& ModMulNoCheckEq(const BigVectorFixedT& b);
 
+    /**
+   * Vector component wise modulus multiply-add: adds b * c to this vector.
+   * In-place variant.
+   *
+   * @param &b is the first vector to multiply.
+   * @param &c is the second vector to multiply.
+   * @return is the result of the component wise modulus multiply-add
+   * operation.
+   */
+    BigVectorFixedT& ModMulAddEq(const BigVectorFixedT& b, const BigVectorFixedT& c);
+
     /**
    * Scalar modulus exponentiation operation.
    *
@@ -475,6 +475,23 @@ public:
         return (*this);
     }
 
+    /**
+   * Vector component wise modulus multiply-add: adds b * c to this vector.
+   * In-place variant.
+   *
+   * @param &b is the first vector to multiply.
+   * @param &c is the second vector to multiply.
+   * @return is the result of the component wise modulus multiply-add
+   * operation.
+   */
+    myVecP& ModMulAddEq(const myVecP& b, const myVecP& c) {
+        ArgCheckVector(b, "myVecP ModMulAddEq()");
+        ArgCheckVector(c, "myVecP ModMulAddEq()");
+        for (usint i = 0; i < this->GetLength(); i++)
+            this->operator[](i).ModAddEq(b[i].ModMul(c[i], this->m_modulus), this->m_modulus);
+        return (*this);
+    }
+
     /// procedural version for the vector component wise modulus multiplication
     /// operation.
     void modmul_p(myVecP& x, const myVecP& a, const myVecP& b) const;
@@ -0,0 +1,99 @@
+//==================================================================================
+// BSD 2-Clause License
+//
+// Copyright (c) 2014-2022, NJIT, Duality Technologies Inc. and other contributors
+//
+// All rights reserved.
+//
+// Author TPOC: contact@openfhe.org
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice, this
+//    list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+//    this list of conditions and the following disclaimer in the documentation
+//    and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+// OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//==================================================================================
+
+
+/*
+  This file contains the vectorized (AVX2/AVX-512) RNS basis conversion kernels for the native math backend
+ */
+
+#ifndef LBCRYPTO_MATH_HAL_INTNAT_BASISCONVNAT_SIMD_H
+#define LBCRYPTO_MATH_HAL_INTNAT_BASISCONVNAT_SIMD_H
+
+#include "utils/cpufeatures.h"
+
+#include <cstdint>
+
+namespace intnat {
+
+/**
+ * Inner products of the fast basis conversion, computed with the highest SIMD level enabled in
+ * lbcrypto::OpenFHESIMDControls:
+ *
+ *   out[j][k] = (sum_i in[i][k] * constants[j * sizeIn + i]) mod moduli[j],  0 <= j < sizeOut, 0 <= k < len
+ *
+ * The products are accumulated lazily in 128 bits and each output value is reduced once (Barrett), as in
+ * the scalar code, so the results are identical.
+ *
+ * @param in are the sizeIn input rows of len values each; row i must be reduced modulo inModuli[i].
+ * @param inModuli are the moduli of the input rows.
+ * @param sizeIn is the number of input rows.
+ * @param constants are the conversion constants, stored per output modulus (sizeIn values for each j);
+ * the constants for modulus j must be reduced modulo moduli[j].
+ * @param moduli are the output moduli.
+ * @param barrettMu are the Barrett constants floor(2^128 / moduli[j]) as pairs of 64-bit words with the low
+ * word first, i.e. the memory layout of an array of DoubleNativeInt.
+ * @param out are the sizeOut output rows of len values each; they may not overlap the input rows.
+ * @param sizeOut is the number of output rows.
+ * @param len is the number of values per row.
+ * @return false if no vectorized kernel applies (SIMD disabled, unsupported CPU or moduli above 60 bits);
+ * the caller then runs the scalar code.
+ */
+bool FastBaseConvSIMD(const uint64_t* const* in, const uint64_t* inModuli, uint32_t sizeIn,
+                      const uint64_t* constants, const uint64_t* moduli, const uint64_t* barrettMu,
+                      uint64_t* const* out, uint32_t sizeOut, uint32_t len);
+
+/**
+ * Selects the kernel of FastBaseConvSIMD() for the given input and output moduli and the current SIMD level,
+ * so that callers converting many blocks between the same bases scan the moduli only once.
+ *
+ * @param inModuli are the moduli of the input rows.
+ * @param sizeIn is the number of input rows.
+ * @param moduli are the output moduli.
+ * @param sizeOut is the number of output rows.
+ * @return the kernel to pass to FastBaseConvSIMD(), identified by the SIMD level it needs; SIMD_SCALAR if none
+ * applies.
+ */
+lbcrypto::SIMDLevel SelectFastBaseConvKernel(const uint64_t* inModuli, uint32_t sizeIn, const uint64_t* moduli,
+                                            uint32_t sizeOut);
+
+/**
+ * FastBaseConvSIMD() with a kernel selected by SelectFastBaseConvKernel() for these moduli, or for a set of
+ * moduli that includes them.
+ *
+ * @return false if kernel is SIMD_SCALAR; the caller then runs the scalar code.
+ */
+bool FastBaseConvSIMD(lbcrypto::SIMDLevel kernel, const uint64_t* const* in, uint32_t sizeIn,
+                      const uint64_t* constants, const uint64_t* moduli, const uint64_t* barrettMu,
+                      uint64_t* const* out, uint32_t sizeOut, uint32_t len);
+
+}  // namespace intnat
+
+#endif
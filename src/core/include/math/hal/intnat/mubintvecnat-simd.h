@@ -0,0 +1,82 @@
+//==================================================================================
+// BSD 2-Clause License
+//
+// Copyright (c) 2014-2022, NJIT, Duality Technologies Inc. and other contributors
+//
+// All rights reserved.
+//
+// Author TPOC: contact@openfhe.org
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice, this
+//    list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+//    this list of conditions and the following disclaimer in the documentation
+//    and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+// OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//==================================================================================
+
+
+
+/*
+  This file contains the vectorized (AVX2/AVX-512) element-wise modular arithmetic kernels used by NativeVector
+ */
+
+#ifndef LBCRYPTO_MATH_HAL_INTNAT_MUBINTVECNAT_SIMD_H
+#define LBCRYPTO_MATH_HAL_INTNAT_MUBINTVECNAT_SIMD_H
+
+#include <cstddef>
+#include <cstdint>
+
+namespace intnat {
+
+/*
+  Element-wise kernels over the raw 64-bit values of NativeVector, computed with the highest SIMD level enabled
+  in lbcrypto::OpenFHESIMDControls. Each kernel follows the arithmetic of the corresponding scalar
+  NativeIntegerT method step by step, so the results are identical to the scalar loops for any input values.
+
+  Every function processes a prefix of the n values whose length is a multiple of the vector width and returns
+  the length of that prefix (0 if no vectorized kernel applies: SIMD disabled, unsupported CPU or parameters);
+  the caller runs the scalar code for the remaining values. The in-place operand "a" may alias "b" or "c".
+ */
+
+// a[i] = a[i] + b[i] mod modulus, as NativeIntegerT::ModAddFastEq()
+size_t ModAddSIMD(uint64_t* a, const uint64_t* b, uint64_t modulus, size_t n);
+
+// a[i] = a[i] + b mod modulus, as NativeIntegerT::ModAddFastEq()
+size_t ModAddConstSIMD(uint64_t* a, uint64_t b, uint64_t modulus, size_t n);
+
+// a[i] = a[i] - b[i] mod modulus, as NativeIntegerT::ModSubFastEq()
+size_t ModSubSIMD(uint64_t* a, const uint64_t* b, uint64_t modulus, size_t n);
+
+// a[i] = a[i] - b mod modulus, as NativeIntegerT::ModSubFastEq()
+size_t ModSubConstSIMD(uint64_t* a, uint64_t b, uint64_t modulus, size_t n);
+
+// a[i] = a[i] * b mod modulus with Shoup's precomputation bPrecon = floor(b * 2^64 / modulus),
+// as NativeIntegerT::ModMulFastConstEq()
+size_t ModMulConstSIMD(uint64_t* a, uint64_t b, uint64_t bPrecon, uint64_t modulus, size_t n);
+
+// a[i] = a[i] * b[i] mod modulus with the Barrett constant mu = NativeIntegerT::ComputeMu(),
+// as NativeIntegerT::ModMulFastEq()
+size_t ModMulSIMD(uint64_t* a, const uint64_t* b, uint64_t modulus, uint64_t mu, size_t n);
+
+// a[i] = a[i] + b[i] * c[i] mod modulus: the Barrett multiplication of ModMulSIMD() followed by the addition
+// of ModAddSIMD(), fused into a single pass over the data
+size_t ModMulAddSIMD(uint64_t* a, const uint64_t* b, const uint64_t* c, uint64_t modulus, uint64_t mu, size_t n);
+
+}  // namespace intnat
+
+#endif
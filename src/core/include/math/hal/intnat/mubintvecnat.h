@@ -411,13 +411,7 @@ public:
    * @return is the result of the modulus addition operation.
    */
     NativeVectorT& ModAddEq(const NativeVectorT& b);
-    NativeVectorT& ModAddNoCheckEq(const NativeVectorT& b) {
-        size_t size{m_data.size()};
-        auto mv{m_modulus};
-        for (size_t i = 0; i < size; ++i)
-            m_data[i].ModAddFastEq(b[i], mv);
-        return *this;
-    }
+    NativeVectorT& ModAddNoCheckEq(const NativeVectorT& b);
 
     /**
    * Scalar modulus subtraction.
@@ -486,19 +480,17 @@ public:
    * @return is the result of the modulus multiplication operation.
    */
     NativeVectorT& ModMulEq(const NativeVectorT& b);
-    NativeVectorT& ModMulNoCheckEq(const NativeVectorT& b) {
-        size_t size{m_data.size()};
-        auto mv{m_modulus};
-#ifdef NATIVEINT_BARRET_MOD
-        auto mu{m_modulus.ComputeMu()};
-        for (size_t i = 0; i < size; ++i)
-            m_data[i].ModMulFastEq(b[i], mv, mu);
-#else
-        for (size_t i = 0; i < size; ++i)
-            m_data[i].ModMulFastEq(b[i], mv);
-#endif
-        return *this;
-    }
+    NativeVectorT& ModMulNoCheckEq(const NativeVectorT& b);
+
+    /**
+   * Vector modulus multiply-add: adds the component wise product b * c to
+   * this vector. In-place variant.
+   *
+   * @param &b is the first vector to multiply.
+   * @param &c is the second vector to multiply.
+   * @return is the result of the modulus multiply-add operation.
+   */
+    NativeVectorT& ModMulAddEq(const NativeVectorT& b, const NativeVectorT& c);
 
     /**
    * Vector multiplication without applying the modulus operation.
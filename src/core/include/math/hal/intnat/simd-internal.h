@@ -0,0 +1,146 @@
+//==================================================================================
+// BSD 2-Clause License
+//
+// Copyright (c) 2014-2022, NJIT, Duality Technologies Inc. and other contributors
+//
+// All rights reserved.
+//
+// Author TPOC: contact@openfhe.org
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice, this
+//    list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+//    this list of conditions and the following disclaimer in the documentation
+//    and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+// OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//==================================================================================
+
+/*
+  This file contains the intrinsics helpers shared by the vectorized (AVX2/AVX-512) kernels of the native math
+  backend. It is included only by the translation units that implement the kernels and is not part of the API.
+ */
+
+#ifndef LBCRYPTO_MATH_HAL_INTNAT_SIMD_INTERNAL_H
+#define LBCRYPTO_MATH_HAL_INTNAT_SIMD_INTERNAL_H
+
+#include "math/hal/basicint.h"
+
+#include "utils/cpufeatures.h"
+
+#include <cstdint>
+
+#if defined(OPENFHE_SIMD_X86) && (NATIVEINT == 64) && defined(HAVE_INT128)
+    #define OPENFHE_SIMD_INTNAT
+    #if defined(__GNUC__) && !defined(__clang__)
+        // GCC reports false positives for _mm512_undefined_epi32() used inside the AVX-512 intrinsics
+        #pragma GCC diagnostic ignored "-Wmaybe-uninitialized"
+    #endif
+    #include <immintrin.h>
+#endif
+
+#ifdef OPENFHE_SIMD_INTNAT
+
+    // the kernels are compiled with per-function target attributes and dispatched at runtime
+    #define AVX2_TARGET   __attribute__((target("avx2")))
+    #define AVX512_TARGET __attribute__((target("avx512f,avx512dq")))
+    #define IFMA_TARGET   __attribute__((target("avx512f,avx512dq,avx512ifma")))
+
+namespace intnat {
+
+// Kernels are identified by the SIMD level they need. Every family of kernels describes the kernels it
+// implements for the given operands as a mask of SIMDKernelBit() values.
+constexpr uint32_t SIMDKernelBit(lbcrypto::SIMDLevel kernel) {
+    return uint32_t(1) << kernel;
+}
+
+// Returns the fastest of the applicable kernels allowed by lbcrypto::OpenFHESIMDControls, or SIMD_SCALAR if
+// the caller has to run the scalar code. A kernel of a lower level is used when the one of the current level
+// does not apply.
+static inline lbcrypto::SIMDLevel SelectSIMDKernel(uint32_t applicable) {
+    for (int level = lbcrypto::OpenFHESIMDControls.GetLevel(); level > lbcrypto::SIMD_SCALAR; --level) {
+        const auto kernel = static_cast<lbcrypto::SIMDLevel>(level);
+        if (applicable & SIMDKernelBit(kernel))
+            return kernel;
+    }
+    return lbcrypto::SIMD_SCALAR;
+}
+
+// ************************************************************************************
+// AVX2: 4 x 64-bit lanes; 64x64-bit products are emulated with 32x32-bit multiplies
+
+// (a * b) mod 2^64
+static inline AVX2_TARGET __m256i MulLo64AVX2(__m256i a, __m256i b) {
+    __m256i cross = _mm256_add_epi64(_mm256_mul_epu32(_mm256_srli_epi64(a, 32), b),
+                                     _mm256_mul_epu32(a, _mm256_srli_epi64(b, 32)));
+    return _mm256_add_epi64(_mm256_mul_epu32(a, b), _mm256_slli_epi64(cross, 32));
+}
+
+// (a * b) >> 64
+static inline AVX2_TARGET __m256i MulHi64AVX2(__m256i a, __m256i b) {
+    const __m256i lo32{_mm256_set1_epi64x(0xFFFFFFFF)};
+    __m256i ah{_mm256_srli_epi64(a, 32)};
+    __m256i bh{_mm256_srli_epi64(b, 32)};
+    __m256i ll{_mm256_mul_epu32(a, b)};
+    __m256i lh{_mm256_mul_epu32(a, bh)};
+    __m256i hl{_mm256_mul_epu32(ah, b)};
+    __m256i hh{_mm256_mul_epu32(ah, bh)};
+    __m256i mid{_mm256_add_epi64(_mm256_srli_epi64(ll, 32),
+                                 _mm256_add_epi64(_mm256_and_si256(lh, lo32), _mm256_and_si256(hl, lo32)))};
+    return _mm256_add_epi64(_mm256_add_epi64(hh, _mm256_srli_epi64(lh, 32)),
+                            _mm256_add_epi64(_mm256_srli_epi64(hl, 32), _mm256_srli_epi64(mid, 32)));
+}
+
+// all ones in the lanes where a < b (unsigned)
+static inline AVX2_TARGET __m256i CmpLtU64AVX2(__m256i a, __m256i b) {
+    const __m256i sign{_mm256_set1_epi64x(static_cast<int64_t>(uint64_t(1) << 63))};
+    return _mm256_cmpgt_epi64(_mm256_xor_si256(b, sign), _mm256_xor_si256(a, sign));
+}
+
+// maps r in [0, 2q) to [0, q); requires q < 2^62 so that the signed comparison is valid
+static inline AVX2_TARGET __m256i ReduceOnceAVX2(__m256i r, __m256i q) {
+    r = _mm256_sub_epi64(r, q);
+    return _mm256_add_epi64(r, _mm256_and_si256(_mm256_cmpgt_epi64(_mm256_setzero_si256(), r), q));
+}
+
+// ************************************************************************************
+// AVX-512: 8 x 64-bit lanes; the low halves of 64x64-bit products come from AVX-512 DQ
+
+// (a * b) >> 64
+static inline AVX512_TARGET __m512i MulHi64AVX512(__m512i a, __m512i b) {
+    const __m512i lo32{_mm512_set1_epi64(0xFFFFFFFF)};
+    __m512i ah{_mm512_srli_epi64(a, 32)};
+    __m512i bh{_mm512_srli_epi64(b, 32)};
+    __m512i ll{_mm512_mul_epu32(a, b)};
+    __m512i lh{_mm512_mul_epu32(a, bh)};
+    __m512i hl{_mm512_mul_epu32(ah, b)};
+    __m512i hh{_mm512_mul_epu32(ah, bh)};
+    __m512i mid{_mm512_add_epi64(_mm512_srli_epi64(ll, 32),
+                                 _mm512_add_epi64(_mm512_and_si512(lh, lo32), _mm512_and_si512(hl, lo32)))};
+    return _mm512_add_epi64(_mm512_add_epi64(hh, _mm512_srli_epi64(lh, 32)),
+                            _mm512_add_epi64(_mm512_srli_epi64(hl, 32), _mm512_srli_epi64(mid, 32)));
+}
+
+// maps r in [0, 2q) to [0, q)
+static inline AVX512_TARGET __m512i ReduceOnceAVX512(__m512i r, __m512i q) {
+    return _mm512_min_epu64(r, _mm512_sub_epi64(r, q));
+}
+
+}  // namespace intnat
+
+#endif  // OPENFHE_SIMD_INTNAT
+
+#endif
@@ -40,13 +40,17 @@
 #include "math/hal/intnat/ubintnat.h"
 #include "math/hal/intnat/mubintvecnat.h"
 #include "math/hal/intnat/transformnat.h"
+#include "math/hal/intnat/transformnat-simd.h"
 #include "math/nbtheory.h"
 
 #include "utils/exception.h"
 #include "utils/inttypes.h"
+#include "utils/parallel.h"
 #include "utils/utilities.h"
 
+#include <algorithm>
 #include <map>
+#include <type_traits>
 #include <vector>
 
 namespace intnat {
@@ -54,28 +58,15 @@ namespace intnat {
 using namespace lbcrypto;
 
 template <typename VecType>
-std::map<typename VecType::Integer, VecType>
-    ChineseRemainderTransformFTTNat<VecType>::m_cycloOrderInverseTableByModulus;
-
-template <typename VecType>
-std::map<typename VecType::Integer, VecType>
-    ChineseRemainderTransformFTTNat<VecType>::m_cycloOrderInversePreconTableByModulus;
-
-template <typename VecType>
-std::map<typename VecType::Integer, VecType>
-    ChineseRemainderTransformFTTNat<VecType>::m_rootOfUnityReverseTableByModulus;
-
-template <typename VecType>
-std::map<typename VecType::Integer, VecType>
-    ChineseRemainderTransformFTTNat<VecType>::m_rootOfUnityInverseReverseTableByModulus;
+lbcrypto::PrecomputationRegistry<std::pair<typename VecType::Integer, usint>,
+                                 std::shared_ptr<const typename ChineseRemainderTransformFTTNat<VecType>::NTTTables>,
+                                 HashModulusOrder>
+    ChineseRemainderTransformFTTNat<VecType>::m_tables;
 
 template <typename VecType>
-std::map<typename VecType::Integer, VecType>
-    ChineseRemainderTransformFTTNat<VecType>::m_rootOfUnityPreconReverseTableByModulus;
-
-template <typename VecType>
-std::map<typename VecType::Integer, VecType>
-    ChineseRemainderTransformFTTNat<VecType>::m_rootOfUnityInversePreconReverseTableByModulus;
+lbcrypto::PrecomputationRegistry<std::pair<typename VecType::Integer, usint>,
+                                 typename ChineseRemainderTransformFTTNat<VecType>::SharedTables, HashModulusOrder>
+    ChineseRemainderTransformFTTNat<VecType>::m_sharedTables;
 
 template <typename VecType>
 std::map<typename VecType::Integer, VecType> ChineseRemainderTransformArbNat<VecType>::m_cyclotomicPolyMap;
@@ -122,6 +113,22 @@ std::map<typename VecType::Integer, typename VecType::Integer>
 template <typename VecType>
 std::map<usint, usint> ChineseRemainderTransformArbNat<VecType>::m_nttDivisionDim;
 
+// the lazy-reduction transforms keep values in [0, 4q), which must fit in a machine word
+template <typename IntType>
+inline bool IsLazyReductionModulus(const IntType& modulus) {
+    return modulus.GetMSB() + 2 <= IntType::MaxBits();
+}
+
+// reduces x in [0, 4q) to [0, q)
+template <typename IntType>
+inline IntType ReduceLazyNat(IntType x, const IntType& modulus, const IntType& twoModulus) {
+    if (x >= twoModulus)
+        x -= twoModulus;
+    if (x >= modulus)
+        x -= modulus;
+    return x;
+}
+
 template <typename VecType>
 void NumberTheoreticTransformNat<VecType>::ForwardTransformIterative(const VecType& element,
                                                                      const VecType& rootOfUnityTable, VecType* result) {
@@ -318,6 +325,25 @@ void NumberTheoreticTransformNat<VecType>::ForwardTransformToBitReverseInPlace(c
     //             element[j1 + t] = (loVal - hiVal) mod modulus
     //
 
+    const auto modulus{element->GetModulus()};
+    if constexpr (std::is_same_v<VecType, NativeVectorT<NativeIntegerT<uint64_t>>>) {
+        // vectorized kernels selected at runtime; bit-exact with the scalar code below
+        if (ForwardTransformToBitReverseInPlaceSIMD(
+                reinterpret_cast<uint64_t*>(&(*element)[0]), reinterpret_cast<const uint64_t*>(&rootOfUnityTable[0]),
+                reinterpret_cast<const uint64_t*>(&preconRootOfUnityTable[0]), modulus.ConvertToInt(),
+                element->GetLength()))
+            return;
+    }
+    if (IsLazyReductionModulus(modulus)) {
+        ForwardTransformToBitReverseInPlaceLazy(rootOfUnityTable, preconRootOfUnityTable, element);
+        return;
+    }
+    ForwardTransformToBitReverseInPlaceReduced(rootOfUnityTable, preconRootOfUnityTable, element);
+}
+
+template <typename VecType>
+void NumberTheoreticTransformNat<VecType>::ForwardTransformToBitReverseInPlaceReduced(
+    const VecType& rootOfUnityTable, const VecType& preconRootOfUnityTable, VecType* element) {
     const auto modulus{element->GetModulus()};
     const uint32_t n(element->GetLength() >> 1);
     for (uint32_t m{1}, t{n}, logt{GetMSB(t)}; m < n; m <<= 1, t >>= 1, --logt) {
@@ -533,6 +559,31 @@ void NumberTheoreticTransformNat<VecType>::InverseTransformFromBitReverseInPlace
     auto modulus{element->GetModulus()};
     uint32_t n(element->GetLength());
 
+    if constexpr (std::is_same_v<VecType, NativeVectorT<NativeIntegerT<uint64_t>>>) {
+        // vectorized kernels selected at runtime; bit-exact with the scalar code below
+        if (InverseTransformFromBitReverseInPlaceSIMD(
+                reinterpret_cast<uint64_t*>(&(*element)[0]),
+                reinterpret_cast<const uint64_t*>(&rootOfUnityInverseTable[0]),
+                reinterpret_cast<const uint64_t*>(&preconRootOfUnityInverseTable[0]), cycloOrderInv.ConvertToInt(),
+                preconCycloOrderInv.ConvertToInt(), modulus.ConvertToInt(), n))
+            return;
+    }
+    if (IsLazyReductionModulus(modulus)) {
+        InverseTransformFromBitReverseInPlaceLazy(rootOfUnityInverseTable, preconRootOfUnityInverseTable, cycloOrderInv,
+                                                  preconCycloOrderInv, element);
+        return;
+    }
+    InverseTransformFromBitReverseInPlaceReduced(rootOfUnityInverseTable, preconRootOfUnityInverseTable, cycloOrderInv,
+                                                 preconCycloOrderInv, element);
+}
+
+template <typename VecType>
+void NumberTheoreticTransformNat<VecType>::InverseTransformFromBitReverseInPlaceReduced(
+    const VecType& rootOfUnityInverseTable, const VecType& preconRootOfUnityInverseTable, const IntType& cycloOrderInv,
+    const IntType& preconCycloOrderInv, VecType* element) {
+    auto modulus{element->GetModulus()};
+    uint32_t n(element->GetLength());
+
     // precomputed omega[bitreversed(1)] * (n inverse). used in final stage of intt.
     auto omega1Inv{rootOfUnityInverseTable[1].ModMulFastConst(cycloOrderInv, modulus, preconCycloOrderInv)};
     auto preconOmega1Inv{omega1Inv.PrepModMulConst(modulus)};
@@ -621,6 +672,351 @@ void NumberTheoreticTransformNat<VecType>::InverseTransformFromBitReverseInPlace
         (*element)[i].ModMulFastConstEq(cycloOrderInv, modulus, preconCycloOrderInv);
 }
 
+template <typename VecType>
+void NumberTheoreticTransformNat<VecType>::ForwardTransformToBitReverseInPlaceLazy(const VecType& rootOfUnityTable,
+                                                                                   const VecType& preconRootOfUnityTable,
+                                                                                   VecType* element) {
+    //
+    // Harvey's variant of the CT butterfly [https://arxiv.org/abs/1205.2926]: the inputs of each stage are
+    // in [0, 4q), lo is brought back to [0, 2q) with one conditional subtraction and omega * hi is computed
+    // with Shoup's multiplication without correction (in [0, 2q)), so that
+    //     element[j1 + 0] = lo + omega * hi           in [0, 4q)
+    //     element[j1 + t] = lo - omega * hi + 2q      in [0, 4q)
+    // The outputs are fully reduced once, in the peeled off last stage.
+    //
+    const auto modulus{element->GetModulus()};
+    const auto twoModulus{modulus + modulus};
+    const uint32_t n(element->GetLength() >> 1);
+    for (uint32_t m{1}, t{n}, logt{GetMSB(t)}; m < n; m <<= 1, t >>= 1, --logt) {
+        for (uint32_t i{0}; i < m; ++i) {
+            auto omega{rootOfUnityTable[i + m]};
+            auto preconOmega{preconRootOfUnityTable[i + m]};
+            for (uint32_t j1{i << logt}, j2{j1 + t}; j1 < j2; ++j1) {
+                auto loVal{(*element)[j1 + 0]};
+                if (loVal >= twoModulus)
+                    loVal -= twoModulus;
+                auto omegaFactor{(*element)[j1 + t].ModMulFastConstLazy(omega, modulus, preconOmega)};
+                (*element)[j1 + 0] = loVal + omegaFactor;
+                (*element)[j1 + t] = loVal + twoModulus - omegaFactor;
+            }
+        }
+    }
+    for (uint32_t i{0}; i < (n << 1); i += 2) {
+        auto loVal{(*element)[i + 0]};
+        if (loVal >= twoModulus)
+            loVal -= twoModulus;
+        auto omegaFactor{(*element)[i + 1].ModMulFastConstLazy(rootOfUnityTable[(i >> 1) + n], modulus,
+                                                                preconRootOfUnityTable[(i >> 1) + n])};
+        auto hiVal{loVal + omegaFactor};
+        loVal += twoModulus - omegaFactor;
+        (*element)[i + 0] = ReduceLazyNat(hiVal, modulus, twoModulus);
+        (*element)[i + 1] = ReduceLazyNat(loVal, modulus, twoModulus);
+    }
+}
+
+template <typename VecType>
+void NumberTheoreticTransformNat<VecType>::InverseTransformFromBitReverseInPlaceLazy(
+    const VecType& rootOfUnityInverseTable, const VecType& preconRootOfUnityInverseTable, const IntType& cycloOrderInv,
+    const IntType& preconCycloOrderInv, VecType* element) {
+    //
+    // Harvey's variant of the GS butterfly: the values stay in [0, 2q) between stages
+    //     element[j1 + 0] = lo + hi (one conditional subtraction of 2q)    in [0, 2q)
+    //     element[j1 + t] = omega * (lo - hi + 2q) (without correction)     in [0, 2q)
+    // and are fully reduced once, in the final stage where the multiplies by (n inverse) are folded in.
+    //
+    const auto modulus{element->GetModulus()};
+    const auto twoModulus{modulus + modulus};
+    const uint32_t n(element->GetLength());
+
+    for (uint32_t m{n >> 1}, t{1}, logt{1}; m > 1; m >>= 1, t <<= 1, ++logt) {
+        for (uint32_t i{0}; i < m; ++i) {
+            auto omega{rootOfUnityInverseTable[i + m]};
+            auto preconOmega{preconRootOfUnityInverseTable[i + m]};
+            for (uint32_t j1{i << logt}, j2{j1 + t}; j1 < j2; ++j1) {
+                auto loVal{(*element)[j1 + 0]};
+                auto hiVal{(*element)[j1 + t]};
+                auto omegaFactor{loVal + twoModulus - hiVal};
+                loVal += hiVal;
+                if (loVal >= twoModulus)
+                    loVal -= twoModulus;
+                (*element)[j1 + 0] = loVal;
+                (*element)[j1 + t] = omegaFactor.ModMulFastConstLazy(omega, modulus, preconOmega);
+            }
+        }
+    }
+
+    auto omega1Inv{rootOfUnityInverseTable[1].ModMulFastConst(cycloOrderInv, modulus, preconCycloOrderInv)};
+    auto preconOmega1Inv{omega1Inv.PrepModMulConst(modulus)};
+    const uint32_t j2{n >> 1};
+    for (uint32_t j1{0}; j1 < j2; ++j1) {
+        auto loVal{(*element)[j1]};
+        auto hiVal{(*element)[j1 + j2]};
+        auto omegaFactor{loVal + twoModulus - hiVal};
+        loVal += hiVal;
+        (*element)[j1 + 0] =
+            ReduceLazyNat(loVal.ModMulFastConstLazy(cycloOrderInv, modulus, preconCycloOrderInv), modulus, twoModulus);
+        (*element)[j1 + j2] =
+            ReduceLazyNat(omegaFactor.ModMulFastConstLazy(omega1Inv, modulus, preconOmega1Inv), modulus, twoModulus);
+    }
+}
+
+// butterflies of the blocked transforms below: fully reduced ones with the same arithmetic as the
+// in-place transforms above, and lazy ones with the same arithmetic as the *Lazy() transforms
+template <typename IntType>
+inline void ButterflyCTNat(IntType& lo, IntType& hi, const IntType& omega, const IntType& preconOmega,
+                           const IntType& modulus) {
+    auto omegaFactor{hi.ModMulFastConst(omega, modulus, preconOmega)};
+    auto loVal{lo};
+#if defined(__GNUC__) && !defined(__clang__)
+    auto hiVal{loVal + omegaFactor};
+    if (hiVal >= modulus)
+        hiVal -= modulus;
+    if (loVal < omegaFactor)
+        loVal += modulus;
+    loVal -= omegaFactor;
+    lo = hiVal;
+    hi = loVal;
+#else
+    lo += omegaFactor - (omegaFactor >= (modulus - loVal) ? modulus : 0);
+    if (omegaFactor > loVal)
+        loVal += modulus;
+    hi = loVal - omegaFactor;
+#endif
+}
+
+template <typename IntType>
+inline void ButterflyGSNat(IntType& lo, IntType& hi, const IntType& omega, const IntType& preconOmega,
+                           const IntType& modulus) {
+    auto loVal{lo};
+    auto hiVal{hi};
+#if defined(__GNUC__) && !defined(__clang__)
+    auto omegaFactor{loVal};
+    if (omegaFactor < hiVal)
+        omegaFactor += modulus;
+    omegaFactor -= hiVal;
+    loVal += hiVal;
+    if (loVal >= modulus)
+        loVal -= modulus;
+    omegaFactor.ModMulFastConstEq(omega, modulus, preconOmega);
+    lo = loVal;
+    hi = omegaFactor;
+#else
+    lo += hiVal - (hiVal >= (modulus - loVal) ? modulus : 0);
+    auto omegaFactor = loVal + (hiVal > loVal ? modulus : 0) - hiVal;
+    omegaFactor.ModMulFastConstEq(omega, modulus, preconOmega);
+    hi = omegaFactor;
+#endif
+}
+
+// inputs and outputs in [0, 4q)
+template <typename IntType>
+inline void ButterflyCTLazyNat(IntType& lo, IntType& hi, const IntType& omega, const IntType& preconOmega,
+                               const IntType& modulus, const IntType& twoModulus) {
+    auto loVal{lo};
+    if (loVal >= twoModulus)
+        loVal -= twoModulus;
+    auto omegaFactor{hi.ModMulFastConstLazy(omega, modulus, preconOmega)};
+    lo = loVal + omegaFactor;
+    hi = loVal + twoModulus - omegaFactor;
+}
+
+// inputs and outputs in [0, 2q)
+template <typename IntType>
+inline void ButterflyGSLazyNat(IntType& lo, IntType& hi, const IntType& omega, const IntType& preconOmega,
+                               const IntType& modulus, const IntType& twoModulus) {
+    auto omegaFactor{lo + twoModulus - hi};
+    lo += hi;
+    if (lo >= twoModulus)
+        lo -= twoModulus;
+    hi = omegaFactor.ModMulFastConstLazy(omega, modulus, preconOmega);
+}
+
+template <typename VecType>
+void NumberTheoreticTransformNat<VecType>::ForwardTransformToBitReverseInPlaceColumns(
+    const VecType& rootOfUnityTable, const VecType& preconRootOfUnityTable, uint32_t logBlocks, uint32_t begin,
+    uint32_t end, VecType* element) {
+    const auto modulus{element->GetModulus()};
+    const uint32_t n(element->GetLength());
+    if constexpr (std::is_same_v<VecType, NativeVectorT<NativeIntegerT<uint64_t>>>) {
+        if (ForwardTransformToBitReverseColumnsSIMD(
+                reinterpret_cast<uint64_t*>(&(*element)[0]), reinterpret_cast<const uint64_t*>(&rootOfUnityTable[0]),
+                reinterpret_cast<const uint64_t*>(&preconRootOfUnityTable[0]), modulus.ConvertToInt(), n, logBlocks,
+                begin, end))
+            return;
+    }
+    const auto twoModulus{modulus + modulus};
+    const bool lazy{IsLazyReductionModulus(modulus)};
+    const uint32_t stride{n >> logBlocks};
+    for (uint32_t s{0}, m{1}, t{n >> 1}; s < logBlocks; ++s, m <<= 1, t >>= 1) {
+        for (uint32_t i{0}; i < m; ++i) {
+            auto omega{rootOfUnityTable[i + m]};
+            auto preconOmega{preconRootOfUnityTable[i + m]};
+            for (uint32_t j0{2 * i * t}, j2{j0 + t}; j0 < j2; j0 += stride) {
+                if (lazy) {
+                    for (uint32_t j1{j0 + begin}, j3{j0 + end}; j1 < j3; ++j1)
+                        ButterflyCTLazyNat((*element)[j1], (*element)[j1 + t], omega, preconOmega, modulus,
+                                           twoModulus);
+                }
+                else {
+                    for (uint32_t j1{j0 + begin}, j3{j0 + end}; j1 < j3; ++j1)
+                        ButterflyCTNat((*element)[j1], (*element)[j1 + t], omega, preconOmega, modulus);
+                }
+            }
+        }
+    }
+    // each phase returns fully reduced values
+    if (lazy) {
+        for (uint32_t j0{0}; j0 < n; j0 += stride) {
+            for (uint32_t j1{j0 + begin}, j3{j0 + end}; j1 < j3; ++j1)
+                (*element)[j1] = ReduceLazyNat((*element)[j1], modulus, twoModulus);
+        }
+    }
+}
+
+template <typename VecType>
+void NumberTheoreticTransformNat<VecType>::ForwardTransformToBitReverseInPlaceBlock(
+    const VecType& rootOfUnityTable, const VecType& preconRootOfUnityTable, uint32_t logBlocks, uint32_t block,
+    VecType* element) {
+    const auto modulus{element->GetModulus()};
+    const uint32_t n(element->GetLength());
+    if constexpr (std::is_same_v<VecType, NativeVectorT<NativeIntegerT<uint64_t>>>) {
+        if (ForwardTransformToBitReverseBlockSIMD(
+                reinterpret_cast<uint64_t*>(&(*element)[0]), reinterpret_cast<const uint64_t*>(&rootOfUnityTable[0]),
+                reinterpret_cast<const uint64_t*>(&preconRootOfUnityTable[0]), modulus.ConvertToInt(), n, logBlocks,
+                block))
+            return;
+    }
+    const auto twoModulus{modulus + modulus};
+    const bool lazy{IsLazyReductionModulus(modulus)};
+    const uint32_t size{n >> logBlocks};
+    for (uint32_t m{uint32_t(1) << logBlocks}, t{size >> 1}; t >= 1; m <<= 1, t >>= 1) {
+        const uint32_t groups{m >> logBlocks};
+        for (uint32_t i{block * groups}, i1{i + groups}; i < i1; ++i) {
+            auto omega{rootOfUnityTable[i + m]};
+            auto preconOmega{preconRootOfUnityTable[i + m]};
+            if (lazy) {
+                for (uint32_t j1{2 * i * t}, j2{j1 + t}; j1 < j2; ++j1)
+                    ButterflyCTLazyNat((*element)[j1], (*element)[j1 + t], omega, preconOmega, modulus, twoModulus);
+            }
+            else {
+                for (uint32_t j1{2 * i * t}, j2{j1 + t}; j1 < j2; ++j1)
+                    ButterflyCTNat((*element)[j1], (*element)[j1 + t], omega, preconOmega, modulus);
+            }
+        }
+    }
+    if (lazy) {
+        for (uint32_t j{block * size}, j1{j + size}; j < j1; ++j)
+            (*element)[j] = ReduceLazyNat((*element)[j], modulus, twoModulus);
+    }
+}
+
+template <typename VecType>
+void NumberTheoreticTransformNat<VecType>::InverseTransformFromBitReverseInPlaceBlock(
+    const VecType& rootOfUnityInverseTable, const VecType& preconRootOfUnityInverseTable, const IntType& cycloOrderInv,
+    const IntType& preconCycloOrderInv, uint32_t logBlocks, uint32_t block, VecType* element) {
+    if (logBlocks == 0) {
+        InverseTransformFromBitReverseInPlace(rootOfUnityInverseTable, preconRootOfUnityInverseTable, cycloOrderInv,
+                                              preconCycloOrderInv, element);
+        return;
+    }
+    const auto modulus{element->GetModulus()};
+    const uint32_t n(element->GetLength());
+    if constexpr (std::is_same_v<VecType, NativeVectorT<NativeIntegerT<uint64_t>>>) {
+        NTTFinalStage fs(rootOfUnityInverseTable[1].ConvertToInt(), cycloOrderInv.ConvertToInt(),
+                         preconCycloOrderInv.ConvertToInt(), modulus.ConvertToInt());
+        if (InverseTransformFromBitReverseBlockSIMD(
+                reinterpret_cast<uint64_t*>(&(*element)[0]),
+                reinterpret_cast<const uint64_t*>(&rootOfUnityInverseTable[0]),
+                reinterpret_cast<const uint64_t*>(&preconRootOfUnityInverseTable[0]), fs, modulus.ConvertToInt(), n,
+                logBlocks, block))
+            return;
+    }
+    const auto twoModulus{modulus + modulus};
+    const bool lazy{IsLazyReductionModulus(modulus)};
+    const uint32_t size{n >> logBlocks};
+    for (uint32_t m{n >> 1}, t{1}; t < size; m >>= 1, t <<= 1) {
+        const uint32_t groups{m >> logBlocks};
+        for (uint32_t i{block * groups}, i1{i + groups}; i < i1; ++i) {
+            auto omega{rootOfUnityInverseTable[i + m]};
+            auto preconOmega{preconRootOfUnityInverseTable[i + m]};
+            if (lazy) {
+                for (uint32_t j1{2 * i * t}, j2{j1 + t}; j1 < j2; ++j1)
+                    ButterflyGSLazyNat((*element)[j1], (*element)[j1 + t], omega, preconOmega, modulus, twoModulus);
+            }
+            else {
+                for (uint32_t j1{2 * i * t}, j2{j1 + t}; j1 < j2; ++j1)
+                    ButterflyGSNat((*element)[j1], (*element)[j1 + t], omega, preconOmega, modulus);
+            }
+        }
+    }
+    // each phase returns fully reduced values
+    if (lazy) {
+        for (uint32_t j{block * size}, j1{j + size}; j < j1; ++j)
+            (*element)[j] = ReduceLazyNat((*element)[j], modulus, twoModulus);
+    }
+}
+
+template <typename VecType>
+void NumberTheoreticTransformNat<VecType>::InverseTransformFromBitReverseInPlaceColumns(
+    const VecType& rootOfUnityInverseTable, const VecType& preconRootOfUnityInverseTable, const IntType& cycloOrderInv,
+    const IntType& preconCycloOrderInv, uint32_t logBlocks, uint32_t begin, uint32_t end, VecType* element) {
+    if (logBlocks == 0)
+        OPENFHE_THROW("logBlocks must be positive");
+    const auto modulus{element->GetModulus()};
+    const uint32_t n(element->GetLength());
+    if constexpr (std::is_same_v<VecType, NativeVectorT<NativeIntegerT<uint64_t>>>) {
+        NTTFinalStage fs(rootOfUnityInverseTable[1].ConvertToInt(), cycloOrderInv.ConvertToInt(),
+                         preconCycloOrderInv.ConvertToInt(), modulus.ConvertToInt());
+        if (InverseTransformFromBitReverseColumnsSIMD(
+                reinterpret_cast<uint64_t*>(&(*element)[0]),
+                reinterpret_cast<const uint64_t*>(&rootOfUnityInverseTable[0]),
+                reinterpret_cast<const uint64_t*>(&preconRootOfUnityInverseTable[0]), fs, modulus.ConvertToInt(), n,
+                logBlocks, begin, end))
+            return;
+    }
+    const auto twoModulus{modulus + modulus};
+    const bool lazy{IsLazyReductionModulus(modulus)};
+    const uint32_t stride{n >> logBlocks};
+    for (uint32_t m{uint32_t(1) << (logBlocks - 1)}, t{stride}; m > 1; m >>= 1, t <<= 1) {
+        for (uint32_t i{0}; i < m; ++i) {
+            auto omega{rootOfUnityInverseTable[i + m]};
+            auto preconOmega{preconRootOfUnityInverseTable[i + m]};
+            for (uint32_t j0{2 * i * t}, j2{j0 + t}; j0 < j2; j0 += stride) {
+                if (lazy) {
+                    for (uint32_t j1{j0 + begin}, j3{j0 + end}; j1 < j3; ++j1)
+                        ButterflyGSLazyNat((*element)[j1], (*element)[j1 + t], omega, preconOmega, modulus,
+                                           twoModulus);
+                }
+                else {
+                    for (uint32_t j1{j0 + begin}, j3{j0 + end}; j1 < j3; ++j1)
+                        ButterflyGSNat((*element)[j1], (*element)[j1 + t], omega, preconOmega, modulus);
+                }
+            }
+        }
+    }
+
+    // final stage with the n/2 scalar multiplies by (n inverse) folded in, see InverseTransformFromBitReverseInPlace()
+    auto omega1Inv{rootOfUnityInverseTable[1].ModMulFastConst(cycloOrderInv, modulus, preconCycloOrderInv)};
+    auto preconOmega1Inv{omega1Inv.PrepModMulConst(modulus)};
+    const uint32_t t{n >> 1};
+    for (uint32_t j0{0}; j0 < t; j0 += stride) {
+        for (uint32_t j1{j0 + begin}, j3{j0 + end}; j1 < j3; ++j1) {
+            if (lazy) {
+                ButterflyGSLazyNat((*element)[j1], (*element)[j1 + t], omega1Inv, preconOmega1Inv, modulus,
+                                   twoModulus);
+                (*element)[j1] = ReduceLazyNat(
+                    (*element)[j1].ModMulFastConstLazy(cycloOrderInv, modulus, preconCycloOrderInv), modulus,
+                    twoModulus);
+                (*element)[j1 + t] = ReduceLazyNat((*element)[j1 + t], modulus, twoModulus);
+            }
+            else {
+                ButterflyGSNat((*element)[j1], (*element)[j1 + t], omega1Inv, preconOmega1Inv, modulus);
+                (*element)[j1].ModMulFastConstEq(cycloOrderInv, modulus, preconCycloOrderInv);
+            }
+        }
+    }
+}
+
 template <typename VecType>
 void NumberTheoreticTransformNat<VecType>::InverseTransformFromBitReverse(
     const VecType& element, const VecType& rootOfUnityInverseTable, const VecType& preconRootOfUnityInverseTable,
@@ -660,13 +1056,10 @@ void ChineseRemainderTransformFTTNat<VecType>::ForwardTransformToBitReverseInPla
 
     IntType modulus = element->GetModulus();
 
-    auto mapSearch = m_rootOfUnityReverseTableByModulus.find(modulus);
-    if (mapSearch == m_rootOfUnityReverseTableByModulus.end() || mapSearch->second.GetLength() != CycloOrderHf) {
-        PreCompute(rootOfUnity, CycloOrder, modulus);
-    }
+    const auto& tables = GetTables(rootOfUnity, CycloOrder, modulus);
 
     NumberTheoreticTransformNat<VecType>().ForwardTransformToBitReverseInPlace(
-        m_rootOfUnityReverseTableByModulus[modulus], m_rootOfUnityPreconReverseTableByModulus[modulus], element);
+        tables.rootOfUnityReverse, tables.rootOfUnityPreconReverse, element);
 }
 
 template <typename VecType>
@@ -689,14 +1082,10 @@ void ChineseRemainderTransformFTTNat<VecType>::ForwardTransformToBitReverse(cons
 
     IntType modulus = element.GetModulus();
 
-    auto mapSearch = m_rootOfUnityReverseTableByModulus.find(modulus);
-    if (mapSearch == m_rootOfUnityReverseTableByModulus.end() || mapSearch->second.GetLength() != CycloOrderHf) {
-        PreCompute(rootOfUnity, CycloOrder, modulus);
-    }
+    const auto& tables = GetTables(rootOfUnity, CycloOrder, modulus);
 
-    NumberTheoreticTransformNat<VecType>().ForwardTransformToBitReverse(
-        element, m_rootOfUnityReverseTableByModulus[modulus], m_rootOfUnityPreconReverseTableByModulus[modulus],
-        result);
+    NumberTheoreticTransformNat<VecType>().ForwardTransformToBitReverse(element, tables.rootOfUnityReverse,
+                                                                        tables.rootOfUnityPreconReverse, result);
 
     return;
 }
@@ -720,16 +1109,11 @@ void ChineseRemainderTransformFTTNat<VecType>::InverseTransformFromBitReverseInP
 
     IntType modulus = element->GetModulus();
 
-    auto mapSearch = m_rootOfUnityReverseTableByModulus.find(modulus);
-    if (mapSearch == m_rootOfUnityReverseTableByModulus.end() || mapSearch->second.GetLength() != CycloOrderHf) {
-        PreCompute(rootOfUnity, CycloOrder, modulus);
-    }
+    const auto& tables = GetTables(rootOfUnity, CycloOrder, modulus);
 
-    usint msb = GetMSB(CycloOrderHf - 1);
     NumberTheoreticTransformNat<VecType>().InverseTransformFromBitReverseInPlace(
-        m_rootOfUnityInverseReverseTableByModulus[modulus], m_rootOfUnityInversePreconReverseTableByModulus[modulus],
-        m_cycloOrderInverseTableByModulus[modulus][msb], m_cycloOrderInversePreconTableByModulus[modulus][msb],
-        element);
+        tables.rootOfUnityInverseReverse, tables.rootOfUnityInversePreconReverse, tables.cycloOrderInverse,
+        tables.cycloOrderInversePrecon, element);
 }
 
 template <typename VecType>
@@ -752,10 +1136,7 @@ void ChineseRemainderTransformFTTNat<VecType>::InverseTransformFromBitReverse(co
 
     IntType modulus = element.GetModulus();
 
-    auto mapSearch = m_rootOfUnityReverseTableByModulus.find(modulus);
-    if (mapSearch == m_rootOfUnityReverseTableByModulus.end() || mapSearch->second.GetLength() != CycloOrderHf) {
-        PreCompute(rootOfUnity, CycloOrder, modulus);
-    }
+    const auto& tables = GetTables(rootOfUnity, CycloOrder, modulus);
 
     usint n = element.GetLength();
     result->SetModulus(element.GetModulus());
@@ -763,69 +1144,362 @@ void ChineseRemainderTransformFTTNat<VecType>::InverseTransformFromBitReverse(co
         (*result)[i] = element[i];
     }
 
-    usint msb = GetMSB(CycloOrderHf - 1);
     NumberTheoreticTransformNat<VecType>().InverseTransformFromBitReverseInPlace(
-        m_rootOfUnityInverseReverseTableByModulus[modulus], m_rootOfUnityInversePreconReverseTableByModulus[modulus],
-        m_cycloOrderInverseTableByModulus[modulus][msb], m_cycloOrderInversePreconTableByModulus[modulus][msb], result);
+        tables.rootOfUnityInverseReverse, tables.rootOfUnityInversePreconReverse, tables.cycloOrderInverse,
+        tables.cycloOrderInversePrecon, result);
 
     return;
 }
 
 template <typename VecType>
-void ChineseRemainderTransformFTTNat<VecType>::PreCompute(const IntType& rootOfUnity, const usint CycloOrder,
-                                                          const IntType& modulus) {
-    usint CycloOrderHf = (CycloOrder >> 1);
+void ChineseRemainderTransformFTTNat<VecType>::ForwardTransformToBitReverseInPlace(const NTTTables& tables,
+                                                                                   VecType* element) {
+    if (element->GetLength() != tables.rootOfUnityReverse.GetLength()) {
+        OPENFHE_THROW("element size must be equal to CyclotomicOrder / 2");
+    }
 
-    auto mapSearch = m_rootOfUnityReverseTableByModulus.find(modulus);
-    if (mapSearch == m_rootOfUnityReverseTableByModulus.end() || mapSearch->second.GetLength() != CycloOrderHf) {
-#pragma omp critical
-        {
-            IntType x(1), xinv(1);
-            usint msb  = GetMSB(CycloOrderHf - 1);
-            IntType mu = modulus.ComputeMu();
-            VecType Table(CycloOrderHf, modulus);
-            VecType TableI(CycloOrderHf, modulus);
-            IntType rootOfUnityInverse = rootOfUnity.ModInverse(modulus);
-            usint iinv;
-            for (usint i = 0; i < CycloOrderHf; i++) {
-                iinv         = ReverseBits(i, msb);
-                Table[iinv]  = x;
-                TableI[iinv] = xinv;
-                x.ModMulEq(rootOfUnity, modulus, mu);
-                xinv.ModMulEq(rootOfUnityInverse, modulus, mu);
-            }
-            m_rootOfUnityReverseTableByModulus[modulus]        = Table;
-            m_rootOfUnityInverseReverseTableByModulus[modulus] = TableI;
+    NumberTheoreticTransformNat<VecType>().ForwardTransformToBitReverseInPlace(
+        tables.rootOfUnityReverse, tables.rootOfUnityPreconReverse, element);
+}
 
-            VecType TableCOI(msb + 1, modulus);
-            for (usint i = 0; i < msb + 1; i++) {
-                IntType coInv(IntType(1 << i).ModInverse(modulus));
-                TableCOI[i] = coInv;
-            }
-            m_cycloOrderInverseTableByModulus[modulus] = TableCOI;
+template <typename VecType>
+void ChineseRemainderTransformFTTNat<VecType>::InverseTransformFromBitReverseInPlace(const NTTTables& tables,
+                                                                                     VecType* element) {
+    if (element->GetLength() != tables.rootOfUnityInverseReverse.GetLength()) {
+        OPENFHE_THROW("element size must be equal to CyclotomicOrder / 2");
+    }
 
-            NativeInteger nativeModulus = modulus.ConvertToInt();
-            VecType preconTable(CycloOrderHf, nativeModulus);
-            VecType preconTableI(CycloOrderHf, nativeModulus);
+    NumberTheoreticTransformNat<VecType>().InverseTransformFromBitReverseInPlace(
+        tables.rootOfUnityInverseReverse, tables.rootOfUnityInversePreconReverse, tables.cycloOrderInverse,
+        tables.cycloOrderInversePrecon, element);
+}
 
-            for (usint i = 0; i < CycloOrderHf; i++) {
-                preconTable[i] = NativeInteger(m_rootOfUnityReverseTableByModulus[modulus][i].ConvertToInt())
-                                     .PrepModMulConst(nativeModulus);
-                preconTableI[i] = NativeInteger(m_rootOfUnityInverseReverseTableByModulus[modulus][i].ConvertToInt())
-                                      .PrepModMulConst(nativeModulus);
-            }
+template <typename VecType>
+void ChineseRemainderTransformFTTNat<VecType>::ForwardTransformToBitReverseInPlace(
+    const std::vector<IntType>& rootOfUnity, const usint CycloOrder, const std::vector<VecType*>& elements) {
+    if (rootOfUnity.size() != elements.size()) {
+        OPENFHE_THROW("the number of roots of unity must be equal to the number of elements");
+    }
 
-            VecType preconTableCOI(msb + 1, nativeModulus);
-            for (usint i = 0; i < msb + 1; i++) {
-                preconTableCOI[i] = NativeInteger(m_cycloOrderInverseTableByModulus[modulus][i].ConvertToInt())
-                                        .PrepModMulConst(nativeModulus);
-            }
+    if (!IsPowerOfTwo(CycloOrder)) {
+        OPENFHE_THROW("CyclotomicOrder is not a power of two");
+    }
 
-            m_rootOfUnityPreconReverseTableByModulus[modulus]        = preconTable;
-            m_rootOfUnityInversePreconReverseTableByModulus[modulus] = preconTableI;
-            m_cycloOrderInversePreconTableByModulus[modulus]         = preconTableCOI;
+    // table lookups (and precomputations) are done once per tower, outside of the parallel regions
+    std::vector<const NTTTables*> tables;
+    std::vector<VecType*> towers;
+    tables.reserve(elements.size());
+    towers.reserve(elements.size());
+    for (size_t i = 0; i < elements.size(); ++i) {
+        if (rootOfUnity[i] == IntType(1) || rootOfUnity[i] == IntType(0))
+            continue;
+
+        if (elements[i]->GetLength() != (CycloOrder >> 1)) {
+            OPENFHE_THROW("element size must be equal to CyclotomicOrder / 2");
         }
+
+        tables.push_back(&GetTables(rootOfUnity[i], CycloOrder, elements[i]->GetModulus()));
+        towers.push_back(elements[i]);
     }
+
+    ForwardTransformToBitReverseInPlace(tables, towers);
+}
+
+template <typename VecType>
+void ChineseRemainderTransformFTTNat<VecType>::ForwardTransformToBitReverseInPlace(
+    const std::vector<const NTTTables*>& tables, const std::vector<VecType*>& elements) {
+    if (tables.size() != elements.size()) {
+        OPENFHE_THROW("the number of tables must be equal to the number of elements");
+    }
+    if (elements.empty())
+        return;
+
+    const uint32_t CycloOrderHf(tables[0]->rootOfUnityReverse.GetLength());
+    for (size_t i = 0; i < elements.size(); ++i) {
+        if (elements[i]->GetLength() != CycloOrderHf || tables[i]->rootOfUnityReverse.GetLength() != CycloOrderHf) {
+            OPENFHE_THROW("element size must be equal to CyclotomicOrder / 2");
+        }
+    }
+
+    const uint32_t numTowers(elements.size());
+    const uint32_t logn(GetMSB(CycloOrderHf - 1));
+    NumberTheoreticTransformNat<VecType> ntt;
+    if (logn <= LOG_BATCH_BLOCK_SIZE) {
+        ParallelFor(0, numTowers, OpenFHEParallelControls.GetThreadLimit(numTowers), [&](uint32_t i) {
+            ntt.ForwardTransformToBitReverseInPlace(tables[i]->rootOfUnityReverse, tables[i]->rootOfUnityPreconReverse,
+                                                    elements[i]);
+        });
+        return;
+    }
+
+    // first stages on column chunks of about one block of values each, then the remaining stages per block
+    const uint32_t logBlocks{logn - LOG_BATCH_BLOCK_SIZE};
+    const uint32_t stride{CycloOrderHf >> logBlocks};
+    const uint32_t width{std::min(stride, std::max<uint32_t>(8, stride >> logBlocks))};
+    const uint32_t chunks{stride / width};
+    const uint32_t numColumnTasks{numTowers * chunks};
+    ParallelFor(0, numColumnTasks, OpenFHEParallelControls.GetThreadLimit(numColumnTasks), [&](uint32_t k) {
+        const NTTTables& t{*tables[k / chunks]};
+        const uint32_t c{k % chunks};
+        ntt.ForwardTransformToBitReverseInPlaceColumns(t.rootOfUnityReverse, t.rootOfUnityPreconReverse, logBlocks,
+                                                       c * width, (c + 1) * width, elements[k / chunks]);
+    });
+
+    const uint32_t numBlocks{uint32_t(1) << logBlocks};
+    const uint32_t numBlockTasks{numTowers * numBlocks};
+    ParallelFor(0, numBlockTasks, OpenFHEParallelControls.GetThreadLimit(numBlockTasks), [&](uint32_t k) {
+        const NTTTables& t{*tables[k / numBlocks]};
+        ntt.ForwardTransformToBitReverseInPlaceBlock(t.rootOfUnityReverse, t.rootOfUnityPreconReverse, logBlocks,
+                                                     k % numBlocks, elements[k / numBlocks]);
+    });
+}
+
+template <typename VecType>
+void ChineseRemainderTransformFTTNat<VecType>::InverseTransformFromBitReverseInPlace(
+    const std::vector<IntType>& rootOfUnity, const usint CycloOrder, const std::vector<VecType*>& elements) {
+    if (rootOfUnity.size() != elements.size()) {
+        OPENFHE_THROW("the number of roots of unity must be equal to the number of elements");
+    }
+
+    if (!IsPowerOfTwo(CycloOrder)) {
+        OPENFHE_THROW("CyclotomicOrder is not a power of two");
+    }
+
+    // table lookups (and precomputations) are done once per tower, outside of the parallel regions
+    std::vector<const NTTTables*> tables;
+    std::vector<VecType*> towers;
+    tables.reserve(elements.size());
+    towers.reserve(elements.size());
+    for (size_t i = 0; i < elements.size(); ++i) {
+        if (rootOfUnity[i] == IntType(1) || rootOfUnity[i] == IntType(0))
+            continue;
+
+        if (elements[i]->GetLength() != (CycloOrder >> 1)) {
+            OPENFHE_THROW("element size must be equal to CyclotomicOrder / 2");
+        }
+
+        tables.push_back(&GetTables(rootOfUnity[i], CycloOrder, elements[i]->GetModulus()));
+        towers.push_back(elements[i]);
+    }
+
+    InverseTransformFromBitReverseInPlace(tables, towers);
+}
+
+template <typename VecType>
+void ChineseRemainderTransformFTTNat<VecType>::InverseTransformFromBitReverseInPlace(
+    const std::vector<const NTTTables*>& tables, const std::vector<VecType*>& elements) {
+    if (tables.size() != elements.size()) {
+        OPENFHE_THROW("the number of tables must be equal to the number of elements");
+    }
+    if (elements.empty())
+        return;
+
+    const uint32_t CycloOrderHf(tables[0]->rootOfUnityInverseReverse.GetLength());
+    for (size_t i = 0; i < elements.size(); ++i) {
+        if (elements[i]->GetLength() != CycloOrderHf ||
+            tables[i]->rootOfUnityInverseReverse.GetLength() != CycloOrderHf) {
+            OPENFHE_THROW("element size must be equal to CyclotomicOrder / 2");
+        }
+    }
+
+    const uint32_t numTowers(elements.size());
+    const uint32_t msb(GetMSB(CycloOrderHf - 1));
+    NumberTheoreticTransformNat<VecType> ntt;
+    if (msb <= LOG_BATCH_BLOCK_SIZE) {
+        ParallelFor(0, numTowers, OpenFHEParallelControls.GetThreadLimit(numTowers), [&](uint32_t i) {
+            const NTTTables& t{*tables[i]};
+            ntt.InverseTransformFromBitReverseInPlace(t.rootOfUnityInverseReverse, t.rootOfUnityInversePreconReverse,
+                                                      t.cycloOrderInverse, t.cycloOrderInversePrecon, elements[i]);
+        });
+        return;
+    }
+
+    // first stages per block, then the remaining stages on column chunks of about one block of values each
+    const uint32_t logBlocks{msb - LOG_BATCH_BLOCK_SIZE};
+    const uint32_t numBlocks{uint32_t(1) << logBlocks};
+    const uint32_t numBlockTasks{numTowers * numBlocks};
+    ParallelFor(0, numBlockTasks, OpenFHEParallelControls.GetThreadLimit(numBlockTasks), [&](uint32_t k) {
+        const NTTTables& t{*tables[k / numBlocks]};
+        ntt.InverseTransformFromBitReverseInPlaceBlock(t.rootOfUnityInverseReverse, t.rootOfUnityInversePreconReverse,
+                                                       t.cycloOrderInverse, t.cycloOrderInversePrecon, logBlocks,
+                                                       k % numBlocks, elements[k / numBlocks]);
+    });
+
+    const uint32_t stride{CycloOrderHf >> logBlocks};
+    const uint32_t width{std::min(stride, std::max<uint32_t>(8, stride >> logBlocks))};
+    const uint32_t chunks{stride / width};
+    const uint32_t numColumnTasks{numTowers * chunks};
+    ParallelFor(0, numColumnTasks, OpenFHEParallelControls.GetThreadLimit(numColumnTasks), [&](uint32_t k) {
+        const NTTTables& t{*tables[k / chunks]};
+        const uint32_t c{k % chunks};
+        ntt.InverseTransformFromBitReverseInPlaceColumns(
+            t.rootOfUnityInverseReverse, t.rootOfUnityInversePreconReverse, t.cycloOrderInverse,
+            t.cycloOrderInversePrecon, logBlocks, c * width, (c + 1) * width, elements[k / chunks]);
+    });
+}
+
+template <typename VecType>
+void ChineseRemainderTransformFTTNat<VecType>::InverseTransformMapForward(
+    const std::vector<const NTTTables*>& inTables, const std::vector<const VecType*>& in,
+    const std::vector<VecType*>& work, const std::vector<const NTTTables*>& outTables,
+    const std::vector<VecType*>& out, const std::function<void(uint32_t, uint32_t)>& map) {
+    if (inTables.size() != in.size() || work.size() != in.size() || outTables.size() != out.size()) {
+        OPENFHE_THROW("the number of tables must be equal to the number of elements");
+    }
+    if (in.empty())
+        return;
+
+    const uint32_t CycloOrderHf(inTables[0]->rootOfUnityInverseReverse.GetLength());
+    for (size_t i = 0; i < in.size(); ++i) {
+        if (in[i]->GetLength() != CycloOrderHf || work[i]->GetLength() != CycloOrderHf ||
+            inTables[i]->rootOfUnityInverseReverse.GetLength() != CycloOrderHf) {
+            OPENFHE_THROW("element size must be equal to CyclotomicOrder / 2");
+        }
+    }
+    for (size_t j = 0; j < out.size(); ++j) {
+        if (out[j]->GetLength() != CycloOrderHf || outTables[j]->rootOfUnityReverse.GetLength() != CycloOrderHf) {
+            OPENFHE_THROW("element size must be equal to CyclotomicOrder / 2");
+        }
+    }
+
+    const uint32_t numIn(in.size());
+    const uint32_t logn(GetMSB(CycloOrderHf - 1));
+    if (logn <= LOG_BATCH_BLOCK_SIZE) {
+        // the towers fit in cache: nothing to block
+        ParallelFor(0, numIn, OpenFHEParallelControls.GetThreadLimit(numIn), [&](uint32_t i) {
+            if (work[i] != in[i])
+                *work[i] = *in[i];
+        });
+        InverseTransformFromBitReverseInPlace(inTables, work);
+        ParallelForRange(0, CycloOrderHf, OpenFHEParallelControls.GetThreadLimit(numIn + out.size()),
+                         [&](size_t first, size_t last) { map(first, last); });
+        ForwardTransformToBitReverseInPlace(outTables, out);
+        return;
+    }
+
+    // same blocks and column chunks as the batched transforms
+    const uint32_t logBlocks{logn - LOG_BATCH_BLOCK_SIZE};
+    const uint32_t numBlocks{uint32_t(1) << logBlocks};
+    const uint32_t stride{CycloOrderHf >> logBlocks};
+    const uint32_t width{std::min(stride, std::max<uint32_t>(8, stride >> logBlocks))};
+    const uint32_t chunks{stride / width};
+    NumberTheoreticTransformNat<VecType> ntt;
+
+    // the copy of each block is followed by the first stages of the inverse transform on it
+    const uint32_t numBlockTasks{numIn * numBlocks};
+    ParallelFor(0, numBlockTasks, OpenFHEParallelControls.GetThreadLimit(numBlockTasks), [&](uint32_t k) {
+        const uint32_t i{k / numBlocks};
+        const uint32_t b{k % numBlocks};
+        if (work[i] != in[i]) {
+            for (uint32_t l = b * stride; l < (b + 1) * stride; ++l)
+                (*work[i])[l] = (*in[i])[l];
+        }
+        const NTTTables& t{*inTables[i]};
+        ntt.InverseTransformFromBitReverseInPlaceBlock(t.rootOfUnityInverseReverse, t.rootOfUnityInversePreconReverse,
+                                                       t.cycloOrderInverse, t.cycloOrderInversePrecon, logBlocks, b,
+                                                       work[i]);
+    });
+
+    // a column chunk is final in every input tower after its last inverse stages, so it is mapped and goes
+    // through the first forward stages of the output towers in the same task
+    ParallelFor(0, chunks, OpenFHEParallelControls.GetThreadLimit(chunks), [&](uint32_t c) {
+        const uint32_t begin{c * width};
+        const uint32_t end{begin + width};
+        for (uint32_t i = 0; i < numIn; ++i) {
+            const NTTTables& t{*inTables[i]};
+            ntt.InverseTransformFromBitReverseInPlaceColumns(t.rootOfUnityInverseReverse,
+                                                             t.rootOfUnityInversePreconReverse, t.cycloOrderInverse,
+                                                             t.cycloOrderInversePrecon, logBlocks, begin, end, work[i]);
+        }
+        for (uint32_t b = 0; b < numBlocks; ++b)
+            map(b * stride + begin, b * stride + end);
+        for (size_t j = 0; j < out.size(); ++j) {
+            const NTTTables& t{*outTables[j]};
+            ntt.ForwardTransformToBitReverseInPlaceColumns(t.rootOfUnityReverse, t.rootOfUnityPreconReverse,
+                                                           logBlocks, begin, end, out[j]);
+        }
+    });
+
+    const uint32_t numOut(out.size());
+    const uint32_t numOutTasks{numOut * numBlocks};
+    ParallelFor(0, numOutTasks, OpenFHEParallelControls.GetThreadLimit(numOutTasks), [&](uint32_t k) {
+        const NTTTables& t{*outTables[k / numBlocks]};
+        ntt.ForwardTransformToBitReverseInPlaceBlock(t.rootOfUnityReverse, t.rootOfUnityPreconReverse, logBlocks,
+                                                     k % numBlocks, out[k / numBlocks]);
+    });
+}
+
+template <typename VecType>
+const typename ChineseRemainderTransformFTTNat<VecType>::NTTTables& ChineseRemainderTransformFTTNat<VecType>::GetTables(
+    const IntType& rootOfUnity, const usint CycloOrder, const IntType& modulus) {
+    // an entry of m_tables is never replaced, so the tables stay valid until Reset()
+    const auto key = std::make_pair(modulus, CycloOrder);
+    if (const auto* tables = m_tables.Find(key))
+        return **tables;
+    return *m_tables.GetOrCreate(key, [&]() { return GetSharedTables(rootOfUnity, CycloOrder, modulus); });
+}
+
+template <typename VecType>
+std::shared_ptr<const typename ChineseRemainderTransformFTTNat<VecType>::NTTTables>
+ChineseRemainderTransformFTTNat<VecType>::GetSharedTables(const IntType& rootOfUnity, const usint CycloOrder,
+                                                          const IntType& modulus) {
+    const auto key = std::make_pair(modulus, CycloOrder);
+    if (const auto tables = m_tables.FindShared(key))
+        return *tables;
+    if (const auto shared = m_sharedTables.FindShared(key)) {
+        if (auto tables = shared->tables.lock())
+            return tables;
+    }
+    // two threads creating the handles at once may compute the tables twice; both results are valid
+    auto tables = ComputeTables(rootOfUnity, CycloOrder, modulus);
+    m_sharedTables.Set(key, SharedTables{tables});
+    return tables;
+}
+
+template <typename VecType>
+std::shared_ptr<const typename ChineseRemainderTransformFTTNat<VecType>::NTTTables>
+ChineseRemainderTransformFTTNat<VecType>::ComputeTables(const IntType& rootOfUnity, const usint CycloOrder,
+                                                        const IntType& modulus) {
+    usint CycloOrderHf = (CycloOrder >> 1);
+    usint msb          = GetMSB(CycloOrderHf - 1);
+
+    NTTTables tables;
+    IntType x(1), xinv(1);
+    IntType mu = modulus.ComputeMu();
+    VecType Table(CycloOrderHf, modulus);
+    VecType TableI(CycloOrderHf, modulus);
+    IntType rootOfUnityInverse = rootOfUnity.ModInverse(modulus);
+    usint iinv;
+    for (usint i = 0; i < CycloOrderHf; i++) {
+        iinv         = ReverseBits(i, msb);
+        Table[iinv]  = x;
+        TableI[iinv] = xinv;
+        x.ModMulEq(rootOfUnity, modulus, mu);
+        xinv.ModMulEq(rootOfUnityInverse, modulus, mu);
+    }
+
+    NativeInteger nativeModulus = modulus.ConvertToInt();
+    VecType preconTable(CycloOrderHf, nativeModulus);
+    VecType preconTableI(CycloOrderHf, nativeModulus);
+    for (usint i = 0; i < CycloOrderHf; i++) {
+        preconTable[i]  = NativeInteger(Table[i].ConvertToInt()).PrepModMulConst(nativeModulus);
+        preconTableI[i] = NativeInteger(TableI[i].ConvertToInt()).PrepModMulConst(nativeModulus);
+    }
+
+    tables.rootOfUnityReverse              = std::move(Table);
+    tables.rootOfUnityInverseReverse       = std::move(TableI);
+    tables.rootOfUnityPreconReverse        = std::move(preconTable);
+    tables.rootOfUnityInversePreconReverse = std::move(preconTableI);
+    tables.cycloOrderInverse               = IntType(CycloOrderHf).ModInverse(modulus);
+    tables.cycloOrderInversePrecon =
+        NativeInteger(tables.cycloOrderInverse.ConvertToInt()).PrepModMulConst(nativeModulus);
+    return std::make_shared<const NTTTables>(std::move(tables));
+}
+
+template <typename VecType>
+void ChineseRemainderTransformFTTNat<VecType>::PreCompute(const IntType& rootOfUnity, const usint CycloOrder,
+                                                          const IntType& modulus) {
+    GetTables(rootOfUnity, CycloOrder, modulus);
 }
 
 template <typename VecType>
@@ -847,12 +1521,8 @@ void ChineseRemainderTransformFTTNat<VecType>::PreCompute(std::vector<IntType>&
 
 template <typename VecType>
 void ChineseRemainderTransformFTTNat<VecType>::Reset() {
-    m_cycloOrderInverseTableByModulus.clear();
-    m_cycloOrderInversePreconTableByModulus.clear();
-    m_rootOfUnityReverseTableByModulus.clear();
-    m_rootOfUnityInverseReverseTableByModulus.clear();
-    m_rootOfUnityPreconReverseTableByModulus.clear();
-    m_rootOfUnityInversePreconReverseTableByModulus.clear();
+    m_tables.Clear();
+    m_sharedTables.Clear();
 }
 
 template <typename VecType>
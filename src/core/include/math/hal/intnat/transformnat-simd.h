@@ -0,0 +1,122 @@
+//==================================================================================
+// BSD 2-Clause License
+//
+// Copyright (c) 2014-2022, NJIT, Duality Technologies Inc. and other contributors
+//
+// All rights reserved.
+//
+// Author TPOC: contact@openfhe.org
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice, this
+//    list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+//    this list of conditions and the following disclaimer in the documentation
+//    and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+// OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//==================================================================================
+
+
+/*
+  This file contains the vectorized (AVX2/AVX-512 IFMA) NTT kernels for the native math backend
+ */
+
+#ifndef LBCRYPTO_MATH_HAL_INTNAT_TRANSFORMNAT_SIMD_H
+#define LBCRYPTO_MATH_HAL_INTNAT_TRANSFORMNAT_SIMD_H
+
+#include <cstdint>
+
+namespace intnat {
+
+/**
+ * In-place forward transform in the ring Z_q[X]/(X^n+1) using the highest SIMD level enabled in
+ * lbcrypto::OpenFHESIMDControls. The result is bit-exact with
+ * NumberTheoreticTransformNat::ForwardTransformToBitReverseInPlace() (Shoup's variant).
+ *
+ * @param[in,out] element is the input/output of the transform; all values must be in [0, modulus).
+ * @param rootOfUnityTable is the table with the root of unity powers in bit reverse order.
+ * @param preconRootOfUnityTable is Shoup's precomputation for rootOfUnityTable.
+ * @param modulus is the prime modulus q.
+ * @param n is the ring dimension (power of two).
+ * @return false if no vectorized kernel applies (SIMD disabled, unsupported CPU or parameters);
+ * the caller then runs the scalar transform.
+ */
+bool ForwardTransformToBitReverseInPlaceSIMD(uint64_t* element, const uint64_t* rootOfUnityTable,
+                                             const uint64_t* preconRootOfUnityTable, uint64_t modulus, uint32_t n);
+
+/**
+ * In-place inverse transform in the ring Z_q[X]/(X^n+1) using the highest SIMD level enabled in
+ * lbcrypto::OpenFHESIMDControls. The result is bit-exact with
+ * NumberTheoreticTransformNat::InverseTransformFromBitReverseInPlace() (Shoup's variant).
+ *
+ * @param[in,out] element is the input/output of the transform; all values must be in [0, modulus).
+ * @param rootOfUnityInverseTable is the table with the inverse root of unity powers in bit reverse order.
+ * @param preconRootOfUnityInverseTable is Shoup's precomputation for rootOfUnityInverseTable.
+ * @param cycloOrderInv is inverse of n modulo q.
+ * @param preconCycloOrderInv is Shoup's precomputation for cycloOrderInv.
+ * @param modulus is the prime modulus q.
+ * @param n is the ring dimension (power of two).
+ * @return false if no vectorized kernel applies; the caller then runs the scalar transform.
+ */
+bool InverseTransformFromBitReverseInPlaceSIMD(uint64_t* element, const uint64_t* rootOfUnityInverseTable,
+                                               const uint64_t* preconRootOfUnityInverseTable, uint64_t cycloOrderInv,
+                                               uint64_t preconCycloOrderInv, uint64_t modulus, uint32_t n);
+
+/**
+ * Constants of the last stage of the inverse transform (m = 1), where the multiplication by (n inverse)
+ * is folded into the butterfly as in the scalar implementation.
+ */
+struct NTTFinalStage {
+    NTTFinalStage(uint64_t rootOfUnityInverse1, uint64_t cycloOrderInv, uint64_t preconCycloOrderInv,
+                  uint64_t modulus);
+
+    uint64_t omega1Inv;
+    uint64_t preconOmega1Inv;
+    uint64_t cycloOrderInv;
+    uint64_t preconCycloOrderInv;
+};
+
+/*
+  Cache-blocked decomposition of the transforms used by the batched multi-tower NTT: with
+  stride = n >> logBlocks, the first logBlocks stages of the forward transform only combine values whose
+  indices are congruent modulo stride ("columns"), and the remaining stages operate independently on the
+  2^logBlocks contiguous blocks of stride values. The forward transform is therefore
+  Columns([0, stride)) followed by Block(b) for every b; the inverse transform runs the same phases in the
+  reverse order. Column ranges [begin, end) are subsets of [0, stride) and may be processed by different
+  threads. Each function returns false if no vectorized kernel applies to the given parameters
+  (e.g. begin/end not multiples of the vector width); the caller then runs the scalar code.
+ */
+
+bool ForwardTransformToBitReverseColumnsSIMD(uint64_t* element, const uint64_t* rootOfUnityTable,
+                                             const uint64_t* preconRootOfUnityTable, uint64_t modulus, uint32_t n,
+                                             uint32_t logBlocks, uint32_t begin, uint32_t end);
+
+bool ForwardTransformToBitReverseBlockSIMD(uint64_t* element, const uint64_t* rootOfUnityTable,
+                                           const uint64_t* preconRootOfUnityTable, uint64_t modulus, uint32_t n,
+                                           uint32_t logBlocks, uint32_t block);
+
+bool InverseTransformFromBitReverseBlockSIMD(uint64_t* element, const uint64_t* rootOfUnityInverseTable,
+                                             const uint64_t* preconRootOfUnityInverseTable, const NTTFinalStage& fs,
+                                             uint64_t modulus, uint32_t n, uint32_t logBlocks, uint32_t block);
+
+bool InverseTransformFromBitReverseColumnsSIMD(uint64_t* element, const uint64_t* rootOfUnityInverseTable,
+                                               const uint64_t* preconRootOfUnityInverseTable, const NTTFinalStage& fs,
+                                               uint64_t modulus, uint32_t n, uint32_t logBlocks, uint32_t begin,
+                                               uint32_t end);
+
+}  // namespace intnat
+
+#endif
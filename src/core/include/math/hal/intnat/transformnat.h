@@ -39,8 +39,11 @@
 #include "math/hal/transform.h"
 
 #include "utils/inttypes.h"
+#include "utils/precomputation-registry.h"
 
+#include <functional>
 #include <map>
+#include <memory>
 #include <mutex>
 #include <unordered_map>
 #include <utility>
@@ -66,6 +69,15 @@ struct HashPair {
     }
 };
 
+// hash of a (modulus, cyclotomic order) pair, the key of the precomputed transform tables
+struct HashModulusOrder {
+    template <class IntType, class OrderType>
+    size_t operator()(const std::pair<IntType, OrderType>& p) const {
+        return HashPair::HashCombine(std::hash<uint64_t>{}(static_cast<uint64_t>(p.first.ConvertToInt())),
+                                     std::hash<OrderType>{}(p.second));
+    }
+};
+
 /**
  * @brief Number Theoretic Transform implementation
  */
@@ -161,6 +173,38 @@ public:
     void ForwardTransformToBitReverseInPlace(const VecType& rootOfUnityTable, const VecType& preconRootOfUnityTable,
                                              VecType* element);
 
+    /**
+   * In-place forward transform with Harvey's lazy-reduction butterflies
+   * [https://arxiv.org/abs/1205.2926]: intermediate values are kept in [0, 4q) and
+   * fully reduced once at the end. Requires 4q to fit in a machine word (q < 2^62
+   * for 64-bit native integers); ForwardTransformToBitReverseInPlace() uses it for
+   * such moduli when no vectorized kernel applies, e.g. at SIMD_SCALAR or on CPUs
+   * without AVX2.
+   *
+   * @param &rootOfUnityTable is the table with the root of unity powers in bit
+   * reverse order.
+   * @param &preconRootOfUnityTable is NTL-specific precomputations for
+   * optimized NativeInteger modulo multiplications.
+   * @param[in,out] &element is the input/output of the transform of type VecType and length n.
+   * @return none
+   */
+    void ForwardTransformToBitReverseInPlaceLazy(const VecType& rootOfUnityTable,
+                                                 const VecType& preconRootOfUnityTable, VecType* element);
+
+    /**
+   * In-place forward transform that fully reduces the values after every butterfly;
+   * ForwardTransformToBitReverseInPlace() uses it for moduli too large for lazy reduction.
+   *
+   * @param &rootOfUnityTable is the table with the root of unity powers in bit
+   * reverse order.
+   * @param &preconRootOfUnityTable is NTL-specific precomputations for
+   * optimized NativeInteger modulo multiplications.
+   * @param[in,out] &element is the input/output of the transform of type VecType and length n.
+   * @return none
+   */
+    void ForwardTransformToBitReverseInPlaceReduced(const VecType& rootOfUnityTable,
+                                                    const VecType& preconRootOfUnityTable, VecType* element);
+
     /**
    * Copies \p element into \p result and calls InverseTransformFromBitReverseInPlace()
    *
@@ -239,6 +283,91 @@ public:
                                                const VecType& preconRootOfUnityInverseTable,
                                                const IntType& cycloOrderInv, const IntType& preconCycloOrderInv,
                                                VecType* element);
+
+    /**
+   * In-place inverse transform with Harvey's lazy-reduction butterflies: intermediate
+   * values are kept in [0, 2q) and fully reduced once, in the final stage. Requires
+   * 4q to fit in a machine word (q < 2^62 for 64-bit native integers);
+   * InverseTransformFromBitReverseInPlace() uses it for such moduli when no vectorized
+   * kernel applies, e.g. at SIMD_SCALAR or on CPUs without AVX2.
+   *
+   * @param &rootOfUnityInverseTable is the table with the inverse 2n-th root of
+   * unity powers in bit reverse order.
+   * @param &preconRootOfUnityInverseTable is NTL-specific precomputations for
+   * optimized NativeInteger modulo multiplications.
+   * @param &cycloOrderInv is inverse of n modulo q
+   * @param &preconCycloOrderInv is NTL-specific precomputations for optimized
+   * NativeInteger modulo multiplications.
+   * @param &element[in,out] is the input/output of the transform of type VecType and length n.
+   * @return none
+   */
+    void InverseTransformFromBitReverseInPlaceLazy(const VecType& rootOfUnityInverseTable,
+                                                   const VecType& preconRootOfUnityInverseTable,
+                                                   const IntType& cycloOrderInv, const IntType& preconCycloOrderInv,
+                                                   VecType* element);
+
+    /**
+   * In-place inverse transform that fully reduces the values after every butterfly;
+   * InverseTransformFromBitReverseInPlace() uses it for moduli too large for lazy reduction.
+   *
+   * @param &rootOfUnityInverseTable is the table with the inverse 2n-th root of
+   * unity powers in bit reverse order.
+   * @param &preconRootOfUnityInverseTable is NTL-specific precomputations for
+   * optimized NativeInteger modulo multiplications.
+   * @param &cycloOrderInv is inverse of n modulo q
+   * @param &preconCycloOrderInv is NTL-specific precomputations for optimized
+   * NativeInteger modulo multiplications.
+   * @param &element[in,out] is the input/output of the transform of type VecType and length n.
+   * @return none
+   */
+    void InverseTransformFromBitReverseInPlaceReduced(const VecType& rootOfUnityInverseTable,
+                                                      const VecType& preconRootOfUnityInverseTable,
+                                                      const IntType& cycloOrderInv, const IntType& preconCycloOrderInv,
+                                                      VecType* element);
+
+    /*
+   * Cache-blocked phases of the in-place transforms above, used by the batched multi-tower transforms
+   * of ChineseRemainderTransformFTTNat. With stride = n >> logBlocks, the first logBlocks stages of the
+   * forward transform only combine values whose indices are congruent modulo stride (columns), and the
+   * remaining stages act independently on the 2^logBlocks contiguous blocks of stride values. A forward
+   * transform is ForwardTransformToBitReverseInPlaceColumns() over [0, stride) followed by
+   * ForwardTransformToBitReverseInPlaceBlock() for every block; the inverse transform runs the blocks first.
+   * Column ranges and blocks are disjoint and can be processed concurrently. The results are bit-exact
+   * with the unblocked transforms.
+   */
+
+    /**
+   * Runs the first logBlocks stages of the forward transform on columns [begin, end).
+   */
+    void ForwardTransformToBitReverseInPlaceColumns(const VecType& rootOfUnityTable,
+                                                    const VecType& preconRootOfUnityTable, uint32_t logBlocks,
+                                                    uint32_t begin, uint32_t end, VecType* element);
+
+    /**
+   * Runs the last log(n) - logBlocks stages of the forward transform on block \p block.
+   */
+    void ForwardTransformToBitReverseInPlaceBlock(const VecType& rootOfUnityTable,
+                                                  const VecType& preconRootOfUnityTable, uint32_t logBlocks,
+                                                  uint32_t block, VecType* element);
+
+    /**
+   * Runs the first log(n) - logBlocks stages of the inverse transform on block \p block
+   * (the whole inverse transform if logBlocks == 0).
+   */
+    void InverseTransformFromBitReverseInPlaceBlock(const VecType& rootOfUnityInverseTable,
+                                                    const VecType& preconRootOfUnityInverseTable,
+                                                    const IntType& cycloOrderInv, const IntType& preconCycloOrderInv,
+                                                    uint32_t logBlocks, uint32_t block, VecType* element);
+
+    /**
+   * Runs the last logBlocks stages of the inverse transform, including the scaling by (n inverse),
+   * on columns [begin, end). logBlocks must be positive.
+   */
+    void InverseTransformFromBitReverseInPlaceColumns(const VecType& rootOfUnityInverseTable,
+                                                      const VecType& preconRootOfUnityInverseTable,
+                                                      const IntType& cycloOrderInv, const IntType& preconCycloOrderInv,
+                                                      uint32_t logBlocks, uint32_t begin, uint32_t end,
+                                                      VecType* element);
 };
 
 /**
@@ -249,6 +378,23 @@ class ChineseRemainderTransformFTTNat final : public lbcrypto::ChineseRemainderT
     using IntType = typename VecType::Integer;
 
 public:
+    /**
+   * Precomputed tables of the transforms modulo one prime q for one cyclotomic order 2n
+   */
+    struct NTTTables {
+        /// forward roots of unity for NTT, with bits reversed (aka twiddle factors)
+        VecType rootOfUnityReverse;
+        /// inverse roots of unity for iNTT, with bits reversed (aka inverse twiddle factors)
+        VecType rootOfUnityInverseReverse;
+        /// Shoup's precomputations of the forward roots of unity
+        VecType rootOfUnityPreconReverse;
+        /// Shoup's precomputations of the inverse roots of unity
+        VecType rootOfUnityInversePreconReverse;
+        /// n^(-1) mod q, used to scale the inverse transform, and its Shoup's precomputation
+        IntType cycloOrderInverse;
+        IntType cycloOrderInversePrecon;
+    };
+
     /**
    * Copies \p element into \p result and calls NumberTheoreticTransform::ForwardTransformToBitReverseInPlace()
    *
@@ -318,6 +464,96 @@ public:
    */
     void InverseTransformFromBitReverseInPlace(const IntType& rootOfUnity, const usint CycloOrder, VecType* element);
 
+    /**
+   * Batched in-place forward transform of several towers (e.g. the RNS limbs of a DCRTPoly) in the rings
+   * Z_qi[X]/(X^n+1). Each tower is split into cache-sized blocks and the (tower, block) tasks are
+   * scheduled over all threads, so that the parallelism does not depend on the number of towers and each
+   * task works on data that fits in the L1/L2 caches. The result is bit-exact with calling
+   * ForwardTransformToBitReverseInPlace() on every tower.
+   *
+   * @param &rootOfUnity contains the 2n-th roots of unity of the towers; towers whose root of unity is
+   * 0 or 1 are left unchanged.
+   * @param CycloOrder is 2n, should be a power-of-two or a throw if an error occurs.
+   * @param &elements are the towers (modulus qi, length n) transformed in place.
+   */
+    void ForwardTransformToBitReverseInPlace(const std::vector<IntType>& rootOfUnity, const usint CycloOrder,
+                                             const std::vector<VecType*>& elements);
+
+    /**
+   * Batched in-place inverse transform of several towers, see the batched
+   * ForwardTransformToBitReverseInPlace(). The result is bit-exact with calling
+   * InverseTransformFromBitReverseInPlace() on every tower.
+   *
+   * @param &rootOfUnity contains the 2n-th roots of unity of the towers; towers whose root of unity is
+   * 0 or 1 are left unchanged.
+   * @param CycloOrder is 2n, should be a power-of-two or a throw if an error occurs.
+   * @param &elements are the towers (modulus qi, length n) transformed in place.
+   */
+    void InverseTransformFromBitReverseInPlace(const std::vector<IntType>& rootOfUnity, const usint CycloOrder,
+                                               const std::vector<VecType*>& elements);
+
+    /**
+   * In-place forward transform with tables obtained from GetTables() or GetSharedTables(), e.g. the ones held by
+   * the ring parameters; skips the lookup of the tables by modulus.
+   *
+   * @param &tables are the tables of the modulus of element.
+   * @param[in,out] &element is the input to the transform of type VecType and length n.
+   */
+    void ForwardTransformToBitReverseInPlace(const NTTTables& tables, VecType* element);
+
+    /**
+   * In-place inverse transform with tables obtained from GetTables() or GetSharedTables().
+   *
+   * @param &tables are the tables of the modulus of element.
+   * @param[in,out] &element is the input/output of the transform of type VecType and length n.
+   */
+    void InverseTransformFromBitReverseInPlace(const NTTTables& tables, VecType* element);
+
+    /**
+   * Batched in-place forward transform of several towers with their tables, see the batched
+   * ForwardTransformToBitReverseInPlace() above.
+   *
+   * @param &tables contains the tables of the towers, all for the same cyclotomic order.
+   * @param &elements are the towers (modulus qi, length n) transformed in place.
+   */
+    void ForwardTransformToBitReverseInPlace(const std::vector<const NTTTables*>& tables,
+                                             const std::vector<VecType*>& elements);
+
+    /**
+   * Batched in-place inverse transform of several towers with their tables, see the batched
+   * InverseTransformFromBitReverseInPlace() above.
+   *
+   * @param &tables contains the tables of the towers, all for the same cyclotomic order.
+   * @param &elements are the towers (modulus qi, length n) transformed in place.
+   */
+    void InverseTransformFromBitReverseInPlace(const std::vector<const NTTTables*>& tables,
+                                               const std::vector<VecType*>& elements);
+
+    /**
+   * Fused inverse transform, coefficient-wise map and forward transform of several towers, the building block
+   * of approximate modulus raising and reduction. Copies \p in[i] (evaluation form) into \p work[i] and
+   * transforms it to coefficient form, calls map(first, last) for ranges [first, last) of coefficients that
+   * are in coefficient form in all work towers, and transforms the towers of \p out, which map must set on
+   * [first, last), to evaluation form. For n > 2^LOG_BATCH_BLOCK_SIZE, the last stages of the inverse
+   * transforms, the map and the first stages of the forward transforms run in one task per column chunk of
+   * the batched transforms, i.e., on the same values of all towers while they are in cache; map is called
+   * concurrently for disjoint ranges. The results are bit-exact with the separate transforms.
+   *
+   * @param &inTables contains the tables of the input towers, all for the same cyclotomic order.
+   * @param &in are the input towers, left unchanged; in[i] may be work[i] for an in-place inverse transform.
+   * @param &work receive the input towers in coefficient form; work[i] has length n and the modulus of in[i].
+   * @param &outTables contains the tables of the output towers.
+   * @param &out are the output towers (length n), set by map.
+   * @param &map is called as map(first, last).
+   */
+    void InverseTransformMapForward(const std::vector<const NTTTables*>& inTables,
+                                    const std::vector<const VecType*>& in, const std::vector<VecType*>& work,
+                                    const std::vector<const NTTTables*>& outTables, const std::vector<VecType*>& out,
+                                    const std::function<void(uint32_t, uint32_t)>& map);
+
+    /// log2 of the block size used by the batched transforms: 2^12 64-bit values (32 KB) fit in L1/L2
+    static constexpr uint32_t LOG_BATCH_BLOCK_SIZE{12};
+
     /**
    * Precomputation of root of unity tables for transforms in the ring
    * Z_q[X]/(X^n+1)
@@ -343,29 +579,50 @@ public:
     void PreCompute(std::vector<IntType>& rootOfUnity, const usint CycloOrder, std::vector<IntType>& moduliChain);
 
     /**
-   * Reset cached values for the root of unity tables to empty.
+   * Reset cached values for the root of unity tables to empty. Tables held through handles from
+   * GetSharedTables() stay valid.
    */
     void Reset();
 
-    /// map to store the cyclo order inverse with modulus as a key
-    /// For inverse FTT, we also need #m_cycloOrderInversePreconTableByModulus (this is to use an N-size NTT for FTT instead of 2N-size NTT).
-    static std::map<IntType, VecType> m_cycloOrderInverseTableByModulus;
-
-    /// map to store the cyclo order inverse preconditioned with modulus as a key
-    /// Shoup's precomputation of above #m_cycloOrderInverseTableByModulus
-    static std::map<IntType, VecType> m_cycloOrderInversePreconTableByModulus;
-
-    /// map to store the forward roots of Unity for NTT, with bits reversed, with modulus as a key (aka twiddle factors)
-    static std::map<IntType, VecType> m_rootOfUnityReverseTableByModulus;
-
-    /// map to store inverse roots of unity for iNTT, with bits reversed, with modulus as a key (aka inverse twiddle factors)
-    static std::map<IntType, VecType> m_rootOfUnityInverseReverseTableByModulus;
+    /**
+   * Returns the tables for modulus q and cyclotomic order 2n, computing them on first use.
+   * Lookups are lock-free; the tables are kept by the transform and the returned reference stays valid until
+   * Reset().
+   *
+   * @param &rootOfUnity is the 2n-th root of unity in Z_q, used only if the tables are not computed yet.
+   * @param CycloOrder is a power-of-two, equal to 2n.
+   * @param modulus is q, the prime modulus
+   */
+    static const NTTTables& GetTables(const IntType& rootOfUnity, const usint CycloOrder, const IntType& modulus);
 
-    /// map to store Shoup's precomputations of forward roots of unity for NTT, with bits reversed, with modulus as a key
-    static std::map<IntType, VecType> m_rootOfUnityPreconReverseTableByModulus;
+    /**
+   * Same as GetTables(), but returns a handle owning the tables. Used by the ring parameters to hold on to the
+   * tables of their modulus: unless GetTables() has been called for them, the tables are freed with the last
+   * handle, and handles requested while one is alive share its tables.
+   */
+    static std::shared_ptr<const NTTTables> GetSharedTables(const IntType& rootOfUnity, const usint CycloOrder,
+                                                            const IntType& modulus);
 
-    /// map to store Shoup's precomputations of inverse rou for iNTT, with bits reversed, with modulus as a key
-    static std::map<IntType, VecType> m_rootOfUnityInversePreconReverseTableByModulus;
+private:
+    // tables owned by handles, looked up without keeping them alive
+    struct SharedTables {
+        std::weak_ptr<const NTTTables> tables;
+
+        bool operator==(const SharedTables& rhs) const {
+            return !tables.owner_before(rhs.tables) && !rhs.tables.owner_before(tables);
+        }
+    };
+
+    static std::shared_ptr<const NTTTables> ComputeTables(const IntType& rootOfUnity, const usint CycloOrder,
+                                                          const IntType& modulus);
+
+    /// tables kept by the transform for GetTables(), keyed by (modulus, cyclotomic order)
+    static lbcrypto::PrecomputationRegistry<std::pair<IntType, usint>, std::shared_ptr<const NTTTables>,
+                                            HashModulusOrder>
+        m_tables;
+    /// tables of the handles from GetSharedTables()
+    static lbcrypto::PrecomputationRegistry<std::pair<IntType, usint>, SharedTables, HashModulusOrder>
+        m_sharedTables;
 };
 
 // struct used as a key in BlueStein transform
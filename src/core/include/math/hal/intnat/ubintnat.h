@@ -1490,6 +1490,23 @@ public:
         return *this;
     }
 
+    /**
+   * Modular multiplication using Shoup's precomputation for the multiplicand without
+   * the final correction (lazy reduction, see https://arxiv.org/abs/1205.2926).
+   * The result is congruent to this * b and lies in [0, 2 * modulus); this may be
+   * any single-word value, which requires modulus < 2^(MaxBits() - 1).
+   *
+   * @param &b is the NativeIntegerT to multiply, b < modulus.
+   * @param modulus is the modulus to perform operations with.
+   * @param &bInv precomputation for b.
+   * @return is the result of the modulus multiplication operation in [0, 2 * modulus).
+   */
+    NativeIntegerT ModMulFastConstLazy(const NativeIntegerT& b, const NativeIntegerT& modulus,
+                                       const NativeIntegerT& bInv) const {
+        NativeInt q = MultDHi(m_value, bInv.m_value);
+        return {m_value * b.m_value - q * modulus.m_value};
+    }
+
     /**
    * Modulus exponentiation operation.
    *
@@ -365,6 +365,17 @@ public:
         return a.ModMulEq(b);
     }
 
+    /**
+   * Vector component wise modulus multiply-add: adds b * c to this vector.
+   * In-place variant.
+   *
+   * @param &b is the first vector to multiply.
+   * @param &c is the second vector to multiply.
+   * @return is the result of the component wise modulus multiply-add
+   * operation.
+   */
+    T& ModMulAddEq(const T& b, const T& c);
+
     /**
    * Scalar modulus exponentiation operation.
    *
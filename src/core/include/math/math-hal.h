@@ -101,6 +101,22 @@ using ChineseRemainderTransformFTT = typename FTTTypedef<VecType>::type;
 
 //==============================================================================================
 
+// precomputed NTT tables held by the ring parameters; only the native backend has them
+template <typename IntType>
+struct NTTTablesTypedef {
+    typedef void type;
+};
+
+template <>
+struct NTTTablesTypedef<NativeInteger> {
+    typedef ChineseRemainderTransformFTT<NativeVector>::NTTTables type;
+};
+
+template <typename IntType>
+using NTTTables = typename NTTTablesTypedef<IntType>::type;
+
+//==============================================================================================
+
 template <typename VecType>
 struct ArbTypedef {
     typedef void type;
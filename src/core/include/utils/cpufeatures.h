@@ -0,0 +1,94 @@
+//==================================================================================
+// BSD 2-Clause License
+//
+// Copyright (c) 2014-2022, NJIT, Duality Technologies Inc. and other contributors
+//
+// All rights reserved.
+//
+// Author TPOC: contact@openfhe.org
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice, this
+//    list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+//    this list of conditions and the following disclaimer in the documentation
+//    and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+// OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//==================================================================================
+
+
+/*
+  This file contains the runtime selection of SIMD kernels based on the CPU features
+ */
+
+#ifndef LBCRYPTO_UTILS_CPUFEATURES_H
+#define LBCRYPTO_UTILS_CPUFEATURES_H
+
+#include <ostream>
+
+// SIMD kernels are compiled with per-function target attributes and selected at runtime,
+// so they do not depend on WITH_NATIVEOPT or on the flags the library was built with
+#if defined(__x86_64__) && (defined(__GNUC__) || defined(__clang__)) && !defined(__EMSCRIPTEN__)
+    #define OPENFHE_SIMD_X86
+#endif
+
+namespace lbcrypto {
+
+/**
+ * @brief Instruction set extensions for which the library has vectorized kernels.
+ * The values are ordered: every level implies the support of all levels below it.
+ */
+enum SIMDLevel {
+    SIMD_SCALAR = 0,
+    SIMD_AVX2,
+    SIMD_AVX512,      // AVX-512 F + DQ
+    SIMD_AVX512IFMA,  // AVX-512 F + DQ + IFMA52
+};
+
+std::ostream& operator<<(std::ostream& s, SIMDLevel level);
+
+class SIMDControls {
+public:
+    // @Brief CTOR, detects the instruction set extensions supported by the CPU
+    // and enables the highest supported SIMD level on startup by default
+    SIMDControls();
+
+    // @Brief returns the highest SIMD level supported by the CPU and the OS
+    SIMDLevel GetSupportedLevel() const {
+        return supportedLevel;
+    }
+
+    // @Brief returns the SIMD level currently used by the vectorized kernels
+    SIMDLevel GetLevel() const {
+        return level;
+    }
+
+    // @Brief sets the SIMD level to use (limited by the supported level);
+    // SIMD_SCALAR disables all vectorized kernels
+    void SetLevel(SIMDLevel lvl) {
+        level = lvl > supportedLevel ? supportedLevel : lvl;
+    }
+
+private:
+    SIMDLevel supportedLevel{SIMD_SCALAR};
+    SIMDLevel level{SIMD_SCALAR};
+};
+
+extern SIMDControls OpenFHESIMDControls;
+
+}  // namespace lbcrypto
+
+#endif  // LBCRYPTO_UTILS_CPUFEATURES_H
@@ -36,10 +36,22 @@
 #ifndef SRC_CORE_LIB_UTILS_PARALLEL_H_
 #define SRC_CORE_LIB_UTILS_PARALLEL_H_
 
+#include "config_core.h"
+#include "utils/exception.h"
+
 #ifdef PARALLEL
     #include <omp.h>
 #endif
 
+#ifdef WITH_TASKPOOL
+    #include "utils/taskpool.h"
+    #include <thread>
+#endif
+
+#include <algorithm>
+#include <cstddef>
+#include <exception>
+
 namespace lbcrypto {
 
 class ParallelControls {
@@ -55,6 +67,8 @@ public:
             // omp_set_dynamic(0);
             // omp_set_nested(0);
             // omp_set_max_active_levels(1);
+#elif defined(WITH_TASKPOOL)
+        machineThreads = std::max(static_cast<int>(std::thread::hardware_concurrency()), 1);
 #endif
     }
 
@@ -103,15 +117,19 @@ public:
             }
         }
         return nthreads;
+#elif defined(WITH_TASKPOOL)
+        return machineThreads;
 #else
         return 1;
 #endif
     }
 
-    // @Brief returns min of int n and machineThreads
+    // @Brief returns min of int n, machineThreads and the limit of the innermost ScopedParallelism
+    // of the calling thread
     int GetThreadLimit(int n) const {
-#ifdef PARALLEL
-        return n > machineThreads ? machineThreads : n;
+#if defined(PARALLEL) || defined(WITH_TASKPOOL)
+        int limit = (scopedThreads > 0 && scopedThreads < machineThreads) ? scopedThreads : machineThreads;
+        return n > limit ? limit : n;
 #else
         return 1;
 #endif
@@ -125,12 +143,161 @@ public:
 #endif
     }
 
+    // @Brief returns the limit set by the innermost ScopedParallelism of the calling thread, 0 if there is none
+    static int GetScopedThreads() {
+        return scopedThreads;
+    }
+
 private:
+    friend class ScopedParallelism;
+
     int machineThreads{1};
+    // per-thread limit so that concurrent requests in one process can each use their own number of threads
+    static inline thread_local int scopedThreads{0};
 };
 
 extern ParallelControls OpenFHEParallelControls;
 
+/**
+ * @brief Limits the number of threads used by the library for calls made from the current thread until the
+ * guard goes out of scope; other threads of the process are not affected. It applies to every parallel region
+ * since all of them size their teams with GetThreadLimit or, for the OpenMP regions without a num_threads clause,
+ * with the per-thread OpenMP default that the guard also sets. Guards nest and the innermost one wins, so a
+ * latency-sensitive call can use more threads than the batch job around it; 0 lifts the enclosing limits.
+ *
+ * @code
+ *   ScopedParallelism guard(4);  // this request uses at most 4 threads
+ *   auto ctMult = cc->EvalMult(ct1, ct2);
+ * @endcode
+ */
+class ScopedParallelism {
+public:
+    /**
+     * @param nthreads maximum number of threads, capped by the machine threads; 0 means no limit
+     */
+    explicit ScopedParallelism(int nthreads) : m_previous(ParallelControls::scopedThreads) {
+        if (nthreads < 0)
+            OPENFHE_THROW("the number of threads cannot be negative");
+        ParallelControls::scopedThreads = nthreads;
+#ifdef PARALLEL
+        m_previousOMP = omp_get_max_threads();
+        omp_set_num_threads(OpenFHEParallelControls.GetThreadLimit(OpenFHEParallelControls.GetMachineThreads()));
+#endif
+    }
+
+    ~ScopedParallelism() {
+        ParallelControls::scopedThreads = m_previous;
+#ifdef PARALLEL
+        omp_set_num_threads(m_previousOMP);
+#endif
+    }
+
+    ScopedParallelism(const ScopedParallelism&)            = delete;
+    ScopedParallelism& operator=(const ScopedParallelism&) = delete;
+
+private:
+    int m_previous;
+#ifdef PARALLEL
+    int m_previousOMP{1};
+#endif
+};
+
+#ifdef WITH_TASKPOOL
+/**
+ * @brief Limit handed to the tasks of a pool loop: the tasks run on other threads, so they do not see the
+ * caller's ScopedParallelism. The caller's limit is split between the chunks, which keeps the loops nested in
+ * them within the limit in total.
+ */
+inline int TaskThreadLimit(size_t n, int maxThreads) {
+    const int limit{ParallelControls::GetScopedThreads()};
+    if (limit == 0)
+        return 0;
+    const int chunks{static_cast<int>(std::min<size_t>(n, std::max(maxThreads, 1)))};
+    return std::max(limit / chunks, 1);
+}
+#endif
+
+/**
+ * @brief Runs body(i) for every i in [begin, end) on at most maxThreads threads. With WITH_TASKPOOL the
+ * iterations are scheduled on the persistent work-stealing pool (see utils/taskpool.h), which makes nested
+ * calls safe; otherwise this is an OpenMP parallel for. If body throws, the first exception is rethrown to the
+ * caller once the loop is done.
+ */
+template <typename Function>
+void ParallelFor(size_t begin, size_t end, int maxThreads, Function&& body) {
+#ifdef WITH_TASKPOOL
+    if (end <= begin)
+        return;
+    const int limit{TaskThreadLimit(end - begin, maxThreads)};
+    TaskPool::GetInstance().ParallelFor(begin, end, static_cast<uint32_t>(maxThreads),
+                                        [&body, limit](size_t first, size_t last) {
+                                            ScopedParallelism scope(limit);
+                                            for (size_t i = first; i < last; ++i)
+                                                body(i);
+                                        });
+#else
+    // an exception must not leave an OpenMP region, so it is handed over to the calling thread
+    std::exception_ptr error;
+    #pragma omp parallel for num_threads(maxThreads)
+    for (size_t i = begin; i < end; ++i) {
+        try {
+            body(i);
+        }
+        catch (...) {
+    #pragma omp critical(ParallelForError)
+            if (!error)
+                error = std::current_exception();
+        }
+    }
+    if (error)
+        std::rethrow_exception(error);
+#endif
+}
+
+/**
+ * @brief Splits [begin, end) into at most maxThreads contiguous chunks and runs body(first, last) once per chunk,
+ * so scratch space (the firstprivate variables of an OpenMP loop) is set up once per chunk rather than per index.
+ * Exceptions are handled as in ParallelFor.
+ */
+template <typename Function>
+void ParallelForRange(size_t begin, size_t end, int maxThreads, Function&& body) {
+    if (end <= begin)
+        return;
+#ifdef WITH_TASKPOOL
+    const int limit{TaskThreadLimit(end - begin, maxThreads)};
+    TaskPool::GetInstance().ParallelFor(begin, end, static_cast<uint32_t>(maxThreads),
+                                        [&body, limit](size_t first, size_t last) {
+                                            ScopedParallelism scope(limit);
+                                            body(first, last);
+                                        });
+#elif defined(PARALLEL)
+    const size_t n{end - begin};
+    std::exception_ptr error;
+    #pragma omp parallel num_threads(maxThreads < static_cast<int>(n) ? maxThreads : static_cast<int>(n))
+    {
+        const size_t threads{static_cast<size_t>(omp_get_num_threads())};
+        const size_t t{static_cast<size_t>(omp_get_thread_num())};
+        const size_t q{n / threads};
+        const size_t r{n % threads};
+        const size_t first{begin + t * q + (t < r ? t : r)};
+        const size_t last{first + q + (t < r ? 1 : 0)};
+        try {
+            if (first < last)
+                body(first, last);
+        }
+        catch (...) {
+    #pragma omp critical(ParallelForError)
+            if (!error)
+                error = std::current_exception();
+        }
+    }
+    if (error)
+        std::rethrow_exception(error);
+#else
+    body(begin, end);
+#endif
+}
+
 }  // namespace lbcrypto
 
 #endif /* SRC_CORE_LIB_UTILS_PARALLEL_H_ */
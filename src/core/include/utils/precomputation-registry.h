@@ -0,0 +1,290 @@
+//==================================================================================
+// BSD 2-Clause License
+//
+// Copyright (c) 2014-2022, NJIT, Duality Technologies Inc. and other contributors
+//
+// All rights reserved.
+//
+// Author TPOC: contact@openfhe.org
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice, this
+//    list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+//    this list of conditions and the following disclaimer in the documentation
+//    and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+// OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//==================================================================================
+
+/*
+  This file contains a read-mostly registry for precomputed tables that is safe to use from many threads
+ */
+
+#ifndef LBCRYPTO_UTILS_PRECOMPUTATION_REGISTRY_H
+#define LBCRYPTO_UTILS_PRECOMPUTATION_REGISTRY_H
+
+#include <atomic>
+#include <cstddef>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <utility>
+#include <vector>
+
+namespace lbcrypto {
+
+/**
+ * @brief Thread-safe map from keys (e.g. modulus and cyclotomic order) to immutable precomputed values.
+ *
+ * The entries live in an immutable open-addressing hash table (a snapshot). Lookups load the current snapshot
+ * with one atomic read and probe it without taking a lock. Writers build the new value outside of any lock, then
+ * copy the snapshot with the entry added under a mutex and publish the copy atomically (read-copy-update), so
+ * that concurrent readers see either the old or the new snapshot, both complete. While they probe, lookups
+ * announce themselves in a per-thread reader counter, each on its own cache line, so that lookups from different
+ * threads do not write to shared memory. A replaced snapshot, together with the values only it refers to, is freed
+ * as soon as no lookup is in progress, either by the writer that replaced it or by the last lookup to finish.
+ *
+ * A reference returned by Find() or GetOrCreate() stays valid until its key is replaced by Set() or the registry
+ * is cleared. FindShared() and GetOrCreateShared() return owning handles, which keep a value alive in either case;
+ * Set() does not replace a value by an equal one.
+ *
+ * @tparam Key key type, default-constructible and equality-comparable
+ * @tparam Value type of the precomputed values
+ * @tparam Hash hash function of the keys
+ */
+template <typename Key, typename Value, typename Hash = std::hash<Key>>
+class PrecomputationRegistry {
+public:
+    PrecomputationRegistry() = default;
+
+    PrecomputationRegistry(const PrecomputationRegistry&)            = delete;
+    PrecomputationRegistry& operator=(const PrecomputationRegistry&) = delete;
+
+    /**
+     * @brief Returns the value of key, nullptr if there is none. Lock-free.
+     */
+    const Value* Find(const Key& key) const {
+        ReadGuard guard(*this);
+        const Slot* slot = FindSlot(key, std::memory_order_seq_cst);
+        return (slot != nullptr) ? slot->value.get() : nullptr;
+    }
+
+    /**
+     * @brief Same as Find(), but returns an owning handle that keeps the value alive after it is replaced
+     */
+    std::shared_ptr<const Value> FindShared(const Key& key) const {
+        ReadGuard guard(*this);
+        const Slot* slot = FindSlot(key, std::memory_order_seq_cst);
+        return (slot != nullptr) ? slot->value : nullptr;
+    }
+
+    /**
+     * @brief Returns the value of key, creating it with factory() if there is none. The factory runs without any
+     * lock held, so threads first touching different keys do not wait for each other; if two threads create the
+     * same key at once, the first one to publish wins and the other value is discarded.
+     */
+    template <typename Factory>
+    const Value& GetOrCreate(const Key& key, Factory&& factory) {
+        return *GetOrCreateShared(key, std::forward<Factory>(factory));
+    }
+
+    /**
+     * @brief Same as GetOrCreate(), but returns an owning handle that keeps the value alive after it is replaced
+     * or the registry is cleared
+     */
+    template <typename Factory>
+    std::shared_ptr<const Value> GetOrCreateShared(const Key& key, Factory&& factory) {
+        if (auto value = FindShared(key))
+            return value;
+        auto created = std::make_shared<const Value>(factory());
+        std::lock_guard<std::mutex> lock(m_writeMutex);
+        if (const Slot* slot = FindSlot(key, std::memory_order_relaxed))
+            return slot->value;
+        Publish(key, created);
+        return created;
+    }
+
+    /**
+     * @brief Sets the value of key, replacing the previous one if it differs (Value must be equality-comparable).
+     */
+    const Value& Set(const Key& key, Value value) {
+        std::lock_guard<std::mutex> lock(m_writeMutex);
+        if (const Slot* slot = FindSlot(key, std::memory_order_relaxed)) {
+            if (*slot->value == value)
+                return *slot->value;
+        }
+        return Publish(key, std::make_shared<const Value>(std::move(value)));
+    }
+
+    /**
+     * @brief Returns the number of keys
+     */
+    size_t Size() const {
+        ReadGuard guard(*this);
+        const Snapshot* snapshot = m_current.load(std::memory_order_seq_cst);
+        return (snapshot != nullptr) ? snapshot->size : 0;
+    }
+
+    /**
+     * @brief Returns the number of snapshots held in memory, including the current one
+     */
+    size_t GetRetainedCount() const {
+        std::lock_guard<std::mutex> lock(m_writeMutex);
+        return (m_snapshot != nullptr) + m_retired.size();
+    }
+
+    /**
+     * @brief Removes all entries and frees the retained snapshots. Unlike the other methods this must not run
+     * concurrently with lookups or with the use of references obtained from them.
+     */
+    void Clear() {
+        std::lock_guard<std::mutex> lock(m_writeMutex);
+        m_current.store(nullptr, std::memory_order_release);
+        m_snapshot.reset();
+        m_retired.clear();
+        m_pending.store(false, std::memory_order_relaxed);
+    }
+
+private:
+    // number of reader counters; threads beyond it share counters, which is still correct
+    static constexpr size_t READER_SLOTS = 64;
+
+    struct Slot {
+        Key key{};
+        std::shared_ptr<const Value> value;
+    };
+
+    struct Snapshot {
+        // power-of-two number of slots, at most half of them used, so that probing always ends on an empty slot
+        std::vector<Slot> slots;
+        size_t size{0};
+
+        const Slot* Find(const Key& key) const {
+            const size_t mask = slots.size() - 1;
+            for (size_t i = Hash{}(key) & mask;; i = (i + 1) & mask) {
+                const Slot& slot = slots[i];
+                if (!slot.value)
+                    return nullptr;
+                if (slot.key == key)
+                    return &slot;
+            }
+        }
+
+        void Insert(const Key& key, std::shared_ptr<const Value> value) {
+            const size_t mask = slots.size() - 1;
+            size_t i          = Hash{}(key) & mask;
+            while (slots[i].value)
+                i = (i + 1) & mask;
+            slots[i].key   = key;
+            slots[i].value = std::move(value);
+            ++size;
+        }
+    };
+
+    struct alignas(64) ReaderCount {
+        std::atomic<size_t> count{0};
+    };
+
+    static size_t ReaderSlot() {
+        static std::atomic<size_t> threads{0};
+        static thread_local const size_t slot = threads.fetch_add(1, std::memory_order_relaxed) % READER_SLOTS;
+        return slot;
+    }
+
+    // marks a lookup in progress for the lifetime of the object; the last lookup to finish after a snapshot was
+    // replaced frees it
+    class ReadGuard {
+    public:
+        explicit ReadGuard(const PrecomputationRegistry& registry)
+            : m_registry(registry), m_count(registry.m_readers[ReaderSlot()].count) {
+            m_count.fetch_add(1, std::memory_order_seq_cst);
+        }
+        ~ReadGuard() {
+            m_count.fetch_sub(1, std::memory_order_seq_cst);
+            if (m_registry.m_pending.load(std::memory_order_seq_cst)) {
+                std::lock_guard<std::mutex> lock(m_registry.m_writeMutex);
+                m_registry.Reclaim();
+            }
+        }
+        ReadGuard(const ReadGuard&)            = delete;
+        ReadGuard& operator=(const ReadGuard&) = delete;
+
+    private:
+        const PrecomputationRegistry& m_registry;
+        std::atomic<size_t>& m_count;
+    };
+
+    // lookups load the snapshot with memory_order_seq_cst after announcing themselves, so that a writer that
+    // publishes a snapshot and then sees no reader knows that no lookup can still be probing an older one, and
+    // a lookup that the writer still sees in progress sees m_pending when it finishes; writers, which hold
+    // m_writeMutex, may use memory_order_relaxed
+    const Slot* FindSlot(const Key& key, std::memory_order order) const {
+        const Snapshot* snapshot = m_current.load(order);
+        return (snapshot != nullptr) ? snapshot->Find(key) : nullptr;
+    }
+
+    // called with m_writeMutex held; frees the replaced snapshots if no lookup is in progress
+    void Reclaim() const {
+        for (const auto& reader : m_readers) {
+            if (reader.count.load(std::memory_order_seq_cst) != 0)
+                return;
+        }
+        m_retired.clear();
+        m_pending.store(false, std::memory_order_relaxed);
+    }
+
+    // called with m_writeMutex held
+    const Value& Publish(const Key& key, std::shared_ptr<const Value> value) {
+        const size_t count = (m_snapshot != nullptr) ? m_snapshot->size : 0;
+        size_t capacity    = 16;
+        while (capacity < 2 * (count + 1))
+            capacity <<= 1;
+
+        auto next = std::make_unique<Snapshot>();
+        next->slots.resize(capacity);
+        if (m_snapshot != nullptr) {
+            for (const auto& slot : m_snapshot->slots) {
+                if (slot.value && !(slot.key == key))
+                    next->Insert(slot.key, slot.value);
+            }
+        }
+        const Value& result = *value;
+        next->Insert(key, std::move(value));
+
+        m_current.store(next.get(), std::memory_order_seq_cst);
+        if (m_snapshot != nullptr) {
+            // lookups that start from now on only see the new snapshot
+            m_retired.push_back(std::move(m_snapshot));
+            m_pending.store(true, std::memory_order_seq_cst);
+        }
+        m_snapshot = std::move(next);
+        Reclaim();
+        return result;
+    }
+
+    std::atomic<const Snapshot*> m_current{nullptr};
+    mutable ReaderCount m_readers[READER_SLOTS];
+    // set while replaced snapshots wait for the lookups in progress to finish
+    mutable std::atomic<bool> m_pending{false};
+    mutable std::mutex m_writeMutex;
+    std::unique_ptr<const Snapshot> m_snapshot;
+    // replaced snapshots; each keeps the values it refers to alive
+    mutable std::vector<std::unique_ptr<const Snapshot>> m_retired;
+};
+
+}  // namespace lbcrypto
+
+#endif  // LBCRYPTO_UTILS_PRECOMPUTATION_REGISTRY_H
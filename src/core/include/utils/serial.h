@@ -67,6 +67,7 @@
 #include "cereal/archives/portable_binary.hpp"
 #include "cereal/archives/json.hpp"
 #include "cereal/cereal.hpp"
+#include "cereal/types/array.hpp"
 #include "cereal/types/map.hpp"
 #include "cereal/types/memory.hpp"
 #include "cereal/types/polymorphic.hpp"
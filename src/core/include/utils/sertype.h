@@ -46,6 +46,9 @@ static const SERJSON JSON;  // should be const static to avoid compilation failu
 class SERBINARY {};
 static const SERBINARY BINARY;  // should be const static to avoid compilation failure
 
+class SERRAW {};
+static const SERRAW RAW;  // should be const static to avoid compilation failure
+
 }  // namespace SerType
 
 }  // namespace lbcrypto
@@ -0,0 +1,146 @@
+//==================================================================================
+// BSD 2-Clause License
+//
+// Copyright (c) 2014-2022, NJIT, Duality Technologies Inc. and other contributors
+//
+// All rights reserved.
+//
+// Author TPOC: contact@openfhe.org
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice, this
+//    list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+//    this list of conditions and the following disclaimer in the documentation
+//    and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+// OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//==================================================================================
+
+/*
+  This file contains the persistent work-stealing task pool used by ParallelFor when WITH_TASKPOOL is ON
+ */
+
+#ifndef LBCRYPTO_UTILS_TASKPOOL_H
+#define LBCRYPTO_UTILS_TASKPOOL_H
+
+#include "config_core.h"
+
+#ifdef WITH_TASKPOOL
+
+    #include <atomic>
+    #include <condition_variable>
+    #include <cstddef>
+    #include <cstdint>
+    #include <deque>
+    #include <functional>
+    #include <memory>
+    #include <mutex>
+    #include <thread>
+    #include <vector>
+
+namespace lbcrypto {
+
+/**
+ * @brief Process-wide pool of persistent worker threads. Every worker owns a deque of tasks: it pushes and pops
+ * its own tasks at the back and steals from the front of the other deques when it runs out of work. Threads
+ * that are not workers (the application threads) submit through a shared injection queue.
+ *
+ * A thread waiting for its loop to finish keeps executing queued tasks before it blocks, so a ParallelFor
+ * nested inside another one (a parallel rotation loop calling a parallel SwitchFormat) reuses the same workers
+ * rather than forking a new team, and several application threads can share the pool without oversubscribing
+ * the machine. Since the workers live as long as the process, thread_local scratch buffers survive between
+ * calls.
+ */
+class TaskPool {
+public:
+    using RangeFunction = std::function<void(size_t, size_t)>;
+
+    /**
+     * @brief Returns the pool, starting its workers on first use
+     */
+    static TaskPool& GetInstance();
+
+    /**
+     * @brief Starts a pool with its own workers; ParallelFor() in parallel.h always uses GetInstance()
+     * @param numWorkers number of worker threads
+     */
+    explicit TaskPool(uint32_t numWorkers);
+
+    TaskPool(const TaskPool&)            = delete;
+    TaskPool& operator=(const TaskPool&) = delete;
+    ~TaskPool();
+
+    /**
+     * @brief Splits [begin, end) into at most maxTasks contiguous chunks and runs body(chunkBegin, chunkEnd) on
+     * each of them. The calling thread takes part in the work and returns once all chunks are done; the first
+     * exception thrown by body is rethrown in the calling thread.
+     * @param begin first index
+     * @param end one past the last index
+     * @param maxTasks maximum number of chunks, i.e. of threads working on the range
+     * @param body function run on every chunk
+     */
+    void ParallelFor(size_t begin, size_t end, uint32_t maxTasks, const RangeFunction& body);
+
+    /**
+     * @brief Returns the number of worker threads, not counting the threads that call ParallelFor
+     */
+    uint32_t GetNumWorkers() const {
+        return static_cast<uint32_t>(m_workers.size());
+    }
+
+    /**
+     * @brief Returns true if the calling thread is one of the workers of this pool
+     */
+    bool InWorker() const;
+
+private:
+    struct TaskGroup;
+
+    struct Task {
+        TaskGroup* group;
+        const RangeFunction* body;
+        size_t begin;
+        size_t end;
+    };
+
+    struct alignas(64) Worker {
+        std::mutex mutex;
+        std::deque<Task> tasks;
+        std::thread thread;
+    };
+
+    // index of the calling thread among the workers of this pool, -1 for other threads
+    int WorkerId() const;
+
+    void WorkerLoop(uint32_t id);
+    void Push(Task task);
+    bool Pop(Task& task);
+    void Execute(const Task& task);
+
+    std::vector<std::unique_ptr<Worker>> m_workers;
+    std::mutex m_injectMutex;
+    std::deque<Task> m_inject;
+    std::atomic<size_t> m_queued{0};
+    std::mutex m_sleepMutex;
+    std::condition_variable m_wake;
+    bool m_stop{false};
+};
+
+}  // namespace lbcrypto
+
+#endif  // WITH_TASKPOOL
+
+#endif  // LBCRYPTO_UTILS_TASKPOOL_H
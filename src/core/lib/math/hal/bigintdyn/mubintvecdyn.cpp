@@ -408,6 +408,23 @@ mubintvec<ubint_el_t>& mubintvec<ubint_el_t>::ModMulNoCheckEq(const mubintvec& b
     return *this;
 }
 
+template <class ubint_el_t>
+mubintvec<ubint_el_t>& mubintvec<ubint_el_t>::ModMulAddEq(const mubintvec& b, const mubintvec& c) {
+    if (m_modulus != b.m_modulus || m_modulus != c.m_modulus)
+        OPENFHE_THROW("mubintvec multiplying vectors of different moduli");
+    if (m_data.size() != b.m_data.size() || m_data.size() != c.m_data.size())
+        OPENFHE_THROW("mubintvec multiplying vectors of different lengths");
+    #ifdef NO_BARRETT
+    for (size_t i = 0; i < m_data.size(); ++i)
+        m_data[i].ModAddFastEq(b[i].ModMulFast(c[i], m_modulus), m_modulus);
+    #else
+    auto mu(m_modulus.ComputeMu());
+    for (size_t i = 0; i < m_data.size(); ++i)
+        m_data[i].ModAddFastEq(b[i].ModMulFast(c[i], m_modulus, mu), m_modulus);
+    #endif
+    return *this;
+}
+
 template <class ubint_el_t>
 mubintvec<ubint_el_t> mubintvec<ubint_el_t>::ModExp(const ubint_el_t& b) const {
     auto ans(*this);
@@ -436,6 +436,17 @@ BigVectorFixedT<IntegerType>& BigVectorFixedT<IntegerType>::ModMulNoCheckEq(cons
     return *this;
 }
 
+template <class IntegerType>
+BigVectorFixedT<IntegerType>& BigVectorFixedT<IntegerType>::ModMulAddEq(const BigVectorFixedT& b,
+                                                                        const BigVectorFixedT& c) {
+    if (m_length != b.m_length || m_length != c.m_length || m_modulus != b.m_modulus || m_modulus != c.m_modulus)
+        OPENFHE_THROW("ModMulAddEq called on BigVectorFixedT's with different parameters.");
+    auto mu{m_modulus.ComputeMu()};
+    for (usint i = 0; i < m_length; ++i)
+        m_data[i].ModAddEq(b[i].ModMul(c[i], m_modulus, mu), m_modulus);
+    return *this;
+}
+
 template <class IntegerType>
 BigVectorFixedT<IntegerType> BigVectorFixedT<IntegerType>::ModExp(const IntegerType& b) const {
     BigVectorFixedT ans(*this);
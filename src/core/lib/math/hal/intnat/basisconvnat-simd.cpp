@@ -0,0 +1,263 @@
+//==================================================================================
+// BSD 2-Clause License
+//
+// Copyright (c) 2014-2022, NJIT, Duality Technologies Inc. and other contributors
+//
+// All rights reserved.
+//
+// Author TPOC: contact@openfhe.org
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice, this
+//    list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+//    this list of conditions and the following disclaimer in the documentation
+//    and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+// OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//==================================================================================
+
+
+/*
+  This code provides the vectorized (AVX2/AVX-512) RNS basis conversion kernels for the native math backend.
+  The kernels are compiled with per-function target attributes and dispatched at runtime
+  according to lbcrypto::OpenFHESIMDControls, so the library still runs on CPUs without these extensions.
+ */
+
+#include "math/hal/intnat/basisconvnat-simd.h"
+#include "math/hal/intnat/simd-internal.h"
+
+#include <algorithm>
+
+namespace intnat {
+
+#ifdef OPENFHE_SIMD_INTNAT
+
+// The AVX2 and AVX-512 kernels split the 64x64-bit products y * c into 32-bit limb products,
+//   y * c = ll + (lh + hl) * 2^32 + hh * 2^64,
+// accumulated in three 64-bit lanes with the weights 1, 2^32 and 2^64. For y, c < 2^60 the low halves of ll
+// (< 2^32) never overflow, hh < 2^56, and the middle accumulator (< 2^62 per product) is carried into the
+// high one every LIMB_FLUSH products. MAX_TERMS products keep the high accumulator below 2^64.
+constexpr uint64_t LIMB_MAX_MODULUS{uint64_t(1) << 60};
+constexpr uint32_t LIMB_FLUSH{4};
+constexpr uint32_t MAX_TERMS{255};
+
+// the IFMA kernel accumulates the low and high 52-bit halves of the products; inputs must be below 2^52
+constexpr uint64_t IFMA_MAX_MODULUS{uint64_t(1) << 52};
+
+// ************************************************************************************
+// AVX2: 4 x 64-bit lanes; 64x64-bit products are emulated with 32x32-bit multiplies
+
+// (hi * 2^64 + lo) mod p with mu = floor(2^128 / p), computed as in BarrettUint128ModUint64(): the estimated
+// quotient is at most 2 below the exact one, so two conditional subtractions give the reduced value
+static inline AVX2_TARGET __m256i BarrettAVX2(__m256i hi, __m256i lo, __m256i p, __m256i muLo, __m256i muHi) {
+    // the comparison masks are -1 in the lanes with a carry, so the carries are subtracted
+    __m256i leftHi{MulHi64AVX2(lo, muLo)};
+    __m256i tmp1{_mm256_add_epi64(MulLo64AVX2(lo, muHi), leftHi)};
+    __m256i tmp2{_mm256_sub_epi64(MulHi64AVX2(lo, muHi), CmpLtU64AVX2(tmp1, leftHi))};
+    __m256i sum{_mm256_add_epi64(MulLo64AVX2(hi, muLo), tmp1)};
+    leftHi = _mm256_sub_epi64(MulHi64AVX2(hi, muLo), CmpLtU64AVX2(sum, tmp1));
+    __m256i quot{_mm256_add_epi64(_mm256_add_epi64(MulLo64AVX2(hi, muHi), tmp2), leftHi)};
+    __m256i r{_mm256_sub_epi64(lo, MulLo64AVX2(quot, p))};
+    return ReduceOnceAVX2(ReduceOnceAVX2(r, p), p);
+}
+
+static AVX2_TARGET void FastBaseConvAVX2(const uint64_t* const* in, uint32_t sizeIn, const uint64_t* constants,
+                                         const uint64_t* moduli, const uint64_t* barrettMu, uint64_t* const* out,
+                                         uint32_t sizeOut, uint32_t len) {
+    const __m256i zero{_mm256_setzero_si256()};
+    const __m256i lo32{_mm256_set1_epi64x(0xFFFFFFFF)};
+    for (uint32_t j{0}; j < sizeOut; ++j) {
+        const uint64_t* cj{constants + j * sizeIn};
+        const __m256i p{_mm256_set1_epi64x(moduli[j])};
+        const __m256i muLo{_mm256_set1_epi64x(barrettMu[2 * j])};
+        const __m256i muHi{_mm256_set1_epi64x(barrettMu[2 * j + 1])};
+        for (uint32_t k{0}; k < len; k += 4) {
+            __m256i acc0{zero}, acc1{zero}, acc2{zero};
+            for (uint32_t i0{0}; i0 < sizeIn; i0 += LIMB_FLUSH) {
+                for (uint32_t i{i0}, i1{std::min(sizeIn, i0 + LIMB_FLUSH)}; i < i1; ++i) {
+                    __m256i y{_mm256_loadu_si256(reinterpret_cast<const __m256i*>(in[i] + k))};
+                    __m256i yh{_mm256_srli_epi64(y, 32)};
+                    __m256i c{_mm256_set1_epi64x(cj[i])};
+                    __m256i ch{_mm256_set1_epi64x(cj[i] >> 32)};
+                    __m256i ll{_mm256_mul_epu32(y, c)};
+                    __m256i mid{_mm256_add_epi64(_mm256_mul_epu32(y, ch), _mm256_mul_epu32(yh, c))};
+                    acc0 = _mm256_add_epi64(acc0, _mm256_and_si256(ll, lo32));
+                    acc1 = _mm256_add_epi64(acc1, _mm256_add_epi64(mid, _mm256_srli_epi64(ll, 32)));
+                    acc2 = _mm256_add_epi64(acc2, _mm256_mul_epu32(yh, ch));
+                }
+                acc2 = _mm256_add_epi64(acc2, _mm256_srli_epi64(acc1, 32));
+                acc1 = _mm256_and_si256(acc1, lo32);
+            }
+            // (hi, lo) = acc0 + acc1 * 2^32 + acc2 * 2^64
+            acc1 = _mm256_add_epi64(acc1, _mm256_srli_epi64(acc0, 32));
+            __m256i lo{_mm256_or_si256(_mm256_and_si256(acc0, lo32), _mm256_slli_epi64(acc1, 32))};
+            __m256i hi{_mm256_add_epi64(acc2, _mm256_srli_epi64(acc1, 32))};
+            _mm256_storeu_si256(reinterpret_cast<__m256i*>(out[j] + k), BarrettAVX2(hi, lo, p, muLo, muHi));
+        }
+    }
+}
+
+// ************************************************************************************
+// AVX-512: 8 x 64-bit lanes; the low halves of 64x64-bit products come from AVX-512 DQ
+
+// AVX-512 version of BarrettAVX2()
+static inline AVX512_TARGET __m512i BarrettAVX512(__m512i hi, __m512i lo, __m512i p, __m512i muLo, __m512i muHi) {
+    const __m512i one{_mm512_set1_epi64(1)};
+    __m512i leftHi{MulHi64AVX512(lo, muLo)};
+    __m512i tmp1{_mm512_add_epi64(_mm512_mullo_epi64(lo, muHi), leftHi)};
+    __m512i tmp2{MulHi64AVX512(lo, muHi)};
+    tmp2 = _mm512_mask_add_epi64(tmp2, _mm512_cmplt_epu64_mask(tmp1, leftHi), tmp2, one);
+    __m512i sum{_mm512_add_epi64(_mm512_mullo_epi64(hi, muLo), tmp1)};
+    leftHi = MulHi64AVX512(hi, muLo);
+    leftHi = _mm512_mask_add_epi64(leftHi, _mm512_cmplt_epu64_mask(sum, tmp1), leftHi, one);
+    __m512i quot{_mm512_add_epi64(_mm512_add_epi64(_mm512_mullo_epi64(hi, muHi), tmp2), leftHi)};
+    __m512i r{_mm512_sub_epi64(lo, _mm512_mullo_epi64(quot, p))};
+    return ReduceOnceAVX512(ReduceOnceAVX512(r, p), p);
+}
+
+static AVX512_TARGET void FastBaseConvAVX512(const uint64_t* const* in, uint32_t sizeIn, const uint64_t* constants,
+                                             const uint64_t* moduli, const uint64_t* barrettMu, uint64_t* const* out,
+                                             uint32_t sizeOut, uint32_t len) {
+    const __m512i zero{_mm512_setzero_si512()};
+    const __m512i lo32{_mm512_set1_epi64(0xFFFFFFFF)};
+    for (uint32_t j{0}; j < sizeOut; ++j) {
+        const uint64_t* cj{constants + j * sizeIn};
+        const __m512i p{_mm512_set1_epi64(moduli[j])};
+        const __m512i muLo{_mm512_set1_epi64(barrettMu[2 * j])};
+        const __m512i muHi{_mm512_set1_epi64(barrettMu[2 * j + 1])};
+        for (uint32_t k{0}; k < len; k += 8) {
+            __m512i acc0{zero}, acc1{zero}, acc2{zero};
+            for (uint32_t i0{0}; i0 < sizeIn; i0 += LIMB_FLUSH) {
+                for (uint32_t i{i0}, i1{std::min(sizeIn, i0 + LIMB_FLUSH)}; i < i1; ++i) {
+                    __m512i y{_mm512_loadu_si512(in[i] + k)};
+                    __m512i yh{_mm512_srli_epi64(y, 32)};
+                    __m512i c{_mm512_set1_epi64(cj[i])};
+                    __m512i ch{_mm512_set1_epi64(cj[i] >> 32)};
+                    __m512i ll{_mm512_mul_epu32(y, c)};
+                    __m512i mid{_mm512_add_epi64(_mm512_mul_epu32(y, ch), _mm512_mul_epu32(yh, c))};
+                    acc0 = _mm512_add_epi64(acc0, _mm512_and_si512(ll, lo32));
+                    acc1 = _mm512_add_epi64(acc1, _mm512_add_epi64(mid, _mm512_srli_epi64(ll, 32)));
+                    acc2 = _mm512_add_epi64(acc2, _mm512_mul_epu32(yh, ch));
+                }
+                acc2 = _mm512_add_epi64(acc2, _mm512_srli_epi64(acc1, 32));
+                acc1 = _mm512_and_si512(acc1, lo32);
+            }
+            // (hi, lo) = acc0 + acc1 * 2^32 + acc2 * 2^64
+            acc1 = _mm512_add_epi64(acc1, _mm512_srli_epi64(acc0, 32));
+            __m512i lo{_mm512_or_si512(_mm512_and_si512(acc0, lo32), _mm512_slli_epi64(acc1, 32))};
+            __m512i hi{_mm512_add_epi64(acc2, _mm512_srli_epi64(acc1, 32))};
+            _mm512_storeu_si512(out[j] + k, BarrettAVX512(hi, lo, p, muLo, muHi));
+        }
+    }
+}
+
+// ************************************************************************************
+// AVX-512 IFMA: the products of 52-bit values are accumulated as
+//   sum_i y_i * c_i = accLo + accHi * 2^52
+// with accLo and accHi the sums of the low and high 52-bit halves of the 104-bit products
+
+static IFMA_TARGET void FastBaseConvIFMA(const uint64_t* const* in, uint32_t sizeIn, const uint64_t* constants,
+                                         const uint64_t* moduli, const uint64_t* barrettMu, uint64_t* const* out,
+                                         uint32_t sizeOut, uint32_t len) {
+    const __m512i zero{_mm512_setzero_si512()};
+    const __m512i one{_mm512_set1_epi64(1)};
+    for (uint32_t j{0}; j < sizeOut; ++j) {
+        const uint64_t* cj{constants + j * sizeIn};
+        const __m512i p{_mm512_set1_epi64(moduli[j])};
+        const __m512i muLo{_mm512_set1_epi64(barrettMu[2 * j])};
+        const __m512i muHi{_mm512_set1_epi64(barrettMu[2 * j + 1])};
+        for (uint32_t k{0}; k < len; k += 8) {
+            __m512i accLo{zero}, accHi{zero};
+            for (uint32_t i{0}; i < sizeIn; ++i) {
+                __m512i y{_mm512_loadu_si512(in[i] + k)};
+                __m512i c{_mm512_set1_epi64(cj[i])};
+                accLo = _mm512_madd52lo_epu64(accLo, y, c);
+                accHi = _mm512_madd52hi_epu64(accHi, y, c);
+            }
+            __m512i lo{_mm512_add_epi64(accLo, _mm512_slli_epi64(accHi, 52))};
+            __m512i hi{_mm512_srli_epi64(accHi, 12)};
+            hi = _mm512_mask_add_epi64(hi, _mm512_cmplt_epu64_mask(lo, accLo), hi, one);
+            _mm512_storeu_si512(out[j] + k, BarrettAVX512(hi, lo, p, muLo, muHi));
+        }
+    }
+}
+
+// values [begin, end) of every row, for the lengths that are not a multiple of the vector width
+static void FastBaseConvScalar(const uint64_t* const* in, uint32_t sizeIn, const uint64_t* constants,
+                               const uint64_t* moduli, uint64_t* const* out, uint32_t sizeOut, uint32_t begin,
+                               uint32_t end) {
+    for (uint32_t j{0}; j < sizeOut; ++j) {
+        const uint64_t* cj{constants + j * sizeIn};
+        for (uint32_t k{begin}; k < end; ++k) {
+            uint128_t sum{0};
+            for (uint32_t i{0}; i < sizeIn; ++i)
+                sum += uint128_t(in[i][k]) * cj[i];
+            out[j][k] = static_cast<uint64_t>(sum % moduli[j]);
+        }
+    }
+}
+
+#endif  // OPENFHE_SIMD_INTNAT
+
+lbcrypto::SIMDLevel SelectFastBaseConvKernel(const uint64_t* inModuli, uint32_t sizeIn, const uint64_t* moduli,
+                                             uint32_t sizeOut) {
+#ifdef OPENFHE_SIMD_INTNAT
+    if (sizeIn == 0 || sizeOut == 0 || sizeIn > MAX_TERMS)
+        return lbcrypto::SIMD_SCALAR;
+    uint64_t maxModulus{std::max(*std::max_element(inModuli, inModuli + sizeIn),
+                                 *std::max_element(moduli, moduli + sizeOut))};
+    if (maxModulus > LIMB_MAX_MODULUS)
+        return lbcrypto::SIMD_SCALAR;
+    uint32_t applicable{SIMDKernelBit(lbcrypto::SIMD_AVX2) | SIMDKernelBit(lbcrypto::SIMD_AVX512)};
+    if (maxModulus <= IFMA_MAX_MODULUS)
+        applicable |= SIMDKernelBit(lbcrypto::SIMD_AVX512IFMA);
+    return SelectSIMDKernel(applicable);
+#else
+    return lbcrypto::SIMD_SCALAR;
+#endif
+}
+
+bool FastBaseConvSIMD(lbcrypto::SIMDLevel kernel, const uint64_t* const* in, uint32_t sizeIn,
+                      const uint64_t* constants, const uint64_t* moduli, const uint64_t* barrettMu,
+                      uint64_t* const* out, uint32_t sizeOut, uint32_t len) {
+#ifdef OPENFHE_SIMD_INTNAT
+    if (kernel == lbcrypto::SIMD_SCALAR || sizeOut == 0)
+        return false;
+    // number of values the kernel processes at once
+    uint32_t width{(kernel == lbcrypto::SIMD_AVX2) ? 4u : 8u};
+    uint32_t vecLen{len - len % width};
+    if (kernel == lbcrypto::SIMD_AVX512IFMA)
+        FastBaseConvIFMA(in, sizeIn, constants, moduli, barrettMu, out, sizeOut, vecLen);
+    else if (kernel == lbcrypto::SIMD_AVX512)
+        FastBaseConvAVX512(in, sizeIn, constants, moduli, barrettMu, out, sizeOut, vecLen);
+    else
+        FastBaseConvAVX2(in, sizeIn, constants, moduli, barrettMu, out, sizeOut, vecLen);
+    if (vecLen < len)
+        FastBaseConvScalar(in, sizeIn, constants, moduli, out, sizeOut, vecLen, len);
+    return true;
+#else
+    return false;
+#endif
+}
+
+bool FastBaseConvSIMD(const uint64_t* const* in, const uint64_t* inModuli, uint32_t sizeIn,
+                      const uint64_t* constants, const uint64_t* moduli, const uint64_t* barrettMu,
+                      uint64_t* const* out, uint32_t sizeOut, uint32_t len) {
+    return FastBaseConvSIMD(SelectFastBaseConvKernel(inModuli, sizeIn, moduli, sizeOut), in, sizeIn, constants,
+                            moduli, barrettMu, out, sizeOut, len);
+}
+
+}  // namespace intnat
@@ -0,0 +1,400 @@
+//==================================================================================
+// BSD 2-Clause License
+//
+// Copyright (c) 2014-2022, NJIT, Duality Technologies Inc. and other contributors
+//
+// All rights reserved.
+//
+// Author TPOC: contact@openfhe.org
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice, this
+//    list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+//    this list of conditions and the following disclaimer in the documentation
+//    and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+// OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//==================================================================================
+
+
+
+/*
+  This code provides the vectorized (AVX2/AVX-512) element-wise modular arithmetic kernels for NativeVector.
+  The kernels are compiled with per-function target attributes and dispatched at runtime
+  according to lbcrypto::OpenFHESIMDControls, so the library still runs on CPUs without these extensions.
+ */
+
+#include "math/hal/intnat/mubintvecnat-simd.h"
+#include "math/hal/intnat/simd-internal.h"
+
+namespace intnat {
+
+#ifdef OPENFHE_SIMD_INTNAT
+
+// Shift counts of the Barrett reduction in NativeIntegerT::ModMulFastEq(): with n = GetMSB(modulus) - 2, the
+// product is shifted right by n before the multiplication by mu and the result by s = n + 7. Counts outside
+// [0, 63] (e.g. 64 - s for s > 64) make the vector shifts return 0, so that
+//   (x >> s) mod 2^64 = (lo >> s) | (hi << (64 - s)) | (hi >> (s - 64))
+// holds for any s in [1, 127] with x = hi * 2^64 + lo.
+struct BarrettShifts {
+    explicit BarrettShifts(uint64_t modulus) {
+        int64_t n{62 - __builtin_clzll(modulus)};
+        int64_t s{n + 7};
+        nRight = _mm_cvtsi64_si128(n);
+        nLeft  = _mm_cvtsi64_si128(64 - n);
+        sRight = _mm_cvtsi64_si128(s);
+        sLeft  = _mm_cvtsi64_si128(64 - s);
+        sHigh  = _mm_cvtsi64_si128(s - 64);
+    }
+
+    __m128i nRight;
+    __m128i nLeft;
+    __m128i sRight;
+    __m128i sLeft;
+    __m128i sHigh;
+};
+
+// the scalar code shifts the high word of the product left by 64 - n, which requires n >= 1
+constexpr uint64_t BARRETT_MIN_MODULUS{4};
+
+// ************************************************************************************
+// AVX2: 4 x 64-bit lanes; 64x64-bit products are emulated with 32x32-bit multiplies
+
+// r >= q ? r - q : r
+static inline AVX2_TARGET __m256i SubIfGeAVX2(__m256i r, __m256i q) {
+    return _mm256_sub_epi64(r, _mm256_andnot_si256(CmpLtU64AVX2(r, q), q));
+}
+
+static inline AVX2_TARGET __m256i ModAddAVX2(__m256i a, __m256i b, __m256i q) {
+    return SubIfGeAVX2(_mm256_add_epi64(a, b), q);
+}
+
+static inline AVX2_TARGET __m256i ModSubAVX2(__m256i a, __m256i b, __m256i q) {
+    return _mm256_add_epi64(_mm256_sub_epi64(a, b), _mm256_and_si256(CmpLtU64AVX2(a, b), q));
+}
+
+// Shoup's multiplication with the quotient estimate of NativeIntegerT::ModMulFastConstEq()
+static inline AVX2_TARGET __m256i ModMulConstAVX2(__m256i a, __m256i b, __m256i bPrecon, __m256i q) {
+    __m256i quot{_mm256_add_epi64(MulHi64AVX2(a, bPrecon), _mm256_set1_epi64x(1))};
+    __m256i r{_mm256_sub_epi64(MulLo64AVX2(a, b), MulLo64AVX2(quot, q))};
+    return _mm256_add_epi64(r, _mm256_and_si256(_mm256_cmpgt_epi64(_mm256_setzero_si256(), r), q));
+}
+
+// Barrett multiplication of NativeIntegerT::ModMulFastEq(); only the low words of the 128-bit
+// differences are needed since the scalar code truncates the result to 64 bits
+static inline AVX2_TARGET __m256i ModMulAVX2(__m256i a, __m256i b, __m256i q, __m256i mu, const BarrettShifts& sh) {
+    __m256i lo{MulLo64AVX2(a, b)};
+    __m256i hi{MulHi64AVX2(a, b)};
+    __m256i x{_mm256_or_si256(_mm256_srl_epi64(lo, sh.nRight), _mm256_sll_epi64(hi, sh.nLeft))};
+    __m256i tlo{MulLo64AVX2(x, mu)};
+    __m256i thi{MulHi64AVX2(x, mu)};
+    __m256i quot{_mm256_or_si256(_mm256_or_si256(_mm256_srl_epi64(tlo, sh.sRight), _mm256_sll_epi64(thi, sh.sLeft)),
+                                 _mm256_srl_epi64(thi, sh.sHigh))};
+    return SubIfGeAVX2(_mm256_sub_epi64(lo, MulLo64AVX2(quot, q)), q);
+}
+
+static inline AVX2_TARGET __m256i LoadAVX2(const uint64_t* p) {
+    return _mm256_loadu_si256(reinterpret_cast<const __m256i*>(p));
+}
+
+static inline AVX2_TARGET void StoreAVX2(uint64_t* p, __m256i v) {
+    _mm256_storeu_si256(reinterpret_cast<__m256i*>(p), v);
+}
+
+static AVX2_TARGET size_t ModAddVecAVX2(uint64_t* a, const uint64_t* b, uint64_t modulus, size_t n) {
+    const __m256i q{_mm256_set1_epi64x(modulus)};
+    size_t len{n - n % 4};
+    for (size_t i{0}; i < len; i += 4)
+        StoreAVX2(a + i, ModAddAVX2(LoadAVX2(a + i), LoadAVX2(b + i), q));
+    return len;
+}
+
+static AVX2_TARGET size_t ModAddConstVecAVX2(uint64_t* a, uint64_t b, uint64_t modulus, size_t n) {
+    const __m256i q{_mm256_set1_epi64x(modulus)};
+    const __m256i bv{_mm256_set1_epi64x(b)};
+    size_t len{n - n % 4};
+    for (size_t i{0}; i < len; i += 4)
+        StoreAVX2(a + i, ModAddAVX2(LoadAVX2(a + i), bv, q));
+    return len;
+}
+
+static AVX2_TARGET size_t ModSubVecAVX2(uint64_t* a, const uint64_t* b, uint64_t modulus, size_t n) {
+    const __m256i q{_mm256_set1_epi64x(modulus)};
+    size_t len{n - n % 4};
+    for (size_t i{0}; i < len; i += 4)
+        StoreAVX2(a + i, ModSubAVX2(LoadAVX2(a + i), LoadAVX2(b + i), q));
+    return len;
+}
+
+static AVX2_TARGET size_t ModSubConstVecAVX2(uint64_t* a, uint64_t b, uint64_t modulus, size_t n) {
+    const __m256i q{_mm256_set1_epi64x(modulus)};
+    const __m256i bv{_mm256_set1_epi64x(b)};
+    size_t len{n - n % 4};
+    for (size_t i{0}; i < len; i += 4)
+        StoreAVX2(a + i, ModSubAVX2(LoadAVX2(a + i), bv, q));
+    return len;
+}
+
+static AVX2_TARGET size_t ModMulConstVecAVX2(uint64_t* a, uint64_t b, uint64_t bPrecon, uint64_t modulus,
+                                             size_t n) {
+    const __m256i q{_mm256_set1_epi64x(modulus)};
+    const __m256i bv{_mm256_set1_epi64x(b)};
+    const __m256i bp{_mm256_set1_epi64x(bPrecon)};
+    size_t len{n - n % 4};
+    for (size_t i{0}; i < len; i += 4)
+        StoreAVX2(a + i, ModMulConstAVX2(LoadAVX2(a + i), bv, bp, q));
+    return len;
+}
+
+static AVX2_TARGET size_t ModMulVecAVX2(uint64_t* a, const uint64_t* b, uint64_t modulus, uint64_t mu, size_t n) {
+    const BarrettShifts sh(modulus);
+    const __m256i q{_mm256_set1_epi64x(modulus)};
+    const __m256i m{_mm256_set1_epi64x(mu)};
+    size_t len{n - n % 4};
+    for (size_t i{0}; i < len; i += 4)
+        StoreAVX2(a + i, ModMulAVX2(LoadAVX2(a + i), LoadAVX2(b + i), q, m, sh));
+    return len;
+}
+
+static AVX2_TARGET size_t ModMulAddVecAVX2(uint64_t* a, const uint64_t* b, const uint64_t* c, uint64_t modulus,
+                                           uint64_t mu, size_t n) {
+    const BarrettShifts sh(modulus);
+    const __m256i q{_mm256_set1_epi64x(modulus)};
+    const __m256i m{_mm256_set1_epi64x(mu)};
+    size_t len{n - n % 4};
+    for (size_t i{0}; i < len; i += 4) {
+        __m256i prod{ModMulAVX2(LoadAVX2(b + i), LoadAVX2(c + i), q, m, sh)};
+        StoreAVX2(a + i, ModAddAVX2(LoadAVX2(a + i), prod, q));
+    }
+    return len;
+}
+
+// ************************************************************************************
+// AVX-512: 8 x 64-bit lanes; the low halves of 64x64-bit products come from AVX-512 DQ
+
+// r >= q ? r - q : r
+static inline AVX512_TARGET __m512i SubIfGeAVX512(__m512i r, __m512i q) {
+    return _mm512_mask_sub_epi64(r, _mm512_cmpge_epu64_mask(r, q), r, q);
+}
+
+static inline AVX512_TARGET __m512i ModAddAVX512(__m512i a, __m512i b, __m512i q) {
+    return SubIfGeAVX512(_mm512_add_epi64(a, b), q);
+}
+
+static inline AVX512_TARGET __m512i ModSubAVX512(__m512i a, __m512i b, __m512i q) {
+    __m512i r{_mm512_sub_epi64(a, b)};
+    return _mm512_mask_add_epi64(r, _mm512_cmplt_epu64_mask(a, b), r, q);
+}
+
+// AVX-512 version of ModMulConstAVX2()
+static inline AVX512_TARGET __m512i ModMulConstAVX512(__m512i a, __m512i b, __m512i bPrecon, __m512i q) {
+    __m512i quot{_mm512_add_epi64(MulHi64AVX512(a, bPrecon), _mm512_set1_epi64(1))};
+    __m512i r{_mm512_sub_epi64(_mm512_mullo_epi64(a, b), _mm512_mullo_epi64(quot, q))};
+    return _mm512_mask_add_epi64(r, _mm512_movepi64_mask(r), r, q);
+}
+
+// AVX-512 version of ModMulAVX2()
+static inline AVX512_TARGET __m512i ModMulAVX512(__m512i a, __m512i b, __m512i q, __m512i mu,
+                                                 const BarrettShifts& sh) {
+    __m512i lo{_mm512_mullo_epi64(a, b)};
+    __m512i hi{MulHi64AVX512(a, b)};
+    __m512i x{_mm512_or_si512(_mm512_srl_epi64(lo, sh.nRight), _mm512_sll_epi64(hi, sh.nLeft))};
+    __m512i tlo{_mm512_mullo_epi64(x, mu)};
+    __m512i thi{MulHi64AVX512(x, mu)};
+    __m512i quot{_mm512_or_si512(_mm512_or_si512(_mm512_srl_epi64(tlo, sh.sRight), _mm512_sll_epi64(thi, sh.sLeft)),
+                                 _mm512_srl_epi64(thi, sh.sHigh))};
+    return SubIfGeAVX512(_mm512_sub_epi64(lo, _mm512_mullo_epi64(quot, q)), q);
+}
+
+static AVX512_TARGET size_t ModAddVecAVX512(uint64_t* a, const uint64_t* b, uint64_t modulus, size_t n) {
+    const __m512i q{_mm512_set1_epi64(modulus)};
+    size_t len{n - n % 8};
+    for (size_t i{0}; i < len; i += 8)
+        _mm512_storeu_si512(a + i, ModAddAVX512(_mm512_loadu_si512(a + i), _mm512_loadu_si512(b + i), q));
+    return len;
+}
+
+static AVX512_TARGET size_t ModAddConstVecAVX512(uint64_t* a, uint64_t b, uint64_t modulus, size_t n) {
+    const __m512i q{_mm512_set1_epi64(modulus)};
+    const __m512i bv{_mm512_set1_epi64(b)};
+    size_t len{n - n % 8};
+    for (size_t i{0}; i < len; i += 8)
+        _mm512_storeu_si512(a + i, ModAddAVX512(_mm512_loadu_si512(a + i), bv, q));
+    return len;
+}
+
+static AVX512_TARGET size_t ModSubVecAVX512(uint64_t* a, const uint64_t* b, uint64_t modulus, size_t n) {
+    const __m512i q{_mm512_set1_epi64(modulus)};
+    size_t len{n - n % 8};
+    for (size_t i{0}; i < len; i += 8)
+        _mm512_storeu_si512(a + i, ModSubAVX512(_mm512_loadu_si512(a + i), _mm512_loadu_si512(b + i), q));
+    return len;
+}
+
+static AVX512_TARGET size_t ModSubConstVecAVX512(uint64_t* a, uint64_t b, uint64_t modulus, size_t n) {
+    const __m512i q{_mm512_set1_epi64(modulus)};
+    const __m512i bv{_mm512_set1_epi64(b)};
+    size_t len{n - n % 8};
+    for (size_t i{0}; i < len; i += 8)
+        _mm512_storeu_si512(a + i, ModSubAVX512(_mm512_loadu_si512(a + i), bv, q));
+    return len;
+}
+
+static AVX512_TARGET size_t ModMulConstVecAVX512(uint64_t* a, uint64_t b, uint64_t bPrecon, uint64_t modulus,
+                                                 size_t n) {
+    const __m512i q{_mm512_set1_epi64(modulus)};
+    const __m512i bv{_mm512_set1_epi64(b)};
+    const __m512i bp{_mm512_set1_epi64(bPrecon)};
+    size_t len{n - n % 8};
+    for (size_t i{0}; i < len; i += 8)
+        _mm512_storeu_si512(a + i, ModMulConstAVX512(_mm512_loadu_si512(a + i), bv, bp, q));
+    return len;
+}
+
+static AVX512_TARGET size_t ModMulVecAVX512(uint64_t* a, const uint64_t* b, uint64_t modulus, uint64_t mu,
+                                            size_t n) {
+    const BarrettShifts sh(modulus);
+    const __m512i q{_mm512_set1_epi64(modulus)};
+    const __m512i m{_mm512_set1_epi64(mu)};
+    size_t len{n - n % 8};
+    for (size_t i{0}; i < len; i += 8)
+        _mm512_storeu_si512(a + i, ModMulAVX512(_mm512_loadu_si512(a + i), _mm512_loadu_si512(b + i), q, m, sh));
+    return len;
+}
+
+static AVX512_TARGET size_t ModMulAddVecAVX512(uint64_t* a, const uint64_t* b, const uint64_t* c,
+                                               uint64_t modulus, uint64_t mu, size_t n) {
+    const BarrettShifts sh(modulus);
+    const __m512i q{_mm512_set1_epi64(modulus)};
+    const __m512i m{_mm512_set1_epi64(mu)};
+    size_t len{n - n % 8};
+    for (size_t i{0}; i < len; i += 8) {
+        __m512i prod{ModMulAVX512(_mm512_loadu_si512(b + i), _mm512_loadu_si512(c + i), q, m, sh)};
+        _mm512_storeu_si512(a + i, ModAddAVX512(_mm512_loadu_si512(a + i), prod, q));
+    }
+    return len;
+}
+
+// The element-wise operations gain nothing from the 52-bit IFMA multiplier, so the IFMA level uses AVX-512
+static lbcrypto::SIMDLevel SelectKernel() {
+    return SelectSIMDKernel(SIMDKernelBit(lbcrypto::SIMD_AVX2) | SIMDKernelBit(lbcrypto::SIMD_AVX512));
+}
+
+#endif  // OPENFHE_SIMD_INTNAT
+
+size_t ModAddSIMD(uint64_t* a, const uint64_t* b, uint64_t modulus, size_t n) {
+#ifdef OPENFHE_SIMD_INTNAT
+    switch (SelectKernel()) {
+        case lbcrypto::SIMD_AVX512:
+            return ModAddVecAVX512(a, b, modulus, n);
+        case lbcrypto::SIMD_AVX2:
+            return ModAddVecAVX2(a, b, modulus, n);
+        default:
+            break;
+    }
+#endif
+    return 0;
+}
+
+size_t ModAddConstSIMD(uint64_t* a, uint64_t b, uint64_t modulus, size_t n) {
+#ifdef OPENFHE_SIMD_INTNAT
+    switch (SelectKernel()) {
+        case lbcrypto::SIMD_AVX512:
+            return ModAddConstVecAVX512(a, b, modulus, n);
+        case lbcrypto::SIMD_AVX2:
+            return ModAddConstVecAVX2(a, b, modulus, n);
+        default:
+            break;
+    }
+#endif
+    return 0;
+}
+
+size_t ModSubSIMD(uint64_t* a, const uint64_t* b, uint64_t modulus, size_t n) {
+#ifdef OPENFHE_SIMD_INTNAT
+    switch (SelectKernel()) {
+        case lbcrypto::SIMD_AVX512:
+            return ModSubVecAVX512(a, b, modulus, n);
+        case lbcrypto::SIMD_AVX2:
+            return ModSubVecAVX2(a, b, modulus, n);
+        default:
+            break;
+    }
+#endif
+    return 0;
+}
+
+size_t ModSubConstSIMD(uint64_t* a, uint64_t b, uint64_t modulus, size_t n) {
+#ifdef OPENFHE_SIMD_INTNAT
+    switch (SelectKernel()) {
+        case lbcrypto::SIMD_AVX512:
+            return ModSubConstVecAVX512(a, b, modulus, n);
+        case lbcrypto::SIMD_AVX2:
+            return ModSubConstVecAVX2(a, b, modulus, n);
+        default:
+            break;
+    }
+#endif
+    return 0;
+}
+
+size_t ModMulConstSIMD(uint64_t* a, uint64_t b, uint64_t bPrecon, uint64_t modulus, size_t n) {
+#ifdef OPENFHE_SIMD_INTNAT
+    switch (SelectKernel()) {
+        case lbcrypto::SIMD_AVX512:
+            return ModMulConstVecAVX512(a, b, bPrecon, modulus, n);
+        case lbcrypto::SIMD_AVX2:
+            return ModMulConstVecAVX2(a, b, bPrecon, modulus, n);
+        default:
+            break;
+    }
+#endif
+    return 0;
+}
+
+size_t ModMulSIMD(uint64_t* a, const uint64_t* b, uint64_t modulus, uint64_t mu, size_t n) {
+#ifdef OPENFHE_SIMD_INTNAT
+    if (modulus < BARRETT_MIN_MODULUS)
+        return 0;
+    switch (SelectKernel()) {
+        case lbcrypto::SIMD_AVX512:
+            return ModMulVecAVX512(a, b, modulus, mu, n);
+        case lbcrypto::SIMD_AVX2:
+            return ModMulVecAVX2(a, b, modulus, mu, n);
+        default:
+            break;
+    }
+#endif
+    return 0;
+}
+
+size_t ModMulAddSIMD(uint64_t* a, const uint64_t* b, const uint64_t* c, uint64_t modulus, uint64_t mu, size_t n) {
+#ifdef OPENFHE_SIMD_INTNAT
+    if (modulus < BARRETT_MIN_MODULUS)
+        return 0;
+    switch (SelectKernel()) {
+        case lbcrypto::SIMD_AVX512:
+            return ModMulAddVecAVX512(a, b, c, modulus, mu, n);
+        case lbcrypto::SIMD_AVX2:
+            return ModMulAddVecAVX2(a, b, c, modulus, mu, n);
+        default:
+            break;
+    }
+#endif
+    return 0;
+}
+
+}  // namespace intnat
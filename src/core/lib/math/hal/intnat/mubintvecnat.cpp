@@ -35,12 +35,29 @@
 
 #include "math/math-hal.h"
 #include "math/hal/intnat/mubintvecnat.h"
+#include "math/hal/intnat/mubintvecnat-simd.h"
 #include "math/nbtheory-impl.h"
 
 #include "utils/exception.h"
 
+#include <type_traits>
+
 namespace intnat {
 
+// The element-wise kernels of mubintvecnat-simd.h operate on the raw 64-bit words of the values
+template <class IntegerType>
+constexpr bool HAS_SIMD_KERNELS{std::is_same_v<IntegerType, NativeIntegerT<uint64_t>>};
+
+template <class IntegerType>
+static inline uint64_t* Words(IntegerType* data) {
+    return reinterpret_cast<uint64_t*>(data);
+}
+
+template <class IntegerType>
+static inline const uint64_t* Words(const IntegerType* data) {
+    return reinterpret_cast<const uint64_t*>(data);
+}
+
 template <class IntegerType>
 NativeVectorT<IntegerType>::NativeVectorT(usint length, const IntegerType& modulus,
                                           std::initializer_list<std::string> rhs) noexcept
@@ -195,12 +212,7 @@ NativeVectorT<IntegerType>& NativeVectorT<IntegerType>::ModEq(const IntegerType&
 template <class IntegerType>
 NativeVectorT<IntegerType> NativeVectorT<IntegerType>::ModAdd(const IntegerType& b) const {
     auto ans(*this);
-    auto mv{m_modulus};
-    auto bv{b};
-    if (bv.m_value >= mv.m_value)
-        bv.ModEq(mv);
-    for (size_t i = 0; i < ans.m_data.size(); ++i)
-        ans.m_data[i] = ans.m_data[i].ModAddFast(bv, mv);
+    ans.ModAddEq(b);
     return ans;
 }
 
@@ -210,7 +222,10 @@ NativeVectorT<IntegerType>& NativeVectorT<IntegerType>::ModAddEq(const IntegerTy
     auto bv{b};
     if (bv.m_value >= mv.m_value)
         bv.ModEq(mv);
-    for (size_t i = 0; i < m_data.size(); ++i)
+    size_t i{0};
+    if constexpr (HAS_SIMD_KERNELS<IntegerType>)
+        i = ModAddConstSIMD(Words(m_data.data()), bv.m_value, mv.m_value, m_data.size());
+    for (; i < m_data.size(); ++i)
         m_data[i] = m_data[i].ModAddFast(bv, mv);
     return *this;
 }
@@ -232,10 +247,8 @@ template <class IntegerType>
 NativeVectorT<IntegerType> NativeVectorT<IntegerType>::ModAdd(const NativeVectorT& b) const {
     if (m_modulus != b.m_modulus || m_data.size() != b.m_data.size())
         OPENFHE_THROW("ModAdd called on NativeVectorT's with different parameters.");
-    auto mv{m_modulus};
     auto ans(*this);
-    for (size_t i = 0; i < ans.m_data.size(); ++i)
-        ans.m_data[i].ModAddFastEq(b[i], mv);
+    ans.ModAddNoCheckEq(b);
     return ans;
 }
 
@@ -243,21 +256,25 @@ template <class IntegerType>
 NativeVectorT<IntegerType>& NativeVectorT<IntegerType>::ModAddEq(const NativeVectorT& b) {
     if (m_data.size() != b.m_data.size() || m_modulus != b.m_modulus)
         OPENFHE_THROW("ModAddEq called on NativeVectorT's with different parameters.");
+    return ModAddNoCheckEq(b);
+}
+
+template <class IntegerType>
+NativeVectorT<IntegerType>& NativeVectorT<IntegerType>::ModAddNoCheckEq(const NativeVectorT& b) {
     auto mv{m_modulus};
-    for (size_t i = 0; i < m_data.size(); ++i)
+    size_t size{m_data.size()};
+    size_t i{0};
+    if constexpr (HAS_SIMD_KERNELS<IntegerType>)
+        i = ModAddSIMD(Words(m_data.data()), Words(b.m_data.data()), mv.m_value, size);
+    for (; i < size; ++i)
         m_data[i].ModAddFastEq(b[i], mv);
     return *this;
 }
 
 template <class IntegerType>
 NativeVectorT<IntegerType> NativeVectorT<IntegerType>::ModSub(const IntegerType& b) const {
-    auto mv{m_modulus};
-    auto bv{b};
     auto ans(*this);
-    if (bv.m_value >= mv.m_value)
-        bv.ModEq(mv);
-    for (size_t i = 0; i < ans.m_data.size(); ++i)
-        ans[i].ModSubFastEq(bv, mv);
+    ans.ModSubEq(b);
     return ans;
 }
 
@@ -267,7 +284,10 @@ NativeVectorT<IntegerType>& NativeVectorT<IntegerType>::ModSubEq(const IntegerTy
     auto bv{b};
     if (bv.m_value >= mv.m_value)
         bv.ModEq(mv);
-    for (size_t i = 0; i < m_data.size(); ++i)
+    size_t i{0};
+    if constexpr (HAS_SIMD_KERNELS<IntegerType>)
+        i = ModSubConstSIMD(Words(m_data.data()), bv.m_value, mv.m_value, m_data.size());
+    for (; i < m_data.size(); ++i)
         m_data[i].ModSubFastEq(bv, mv);
     return *this;
 }
@@ -276,10 +296,8 @@ template <class IntegerType>
 NativeVectorT<IntegerType> NativeVectorT<IntegerType>::ModSub(const NativeVectorT& b) const {
     if (m_data.size() != b.m_data.size() || m_modulus != b.m_modulus)
         OPENFHE_THROW("ModSub called on NativeVectorT's with different parameters.");
-    auto mv{m_modulus};
     auto ans(*this);
-    for (size_t i = 0; i < ans.m_data.size(); ++i)
-        ans[i].ModSubFastEq(b[i], mv);
+    ans.ModSubEq(b);
     return ans;
 }
 
@@ -287,21 +305,18 @@ template <class IntegerType>
 NativeVectorT<IntegerType>& NativeVectorT<IntegerType>::ModSubEq(const NativeVectorT& b) {
     if (m_data.size() != b.m_data.size() || m_modulus != b.m_modulus)
         OPENFHE_THROW("ModSubEq called on NativeVectorT's with different parameters.");
-    for (size_t i = 0; i < m_data.size(); ++i)
+    size_t i{0};
+    if constexpr (HAS_SIMD_KERNELS<IntegerType>)
+        i = ModSubSIMD(Words(m_data.data()), Words(b.m_data.data()), m_modulus.m_value, m_data.size());
+    for (; i < m_data.size(); ++i)
         m_data[i].ModSubFastEq(b[i], m_modulus);
     return *this;
 }
 
 template <class IntegerType>
 NativeVectorT<IntegerType> NativeVectorT<IntegerType>::ModMul(const IntegerType& b) const {
-    auto mv{m_modulus};
-    auto bv{b};
     auto ans(*this);
-    if (bv.m_value >= mv.m_value)
-        bv.ModEq(mv);
-    auto bconst{bv.PrepModMulConst(mv)};
-    for (size_t i = 0; i < ans.m_data.size(); ++i)
-        ans[i].ModMulFastConstEq(bv, mv, bconst);
+    ans.ModMulEq(b);
     return ans;
 }
 
@@ -312,7 +327,10 @@ NativeVectorT<IntegerType>& NativeVectorT<IntegerType>::ModMulEq(const IntegerTy
     if (bv.m_value >= mv.m_value)
         bv.ModEq(mv);
     auto bconst{bv.PrepModMulConst(mv)};
-    for (size_t i = 0; i < m_data.size(); ++i)
+    size_t i{0};
+    if constexpr (HAS_SIMD_KERNELS<IntegerType>)
+        i = ModMulConstSIMD(Words(m_data.data()), bv.m_value, bconst.m_value, mv.m_value, m_data.size());
+    for (; i < m_data.size(); ++i)
         m_data[i].ModMulFastConstEq(bv, mv, bconst);
     return *this;
 }
@@ -322,16 +340,7 @@ NativeVectorT<IntegerType> NativeVectorT<IntegerType>::ModMul(const NativeVector
     if (m_data.size() != b.m_data.size() || m_modulus != b.m_modulus)
         OPENFHE_THROW("ModMul called on NativeVectorT's with different parameters.");
     auto ans(*this);
-    uint32_t size(m_data.size());
-    auto mv{m_modulus};
-#ifdef NATIVEINT_BARRET_MOD
-    auto mu{m_modulus.ComputeMu()};
-    for (uint32_t i = 0; i < size; ++i)
-        ans[i].ModMulFastEq(b[i], mv, mu);
-#else
-    for (uint32_t i = 0; i < size; ++i)
-        ans[i].ModMulFastEq(b[i], mv);
-#endif
+    ans.ModMulNoCheckEq(b);
     return ans;
 }
 
@@ -339,11 +348,19 @@ template <class IntegerType>
 NativeVectorT<IntegerType>& NativeVectorT<IntegerType>::ModMulEq(const NativeVectorT& b) {
     if (m_data.size() != b.m_data.size() || m_modulus != b.m_modulus)
         OPENFHE_THROW("ModMulEq called on NativeVectorT's with different parameters.");
+    return ModMulNoCheckEq(b);
+}
+
+template <class IntegerType>
+NativeVectorT<IntegerType>& NativeVectorT<IntegerType>::ModMulNoCheckEq(const NativeVectorT& b) {
     auto mv{m_modulus};
     size_t size{m_data.size()};
 #ifdef NATIVEINT_BARRET_MOD
     auto mu{m_modulus.ComputeMu()};
-    for (size_t i = 0; i < size; ++i)
+    size_t i{0};
+    if constexpr (HAS_SIMD_KERNELS<IntegerType>)
+        i = ModMulSIMD(Words(m_data.data()), Words(b.m_data.data()), mv.m_value, mu.m_value, size);
+    for (; i < size; ++i)
         m_data[i].ModMulFastEq(b[i], mv, mu);
 #else
     for (size_t i = 0; i < size; ++i)
@@ -352,6 +369,28 @@ NativeVectorT<IntegerType>& NativeVectorT<IntegerType>::ModMulEq(const NativeVec
     return *this;
 }
 
+template <class IntegerType>
+NativeVectorT<IntegerType>& NativeVectorT<IntegerType>::ModMulAddEq(const NativeVectorT& b, const NativeVectorT& c) {
+    if (m_data.size() != b.m_data.size() || m_data.size() != c.m_data.size() || m_modulus != b.m_modulus ||
+        m_modulus != c.m_modulus)
+        OPENFHE_THROW("ModMulAddEq called on NativeVectorT's with different parameters.");
+    auto mv{m_modulus};
+    size_t size{m_data.size()};
+#ifdef NATIVEINT_BARRET_MOD
+    auto mu{m_modulus.ComputeMu()};
+    size_t i{0};
+    if constexpr (HAS_SIMD_KERNELS<IntegerType>)
+        i = ModMulAddSIMD(Words(m_data.data()), Words(b.m_data.data()), Words(c.m_data.data()), mv.m_value,
+                          mu.m_value, size);
+    for (; i < size; ++i)
+        m_data[i].ModAddFastEq(b[i].ModMulFast(c[i], mv, mu), mv);
+#else
+    for (size_t i = 0; i < size; ++i)
+        m_data[i].ModAddFastEq(b[i].ModMulFast(c[i], mv), mv);
+#endif
+    return *this;
+}
+
 template <class IntegerType>
 NativeVectorT<IntegerType> NativeVectorT<IntegerType>::ModByTwo() const {
     auto ans(*this);
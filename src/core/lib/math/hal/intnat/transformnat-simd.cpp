@@ -0,0 +1,518 @@
+//==================================================================================
+// BSD 2-Clause License
+//
+// Copyright (c) 2014-2022, NJIT, Duality Technologies Inc. and other contributors
+//
+// All rights reserved.
+//
+// Author TPOC: contact@openfhe.org
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice, this
+//    list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+//    this list of conditions and the following disclaimer in the documentation
+//    and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+// OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//==================================================================================
+
+
+/*
+  This code provides the vectorized (AVX2/AVX-512 IFMA) NTT kernels for the native math backend.
+  The kernels are compiled with per-function target attributes and dispatched at runtime
+  according to lbcrypto::OpenFHESIMDControls, so the library still runs on CPUs without these extensions.
+ */
+
+#include "math/hal/intnat/transformnat-simd.h"
+#include "math/hal/intnat/simd-internal.h"
+
+namespace intnat {
+
+#ifdef OPENFHE_SIMD_INTNAT
+
+// the IFMA kernels use 52-bit lanes: Shoup's reduction needs 2q < 2^52, we keep one bit of headroom
+constexpr uint64_t IFMA_MAX_MODULUS{uint64_t(1) << 50};
+
+// ************************************************************************************
+// AVX2: 4 x 64-bit lanes; 64x64-bit products are emulated with 32x32-bit multiplies
+
+// x * w mod q for x in [0, 2q) using Shoup's precomputation wp = floor(w * 2^64 / q)
+static inline AVX2_TARGET __m256i ModMulFastConstAVX2(__m256i x, __m256i w, __m256i wp, __m256i q) {
+    __m256i r{_mm256_sub_epi64(MulLo64AVX2(x, w), MulLo64AVX2(MulHi64AVX2(x, wp), q))};
+    return ReduceOnceAVX2(r, q);
+}
+
+// Cooley-Tukey butterfly: (lo, hi) -> (lo + w*hi, lo - w*hi)
+static inline AVX2_TARGET void ButterflyCTAVX2(__m256i& lo, __m256i& hi, __m256i w, __m256i wp, __m256i q) {
+    __m256i omegaFactor{ModMulFastConstAVX2(hi, w, wp, q)};
+    hi = ReduceOnceAVX2(_mm256_add_epi64(_mm256_sub_epi64(lo, omegaFactor), q), q);
+    lo = ReduceOnceAVX2(_mm256_add_epi64(lo, omegaFactor), q);
+}
+
+// Gentleman-Sande butterfly: (lo, hi) -> (lo + hi, (lo - hi)*w)
+static inline AVX2_TARGET void ButterflyGSAVX2(__m256i& lo, __m256i& hi, __m256i w, __m256i wp, __m256i q) {
+    __m256i diff{_mm256_add_epi64(_mm256_sub_epi64(lo, hi), q)};
+    lo = ReduceOnceAVX2(_mm256_add_epi64(lo, hi), q);
+    hi = ModMulFastConstAVX2(diff, w, wp, q);
+}
+
+// Stages with t < 4 operate on blocks of 8 consecutive values spanning 8/(2t) butterfly groups. The values
+// are regrouped so that lanes of "lo" and "hi" hold matching butterfly inputs, and the twiddles are
+// permuted accordingly (t == 1 uses the lane order 0,2,1,3 to avoid cross-lane shuffles).
+template <bool CT>
+static inline AVX2_TARGET void SmallStageAVX2(uint64_t* element, const uint64_t* table, const uint64_t* precon,
+                                              __m256i q, uint32_t m, uint32_t t, uint32_t j0, uint32_t j1) {
+    for (uint32_t j{j0}; j < j1; j += 8) {
+        __m256i x{_mm256_loadu_si256(reinterpret_cast<const __m256i*>(element + j))};
+        __m256i y{_mm256_loadu_si256(reinterpret_cast<const __m256i*>(element + j + 4))};
+        __m256i lo, hi, w, wp;
+        if (t == 2) {
+            const uint64_t* tw{table + m + (j >> 2)};
+            const uint64_t* twp{precon + m + (j >> 2)};
+            lo = _mm256_permute2x128_si256(x, y, 0x20);
+            hi = _mm256_permute2x128_si256(x, y, 0x31);
+            w  = _mm256_permute4x64_epi64(
+                _mm256_castsi128_si256(_mm_loadu_si128(reinterpret_cast<const __m128i*>(tw))), 0x50);
+            wp = _mm256_permute4x64_epi64(
+                _mm256_castsi128_si256(_mm_loadu_si128(reinterpret_cast<const __m128i*>(twp))), 0x50);
+        }
+        else {
+            const uint64_t* tw{table + m + (j >> 1)};
+            const uint64_t* twp{precon + m + (j >> 1)};
+            lo = _mm256_unpacklo_epi64(x, y);
+            hi = _mm256_unpackhi_epi64(x, y);
+            w  = _mm256_permute4x64_epi64(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(tw)), 0xD8);
+            wp = _mm256_permute4x64_epi64(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(twp)), 0xD8);
+        }
+        if (CT)
+            ButterflyCTAVX2(lo, hi, w, wp, q);
+        else
+            ButterflyGSAVX2(lo, hi, w, wp, q);
+        if (t == 2) {
+            x = _mm256_permute2x128_si256(lo, hi, 0x20);
+            y = _mm256_permute2x128_si256(lo, hi, 0x31);
+        }
+        else {
+            x = _mm256_unpacklo_epi64(lo, hi);
+            y = _mm256_unpackhi_epi64(lo, hi);
+        }
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(element + j), x);
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(element + j + 4), y);
+    }
+}
+
+// butterflies (j, j + t) for j in [j0, j1) sharing the same twiddle
+template <bool CT>
+static inline AVX2_TARGET void ButterflyRunAVX2(uint64_t* element, uint32_t j0, uint32_t j1, uint32_t t,
+                                                __m256i w, __m256i wp, __m256i q) {
+    for (uint32_t j{j0}; j < j1; j += 4) {
+        __m256i lo{_mm256_loadu_si256(reinterpret_cast<const __m256i*>(element + j))};
+        __m256i hi{_mm256_loadu_si256(reinterpret_cast<const __m256i*>(element + j + t))};
+        if (CT)
+            ButterflyCTAVX2(lo, hi, w, wp, q);
+        else
+            ButterflyGSAVX2(lo, hi, w, wp, q);
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(element + j), lo);
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(element + j + t), hi);
+    }
+}
+
+// butterfly groups [i0, i1) of a stage with t >= 4
+template <bool CT>
+static inline AVX2_TARGET void LargeStageAVX2(uint64_t* element, const uint64_t* table, const uint64_t* precon,
+                                              __m256i q, uint32_t m, uint32_t t, uint32_t i0, uint32_t i1) {
+    for (uint32_t i{i0}; i < i1; ++i) {
+        uint32_t j0{2 * i * t};
+        ButterflyRunAVX2<CT>(element, j0, j0 + t, t, _mm256_set1_epi64x(table[i + m]),
+                             _mm256_set1_epi64x(precon[i + m]), q);
+    }
+}
+
+// final inverse stage (m = 1, t = n/2) over [j0, j1) with the scalar multiplies by (n inverse) folded in,
+// as in the scalar implementation
+static inline AVX2_TARGET void FinalStageAVX2(uint64_t* element, uint32_t j0, uint32_t j1, uint32_t t,
+                                              const NTTFinalStage& fs, __m256i q) {
+    const __m256i w{_mm256_set1_epi64x(fs.omega1Inv)};
+    const __m256i wp{_mm256_set1_epi64x(fs.preconOmega1Inv)};
+    const __m256i nInv{_mm256_set1_epi64x(fs.cycloOrderInv)};
+    const __m256i nInvp{_mm256_set1_epi64x(fs.preconCycloOrderInv)};
+    for (uint32_t j{j0}; j < j1; j += 4) {
+        __m256i lo{_mm256_loadu_si256(reinterpret_cast<const __m256i*>(element + j))};
+        __m256i hi{_mm256_loadu_si256(reinterpret_cast<const __m256i*>(element + j + t))};
+        ButterflyGSAVX2(lo, hi, w, wp, q);
+        lo = ModMulFastConstAVX2(lo, nInv, nInvp, q);
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(element + j), lo);
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(element + j + t), hi);
+    }
+}
+
+static AVX2_TARGET void ForwardColumnsAVX2(uint64_t* element, const uint64_t* table, const uint64_t* precon,
+                                           uint64_t modulus, uint32_t n, uint32_t logBlocks, uint32_t begin,
+                                           uint32_t end) {
+    const __m256i q{_mm256_set1_epi64x(modulus)};
+    const uint32_t stride{n >> logBlocks};
+    for (uint32_t s{0}, m{1}, t{n >> 1}; s < logBlocks; ++s, m <<= 1, t >>= 1) {
+        for (uint32_t i{0}; i < m; ++i) {
+            const __m256i w{_mm256_set1_epi64x(table[i + m])};
+            const __m256i wp{_mm256_set1_epi64x(precon[i + m])};
+            for (uint32_t j{2 * i * t}, j2{j + t}; j < j2; j += stride)
+                ButterflyRunAVX2<true>(element, j + begin, j + end, t, w, wp, q);
+        }
+    }
+}
+
+static AVX2_TARGET void ForwardBlockAVX2(uint64_t* element, const uint64_t* table, const uint64_t* precon,
+                                         uint64_t modulus, uint32_t n, uint32_t logBlocks, uint32_t block) {
+    const __m256i q{_mm256_set1_epi64x(modulus)};
+    const uint32_t size{n >> logBlocks};
+    for (uint32_t m{uint32_t(1) << logBlocks}, t{size >> 1}; t >= 1; m <<= 1, t >>= 1) {
+        uint32_t groups{m >> logBlocks};
+        if (t >= 4)
+            LargeStageAVX2<true>(element, table, precon, q, m, t, block * groups, (block + 1) * groups);
+        else
+            SmallStageAVX2<true>(element, table, precon, q, m, t, block * size, (block + 1) * size);
+    }
+}
+
+static AVX2_TARGET void InverseBlockAVX2(uint64_t* element, const uint64_t* table, const uint64_t* precon,
+                                         const NTTFinalStage& fs, uint64_t modulus, uint32_t n, uint32_t logBlocks,
+                                         uint32_t block) {
+    const __m256i q{_mm256_set1_epi64x(modulus)};
+    const uint32_t size{n >> logBlocks};
+    for (uint32_t m{n >> 1}, t{1}; t < size && m > 1; m >>= 1, t <<= 1) {
+        uint32_t groups{m >> logBlocks};
+        if (t >= 4)
+            LargeStageAVX2<false>(element, table, precon, q, m, t, block * groups, (block + 1) * groups);
+        else
+            SmallStageAVX2<false>(element, table, precon, q, m, t, block * size, (block + 1) * size);
+    }
+    if (logBlocks == 0)
+        FinalStageAVX2(element, 0, n >> 1, n >> 1, fs, q);
+}
+
+static AVX2_TARGET void InverseColumnsAVX2(uint64_t* element, const uint64_t* table, const uint64_t* precon,
+                                           const NTTFinalStage& fs, uint64_t modulus, uint32_t n, uint32_t logBlocks,
+                                           uint32_t begin, uint32_t end) {
+    const __m256i q{_mm256_set1_epi64x(modulus)};
+    const uint32_t stride{n >> logBlocks};
+    for (uint32_t m{uint32_t(1) << (logBlocks - 1)}, t{n >> logBlocks}; m > 1; m >>= 1, t <<= 1) {
+        for (uint32_t i{0}; i < m; ++i) {
+            const __m256i w{_mm256_set1_epi64x(table[i + m])};
+            const __m256i wp{_mm256_set1_epi64x(precon[i + m])};
+            for (uint32_t j{2 * i * t}, j2{j + t}; j < j2; j += stride)
+                ButterflyRunAVX2<false>(element, j + begin, j + end, t, w, wp, q);
+        }
+    }
+    for (uint32_t j{0}, t{n >> 1}; j < t; j += stride)
+        FinalStageAVX2(element, j + begin, j + end, t, fs, q);
+}
+
+// ************************************************************************************
+// AVX-512 IFMA: 8 x 52-bit lanes; Shoup's precomputation for 52-bit words is floor(w * 2^52 / q),
+// which is derived from the 64-bit one as wp >> 12
+
+// x * w mod q for x in [0, 2q) and wp = floor(w * 2^52 / q)
+static inline IFMA_TARGET __m512i ModMulFastConstIFMA(__m512i x, __m512i w, __m512i wp, __m512i q) {
+    const __m512i zero{_mm512_setzero_si512()};
+    const __m512i mask52{_mm512_set1_epi64((uint64_t(1) << 52) - 1)};
+    __m512i qhat{_mm512_madd52hi_epu64(zero, x, wp)};
+    __m512i r{_mm512_sub_epi64(_mm512_madd52lo_epu64(zero, x, w), _mm512_madd52lo_epu64(zero, qhat, q))};
+    return ReduceOnceAVX512(_mm512_and_si512(r, mask52), q);
+}
+
+static inline IFMA_TARGET void ButterflyCTIFMA(__m512i& lo, __m512i& hi, __m512i w, __m512i wp, __m512i q) {
+    __m512i omegaFactor{ModMulFastConstIFMA(hi, w, wp, q)};
+    hi = ReduceOnceAVX512(_mm512_add_epi64(_mm512_sub_epi64(lo, omegaFactor), q), q);
+    lo = ReduceOnceAVX512(_mm512_add_epi64(lo, omegaFactor), q);
+}
+
+static inline IFMA_TARGET void ButterflyGSIFMA(__m512i& lo, __m512i& hi, __m512i w, __m512i wp, __m512i q) {
+    __m512i diff{_mm512_add_epi64(_mm512_sub_epi64(lo, hi), q)};
+    lo = ReduceOnceAVX512(_mm512_add_epi64(lo, hi), q);
+    hi = ModMulFastConstIFMA(diff, w, wp, q);
+}
+
+// Permutations for stages with t = 1, 2, 4 (indexed by log2(t)) operating on blocks of 16 values held in
+// two registers: the lane sources of lo/hi, the twiddle of each lane, and the inverse regrouping for the stores.
+alignas(64) static const uint64_t IFMA_LO_IDX[3][8]{
+    {0, 2, 4, 6, 8, 10, 12, 14}, {0, 1, 4, 5, 8, 9, 12, 13}, {0, 1, 2, 3, 8, 9, 10, 11}};
+alignas(64) static const uint64_t IFMA_HI_IDX[3][8]{
+    {1, 3, 5, 7, 9, 11, 13, 15}, {2, 3, 6, 7, 10, 11, 14, 15}, {4, 5, 6, 7, 12, 13, 14, 15}};
+alignas(64) static const uint64_t IFMA_TW_IDX[3][8]{
+    {0, 1, 2, 3, 4, 5, 6, 7}, {0, 0, 1, 1, 2, 2, 3, 3}, {0, 0, 0, 0, 1, 1, 1, 1}};
+alignas(64) static const uint64_t IFMA_X_IDX[3][8]{
+    {0, 8, 1, 9, 2, 10, 3, 11}, {0, 1, 8, 9, 2, 3, 10, 11}, {0, 1, 2, 3, 8, 9, 10, 11}};
+alignas(64) static const uint64_t IFMA_Y_IDX[3][8]{
+    {4, 12, 5, 13, 6, 14, 7, 15}, {4, 5, 12, 13, 6, 7, 14, 15}, {4, 5, 6, 7, 12, 13, 14, 15}};
+
+template <bool CT>
+static inline IFMA_TARGET void SmallStageIFMA(uint64_t* element, const uint64_t* table, const uint64_t* precon,
+                                              __m512i q, uint32_t m, uint32_t logt, uint32_t j0, uint32_t j1) {
+    const __m512i loIdx{_mm512_load_si512(IFMA_LO_IDX[logt])};
+    const __m512i hiIdx{_mm512_load_si512(IFMA_HI_IDX[logt])};
+    const __m512i twIdx{_mm512_load_si512(IFMA_TW_IDX[logt])};
+    const __m512i xIdx{_mm512_load_si512(IFMA_X_IDX[logt])};
+    const __m512i yIdx{_mm512_load_si512(IFMA_Y_IDX[logt])};
+    // number of butterfly groups in a block of 16 values
+    const uint32_t logg{3 - logt};
+    const __mmask8 twMask{static_cast<__mmask8>((1u << (1u << logg)) - 1)};
+    for (uint32_t j{j0}; j < j1; j += 16) {
+        __m512i x{_mm512_loadu_si512(element + j)};
+        __m512i y{_mm512_loadu_si512(element + j + 8)};
+        __m512i lo{_mm512_permutex2var_epi64(x, loIdx, y)};
+        __m512i hi{_mm512_permutex2var_epi64(x, hiIdx, y)};
+        uint32_t tw{m + (j >> (logt + 1))};
+        __m512i w{_mm512_permutexvar_epi64(twIdx, _mm512_maskz_loadu_epi64(twMask, table + tw))};
+        __m512i wp{_mm512_srli_epi64(
+            _mm512_permutexvar_epi64(twIdx, _mm512_maskz_loadu_epi64(twMask, precon + tw)), 12)};
+        if (CT)
+            ButterflyCTIFMA(lo, hi, w, wp, q);
+        else
+            ButterflyGSIFMA(lo, hi, w, wp, q);
+        _mm512_storeu_si512(element + j, _mm512_permutex2var_epi64(lo, xIdx, hi));
+        _mm512_storeu_si512(element + j + 8, _mm512_permutex2var_epi64(lo, yIdx, hi));
+    }
+}
+
+// butterflies (j, j + t) for j in [j0, j1) sharing the same twiddle
+template <bool CT>
+static inline IFMA_TARGET void ButterflyRunIFMA(uint64_t* element, uint32_t j0, uint32_t j1, uint32_t t,
+                                                __m512i w, __m512i wp, __m512i q) {
+    for (uint32_t j{j0}; j < j1; j += 8) {
+        __m512i lo{_mm512_loadu_si512(element + j)};
+        __m512i hi{_mm512_loadu_si512(element + j + t)};
+        if (CT)
+            ButterflyCTIFMA(lo, hi, w, wp, q);
+        else
+            ButterflyGSIFMA(lo, hi, w, wp, q);
+        _mm512_storeu_si512(element + j, lo);
+        _mm512_storeu_si512(element + j + t, hi);
+    }
+}
+
+// butterfly groups [i0, i1) of a stage with t >= 8
+template <bool CT>
+static inline IFMA_TARGET void LargeStageIFMA(uint64_t* element, const uint64_t* table, const uint64_t* precon,
+                                              __m512i q, uint32_t m, uint32_t t, uint32_t i0, uint32_t i1) {
+    for (uint32_t i{i0}; i < i1; ++i) {
+        uint32_t j0{2 * i * t};
+        ButterflyRunIFMA<CT>(element, j0, j0 + t, t, _mm512_set1_epi64(table[i + m]),
+                             _mm512_set1_epi64(precon[i + m] >> 12), q);
+    }
+}
+
+static inline IFMA_TARGET void FinalStageIFMA(uint64_t* element, uint32_t j0, uint32_t j1, uint32_t t,
+                                              const NTTFinalStage& fs, __m512i q) {
+    const __m512i w{_mm512_set1_epi64(fs.omega1Inv)};
+    const __m512i wp{_mm512_set1_epi64(fs.preconOmega1Inv >> 12)};
+    const __m512i nInv{_mm512_set1_epi64(fs.cycloOrderInv)};
+    const __m512i nInvp{_mm512_set1_epi64(fs.preconCycloOrderInv >> 12)};
+    for (uint32_t j{j0}; j < j1; j += 8) {
+        __m512i lo{_mm512_loadu_si512(element + j)};
+        __m512i hi{_mm512_loadu_si512(element + j + t)};
+        ButterflyGSIFMA(lo, hi, w, wp, q);
+        _mm512_storeu_si512(element + j, ModMulFastConstIFMA(lo, nInv, nInvp, q));
+        _mm512_storeu_si512(element + j + t, hi);
+    }
+}
+
+static inline uint32_t Log2(uint32_t x) {
+    uint32_t r{0};
+    while ((uint32_t(1) << r) < x)
+        ++r;
+    return r;
+}
+
+static IFMA_TARGET void ForwardColumnsIFMA(uint64_t* element, const uint64_t* table, const uint64_t* precon,
+                                           uint64_t modulus, uint32_t n, uint32_t logBlocks, uint32_t begin,
+                                           uint32_t end) {
+    const __m512i q{_mm512_set1_epi64(modulus)};
+    const uint32_t stride{n >> logBlocks};
+    for (uint32_t s{0}, m{1}, t{n >> 1}; s < logBlocks; ++s, m <<= 1, t >>= 1) {
+        for (uint32_t i{0}; i < m; ++i) {
+            const __m512i w{_mm512_set1_epi64(table[i + m])};
+            const __m512i wp{_mm512_set1_epi64(precon[i + m] >> 12)};
+            for (uint32_t j{2 * i * t}, j2{j + t}; j < j2; j += stride)
+                ButterflyRunIFMA<true>(element, j + begin, j + end, t, w, wp, q);
+        }
+    }
+}
+
+static IFMA_TARGET void ForwardBlockIFMA(uint64_t* element, const uint64_t* table, const uint64_t* precon,
+                                         uint64_t modulus, uint32_t n, uint32_t logBlocks, uint32_t block) {
+    const __m512i q{_mm512_set1_epi64(modulus)};
+    const uint32_t size{n >> logBlocks};
+    uint32_t logt{Log2(size >> 1)};
+    for (uint32_t m{uint32_t(1) << logBlocks}, t{size >> 1}; t >= 1; m <<= 1, t >>= 1, --logt) {
+        uint32_t groups{m >> logBlocks};
+        if (t >= 8)
+            LargeStageIFMA<true>(element, table, precon, q, m, t, block * groups, (block + 1) * groups);
+        else
+            SmallStageIFMA<true>(element, table, precon, q, m, logt, block * size, (block + 1) * size);
+    }
+}
+
+static IFMA_TARGET void InverseBlockIFMA(uint64_t* element, const uint64_t* table, const uint64_t* precon,
+                                         const NTTFinalStage& fs, uint64_t modulus, uint32_t n, uint32_t logBlocks,
+                                         uint32_t block) {
+    const __m512i q{_mm512_set1_epi64(modulus)};
+    const uint32_t size{n >> logBlocks};
+    uint32_t logt{0};
+    for (uint32_t m{n >> 1}, t{1}; t < size && m > 1; m >>= 1, t <<= 1, ++logt) {
+        uint32_t groups{m >> logBlocks};
+        if (t >= 8)
+            LargeStageIFMA<false>(element, table, precon, q, m, t, block * groups, (block + 1) * groups);
+        else
+            SmallStageIFMA<false>(element, table, precon, q, m, logt, block * size, (block + 1) * size);
+    }
+    if (logBlocks == 0)
+        FinalStageIFMA(element, 0, n >> 1, n >> 1, fs, q);
+}
+
+static IFMA_TARGET void InverseColumnsIFMA(uint64_t* element, const uint64_t* table, const uint64_t* precon,
+                                           const NTTFinalStage& fs, uint64_t modulus, uint32_t n, uint32_t logBlocks,
+                                           uint32_t begin, uint32_t end) {
+    const __m512i q{_mm512_set1_epi64(modulus)};
+    const uint32_t stride{n >> logBlocks};
+    for (uint32_t m{uint32_t(1) << (logBlocks - 1)}, t{n >> logBlocks}; m > 1; m >>= 1, t <<= 1) {
+        for (uint32_t i{0}; i < m; ++i) {
+            const __m512i w{_mm512_set1_epi64(table[i + m])};
+            const __m512i wp{_mm512_set1_epi64(precon[i + m] >> 12)};
+            for (uint32_t j{2 * i * t}, j2{j + t}; j < j2; j += stride)
+                ButterflyRunIFMA<false>(element, j + begin, j + end, t, w, wp, q);
+        }
+    }
+    for (uint32_t j{0}, t{n >> 1}; j < t; j += stride)
+        FinalStageIFMA(element, j + begin, j + end, t, fs, q);
+}
+
+// Selects the kernel for blocks of the given size; there is no AVX-512 kernel without IFMA, so the AVX-512
+// level runs the AVX2 kernel. "width" is the minimal granularity (in values) the kernel can process.
+static lbcrypto::SIMDLevel SelectKernel(uint64_t modulus, uint32_t size, uint32_t& width) {
+    uint32_t applicable{0};
+    if (size >= 8)
+        applicable |= SIMDKernelBit(lbcrypto::SIMD_AVX2);
+    if (modulus < IFMA_MAX_MODULUS && size >= 16)
+        applicable |= SIMDKernelBit(lbcrypto::SIMD_AVX512IFMA);
+    auto kernel{SelectSIMDKernel(applicable)};
+    width = (kernel == lbcrypto::SIMD_AVX512IFMA) ? 8 : 4;
+    return kernel;
+}
+
+#endif  // OPENFHE_SIMD_INTNAT
+
+NTTFinalStage::NTTFinalStage(uint64_t rootOfUnityInverse1, uint64_t cycloOrderInv, uint64_t preconCycloOrderInv,
+                             uint64_t modulus)
+    : cycloOrderInv{cycloOrderInv}, preconCycloOrderInv{preconCycloOrderInv} {
+#ifdef OPENFHE_SIMD_INTNAT
+    omega1Inv       = static_cast<uint64_t>(uint128_t(rootOfUnityInverse1) * cycloOrderInv % modulus);
+    preconOmega1Inv = static_cast<uint64_t>((uint128_t(omega1Inv) << 64) / modulus);
+#else
+    omega1Inv       = 0;
+    preconOmega1Inv = 0;
+#endif
+}
+
+bool ForwardTransformToBitReverseInPlaceSIMD(uint64_t* element, const uint64_t* rootOfUnityTable,
+                                             const uint64_t* preconRootOfUnityTable, uint64_t modulus, uint32_t n) {
+    return ForwardTransformToBitReverseBlockSIMD(element, rootOfUnityTable, preconRootOfUnityTable, modulus, n, 0,
+                                                 0);
+}
+
+bool InverseTransformFromBitReverseInPlaceSIMD(uint64_t* element, const uint64_t* rootOfUnityInverseTable,
+                                               const uint64_t* preconRootOfUnityInverseTable, uint64_t cycloOrderInv,
+                                               uint64_t preconCycloOrderInv, uint64_t modulus, uint32_t n) {
+    if (n < 2)
+        return false;
+    NTTFinalStage fs(rootOfUnityInverseTable[1], cycloOrderInv, preconCycloOrderInv, modulus);
+    return InverseTransformFromBitReverseBlockSIMD(element, rootOfUnityInverseTable, preconRootOfUnityInverseTable,
+                                                   fs, modulus, n, 0, 0);
+}
+
+bool ForwardTransformToBitReverseColumnsSIMD(uint64_t* element, const uint64_t* rootOfUnityTable,
+                                             const uint64_t* preconRootOfUnityTable, uint64_t modulus, uint32_t n,
+                                             uint32_t logBlocks, uint32_t begin, uint32_t end) {
+#ifdef OPENFHE_SIMD_INTNAT
+    uint32_t width{0};
+    auto kernel{SelectKernel(modulus, n >> logBlocks, width)};
+    if (kernel == lbcrypto::SIMD_SCALAR || (begin % width) != 0 || (end % width) != 0)
+        return false;
+    if (kernel == lbcrypto::SIMD_AVX512IFMA)
+        ForwardColumnsIFMA(element, rootOfUnityTable, preconRootOfUnityTable, modulus, n, logBlocks, begin, end);
+    else
+        ForwardColumnsAVX2(element, rootOfUnityTable, preconRootOfUnityTable, modulus, n, logBlocks, begin, end);
+    return true;
+#else
+    return false;
+#endif
+}
+
+bool ForwardTransformToBitReverseBlockSIMD(uint64_t* element, const uint64_t* rootOfUnityTable,
+                                           const uint64_t* preconRootOfUnityTable, uint64_t modulus, uint32_t n,
+                                           uint32_t logBlocks, uint32_t block) {
+#ifdef OPENFHE_SIMD_INTNAT
+    uint32_t width{0};
+    auto kernel{SelectKernel(modulus, n >> logBlocks, width)};
+    if (kernel == lbcrypto::SIMD_AVX512IFMA)
+        ForwardBlockIFMA(element, rootOfUnityTable, preconRootOfUnityTable, modulus, n, logBlocks, block);
+    else if (kernel == lbcrypto::SIMD_AVX2)
+        ForwardBlockAVX2(element, rootOfUnityTable, preconRootOfUnityTable, modulus, n, logBlocks, block);
+    return kernel != lbcrypto::SIMD_SCALAR;
+#else
+    return false;
+#endif
+}
+
+bool InverseTransformFromBitReverseBlockSIMD(uint64_t* element, const uint64_t* rootOfUnityInverseTable,
+                                             const uint64_t* preconRootOfUnityInverseTable, const NTTFinalStage& fs,
+                                             uint64_t modulus, uint32_t n, uint32_t logBlocks, uint32_t block) {
+#ifdef OPENFHE_SIMD_INTNAT
+    uint32_t width{0};
+    auto kernel{SelectKernel(modulus, n >> logBlocks, width)};
+    if (kernel == lbcrypto::SIMD_AVX512IFMA)
+        InverseBlockIFMA(element, rootOfUnityInverseTable, preconRootOfUnityInverseTable, fs, modulus, n, logBlocks,
+                         block);
+    else if (kernel == lbcrypto::SIMD_AVX2)
+        InverseBlockAVX2(element, rootOfUnityInverseTable, preconRootOfUnityInverseTable, fs, modulus, n, logBlocks,
+                         block);
+    return kernel != lbcrypto::SIMD_SCALAR;
+#else
+    return false;
+#endif
+}
+
+bool InverseTransformFromBitReverseColumnsSIMD(uint64_t* element, const uint64_t* rootOfUnityInverseTable,
+                                               const uint64_t* preconRootOfUnityInverseTable, const NTTFinalStage& fs,
+                                               uint64_t modulus, uint32_t n, uint32_t logBlocks, uint32_t begin,
+                                               uint32_t end) {
+#ifdef OPENFHE_SIMD_INTNAT
+    uint32_t width{0};
+    auto kernel{SelectKernel(modulus, n >> logBlocks, width)};
+    if (kernel == lbcrypto::SIMD_SCALAR || (begin % width) != 0 || (end % width) != 0)
+        return false;
+    if (kernel == lbcrypto::SIMD_AVX512IFMA)
+        InverseColumnsIFMA(element, rootOfUnityInverseTable, preconRootOfUnityInverseTable, fs, modulus, n, logBlocks,
+                           begin, end);
+    else
+        InverseColumnsAVX2(element, rootOfUnityInverseTable, preconRootOfUnityInverseTable, fs, modulus, n, logBlocks,
+                           begin, end);
+    return true;
+#else
+    return false;
+#endif
+}
+
+}  // namespace intnat
@@ -0,0 +1,78 @@
+//==================================================================================
+// BSD 2-Clause License
+//
+// Copyright (c) 2014-2022, NJIT, Duality Technologies Inc. and other contributors
+//
+// All rights reserved.
+//
+// Author TPOC: contact@openfhe.org
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice, this
+//    list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+//    this list of conditions and the following disclaimer in the documentation
+//    and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+// OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//==================================================================================
+
+
+/*
+  This file contains the runtime selection of SIMD kernels based on the CPU features
+ */
+
+#include "utils/cpufeatures.h"
+
+namespace lbcrypto {
+
+std::ostream& operator<<(std::ostream& s, SIMDLevel level) {
+    switch (level) {
+        case SIMD_SCALAR:
+            s << "SCALAR";
+            break;
+        case SIMD_AVX2:
+            s << "AVX2";
+            break;
+        case SIMD_AVX512:
+            s << "AVX512";
+            break;
+        case SIMD_AVX512IFMA:
+            s << "AVX512IFMA";
+            break;
+        default:
+            s << "UNKNOWN";
+            break;
+    }
+    return s;
+}
+
+SIMDControls::SIMDControls() {
+#ifdef OPENFHE_SIMD_X86
+    // may run before the constructors of libgcc
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("avx2"))
+        supportedLevel = SIMD_AVX2;
+    if (supportedLevel == SIMD_AVX2 && __builtin_cpu_supports("avx512f") && __builtin_cpu_supports("avx512dq"))
+        supportedLevel = SIMD_AVX512;
+    if (supportedLevel == SIMD_AVX512 && __builtin_cpu_supports("avx512ifma"))
+        supportedLevel = SIMD_AVX512IFMA;
+#endif
+    level = supportedLevel;
+}
+
+SIMDControls OpenFHESIMDControls;
+
+}  // namespace lbcrypto
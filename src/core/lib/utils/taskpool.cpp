@@ -0,0 +1,243 @@
+//==================================================================================
+// BSD 2-Clause License
+//
+// Copyright (c) 2014-2022, NJIT, Duality Technologies Inc. and other contributors
+//
+// All rights reserved.
+//
+// Author TPOC: contact@openfhe.org
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice, this
+//    list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+//    this list of conditions and the following disclaimer in the documentation
+//    and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+// OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//==================================================================================
+
+/*
+  This file contains the persistent work-stealing task pool used by ParallelFor when WITH_TASKPOOL is ON
+ */
+
+#include "utils/taskpool.h"
+
+#ifdef WITH_TASKPOOL
+
+    #include "utils/parallel.h"
+
+    #include <algorithm>
+    #include <exception>
+
+namespace lbcrypto {
+
+namespace {
+
+// pool and index of the pool worker running on this thread; nullptr and -1 for application threads
+thread_local const TaskPool* tPool = nullptr;
+thread_local int tWorkerId         = -1;
+// first deque an application thread tries to steal from; rotated so that callers do not all hit worker 0
+thread_local uint32_t tVictim = 0;
+
+}  // namespace
+
+struct TaskPool::TaskGroup {
+    std::atomic<size_t> pending{0};
+    std::atomic<bool> failed{false};
+    std::mutex mutex;
+    std::exception_ptr error;
+};
+
+TaskPool& TaskPool::GetInstance() {
+    // the calling threads take part in the work, so one worker less than the number of hardware threads
+    static TaskPool pool(static_cast<uint32_t>(std::max(OpenFHEParallelControls.GetMachineThreads(), 1) - 1));
+    return pool;
+}
+
+bool TaskPool::InWorker() const {
+    return tPool == this;
+}
+
+int TaskPool::WorkerId() const {
+    return (tPool == this) ? tWorkerId : -1;
+}
+
+TaskPool::TaskPool(uint32_t numWorkers) {
+    m_workers.reserve(numWorkers);
+    for (uint32_t i = 0; i < numWorkers; ++i)
+        m_workers.emplace_back(std::make_unique<Worker>());
+    for (uint32_t i = 0; i < numWorkers; ++i)
+        m_workers[i]->thread = std::thread(&TaskPool::WorkerLoop, this, i);
+}
+
+TaskPool::~TaskPool() {
+    {
+        std::lock_guard<std::mutex> lock(m_sleepMutex);
+        m_stop = true;
+    }
+    m_wake.notify_all();
+    for (auto& w : m_workers) {
+        if (w->thread.joinable())
+            w->thread.join();
+    }
+}
+
+void TaskPool::WorkerLoop(uint32_t id) {
+    tPool     = this;
+    tWorkerId = static_cast<int>(id);
+    while (true) {
+        Task task{};
+        if (Pop(task)) {
+            Execute(task);
+            continue;
+        }
+        std::unique_lock<std::mutex> lock(m_sleepMutex);
+        m_wake.wait(lock, [this] { return m_stop || m_queued.load(std::memory_order_acquire) > 0; });
+        if (m_stop)
+            return;
+    }
+}
+
+void TaskPool::Push(Task task) {
+    // the counter is updated under the queue lock so that a concurrent Pop never decrements it first
+    const int id = WorkerId();
+    if (id >= 0) {
+        Worker& w = *m_workers[id];
+        std::lock_guard<std::mutex> lock(w.mutex);
+        w.tasks.push_back(task);
+        m_queued.fetch_add(1, std::memory_order_release);
+    }
+    else {
+        std::lock_guard<std::mutex> lock(m_injectMutex);
+        m_inject.push_back(task);
+        m_queued.fetch_add(1, std::memory_order_release);
+    }
+}
+
+bool TaskPool::Pop(Task& task) {
+    const int id = WorkerId();
+    // own tasks are taken LIFO: they are the most recently split, cache-hot ranges
+    if (id >= 0) {
+        Worker& w = *m_workers[id];
+        std::lock_guard<std::mutex> lock(w.mutex);
+        if (!w.tasks.empty()) {
+            task = w.tasks.back();
+            w.tasks.pop_back();
+            m_queued.fetch_sub(1, std::memory_order_relaxed);
+            return true;
+        }
+    }
+    {
+        std::lock_guard<std::mutex> lock(m_injectMutex);
+        if (!m_inject.empty()) {
+            task = m_inject.front();
+            m_inject.pop_front();
+            m_queued.fetch_sub(1, std::memory_order_relaxed);
+            return true;
+        }
+    }
+    // steal FIFO from the other workers: the oldest tasks are the largest remaining ranges
+    const uint32_t numWorkers = GetNumWorkers();
+    const uint32_t start      = (id >= 0) ? static_cast<uint32_t>(id) + 1 : tVictim++;
+    for (uint32_t k = 0; k < numWorkers; ++k) {
+        const uint32_t victim = (start + k) % numWorkers;
+        if (static_cast<int>(victim) == id)
+            continue;
+        Worker& w = *m_workers[victim];
+        std::lock_guard<std::mutex> lock(w.mutex);
+        if (!w.tasks.empty()) {
+            task = w.tasks.front();
+            w.tasks.pop_front();
+            m_queued.fetch_sub(1, std::memory_order_relaxed);
+            return true;
+        }
+    }
+    return false;
+}
+
+void TaskPool::Execute(const Task& task) {
+    TaskGroup* group = task.group;
+    if (!group->failed.load(std::memory_order_relaxed)) {
+        try {
+            (*task.body)(task.begin, task.end);
+        }
+        catch (...) {
+            std::lock_guard<std::mutex> lock(group->mutex);
+            if (!group->error)
+                group->error = std::current_exception();
+            group->failed.store(true, std::memory_order_relaxed);
+        }
+    }
+    // the group lives on the stack of the waiting thread: it must not be touched after this point
+    if (group->pending.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+        // the waiting thread checks the counter under m_sleepMutex before it blocks, so taking the lock here
+        // ensures that the notification cannot be lost
+        {
+            std::lock_guard<std::mutex> lock(m_sleepMutex);
+        }
+        m_wake.notify_all();
+    }
+}
+
+void TaskPool::ParallelFor(size_t begin, size_t end, uint32_t maxTasks, const RangeFunction& body) {
+    if (end <= begin)
+        return;
+    const size_t n      = end - begin;
+    const size_t chunks = std::min<size_t>(n, maxTasks);
+    if (chunks <= 1 || m_workers.empty()) {
+        body(begin, end);
+        return;
+    }
+
+    TaskGroup group;
+    group.pending.store(chunks, std::memory_order_relaxed);
+    const size_t q = n / chunks;
+    const size_t r = n % chunks;
+    // chunk c covers [begin + c * q + min(c, r), begin + (c + 1) * q + min(c + 1, r))
+    for (size_t c = chunks - 1; c > 0; --c) {
+        const size_t first = begin + c * q + std::min(c, r);
+        Push(Task{&group, &body, first, first + q + (c < r ? 1 : 0)});
+    }
+    {
+        std::lock_guard<std::mutex> lock(m_sleepMutex);
+    }
+    if (chunks == 2)
+        m_wake.notify_one();
+    else
+        m_wake.notify_all();
+
+    Execute(Task{&group, &body, begin, begin + q + (r > 0 ? 1 : 0)});
+    // help with any queued work (ours or a concurrent caller's) before blocking, which keeps nested loops
+    // from deadlocking when every worker is itself waiting inside a ParallelFor; once the queues are empty, the
+    // remaining chunks are running on other threads and the last of them wakes this thread up
+    while (group.pending.load(std::memory_order_acquire) != 0) {
+        Task task{};
+        if (Pop(task)) {
+            Execute(task);
+            continue;
+        }
+        std::unique_lock<std::mutex> lock(m_sleepMutex);
+        m_wake.wait(lock, [&] {
+            return group.pending.load(std::memory_order_acquire) == 0 || m_queued.load(std::memory_order_acquire) > 0;
+        });
+    }
+    if (group.error)
+        std::rethrow_exception(group.error);
+}
+
+}  // namespace lbcrypto
+
+#endif  // WITH_TASKPOOL
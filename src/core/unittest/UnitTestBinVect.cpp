@@ -34,11 +34,16 @@
  */
 
 #include <iostream>
+#include <sstream>
+#include <vector>
 #include "gtest/gtest.h"
 
 #include "lattice/lat-hal.h"
 #include "lattice/ilelement.h"
+#include "math/distrgen.h"
+#include "math/nbtheory.h"
 #include "testdefs.h"
+#include "utils/cpufeatures.h"
 #include "utils/debug.h"
 #include "utils/inttypes.h"
 #include "utils/utilities.h"
@@ -550,3 +555,88 @@ void modmul_vector(const std::string& msg) {
 TEST(UTBinVect, modmul_vector) {
     RUN_BIG_BACKENDS(modmul_vector, "modmul_vector")
 }
+
+/*   The method "ModMulAddEq" operates on Big Vectors m,n,p BigInteger q
+        Returns:  (m+n*p)mod q, and the result is stored in Big Vector m.
+*/
+
+template <typename V>
+void modmuladd_vector(const std::string& msg) {
+    typename V::Integer q("657");
+    V m(5, q, {100, 600, 0, 656, 5});
+    V n(5, q, {4, 9, 66, 33, 7});
+    V p(5, q, {13, 600, 5, 656, 93});
+
+    m.ModMulAddEq(n, p);
+
+    uint64_t expectedResult[5] = {152, 87, 330, 623, 656};
+
+    for (usint i = 0; i < 5; i++) {
+        EXPECT_EQ(expectedResult[i], (m.at(i)).ConvertToInt()) << msg;
+    }
+
+    V r(4, q);
+    EXPECT_THROW(m.ModMulAddEq(n, r), OpenFHEException) << msg;
+}
+
+TEST(UTBinVect, modmuladd_vector) {
+    RUN_ALL_BACKENDS(modmuladd_vector, "modmuladd_vector")
+}
+
+// the vectorized element-wise kernels must be bit-exact with the scalar code for every supported SIMD level,
+// also for operands in [0, 2q) left unreduced by lazy reduction
+TEST(UTBinVect, native_vector_simd_vs_scalar) {
+    const SIMDLevel supported = OpenFHESIMDControls.GetSupportedLevel();
+    const SIMDLevel saved     = OpenFHESIMDControls.GetLevel();
+    DiscreteUniformGeneratorImpl<NativeVector> dug;
+
+    // the length is not a multiple of the vector width, so the scalar tail runs as well
+    const usint n = 1029;
+    for (usint bits : {20, 35, 50, 55, MAX_MODULUS_SIZE}) {
+        NativeInteger modulus = LastPrime<NativeInteger>(bits, 2048);
+        for (bool reduced : {true, false}) {
+            NativeVector a  = dug.GenerateVector(n, modulus);
+            NativeVector b  = dug.GenerateVector(n, modulus);
+            NativeVector c  = dug.GenerateVector(n, modulus);
+            NativeInteger s = c[0];
+            if (!reduced) {
+                // every other value of a and every third value of b and c is moved to [q, 2q)
+                for (usint i = 0; i < n; ++i) {
+                    if (i % 2 == 0)
+                        a[i] += modulus;
+                    if (i % 3 == 0) {
+                        b[i] += modulus;
+                        c[i] += modulus;
+                    }
+                }
+            }
+
+            auto compute = [&]() {
+                std::vector<NativeVector> results{a.ModAdd(b), a.ModAdd(s), a.ModSub(b), a.ModSub(s),
+                                                  a.ModMul(s), a.ModMul(b), a};
+                results.back().ModMulAddEq(b, c);
+                return results;
+            };
+
+            OpenFHESIMDControls.SetLevel(SIMD_SCALAR);
+            const std::vector<NativeVector> expected = compute();
+
+            for (int level = SIMD_AVX2; level <= supported; ++level) {
+                OpenFHESIMDControls.SetLevel(static_cast<SIMDLevel>(level));
+                std::stringstream msg;
+                msg << "modulus bits = " << bits << (reduced ? "" : ", unreduced inputs") << ", SIMD level "
+                    << static_cast<SIMDLevel>(level);
+
+                const std::vector<NativeVector> results = compute();
+                EXPECT_EQ(expected[0], results[0]) << "ModAdd (vector) " << msg.str();
+                EXPECT_EQ(expected[1], results[1]) << "ModAdd (scalar) " << msg.str();
+                EXPECT_EQ(expected[2], results[2]) << "ModSub (vector) " << msg.str();
+                EXPECT_EQ(expected[3], results[3]) << "ModSub (scalar) " << msg.str();
+                EXPECT_EQ(expected[4], results[4]) << "ModMul (scalar) " << msg.str();
+                EXPECT_EQ(expected[5], results[5]) << "ModMul (vector) " << msg.str();
+                EXPECT_EQ(expected[6], results[6]) << "ModMulAddEq " << msg.str();
+            }
+        }
+    }
+    OpenFHESIMDControls.SetLevel(saved);
+}
@@ -37,6 +37,7 @@
 #include "lattice/lat-hal.h"
 #include "math/distrgen.h"
 #include "testdefs.h"
+#include "utils/cpufeatures.h"
 #include "utils/debug.h"
 
 #include <iostream>
@@ -592,6 +593,291 @@ TEST(UTDCRTPoly, DCRT_mod_ops_on_two_elements) {
     RUN_BIG_DCRTPOLYS(DCRT_mod_ops_on_two_elements, "DCRT DCRT_mod_ops_on_two_elements");
 }
 
+// the towers of the params hold handles to their NTT tables; transforms with them must match the transforms
+// that look the tables up by modulus, and the handles must stay usable after the tables cache is reset
+template <typename Element>
+void DCRT_ntt_table_handles(const std::string& msg) {
+    using CRT          = ChineseRemainderTransformFTT<NativeVector>;
+    uint32_t order     = 2048;
+    uint32_t nBits     = 40;
+    uint32_t towersize = 3;
+
+    auto ildcrtparams = std::make_shared<ILDCRTParams<typename Element::Integer>>(order, towersize, nBits);
+    for (const auto& tower : ildcrtparams->GetParams()) {
+        ASSERT_NE(nullptr, tower->GetNTTTables()) << msg << " tower without NTT tables";
+        EXPECT_EQ(&CRT::GetTables(tower->GetRootOfUnity(), order, tower->GetModulus()), tower->GetNTTTables().get())
+            << msg << " tower tables are not the shared ones";
+    }
+
+    typename Element::DugType dug;
+    Element op(dug, ildcrtparams, Format::COEFFICIENT);
+    Element transformed(op);
+    transformed.SwitchFormat();
+
+    for (uint32_t i = 0; i < towersize; i++) {
+        const auto& tower = ildcrtparams->GetParams()[i];
+        auto plainParams  = std::make_shared<ILNativeParams>(order, tower->GetModulus(), tower->GetRootOfUnity());
+        EXPECT_EQ(nullptr, plainParams->GetNTTTables()) << msg << " tables precomputed for standalone params";
+
+        NativePoly expected(plainParams, Format::COEFFICIENT);
+        expected.SetValues(op.GetElementAtIndex(i).GetValues(), Format::COEFFICIENT);
+        expected.SwitchFormat();
+        EXPECT_EQ(expected.GetValues(), transformed.GetElementAtIndex(i).GetValues())
+            << msg << " forward transform with table handles, tower " << i;
+    }
+
+    CRT().Reset();
+    transformed.SwitchFormat();
+    EXPECT_EQ(op, transformed) << msg << " round trip with table handles after Reset()";
+}
+
+TEST(UTDCRTPoly, DCRT_ntt_table_handles) {
+    RUN_BIG_DCRTPOLYS(DCRT_ntt_table_handles, "DCRT_ntt_table_handles");
+}
+
+// the handles own the tables: params with the same towers share them, and they are freed with the last params
+// unless the tables were also looked up by modulus
+TEST(UTDCRTPoly, DCRT_ntt_table_ownership) {
+    using CRT      = ChineseRemainderTransformFTT<NativeVector>;
+    uint32_t order = 4096;
+    CRT().Reset();
+
+    std::vector<std::weak_ptr<const CRT::NTTTables>> tables;
+    {
+        auto params = std::make_shared<ILDCRTParams<BigInteger>>(order, 2, 45);
+        auto copy   = std::make_shared<ILDCRTParams<BigInteger>>(order, 2, 45);
+        for (size_t i = 0; i < params->GetParams().size(); ++i) {
+            EXPECT_EQ(params->GetParams()[i]->GetNTTTables(), copy->GetParams()[i]->GetNTTTables())
+                << "params with the same towers do not share their tables";
+            tables.push_back(params->GetParams()[i]->GetNTTTables());
+        }
+    }
+    for (const auto& t : tables)
+        EXPECT_TRUE(t.expired()) << "tables outlive the params holding them";
+
+    auto params      = std::make_shared<ILDCRTParams<BigInteger>>(order, 1, 45);
+    const auto& ring = params->GetParams()[0];
+    std::weak_ptr<const CRT::NTTTables> kept(ring->GetNTTTables());
+    EXPECT_EQ(&CRT::GetTables(ring->GetRootOfUnity(), order, ring->GetModulus()), kept.lock().get());
+    params.reset();
+    EXPECT_FALSE(kept.expired()) << "tables looked up by modulus are freed";
+    CRT().Reset();
+    EXPECT_TRUE(kept.expired());
+}
+
+// approximate modulus raising and reduction of polynomials in EVALUATION format (the fused kernels for
+// power-of-two cyclotomics) must match the separate NTTs and basis conversions, for rings that fit in one block
+// of the batched NTT and for larger ones
+template <typename Element>
+void DCRT_approx_mod_up_down(const std::string& msg) {
+    using Integer        = typename Element::Integer;
+    using Params         = ILDCRTParams<Integer>;
+    const uint32_t sizeQ = 3;
+    const uint32_t sizeP = 2;
+
+    // [(B/b_i)^{-1}]_{b_i}, [B/b_i]_{c_j} and the Barrett constants of c_j for the conversion from {b_i} to {c_j}
+    auto precompute = [](const std::vector<NativeInteger>& from, const std::vector<NativeInteger>& to,
+                         std::vector<NativeInteger>& hatInvMod, std::vector<NativeInteger>& hatInvModPrecon,
+                         std::vector<std::vector<NativeInteger>>& hatMod, std::vector<DoubleNativeInt>& mu) {
+        Integer modulus(1);
+        for (const auto& b : from)
+            modulus *= Integer(b.ConvertToInt());
+        for (const auto& b : from) {
+            Integer hat = modulus / Integer(b.ConvertToInt());
+            hatInvMod.push_back(hat.ModInverse(Integer(b.ConvertToInt())).ConvertToInt());
+            hatInvModPrecon.push_back(hatInvMod.back().PrepModMulConst(b));
+            hatMod.emplace_back();
+            for (const auto& c : to)
+                hatMod.back().push_back(hat.Mod(Integer(c.ConvertToInt())).ConvertToInt());
+        }
+        const auto barrettBase128Bit(Integer(1).LShiftEq(128));
+        for (const auto& c : to)
+            mu.push_back((barrettBase128Bit / Integer(c.ConvertToInt())).template ConvertToInt<DoubleNativeInt>());
+    };
+
+    for (uint32_t order : {2048, 16384}) {
+        auto paramsQP = std::make_shared<Params>(order, sizeQ + sizeP, 50);
+        std::vector<NativeInteger> moduliQ, rootsQ, moduliP, rootsP;
+        for (uint32_t i = 0; i < sizeQ + sizeP; i++) {
+            (i < sizeQ ? moduliQ : moduliP).push_back(paramsQP->GetParams()[i]->GetModulus());
+            (i < sizeQ ? rootsQ : rootsP).push_back(paramsQP->GetParams()[i]->GetRootOfUnity());
+        }
+        auto paramsQ = std::make_shared<Params>(order, moduliQ, rootsQ);
+        auto paramsP = std::make_shared<Params>(order, moduliP, rootsP);
+
+        std::vector<NativeInteger> QHatInvModq, QHatInvModqPrecon, PHatInvModp, PHatInvModpPrecon;
+        std::vector<std::vector<NativeInteger>> QHatModp, PHatModq;
+        std::vector<DoubleNativeInt> modpBarrettMu, modqBarrettMu;
+        precompute(moduliQ, moduliP, QHatInvModq, QHatInvModqPrecon, QHatModp, modpBarrettMu);
+        precompute(moduliP, moduliQ, PHatInvModp, PHatInvModpPrecon, PHatModq, modqBarrettMu);
+
+        typename Element::DugType dug;
+        Element x(dug, paramsQ, Format::EVALUATION);
+        Element xCoef(x);
+        xCoef.SetFormat(Format::COEFFICIENT);
+
+        auto expectedP = xCoef.ApproxSwitchCRTBasis(paramsQ, paramsP, QHatInvModq, QHatInvModqPrecon, QHatModp,
+                                                     modpBarrettMu);
+        expectedP.SetFormat(Format::EVALUATION);
+        EXPECT_EQ(expectedP, x.ApproxSwitchCRTBasisEval(paramsQ, paramsP, QHatInvModq, QHatInvModqPrecon, QHatModp,
+                                                        modpBarrettMu))
+            << msg << " ApproxSwitchCRTBasisEval, order " << order;
+
+        Element up(x);
+        up.ApproxModUp(paramsQ, paramsP, paramsQP, QHatInvModq, QHatInvModqPrecon, QHatModp, modpBarrettMu);
+        xCoef.ApproxModUp(paramsQ, paramsP, paramsQP, QHatInvModq, QHatInvModqPrecon, QHatModp, modpBarrettMu);
+        EXPECT_EQ(xCoef, up) << msg << " ApproxModUp, order " << order;
+
+        std::vector<NativeInteger> PInvModq, PInvModqPrecon;
+        Integer modulusP(1);
+        for (const auto& p : moduliP)
+            modulusP *= Integer(p.ConvertToInt());
+        for (const auto& q : moduliQ) {
+            PInvModq.push_back(modulusP.ModInverse(Integer(q.ConvertToInt())).ConvertToInt());
+            PInvModqPrecon.push_back(PInvModq.back().PrepModMulConst(q));
+        }
+
+        Element y(dug, paramsQP, Format::EVALUATION);
+        for (uint64_t tv : {0, 65537}) {
+            const NativeInteger t(tv);
+            std::vector<NativeInteger> tInvModp, tInvModpPrecon, tModqPrecon;
+            for (const auto& p : moduliP) {
+                tInvModp.push_back(tv > 0 ? t.ModInverse(p) : NativeInteger(0));
+                tInvModpPrecon.push_back(tInvModp.back().PrepModMulConst(p));
+            }
+            for (const auto& q : moduliQ)
+                tModqPrecon.push_back(t.PrepModMulConst(q));
+
+            // separate steps: inverse NTT of the towers of P, conversion to Q, NTT and (x - x') * P^{-1}
+            Element partP(paramsP, Format::EVALUATION, true);
+            for (uint32_t j = 0; j < sizeP; j++)
+                partP.SetElementAtIndex(j, y.GetElementAtIndex(sizeQ + j));
+            partP.SetFormat(Format::COEFFICIENT);
+            if (tv > 0)
+                partP = partP.Times(tInvModp);
+            auto partQ = partP.ApproxSwitchCRTBasis(paramsP, paramsQ, PHatInvModp, PHatInvModpPrecon, PHatModq,
+                                                    modqBarrettMu);
+            if (tv > 0)
+                partQ = partQ.Times(std::vector<NativeInteger>(sizeQ, t));
+            partQ.SetFormat(Format::EVALUATION);
+            Element expected(paramsQ, Format::EVALUATION, true);
+            for (uint32_t i = 0; i < sizeQ; i++)
+                expected.SetElementAtIndex(i,
+                                           (y.GetElementAtIndex(i) - partQ.GetElementAtIndex(i)).Times(PInvModq[i]));
+
+            EXPECT_EQ(expected, y.ApproxModDown(paramsQ, paramsP, PInvModq, PInvModqPrecon, PHatInvModp,
+                                                PHatInvModpPrecon, PHatModq, modqBarrettMu, tInvModp, tInvModpPrecon,
+                                                t, tModqPrecon))
+                << msg << " ApproxModDown, t = " << tv << ", order " << order;
+        }
+    }
+}
+
+TEST(UTDCRTPoly, DCRT_approx_mod_up_down) {
+    RUN_BIG_DCRTPOLYS(DCRT_approx_mod_up_down, "DCRT_approx_mod_up_down");
+}
+
+// the vectorized inner products of the RNS basis conversions must match the scalar code at every SIMD level,
+// for moduli that fit in 52 bits (AVX-512 IFMA) and larger ones; the conversion constants only need to be in
+// the right ranges for this comparison
+template <typename Element>
+void DCRT_base_conv_simd(const std::string& msg) {
+    using Integer = typename Element::Integer;
+    using Params  = ILDCRTParams<Integer>;
+
+    const SIMDLevel supported = OpenFHESIMDControls.GetSupportedLevel();
+    const SIMDLevel saved     = OpenFHESIMDControls.GetLevel();
+    DiscreteUniformGeneratorImpl<NativeVector> dugNative;
+    auto random = [&](const std::vector<NativeInteger>& moduli) {
+        std::vector<NativeInteger> values;
+        for (const auto& m : moduli)
+            values.push_back(dugNative.GenerateVector(1, m)[0]);
+        return values;
+    };
+    auto precon = [](const std::vector<NativeInteger>& values, const std::vector<NativeInteger>& moduli) {
+        std::vector<NativeInteger> precons;
+        for (size_t i = 0; i < values.size(); ++i)
+            precons.push_back(values[i].PrepModMulConst(moduli[i]));
+        return precons;
+    };
+    auto barrett = [](const std::vector<NativeInteger>& moduli) {
+        const auto barrettBase128Bit(Integer(1).LShiftEq(128));
+        std::vector<DoubleNativeInt> mu;
+        for (const auto& m : moduli)
+            mu.push_back((barrettBase128Bit / Integer(m.ConvertToInt())).template ConvertToInt<DoubleNativeInt>());
+        return mu;
+    };
+
+    const uint32_t order = 2048;
+    const uint32_t sizeQ = 3;
+    for (uint32_t bits : {50, 60}) {
+        // Q, Bsk = B U {msk} with |B| = |Q|
+        auto paramsQBsk = std::make_shared<Params>(order, 2 * sizeQ + 1, bits);
+        std::vector<NativeInteger> moduliQ, rootsQ, moduliBsk, rootsBsk;
+        for (uint32_t i = 0; i < 2 * sizeQ + 1; i++) {
+            (i < sizeQ ? moduliQ : moduliBsk).push_back(paramsQBsk->GetParams()[i]->GetModulus());
+            (i < sizeQ ? rootsQ : rootsBsk).push_back(paramsQBsk->GetParams()[i]->GetRootOfUnity());
+        }
+        auto paramsQ   = std::make_shared<Params>(order, moduliQ, rootsQ);
+        auto paramsBsk = std::make_shared<Params>(order, moduliBsk, rootsBsk);
+        const std::vector<NativeInteger> msk{moduliBsk.back()};
+
+        auto QHatInvModq       = random(moduliQ);
+        auto QHatInvModqPrecon = precon(QHatInvModq, moduliQ);
+        auto modqBarrettMu     = barrett(moduliQ);
+        auto modbskBarrettMu   = barrett(moduliBsk);
+        auto QModbsk           = random(moduliBsk);
+        auto QModbskPrecon     = precon(QModbsk, moduliBsk);
+        auto BHatInvModb       = random(moduliBsk);
+        auto BHatInvModbPrecon = precon(BHatInvModb, moduliBsk);
+        auto BHatModmsk        = random(std::vector<NativeInteger>(sizeQ, msk[0]));
+        auto BInvModmsk        = random(msk);
+        auto BInvModmskPrecon  = precon(BInvModmsk, msk);
+        auto BModq             = random(moduliQ);
+        auto BModqPrecon       = precon(BModq, moduliQ);
+        std::vector<std::vector<NativeInteger>> QHatModbsk, BHatModq;
+        for (uint32_t i = 0; i < sizeQ; i++) {
+            QHatModbsk.push_back(random(moduliBsk));
+            BHatModq.push_back(random(moduliQ));
+        }
+        std::vector<uint64_t> QHatModmtilde(sizeQ, 12345);
+
+        typename Element::DugType dug;
+        Element x(dug, paramsQ, Format::COEFFICIENT);
+        Element xBsk(dug, paramsQBsk, Format::COEFFICIENT);
+
+        std::vector<Element> expected;
+        for (int level = SIMD_SCALAR; level <= supported; ++level) {
+            OpenFHESIMDControls.SetLevel(static_cast<SIMDLevel>(level));
+            std::vector<Element> results;
+            results.push_back(x.ApproxSwitchCRTBasis(paramsQ, paramsBsk, QHatInvModq, QHatInvModqPrecon, QHatModbsk,
+                                                     modbskBarrettMu));
+            results.push_back(x);
+            results.back().FastBaseConvqToBskMontgomery(paramsQBsk, moduliQ, moduliBsk, modbskBarrettMu, QHatInvModq,
+                                                        QHatInvModqPrecon, QHatModbsk, QHatModmtilde, QModbsk,
+                                                        QModbskPrecon, 54321, BHatInvModb, BHatInvModbPrecon);
+            results.push_back(xBsk);
+            results.back().FastBaseConvSK(paramsQ, modqBarrettMu, moduliBsk, modbskBarrettMu, BHatInvModb,
+                                          BHatInvModbPrecon, BHatModmsk, BInvModmsk[0], BInvModmskPrecon[0], BHatModq,
+                                          BModq, BModqPrecon);
+            if (level == SIMD_SCALAR) {
+                expected = results;
+                continue;
+            }
+            std::stringstream levelMsg;
+            levelMsg << msg << " modulus bits = " << bits << ", SIMD level " << static_cast<SIMDLevel>(level);
+            EXPECT_EQ(expected[0], results[0]) << levelMsg.str() << " ApproxSwitchCRTBasis";
+            EXPECT_EQ(expected[1], results[1]) << levelMsg.str() << " FastBaseConvqToBskMontgomery";
+            EXPECT_EQ(expected[2], results[2]) << levelMsg.str() << " FastBaseConvSK";
+        }
+    }
+    OpenFHESIMDControls.SetLevel(saved);
+}
+
+TEST(UTDCRTPoly, DCRT_base_conv_simd) {
+    RUN_BIG_DCRTPOLYS(DCRT_base_conv_simd, "DCRT_base_conv_simd");
+}
+
 // only need to try this with one
 void testDCRTPolyConstructorNegative(std::vector<NativePoly>& towers) {
     DCRTPoly expectException(towers);
@@ -38,13 +38,18 @@
   3. Math layer operations such as functions in nbtheory
   */
 
+#include <atomic>
 #include <iostream>
+#include <sstream>
+#include <thread>
+#include <vector>
 #include "gtest/gtest.h"
 
 #include "lattice/lat-hal.h"
 #include "math/distrgen.h"
 #include "math/nbtheory.h"
 #include "testdefs.h"
+#include "utils/cpufeatures.h"
 #include "utils/inttypes.h"
 #include "utils/utilities.h"
 
@@ -111,3 +116,190 @@ void switch_format_simple_double_crt(const std::string& msg) {
 TEST(UTNTT, switch_format_simple_double_crt) {
     RUN_BIG_DCRTPOLYS(switch_format_simple_double_crt, "switch_format_simple_double_crt")
 }
+
+// the vectorized NTT kernels must be bit-exact with the scalar implementation for every supported SIMD level
+TEST(UTNTT, simd_vs_scalar_native) {
+    const SIMDLevel supported = OpenFHESIMDControls.GetSupportedLevel();
+    const SIMDLevel saved     = OpenFHESIMDControls.GetLevel();
+    DiscreteUniformGeneratorImpl<NativeVector> dug;
+
+    for (usint n : {8, 16, 32, 64, 1024, 8192}) {
+        usint m = 2 * n;
+        // 49 bits and below exercise the AVX-512 IFMA kernels
+        for (usint bits : {20, 35, 49, 50, 55, MAX_MODULUS_SIZE}) {
+            NativeInteger modulus = LastPrime<NativeInteger>(bits, m);
+            NativeInteger root    = RootOfUnity<NativeInteger>(m, modulus);
+            NativeVector input    = dug.GenerateVector(n, modulus);
+
+            OpenFHESIMDControls.SetLevel(SIMD_SCALAR);
+            NativeVector fwdScalar(input);
+            ChineseRemainderTransformFTT<NativeVector>().ForwardTransformToBitReverseInPlace(root, m, &fwdScalar);
+            NativeVector invScalar(input);
+            ChineseRemainderTransformFTT<NativeVector>().InverseTransformFromBitReverseInPlace(root, m, &invScalar);
+
+            for (int level = SIMD_AVX2; level <= supported; ++level) {
+                OpenFHESIMDControls.SetLevel(static_cast<SIMDLevel>(level));
+                std::stringstream msg;
+                msg << "n = " << n << ", modulus bits = " << bits << ", SIMD level "
+                    << static_cast<SIMDLevel>(level);
+
+                NativeVector fwd(input);
+                ChineseRemainderTransformFTT<NativeVector>().ForwardTransformToBitReverseInPlace(root, m, &fwd);
+                EXPECT_EQ(fwdScalar, fwd) << "forward NTT " << msg.str();
+
+                NativeVector inv(input);
+                ChineseRemainderTransformFTT<NativeVector>().InverseTransformFromBitReverseInPlace(root, m, &inv);
+                EXPECT_EQ(invScalar, inv) << "inverse NTT " << msg.str();
+
+                ChineseRemainderTransformFTT<NativeVector>().InverseTransformFromBitReverseInPlace(root, m, &fwd);
+                EXPECT_EQ(input, fwd) << "NTT round trip " << msg.str();
+            }
+        }
+    }
+    OpenFHESIMDControls.SetLevel(saved);
+}
+
+// the lazy-reduction (Harvey) transforms must be bit-exact with the fully reduced ones; with the vectorized
+// kernels disabled, the lazy transforms are the ones the in-place transforms run for moduli below 2^62
+TEST(UTNTT, lazy_vs_reduced_native) {
+    using CRT             = intnat::ChineseRemainderTransformFTTNat<NativeVector>;
+    const SIMDLevel saved = OpenFHESIMDControls.GetLevel();
+    OpenFHESIMDControls.SetLevel(SIMD_SCALAR);
+    DiscreteUniformGeneratorImpl<NativeVector> dug;
+    intnat::NumberTheoreticTransformNat<NativeVector> ntt;
+
+    for (usint n : {4, 8, 64, 4096}) {
+        usint m = 2 * n;
+        for (usint bits : {20, 35, 50, MAX_MODULUS_SIZE}) {
+            NativeInteger modulus = LastPrime<NativeInteger>(bits, m);
+            NativeInteger root    = RootOfUnity<NativeInteger>(m, modulus);
+            const auto& tables      = CRT::GetTables(root, m, modulus);
+            const auto& table       = tables.rootOfUnityReverse;
+            const auto& precon      = tables.rootOfUnityPreconReverse;
+            const auto& tableInv    = tables.rootOfUnityInverseReverse;
+            const auto& preconInv   = tables.rootOfUnityInversePreconReverse;
+            const auto& nInv        = tables.cycloOrderInverse;
+            const auto& preconNInv  = tables.cycloOrderInversePrecon;
+            NativeVector input      = dug.GenerateVector(n, modulus);
+            input[0]                = modulus - NativeInteger(1);
+
+            NativeVector fwd(input), fwdLazy(input);
+            ntt.ForwardTransformToBitReverseInPlaceReduced(table, precon, &fwd);
+            ntt.ForwardTransformToBitReverseInPlaceLazy(table, precon, &fwdLazy);
+            EXPECT_EQ(fwd, fwdLazy) << "forward NTT, n = " << n << ", modulus bits = " << bits;
+            NativeVector fwdScalar(input);
+            ntt.ForwardTransformToBitReverseInPlace(table, precon, &fwdScalar);
+            EXPECT_EQ(fwd, fwdScalar) << "scalar forward NTT, n = " << n << ", modulus bits = " << bits;
+
+            NativeVector inv(input), invLazy(input);
+            ntt.InverseTransformFromBitReverseInPlaceReduced(tableInv, preconInv, nInv, preconNInv, &inv);
+            ntt.InverseTransformFromBitReverseInPlaceLazy(tableInv, preconInv, nInv, preconNInv, &invLazy);
+            EXPECT_EQ(inv, invLazy) << "inverse NTT, n = " << n << ", modulus bits = " << bits;
+            NativeVector invScalar(input);
+            ntt.InverseTransformFromBitReverseInPlace(tableInv, preconInv, nInv, preconNInv, &invScalar);
+            EXPECT_EQ(inv, invScalar) << "scalar inverse NTT, n = " << n << ", modulus bits = " << bits;
+
+            ntt.InverseTransformFromBitReverseInPlaceLazy(tableInv, preconInv, nInv, preconNInv, &fwdLazy);
+            EXPECT_EQ(input, fwdLazy) << "NTT round trip, n = " << n << ", modulus bits = " << bits;
+        }
+    }
+    OpenFHESIMDControls.SetLevel(saved);
+}
+
+// the batched multi-tower transforms must be bit-exact with the per-tower transforms,
+// both for a single block (n <= 2^LOG_BATCH_BLOCK_SIZE) and for the cache-blocked decomposition
+TEST(UTNTT, batch_vs_single_native) {
+    const SIMDLevel supported = OpenFHESIMDControls.GetSupportedLevel();
+    const SIMDLevel saved     = OpenFHESIMDControls.GetLevel();
+    DiscreteUniformGeneratorImpl<NativeVector> dug;
+
+    for (usint n : {8, 4096, 8192, 32768, 131072}) {
+        usint m = 2 * n;
+        std::vector<NativeInteger> roots;
+        std::vector<NativeVector> inputs;
+        std::vector<NativeVector> fwdSingle, invSingle;
+        OpenFHESIMDControls.SetLevel(SIMD_SCALAR);
+        for (usint bits : {35, 49, MAX_MODULUS_SIZE}) {
+            NativeInteger modulus = LastPrime<NativeInteger>(bits, m);
+            roots.push_back(RootOfUnity<NativeInteger>(m, modulus));
+            inputs.push_back(dug.GenerateVector(n, modulus));
+            fwdSingle.push_back(inputs.back());
+            ChineseRemainderTransformFTT<NativeVector>().ForwardTransformToBitReverseInPlace(roots.back(), m,
+                                                                                             &fwdSingle.back());
+            invSingle.push_back(inputs.back());
+            ChineseRemainderTransformFTT<NativeVector>().InverseTransformFromBitReverseInPlace(roots.back(), m,
+                                                                                               &invSingle.back());
+        }
+
+        for (int level = SIMD_SCALAR; level <= supported; ++level) {
+            OpenFHESIMDControls.SetLevel(static_cast<SIMDLevel>(level));
+            std::stringstream msg;
+            msg << "n = " << n << ", SIMD level " << static_cast<SIMDLevel>(level);
+
+            std::vector<NativeVector> fwd(inputs), inv(inputs);
+            std::vector<NativeVector*> fwdPtrs, invPtrs;
+            for (size_t i = 0; i < inputs.size(); ++i) {
+                fwdPtrs.push_back(&fwd[i]);
+                invPtrs.push_back(&inv[i]);
+            }
+            ChineseRemainderTransformFTT<NativeVector>().ForwardTransformToBitReverseInPlace(roots, m, fwdPtrs);
+            ChineseRemainderTransformFTT<NativeVector>().InverseTransformFromBitReverseInPlace(roots, m, invPtrs);
+            for (size_t i = 0; i < inputs.size(); ++i) {
+                EXPECT_EQ(fwdSingle[i], fwd[i]) << "batched forward NTT, tower " << i << ", " << msg.str();
+                EXPECT_EQ(invSingle[i], inv[i]) << "batched inverse NTT, tower " << i << ", " << msg.str();
+            }
+
+            ChineseRemainderTransformFTT<NativeVector>().InverseTransformFromBitReverseInPlace(roots, m, fwdPtrs);
+            EXPECT_EQ(inputs, fwd) << "batched NTT round trip " << msg.str();
+        }
+    }
+    OpenFHESIMDControls.SetLevel(saved);
+}
+
+// threads first touching the same moduli at once must all get the same complete tables
+TEST(UTNTT, concurrent_precomputation_native) {
+    using CRT = ChineseRemainderTransformFTT<NativeVector>;
+    DiscreteUniformGeneratorImpl<NativeVector> dug;
+
+    const usint n = 1024;
+    const usint m = 2 * n;
+    std::vector<NativeInteger> roots;
+    std::vector<NativeVector> inputs;
+    for (usint bits : {31, 33, 37, 41, 43, 47}) {
+        NativeInteger modulus = LastPrime<NativeInteger>(bits, m);
+        roots.push_back(RootOfUnity<NativeInteger>(m, modulus));
+        inputs.push_back(dug.GenerateVector(n, modulus));
+    }
+    CRT().Reset();
+
+    const size_t numThreads = 8;
+    std::vector<std::vector<const CRT::NTTTables*>> tables(numThreads);
+    std::atomic<size_t> mismatches{0};
+    std::vector<std::thread> threads;
+    for (size_t t = 0; t < numThreads; ++t) {
+        threads.emplace_back([&, t]() {
+            for (size_t k = 0; k < roots.size(); ++k) {
+                // each thread walks the moduli in a different order
+                size_t i             = (k + t) % roots.size();
+                const auto& modulus  = inputs[i].GetModulus();
+                NativeVector element = inputs[i];
+                CRT().ForwardTransformToBitReverseInPlace(roots[i], m, &element);
+                CRT().InverseTransformFromBitReverseInPlace(roots[i], m, &element);
+                if (element != inputs[i])
+                    ++mismatches;
+                tables[t].push_back(&CRT::GetTables(roots[i], m, modulus));
+            }
+        });
+    }
+    for (auto& thread : threads)
+        thread.join();
+
+    EXPECT_EQ(0u, mismatches.load()) << "NTT round trips with concurrently precomputed tables";
+    for (size_t t = 0; t < numThreads; ++t) {
+        for (size_t k = 0; k < roots.size(); ++k) {
+            size_t i = (k + t) % roots.size();
+            EXPECT_EQ(&CRT::GetTables(roots[i], m, inputs[i].GetModulus()), tables[t][k])
+                << "thread " << t << " got its own tables for modulus " << inputs[i].GetModulus();
+        }
+    }
+}
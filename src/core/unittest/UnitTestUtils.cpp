@@ -33,10 +33,16 @@
   This file tests utilities functions
  */
 
+#include <atomic>
 #include <fstream>
 #include <iostream>
+#include <thread>
+#include <vector>
 #include "include/gtest/gtest.h"
 
+#include "utils/parallel.h"
+#include "utils/precomputation-registry.h"
+#include "utils/taskpool.h"
 #include "utils/utilities.h"
 
 using namespace lbcrypto;
@@ -53,3 +59,158 @@ TEST(Utilities, IsPowerOfTwo) {
         EXPECT_FALSE(IsPowerOfTwo(not_power_of_two));
     }
 }
+
+TEST(Utilities, ScopedParallelism) {
+    const int full = OpenFHEParallelControls.GetThreadLimit(1 << 20);
+    {
+        ScopedParallelism outer(1);
+        EXPECT_EQ(OpenFHEParallelControls.GetThreadLimit(1 << 20), 1);
+        {
+            ScopedParallelism inner(0);
+            EXPECT_EQ(OpenFHEParallelControls.GetThreadLimit(1 << 20), full);
+        }
+        EXPECT_EQ(OpenFHEParallelControls.GetThreadLimit(1 << 20), 1);
+
+        // the limit belongs to the thread that set it
+        int otherLimit = 0;
+        std::thread other([&otherLimit] { otherLimit = OpenFHEParallelControls.GetThreadLimit(1 << 20); });
+        other.join();
+        EXPECT_EQ(otherLimit, full);
+    }
+    EXPECT_EQ(OpenFHEParallelControls.GetThreadLimit(1 << 20), full);
+    EXPECT_THROW(ScopedParallelism(-1), OpenFHEException);
+
+    std::vector<size_t> values(1000);
+    {
+        ScopedParallelism guard(2);
+        ParallelFor(0, values.size(), OpenFHEParallelControls.GetThreadLimit(values.size()), [&](size_t i) {
+            values[i] = i;
+        });
+    }
+    for (size_t i = 0; i < values.size(); ++i)
+        EXPECT_EQ(values[i], i);
+}
+
+TEST(Utilities, ParallelForNested) {
+    const size_t rows = 16, cols = 1000;
+    std::vector<size_t> values(rows * cols);
+    ParallelFor(0, rows, OpenFHEParallelControls.GetThreadLimit(rows), [&](size_t i) {
+        ParallelForRange(0, cols, OpenFHEParallelControls.GetThreadLimit(cols), [&](size_t first, size_t last) {
+            for (size_t j = first; j < last; ++j)
+                values[i * cols + j] = i * cols + j;
+        });
+    });
+    for (size_t k = 0; k < values.size(); ++k)
+        EXPECT_EQ(values[k], k);
+}
+
+TEST(Utilities, ParallelForException) {
+    const size_t n = 1000;
+    std::atomic<size_t> count{0};
+    auto body = [&](size_t i) {
+        if (i == 37)
+            OPENFHE_THROW("error in the loop body");
+        ++count;
+    };
+    EXPECT_THROW(ParallelFor(0, n, OpenFHEParallelControls.GetThreadLimit(n), body), OpenFHEException);
+    EXPECT_THROW(ParallelForRange(0, n, OpenFHEParallelControls.GetThreadLimit(n),
+                                  [&](size_t first, size_t last) {
+                                      for (size_t i = first; i < last; ++i)
+                                          body(i);
+                                  }),
+                 OpenFHEException);
+
+    // the threads are still usable after a failed loop
+    count = 0;
+    ParallelFor(0, n, OpenFHEParallelControls.GetThreadLimit(n), [&](size_t) { ++count; });
+    EXPECT_EQ(count.load(), n);
+}
+
+TEST(Utilities, ParallelForConcurrentCallers) {
+    const size_t numCallers = 4, numLoops = 50, n = 1000;
+    std::vector<std::vector<size_t>> sums(numCallers, std::vector<size_t>(n, 0));
+    std::vector<std::thread> callers;
+    for (size_t c = 0; c < numCallers; ++c) {
+        callers.emplace_back([&, c] {
+            for (size_t l = 0; l < numLoops; ++l) {
+                ParallelFor(0, n, OpenFHEParallelControls.GetThreadLimit(n), [&](size_t i) {
+                    sums[c][i] += i + c;
+                });
+            }
+        });
+    }
+    for (auto& caller : callers)
+        caller.join();
+    for (size_t c = 0; c < numCallers; ++c) {
+        for (size_t i = 0; i < n; ++i)
+            EXPECT_EQ(sums[c][i], numLoops * (i + c));
+    }
+}
+
+TEST(Utilities, PrecomputationRegistryReclaim) {
+    PrecomputationRegistry<uint32_t, uint64_t> registry;
+    for (uint32_t key = 0; key < 20; ++key)
+        registry.GetOrCreate(key, [key] { return uint64_t(key) * key; });
+    EXPECT_EQ(registry.Size(), 20u);
+    EXPECT_EQ(registry.GetRetainedCount(), 1u) << "replaced snapshots are kept without readers";
+
+    // a handle keeps a replaced value alive; the registry itself only keeps the current snapshot
+    auto handle = registry.FindShared(3);
+    for (uint64_t value = 100; value < 110; ++value)
+        registry.Set(3, value);
+    EXPECT_EQ(*handle, 9u);
+    EXPECT_EQ(*registry.Find(3), 109u);
+    EXPECT_EQ(registry.GetRetainedCount(), 1u);
+
+    // concurrent lookups and writers; the snapshots replaced meanwhile are freed by the last lookup
+    std::vector<std::thread> threads;
+    std::atomic<bool> mismatch{false};
+    for (uint32_t t = 0; t < 4; ++t) {
+        threads.emplace_back([&, t] {
+            for (uint32_t i = 0; i < 2000; ++i) {
+                if (t == 0) {
+                    registry.Set(100 + i % 50, i);
+                }
+                else {
+                    uint32_t key = i % 20;
+                    if (key != 3 && *registry.FindShared(key) != uint64_t(key) * key)
+                        mismatch = true;
+                }
+            }
+        });
+    }
+    for (auto& thread : threads)
+        thread.join();
+    EXPECT_FALSE(mismatch.load());
+    registry.Find(0);
+    EXPECT_EQ(registry.GetRetainedCount(), 1u);
+}
+
+#ifdef WITH_TASKPOOL
+TEST(Utilities, TaskPoolShutdown) {
+    // pools are started and stopped while idle, right after nested work and with a single worker, which has to
+    // wait for chunks running on the calling thread
+    for (uint32_t numWorkers : {0u, 1u, 3u}) {
+        for (int round = 0; round < 10; ++round) {
+            TaskPool idle(numWorkers);
+            EXPECT_EQ(idle.GetNumWorkers(), numWorkers);
+            EXPECT_FALSE(idle.InWorker());
+
+            TaskPool pool(numWorkers);
+            std::atomic<size_t> count{0};
+            std::atomic<bool> workerSeen{false};
+            pool.ParallelFor(0, 8, 8, [&](size_t first, size_t last) {
+                if (pool.InWorker())
+                    workerSeen = true;
+                for (size_t i = first; i < last; ++i) {
+                    pool.ParallelFor(0, 100, 4, [&](size_t innerFirst, size_t innerLast) {
+                        count += innerLast - innerFirst;
+                    });
+                }
+            });
+            EXPECT_EQ(count.load(), 800u);
+            EXPECT_TRUE(numWorkers > 0 || !workerSeen.load());
+        }
+    }
+}
+#endif
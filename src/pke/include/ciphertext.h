@@ -95,6 +95,7 @@ public:
         encodingType       = ciphertext.encodingType;
         m_slots            = ciphertext.m_slots;
         m_metadataMap      = ciphertext.m_metadataMap;
+        m_seed             = ciphertext.m_seed;
     }
 
     explicit CiphertextImpl(Ciphertext<Element> ciphertext) : CryptoObject<Element>(*ciphertext) {
@@ -107,6 +108,7 @@ public:
         encodingType       = ciphertext->encodingType;
         m_slots            = ciphertext->m_slots;
         m_metadataMap      = ciphertext->m_metadataMap;
+        m_seed             = ciphertext->m_seed;
     }
 
     /**
@@ -122,6 +124,7 @@ public:
         encodingType       = std::move(ciphertext.encodingType);
         m_slots            = std::move(ciphertext.m_slots);
         m_metadataMap      = std::move(ciphertext.m_metadataMap);
+        m_seed             = std::move(ciphertext.m_seed);
     }
 
     explicit CiphertextImpl(Ciphertext<Element>&& ciphertext) : CryptoObject<Element>(*ciphertext) {
@@ -134,6 +137,7 @@ public:
         encodingType       = std::move(ciphertext->encodingType);
         m_slots            = std::move(ciphertext->m_slots);
         m_metadataMap      = std::move(ciphertext->m_metadataMap);
+        m_seed             = std::move(ciphertext->m_seed);
     }
 
     /**
@@ -192,6 +196,7 @@ public:
             this->encodingType       = rhs.encodingType;
             this->m_slots            = rhs.m_slots;
             this->m_metadataMap      = rhs.m_metadataMap;
+            this->m_seed             = rhs.m_seed;
         }
 
         return *this;
@@ -215,6 +220,7 @@ public:
             this->encodingType       = std::move(rhs.encodingType);
             this->m_slots            = std::move(rhs.m_slots);
             this->m_metadataMap      = std::move(rhs.m_metadataMap);
+            this->m_seed             = std::move(rhs.m_seed);
         }
 
         return *this;
@@ -456,9 +462,36 @@ public:
         (*m_metadataMap)[key] = std::move(value);
     }
 
+    /**
+   * Get the seed the "a" component of a secret-key encrypted ciphertext was expanded from.
+   *
+   * @return the seed or nullptr if the ciphertext was not created with seed compression enabled
+   */
+    std::shared_ptr<const PRNGSeed> GetSeed() const {
+        return m_seed;
+    }
+
+    /**
+   * Record the seed the "a" component (the second element) was expanded from.
+   * The seed is only used for serialization and only as long as the second element still matches it.
+   */
+    void SetSeed(const PRNGSeed& seed) {
+        m_seed = std::make_shared<const PRNGSeed>(seed);
+    }
+
+    /**
+   * Checks whether the second element is still the expansion of the recorded seed, so it can be
+   * serialized as the seed.
+   */
+    bool IsSeedCompressible() const {
+        return m_seed != nullptr && m_elements.size() == 2 && m_elements[1].GetFormat() == Format::EVALUATION &&
+               m_elements[1] == CryptoObject<Element>::ExpandSeed(*m_seed, m_elements[1].GetParams(), 1)[0];
+    }
+
     virtual Ciphertext<Element> Clone() const {
         Ciphertext<Element> cRes = this->CloneZero();
         cRes->SetElements(this->GetElements());
+        cRes->m_seed = m_seed;
 
         return cRes;
     }
@@ -551,7 +584,18 @@ public:
     template <class Archive>
     void save(Archive& ar, std::uint32_t const version) const {
         ar(cereal::base_class<CryptoObject<Element>>(this));
-        ar(cereal::make_nvp("v", m_elements));
+        // the "a" component of a seeded ciphertext is written as its seed; version 1 archives always hold
+        // both elements
+        bool seeded = version > 1 && IsSeedCompressible();
+        if (version > 1)
+            ar(cereal::make_nvp("sd", seeded));
+        if (seeded) {
+            ar(cereal::make_nvp("v0", m_elements[0]));
+            ar(cereal::make_nvp("a", *m_seed));
+        }
+        else {
+            ar(cereal::make_nvp("v", m_elements));
+        }
         ar(cereal::make_nvp("d", m_noiseScaleDeg));
         ar(cereal::make_nvp("l", m_level));
         ar(cereal::make_nvp("t", m_hopslevel));
@@ -569,7 +613,21 @@ public:
                           " is from a later version of the library");
         }
         ar(cereal::base_class<CryptoObject<Element>>(this));
-        ar(cereal::make_nvp("v", m_elements));
+        bool seeded = false;
+        if (version > 1)
+            ar(cereal::make_nvp("sd", seeded));
+        if (seeded) {
+            Element b;
+            PRNGSeed seed;
+            ar(cereal::make_nvp("v0", b));
+            ar(cereal::make_nvp("a", seed));
+            Element a  = CryptoObject<Element>::ExpandSeed(seed, b.GetParams(), 1)[0];
+            m_elements = {std::move(b), std::move(a)};
+            m_seed     = std::make_shared<const PRNGSeed>(seed);
+        }
+        else {
+            ar(cereal::make_nvp("v", m_elements));
+        }
         ar(cereal::make_nvp("d", m_noiseScaleDeg));
         ar(cereal::make_nvp("l", m_level));
         ar(cereal::make_nvp("t", m_hopslevel));
@@ -584,7 +642,7 @@ public:
         return "Ciphertext";
     }
     static uint32_t SerializedVersion() {
-        return 1;
+        return 2;
     }
 
 private:
@@ -609,6 +667,9 @@ private:
 
     // A map to hold different Metadata objects - used for flexible extensions of Ciphertext
     MetadataMap m_metadataMap = std::make_shared<std::map<std::string, std::shared_ptr<Metadata>>>();
+
+    // seed of the "a" component for secret-key encryption with seed compression; nullptr otherwise
+    std::shared_ptr<const PRNGSeed> m_seed;
 };
 
 // TODO the op= are not doing the work in-place, and should be updated
@@ -444,6 +444,21 @@ protected:
 
     PrivateKey<Element> privateKey;
 
+    /**
+   * Shared implementation of EncryptStream() for both key types and value types
+   */
+    template <typename T, typename KeyType>
+    void EncryptStreamInternal(const KeyType key, const T* values, size_t size,
+                               const std::function<void(size_t, Ciphertext<Element>)>& sink, uint32_t level) const;
+
+    Plaintext MakeStreamPlaintext(const std::vector<double>& block, uint32_t level) const {
+        return MakeCKKSPackedPlaintext(block, 1, level);
+    }
+
+    Plaintext MakeStreamPlaintext(const std::vector<int64_t>& block, uint32_t level) const {
+        return MakePackedPlaintext(block, 1, level);
+    }
+
 public:
     /**
    * This stores the private key in the crypto context.
@@ -1173,6 +1188,66 @@ public:
         return MakeCKKSPackedPlaintextInternal(complexValue, scaleDeg, level, params, slots);
     }
 
+    /**
+   * MakeCKKSPackedPlaintextExt constructs a CKKSPackedEncoding in the extended CRT basis P*Q.
+   * Such plaintexts can be multiplied by ciphertexts in the extended basis (see EvalMultExt).
+   * Only supported for hybrid key switching.
+   * @param value - input vector of complex numbers
+   * @param scaleDeg - degree of scaling factor used to encode the vector
+   * @param level - level of the ciphertexts the plaintext will be multiplied by
+   * @param slots - number of slots
+   * @return plaintext in the basis P*Q
+   */
+    Plaintext MakeCKKSPackedPlaintextExt(const std::vector<std::complex<double>>& value, size_t scaleDeg = 1,
+                                         uint32_t level = 0, usint slots = 0) const {
+        VerifyCKKSScheme(__func__);
+        if (!value.size())
+            OPENFHE_THROW("Cannot encode an empty value vector");
+
+        const auto cryptoParams = std::dynamic_pointer_cast<CryptoParametersRNS>(GetCryptoParameters());
+        if (cryptoParams->GetKeySwitchTechnique() != HYBRID)
+            OPENFHE_THROW("MakeCKKSPackedPlaintextExt is only supported for hybrid key switching");
+
+        const auto& paramsQ = cryptoParams->GetElementParams()->GetParams();
+        const auto& paramsP = cryptoParams->GetParamsP()->GetParams();
+        if (level >= paramsQ.size())
+            OPENFHE_THROW("The level [" + std::to_string(level) + "] should be less than the number of moduli [" +
+                          std::to_string(paramsQ.size()) + "]");
+        size_t sizeQl = paramsQ.size() - level;
+
+        std::vector<NativeInteger> moduli(sizeQl + paramsP.size());
+        std::vector<NativeInteger> roots(sizeQl + paramsP.size());
+        for (size_t i = 0; i < sizeQl; i++) {
+            moduli[i] = paramsQ[i]->GetModulus();
+            roots[i]  = paramsQ[i]->GetRootOfUnity();
+        }
+        for (size_t i = 0; i < paramsP.size(); i++) {
+            moduli[sizeQl + i] = paramsP[i]->GetModulus();
+            roots[sizeQl + i]  = paramsP[i]->GetRootOfUnity();
+        }
+        auto paramsQlP = std::make_shared<ILDCRTParams<DCRTPoly::Integer>>(GetCyclotomicOrder(), moduli, roots);
+
+        return MakeCKKSPackedPlaintextInternal(value, scaleDeg, level, paramsQlP, slots);
+    }
+
+    /**
+   * MakeCKKSPackedPlaintextExt constructs a CKKSPackedEncoding in the extended CRT basis P*Q
+   * from a vector of real numbers
+   * @param value - input vector of real numbers
+   * @param scaleDeg - degree of scaling factor used to encode the vector
+   * @param level - level of the ciphertexts the plaintext will be multiplied by
+   * @param slots - number of slots
+   * @return plaintext in the basis P*Q
+   */
+    Plaintext MakeCKKSPackedPlaintextExt(const std::vector<double>& value, size_t scaleDeg = 1, uint32_t level = 0,
+                                         usint slots = 0) const {
+        std::vector<std::complex<double>> complexValue(value.size());
+        std::transform(value.begin(), value.end(), complexValue.begin(),
+                       [](double da) { return std::complex<double>(da); });
+
+        return MakeCKKSPackedPlaintextExt(complexValue, scaleDeg, level, slots);
+    }
+
     /**
    * GetPlaintextForDecrypt returns a new Plaintext to be used in decryption.
    *
@@ -1299,6 +1374,73 @@ public:
         return Decrypt(ciphertext, privateKey, plaintext);
     }
 
+    //------------------------------------------------------------------------------
+    // Streaming encryption/decryption
+    //------------------------------------------------------------------------------
+
+    /**
+   * Number of values packed into each ciphertext by EncryptStream(): the batch size of the encoding
+   * parameters or, if it is not set, the maximum number of slots
+   * @return block size
+   */
+    uint32_t GetStreamBlockSize() const;
+
+    /**
+   * Encrypts a vector longer than one ciphertext. The values are split into consecutive blocks of
+   * GetStreamBlockSize() values (the last one may be shorter); each block is encoded (CKKS packed encoding)
+   * and encrypted. Blocks are processed in parallel, one per thread, with a per-thread scratch buffer that
+   * is reused across rounds. The sink is called on the calling thread in block order, so it does not need
+   * to be thread-safe. It runs between the rounds, while no block is encrypted: the encryption is not
+   * pipelined with the sink, so a slow sink (e.g. one writing to a file or a socket) should hand the
+   * ciphertexts to a queue drained by a thread of its own.
+   *
+   * @param publicKey encryption key
+   * @param values pointer to the first value
+   * @param size number of values
+   * @param sink receives the block index and its ciphertext
+   * @param level level to encode the plaintexts at
+   */
+    void EncryptStream(const PublicKey<Element> publicKey, const double* values, size_t size,
+                       const std::function<void(size_t, Ciphertext<Element>)>& sink, uint32_t level = 0) const;
+    void EncryptStream(const PrivateKey<Element> privateKey, const double* values, size_t size,
+                       const std::function<void(size_t, Ciphertext<Element>)>& sink, uint32_t level = 0) const;
+
+    /**
+   * Same as above with packed encoding of integers (BFV and BGV)
+   */
+    void EncryptStream(const PublicKey<Element> publicKey, const int64_t* values, size_t size,
+                       const std::function<void(size_t, Ciphertext<Element>)>& sink, uint32_t level = 0) const;
+    void EncryptStream(const PrivateKey<Element> privateKey, const int64_t* values, size_t size,
+                       const std::function<void(size_t, Ciphertext<Element>)>& sink, uint32_t level = 0) const;
+
+    template <typename T, typename KeyType>
+    void EncryptStream(const KeyType key, const std::vector<T>& values,
+                       const std::function<void(size_t, Ciphertext<Element>)>& sink, uint32_t level = 0) const {
+        EncryptStream(key, values.data(), values.size(), sink, level);
+    }
+
+    /**
+   * Decrypts a sequence of ciphertexts, typically produced by EncryptStream(). Ciphertexts are requested
+   * from the source and handed to the sink on the calling thread in order; decryption and decoding run in
+   * parallel, one ciphertext per thread. As in EncryptStream(), the source and the sink run between the
+   * rounds, while no ciphertext is decrypted. The plaintexts keep the full batch size, so the caller trims
+   * the last one with SetLength() if needed.
+   *
+   * @param privateKey decryption key
+   * @param numCiphertexts number of ciphertexts
+   * @param source returns the ciphertext with the given index
+   * @param sink receives the index and the decrypted plaintext
+   */
+    void DecryptStream(const PrivateKey<Element> privateKey, size_t numCiphertexts,
+                       const std::function<ConstCiphertext<Element>(size_t)>& source,
+                       const std::function<void(size_t, Plaintext)>& sink);
+
+    void DecryptStream(const PrivateKey<Element> privateKey, const std::vector<Ciphertext<Element>>& ciphertexts,
+                       const std::function<void(size_t, Plaintext)>& sink) {
+        DecryptStream(
+            privateKey, ciphertexts.size(), [&ciphertexts](size_t i) { return ciphertexts[i]; }, sink);
+    }
+
     //------------------------------------------------------------------------------
     // KeySwitch Wrapper
     //------------------------------------------------------------------------------
@@ -1343,6 +1485,25 @@ public:
         GetScheme()->KeySwitchInPlace(ciphertext, evalKey);
     }
 
+    /**
+   * KeySwitchMany - applies several key switches to the same ciphertext. For hybrid key switching
+   * the digit decomposition and ModUp of the ciphertext are computed once and shared by all keys,
+   * so this is cheaper than calling KeySwitch for every key.
+   * Note: the keys are used as plain key switching keys; for automorphism keys the automorphism
+   * still has to be applied to the results, as EvalAutomorphism does.
+   * @param ciphertext - ciphertext
+   * @param evalKeys - evaluation keys used for key switching
+   * @return a vector of ciphertexts, the i-th one being KeySwitch(ciphertext, evalKeys[i])
+   */
+    std::vector<Ciphertext<Element>> KeySwitchMany(ConstCiphertext<Element> ciphertext,
+                                                   const std::vector<EvalKey<Element>>& evalKeys) const {
+        ValidateCiphertext(ciphertext);
+        for (const auto& evalKey : evalKeys)
+            ValidateKey(evalKey);
+
+        return GetScheme()->KeySwitchMany(ciphertext, evalKeys);
+    }
+
     //------------------------------------------------------------------------------
     // SHE NEGATION Wrapper
     //------------------------------------------------------------------------------
@@ -2258,6 +2419,60 @@ public:
         return GetScheme()->KeySwitchExt(ciphertext, addFirst);
     }
 
+    /**
+   * Only supported for hybrid key switching.
+   * Multiplies a ciphertext in the extended basis P*Q by a plaintext in the same basis
+   * (see MakeCKKSPackedPlaintextExt). No rescaling is done.
+   *
+   * Together with EvalFastRotationExt/KeySwitchExt, EvalAddExt and KeySwitchDown this allows
+   * computing sum_i rot_i(ct) * pt_i with a single ModDown:
+   *
+   *   auto digits = cc->EvalFastRotationPrecompute(ct);
+   *   auto acc    = cc->EvalMultExt(cc->KeySwitchExt(ct, true), pt[0]);
+   *   for (...) cc->EvalAddExtInPlace(acc, cc->EvalMultExt(cc->EvalFastRotationExt(ct, i, digits, true), pt[i]));
+   *   auto result = cc->KeySwitchDown(acc);
+   *
+   * @param ciphertext input ciphertext in the extended basis
+   * @param plaintext input plaintext in the extended basis
+   * @return resulting ciphertext in the extended basis
+   */
+    Ciphertext<Element> EvalMultExt(ConstCiphertext<Element> ciphertext, ConstPlaintext plaintext) const {
+        ValidateCiphertext(ciphertext);
+        if (!plaintext)
+            OPENFHE_THROW("Input plaintext is nullptr");
+
+        return GetScheme()->EvalMultExt(ciphertext, plaintext);
+    }
+
+    /**
+   * Only supported for hybrid key switching.
+   * Adds two ciphertexts in the extended basis P*Q.
+   *
+   * @param ciphertext1 first ciphertext in the extended basis
+   * @param ciphertext2 second ciphertext in the extended basis
+   * @return resulting ciphertext in the extended basis
+   */
+    Ciphertext<Element> EvalAddExt(ConstCiphertext<Element> ciphertext1, ConstCiphertext<Element> ciphertext2) const {
+        ValidateCiphertext(ciphertext1);
+        ValidateCiphertext(ciphertext2);
+
+        return GetScheme()->EvalAddExt(ciphertext1, ciphertext2);
+    }
+
+    /**
+   * Only supported for hybrid key switching.
+   * Adds a ciphertext in the extended basis P*Q to another one in place.
+   *
+   * @param ciphertext1 first ciphertext in the extended basis; the result is stored here
+   * @param ciphertext2 second ciphertext in the extended basis
+   */
+    void EvalAddExtInPlace(Ciphertext<Element>& ciphertext1, ConstCiphertext<Element> ciphertext2) const {
+        ValidateCiphertext(ciphertext1);
+        ValidateCiphertext(ciphertext2);
+
+        GetScheme()->EvalAddExtInPlace(ciphertext1, ciphertext2);
+    }
+
     /**
    * EvalAtIndexKeyGen generates evaluation keys for a list of rotation indices
    *
@@ -36,11 +36,13 @@
 #include "encoding/encodingparams.h"
 #include "schemebase/base-cryptoparameters.h"
 #include "cryptocontextfactory.h"
+#include "math/discreteuniformgenerator.h"
 
 #include <algorithm>
 #include <memory>
 #include <string>
 #include <utility>
+#include <vector>
 
 namespace lbcrypto {
 
@@ -104,6 +106,27 @@ public:
         keyTag = tag;
     }
 
+    /**
+   * Expands a seed into the sequence of uniformly random polynomials sampled from it. Seed-compressed
+   * ciphertexts and keys are generated and deserialized with this function, so both sides expand the
+   * same polynomials.
+   *
+   * @param seed the seed
+   * @param params parameters of the polynomials
+   * @param count number of polynomials
+   * @return polynomials in the EVALUATION format
+   */
+    static std::vector<Element> ExpandSeed(const PRNGSeed& seed,
+                                           const std::shared_ptr<typename Element::Params>& params, size_t count) {
+        typename Element::DugType dug;
+        dug.SetSeed(seed);
+        std::vector<Element> result;
+        result.reserve(count);
+        for (size_t i = 0; i < count; ++i)
+            result.emplace_back(dug, params, Format::EVALUATION);
+        return result;
+    }
+
     template <class Archive>
     void save(Archive& ar, std::uint32_t const version) const {
         ar(::cereal::make_nvp("cc", context));
@@ -40,6 +40,7 @@
 #include <initializer_list>
 #include <map>
 #include <memory>
+#include <mutex>
 #include <numeric>
 #include <utility>
 #include <vector>
@@ -47,6 +48,7 @@
 #include "encoding/encodingparams.h"
 #include "encoding/plaintext.h"
 #include "utils/inttypes.h"
+#include "utils/precomputation-registry.h"
 
 namespace lbcrypto {
 
@@ -108,7 +110,8 @@ public:
     PackedEncoding() : PlaintextImpl(std::shared_ptr<Poly::Params>(0), nullptr), value() {}
 
     static usint GetAutomorphismGenerator(usint m) {
-        return m_automorphismGenerator[m];
+        const auto permutation = m_permutations.FindShared(m);
+        return (permutation != nullptr) ? permutation->automorphismGenerator : 0;
     }
 
     bool Encode();
@@ -185,6 +188,12 @@ public:
    */
     static void Destroy();
 
+    /**
+   * @brief Returns the number of snapshots held by the registries of precomputed values; it does not grow when
+   * SetParams() is called again with the same parameters.
+   */
+    static size_t GetRetainedCount();
+
     void PrintValue(std::ostream& out) const {
         // for sanity's sake, trailing zeros get elided into "..."
         out << "(";
@@ -200,16 +209,41 @@ public:
     }
 
 private:
-    // initial root of unity for plaintext space
-    static std::map<ModulusM, NativeInteger> m_initRoot;
-    // modulus and root of unity to be used for Arbitrary CRT
-    static std::map<ModulusM, NativeInteger> m_bigModulus;
-    static std::map<ModulusM, NativeInteger> m_bigRoot;
-
-    // stores the list of primitive roots used in packing.
-    static std::map<usint, usint> m_automorphismGenerator;
-    static std::map<usint, std::vector<usint>> m_toCRTPerm;
-    static std::map<usint, std::vector<usint>> m_fromCRTPerm;
+    // roots of unity for the plaintext space of one (plaintext modulus, cyclotomic order) pair
+    struct PlaintextRoots {
+        // initial root of unity for plaintext space
+        NativeInteger initRoot;
+        // modulus and root of unity to be used for Arbitrary CRT
+        NativeInteger bigModulus;
+        NativeInteger bigRoot;
+
+        bool operator==(const PlaintextRoots& rhs) const {
+            return initRoot == rhs.initRoot && bigModulus == rhs.bigModulus && bigRoot == rhs.bigRoot;
+        }
+    };
+
+    // primitive root used in packing (0 for power-of-two orders) and the permutations that interchange the
+    // automorphism and CRT orderings of the slots
+    struct SlotPermutation {
+        usint automorphismGenerator{0};
+        std::vector<usint> toCRTPerm;
+        std::vector<usint> fromCRTPerm;
+
+        bool operator==(const SlotPermutation& rhs) const {
+            return automorphismGenerator == rhs.automorphismGenerator && toCRTPerm == rhs.toCRTPerm &&
+                   fromCRTPerm == rhs.fromCRTPerm;
+        }
+    };
+
+    // lookups from Pack/Unpack are lock-free; SetParams serializes on m_paramsMutex as it also updates the params
+    static PrecomputationRegistry<ModulusM, PlaintextRoots, intnat::HashModulusOrder> m_roots;
+    static PrecomputationRegistry<usint, SlotPermutation> m_permutations;
+    static std::mutex m_paramsMutex;
+
+    // returns the precomputed values for (modulus, m), computing them with default parameters if needed
+    // owning handles, as a concurrent SetParams() may replace the values
+    static std::pair<std::shared_ptr<const PlaintextRoots>, std::shared_ptr<const SlotPermutation>> GetParams(
+        usint m, const PlaintextModulus& modulus);
 
     static void SetParams_2n(usint m, const NativeInteger& modulusNI);
 
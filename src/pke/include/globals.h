@@ -54,6 +54,23 @@ bool PrecomputeCRTTablesAfterDeserializaton();
 void EnablePrecomputeCRTTablesAfterDeserializaton();
 void DisablePrecomputeCRTTablesAfterDeserializaton();
 
+/**
+     * SeedCompressionEnabled() controls how the uniformly random "a" polynomials of secret-key encryption
+     * and of key switching key generation are sampled.
+     * function's return values:
+     * true:            "a" is expanded from a fresh 256-bit seed that is stored in the ciphertext or the key;
+     *                  serialization then writes the seed instead of the polynomials
+     * false (default): "a" is sampled directly and the full polynomials are serialized
+     */
+bool SeedCompressionEnabled();
+
+/**
+     * Calling EnableSeedCompression() and DisableSeedCompression()
+     * changes the boolean value returned by SeedCompressionEnabled()
+     */
+void EnableSeedCompression();
+void DisableSeedCompression();
+
 }  // namespace lbcrypto
 
 #endif  // __GLOBALS_H__
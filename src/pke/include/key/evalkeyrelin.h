@@ -71,7 +71,7 @@ public:
    *@param &rhs key to copy from
    */
     explicit EvalKeyRelinImpl(const EvalKeyRelinImpl<Element>& rhs)
-        : EvalKeyImpl<Element>(rhs.GetCryptoContext()), m_rKey(rhs.m_rKey) {}
+        : EvalKeyImpl<Element>(rhs.GetCryptoContext()), m_rKey(rhs.m_rKey), m_seed(rhs.m_seed) {}
 
     /**
    * Move constructor
@@ -79,7 +79,7 @@ public:
    *@param &rhs key to move from
    */
     explicit EvalKeyRelinImpl(EvalKeyRelinImpl<Element>&& rhs) noexcept
-        : EvalKeyImpl<Element>(rhs.GetCryptoContext()), m_rKey(std::move(rhs.m_rKey)) {}
+        : EvalKeyImpl<Element>(rhs.GetCryptoContext()), m_rKey(std::move(rhs.m_rKey)), m_seed(std::move(rhs.m_seed)) {}
 
     operator bool() const {
         return static_cast<bool>(this->context) && m_rKey.size() != 0;
@@ -93,6 +93,7 @@ public:
     EvalKeyRelinImpl<Element>& operator=(const EvalKeyRelinImpl<Element>& rhs) {
         this->context = rhs.context;
         this->m_rKey  = rhs.m_rKey;
+        this->m_seed  = rhs.m_seed;
         return *this;
     }
 
@@ -105,6 +106,7 @@ public:
         this->context = rhs.context;
         rhs.context   = 0;
         m_rKey        = std::move(rhs.m_rKey);
+        m_seed        = std::move(rhs.m_seed);
         return *this;
     }
 
@@ -235,6 +237,34 @@ public:
     virtual void ClearKeys() {
         m_rKey.clear();
         m_dcrtKeys.clear();
+        m_seed.reset();
+    }
+
+    /**
+   * Get the seed vector A was expanded from.
+   *
+   * @return the seed or nullptr if the key was not generated with seed compression enabled
+   */
+    std::shared_ptr<const PRNGSeed> GetSeed() const {
+        return m_seed;
+    }
+
+    /**
+   * Record the seed vector A was expanded from (see CryptoObject::ExpandSeed).
+   * The seed is only used for serialization and only as long as vector A still matches it.
+   */
+    void SetSeed(const PRNGSeed& seed) {
+        m_seed = std::make_shared<const PRNGSeed>(seed);
+    }
+
+    /**
+   * Checks whether vector A is still the expansion of the recorded seed, so it can be serialized as the seed.
+   */
+    bool IsSeedCompressible() const {
+        if (m_seed == nullptr || m_rKey.size() != 2 || m_rKey[0].empty() || m_rKey[0].size() != m_rKey[1].size())
+            return false;
+        const auto& a = m_rKey[0];
+        return a == CryptoObject<Element>::ExpandSeed(*m_seed, a[0].GetParams(), a.size());
     }
 
     bool key_compare(const EvalKeyImpl<Element>& other) const {
@@ -259,7 +289,17 @@ public:
     template <class Archive>
     void save(Archive& ar, std::uint32_t const version) const {
         ar(::cereal::base_class<EvalKeyImpl<Element>>(this));
-        ar(::cereal::make_nvp("k", m_rKey));
+        // vector A of a seeded key is written as its seed; version 1 archives always hold the full key
+        bool seeded = version > 1 && IsSeedCompressible();
+        if (version > 1)
+            ar(::cereal::make_nvp("sd", seeded));
+        if (seeded) {
+            ar(::cereal::make_nvp("b", m_rKey[1]));
+            ar(::cereal::make_nvp("a", *m_seed));
+        }
+        else {
+            ar(::cereal::make_nvp("k", m_rKey));
+        }
     }
 
     template <class Archive>
@@ -269,13 +309,29 @@ public:
                           " is from a later version of the library");
         }
         ar(::cereal::base_class<EvalKeyImpl<Element>>(this));
-        ar(::cereal::make_nvp("k", m_rKey));
+        bool seeded = false;
+        if (version > 1)
+            ar(::cereal::make_nvp("sd", seeded));
+        if (seeded) {
+            std::vector<Element> b;
+            PRNGSeed seed;
+            ar(::cereal::make_nvp("b", b));
+            ar(::cereal::make_nvp("a", seed));
+            if (b.empty())
+                OPENFHE_THROW("Seed-compressed evaluation key has no B vector");
+            auto a = CryptoObject<Element>::ExpandSeed(seed, b[0].GetParams(), b.size());
+            m_rKey = {std::move(a), std::move(b)};
+            m_seed = std::make_shared<const PRNGSeed>(seed);
+        }
+        else {
+            ar(::cereal::make_nvp("k", m_rKey));
+        }
     }
     std::string SerializedObjectName() const {
         return "EvalKeyRelin";
     }
     static uint32_t SerializedVersion() {
-        return 1;
+        return 2;
     }
 
 private:
@@ -284,6 +340,9 @@ private:
 
     // Used for hybrid key switching
     std::vector<DCRTPoly> m_dcrtKeys;
+
+    // seed of vector A for keys generated with seed compression; nullptr otherwise
+    std::shared_ptr<const PRNGSeed> m_seed;
 };
 
 }  // namespace lbcrypto
@@ -0,0 +1,194 @@
+//==================================================================================
+// BSD 2-Clause License
+//
+// Copyright (c) 2014-2022, NJIT, Duality Technologies Inc. and other contributors
+//
+// All rights reserved.
+//
+// Author TPOC: contact@openfhe.org
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice, this
+//    list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+//    this list of conditions and the following disclaimer in the documentation
+//    and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+// OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//==================================================================================
+
+
+#ifndef LBCRYPTO_CRYPTO_KEY_EVALKEYSTORE_H
+#define LBCRYPTO_CRYPTO_KEY_EVALKEYSTORE_H
+
+#include "key/evalkey.h"
+#include "lattice/lat-hal.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <string>
+#include <vector>
+
+/**
+ * @namespace lbcrypto
+ * The namespace of lbcrypto
+ */
+namespace lbcrypto {
+
+/**
+ * @brief Packed, memory-mapped storage for a set of evaluation keys (e.g., all rotation keys of a secret key).
+ *
+ * Write() stores the key set in a single file: a small header with the CRT moduli, the key tag and an index,
+ * followed by one contiguous, page-aligned block of raw tower data laid out by (key, A/B vector, digit, tower).
+ * Open() maps the file with mmap, so opening a store costs no parsing and several processes opening the same
+ * file share one copy of it in the page cache. GetKeyView() gives read-only access to the towers of a key in the
+ * mapping without copying them. GetEvalKey() builds a single key on demand; as the towers of a DCRTPoly own their
+ * storage, the key data is copied out of the mapping. GetEvalKeyMap() builds all of them in parallel.
+ *
+ * Only EvalKeyRelin keys in the EVALUATION format are supported. The file uses the native byte order and word
+ * size; Open() rejects files written with a different word size.
+ */
+class EvalKeyStore {
+public:
+    /**
+   * @brief Read-only view of the towers of one key in the mapped file. A view keeps the mapping alive, so it stays
+   * valid after the store is closed or reopened.
+   */
+    class KeyView {
+    public:
+        uint32_t GetNumDigits() const {
+            return m_numDigits;
+        }
+
+        uint32_t GetNumTowers() const {
+            return m_numTowers;
+        }
+
+        uint32_t GetRingDimension() const {
+            return m_ringDim;
+        }
+
+        /**
+     * @param bVector false for the A vector, true for the B vector
+     * @param digit digit of the key
+     * @param tower CRT tower of the digit
+     * @return pointer to the GetRingDimension() coefficients of the tower, in the EVALUATION format
+     */
+        const NativeInteger::Integer* GetTower(bool bVector, uint32_t digit, uint32_t tower) const;
+
+    private:
+        friend class EvalKeyStore;
+
+        std::shared_ptr<const uint8_t> m_mapping;
+        const NativeInteger::Integer* m_data{nullptr};
+        uint32_t m_numDigits{0};
+        uint32_t m_numTowers{0};
+        uint32_t m_ringDim{0};
+    };
+
+    EvalKeyStore() = default;
+    ~EvalKeyStore();
+
+    EvalKeyStore(const EvalKeyStore&)            = delete;
+    EvalKeyStore& operator=(const EvalKeyStore&) = delete;
+
+    /**
+   * Writes a set of evaluation keys to a packed key store file.
+   *
+   * @param filename output file
+   * @param evalKeyMap keys to write, indexed by automorphism index
+   * @return false if the file cannot be opened for writing, true on success
+   */
+    static bool Write(const std::string& filename, const std::map<uint32_t, EvalKey<DCRTPoly>>& evalKeyMap);
+
+    /**
+   * Maps a packed key store file written by Write(). Any previously opened file is closed.
+   *
+   * @param filename input file
+   * @return false if the file cannot be opened or mapped, true on success
+   */
+    bool Open(const std::string& filename);
+
+    /**
+   * Closes the store; the file is unmapped once no KeyView uses it. Keys already built from it stay valid.
+   */
+    void Close();
+
+    bool IsOpen() const {
+        return m_mapping != nullptr;
+    }
+
+    /**
+   * @return the key tag (secret key id) of the keys in the store
+   */
+    const std::string& GetKeyTag() const {
+        return m_keyTag;
+    }
+
+    /**
+   * @return the automorphism indices of all keys in the store
+   */
+    std::vector<uint32_t> GetIndices() const;
+
+    /**
+   * Gives read-only access to the key for one automorphism index without copying it.
+   *
+   * @param index automorphism index
+   * @return view of the key towers in the mapped file
+   */
+    KeyView GetKeyView(uint32_t index) const;
+
+    /**
+   * Builds the key for one automorphism index from the mapped data.
+   *
+   * @param index automorphism index
+   * @param cc crypto context the key belongs to
+   * @return the evaluation key
+   */
+    EvalKey<DCRTPoly> GetEvalKey(uint32_t index, const CryptoContext<DCRTPoly> cc) const;
+
+    /**
+   * Builds all keys in the store. The result can be passed to CryptoContextImpl::InsertEvalAutomorphismKey
+   * together with GetKeyTag().
+   *
+   * @param cc crypto context the keys belong to
+   * @return map of evaluation keys indexed by automorphism index
+   */
+    std::shared_ptr<std::map<uint32_t, EvalKey<DCRTPoly>>> GetEvalKeyMap(const CryptoContext<DCRTPoly> cc) const;
+
+private:
+    struct IndexEntry {
+        uint32_t numDigits;
+        uint64_t offset;
+    };
+
+    std::vector<DCRTPoly> ReadVector(const KeyView& view, bool bVector) const;
+
+    void ValidateContext(const CryptoContext<DCRTPoly> cc) const;
+
+    std::shared_ptr<const uint8_t> m_mapping;
+    size_t m_size{0};
+
+    std::string m_keyTag;
+    uint32_t m_ringDim{0};
+    std::shared_ptr<DCRTPoly::Params> m_params;
+    std::map<uint32_t, IndexEntry> m_index;
+};
+
+}  // namespace lbcrypto
+
+#endif
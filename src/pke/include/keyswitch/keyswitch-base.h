@@ -96,6 +96,18 @@ public:
         OPENFHE_THROW("KeySwitch is not supported");
     }
 
+    /**
+   * Applies several key switches to the same ciphertext. The default implementation calls
+   * KeySwitch() for every key; key switching methods with a digit decomposition override it
+   * to share the decomposition between all keys.
+   *
+   * @param ciphertext the input ciphertext.
+   * @param evalKeys the evaluation keys.
+   * @return the ciphertexts KeySwitch(ciphertext, evalKeys[i]).
+   */
+    virtual std::vector<Ciphertext<Element>> KeySwitchMany(ConstCiphertext<Element> ciphertext,
+                                                           const std::vector<EvalKey<Element>>& evalKeys) const;
+
     virtual Ciphertext<Element> KeySwitchExt(ConstCiphertext<Element> ciphertext, bool addFirst) const {
         OPENFHE_THROW("KeySwitchExt is not supported");
     }
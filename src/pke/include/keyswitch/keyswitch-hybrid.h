@@ -84,6 +84,13 @@ public:
 
     void KeySwitchInPlace(Ciphertext<DCRTPoly>& ciphertext, const EvalKey<DCRTPoly> evalKey) const override;
 
+    /**
+   * Computes the digit decomposition and ModUp of the ciphertext once (as EvalFastRotationPrecompute
+   * does for rotations) and runs the inner products with the keys and ModDown in parallel across keys.
+   */
+    std::vector<Ciphertext<DCRTPoly>> KeySwitchMany(ConstCiphertext<DCRTPoly> ciphertext,
+                                                    const std::vector<EvalKey<DCRTPoly>>& evalKeys) const override;
+
     Ciphertext<DCRTPoly> KeySwitchExt(ConstCiphertext<DCRTPoly> ciphertext, bool addFirst) const override;
 
     Ciphertext<DCRTPoly> KeySwitchDown(ConstCiphertext<DCRTPoly> ciphertext) const override;
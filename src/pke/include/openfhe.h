@@ -44,6 +44,7 @@
 #include "key/privatekey.h"
 #include "key/evalkey.h"
 #include "key/evalkeyrelin.h"
+#include "key/evalkeystore.h"
 
 #include "cryptoobject.h"
 
@@ -52,6 +53,7 @@
 
 #include "ciphertext.h"
 #include "cryptocontext.h"
+#include "raw-ser.h"
 
 #include "keyswitch/keyswitch-bv.h"
 #include "keyswitch/keyswitch-hybrid.h"
@@ -0,0 +1,125 @@
+//==================================================================================
+// BSD 2-Clause License
+//
+// Copyright (c) 2014-2022, NJIT, Duality Technologies Inc. and other contributors
+//
+// All rights reserved.
+//
+// Author TPOC: contact@openfhe.org
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice, this
+//    list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+//    this list of conditions and the following disclaimer in the documentation
+//    and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+// OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//==================================================================================
+
+
+/*
+  Raw (native-layout) serialization of DCRTPoly ciphertexts and evaluation keys
+ */
+
+#ifndef LBCRYPTO_CRYPTO_RAWSER_H
+#define LBCRYPTO_CRYPTO_RAWSER_H
+
+#include "ciphertext.h"
+#include "key/evalkey.h"
+#include "lattice/lat-hal.h"
+#include "utils/sertype.h"
+
+#include <fstream>
+#include <iostream>
+#include <string>
+
+namespace lbcrypto {
+// ================================= RAW serialization/deserialization
+namespace Serial {
+/**
+ * SerType::RAW writes a small fixed-size header followed by the tower data of every DCRTPoly exactly as it is
+ * laid out in memory: one stream write per tower and no per-coefficient archive calls. Deserialization reads
+ * every tower directly into the storage of a freshly allocated NativeVector.
+ *
+ * The format is meant for exchanging objects between processes that share a CryptoContext:
+ * - the CryptoContext itself is not written; it must be deserialized (e.g. with SerType::BINARY) or generated
+ *   in the receiving process before any RAW object is read. The matching context is found among the
+ *   registered contexts by a fingerprint of its scheme and CRT moduli.
+ * - integers are written with the native word size and byte order; the header records both, and reading a
+ *   file produced on a platform with a different word size or byte order throws an exception.
+ * - the sizes in the headers are checked against the CryptoContext and, for streams that can seek, against
+ *   the length of the stream before any memory is allocated for the data.
+ * - ciphertext metadata maps are not supported.
+ */
+
+/**
+ * Serialize a DCRTPoly ciphertext
+ * @param obj - ciphertext to serialize
+ * @param stream - stream to serialize to
+ * @param sertype - RAW serialization type
+ */
+void Serialize(const Ciphertext<DCRTPoly>& obj, std::ostream& stream, const SerType::SERRAW& sertype);
+
+/**
+ * Deserialize a DCRTPoly ciphertext
+ * @param obj - the target for the deserialization
+ * @param stream - stream to deserialize from
+ * @param sertype - RAW serialization type
+ */
+void Deserialize(Ciphertext<DCRTPoly>& obj, std::istream& stream, const SerType::SERRAW& sertype);
+
+/**
+ * Serialize a DCRTPoly evaluation (relinearization, rotation or switching) key
+ * @param obj - evaluation key to serialize
+ * @param stream - stream to serialize to
+ * @param sertype - RAW serialization type
+ */
+void Serialize(const EvalKey<DCRTPoly>& obj, std::ostream& stream, const SerType::SERRAW& sertype);
+
+/**
+ * Deserialize a DCRTPoly evaluation key
+ * @param obj - the target for the deserialization
+ * @param stream - stream to deserialize from
+ * @param sertype - RAW serialization type
+ */
+void Deserialize(EvalKey<DCRTPoly>& obj, std::istream& stream, const SerType::SERRAW& sertype);
+
+template <typename T>
+bool SerializeToFile(const std::string& filename, const T& obj, const SerType::SERRAW& sertype) {
+    std::ofstream file(filename, std::ios::out | std::ios::binary);
+    if (file.is_open()) {
+        Serial::Serialize(obj, file, sertype);
+        file.close();
+        return true;
+    }
+    return false;
+}
+
+template <typename T>
+bool DeserializeFromFile(const std::string& filename, T& obj, const SerType::SERRAW& sertype) {
+    std::ifstream file(filename, std::ios::in | std::ios::binary);
+    if (file.is_open()) {
+        Serial::Deserialize(obj, file, sertype);
+        file.close();
+        return true;
+    }
+    return false;
+}
+}  // namespace Serial
+
+}  // namespace lbcrypto
+
+#endif
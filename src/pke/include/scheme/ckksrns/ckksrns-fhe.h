@@ -39,8 +39,10 @@
 #include "utils/caller_info.h"
 #include "math/hal/basicint.h"
 
+#include <functional>
 #include <map>
 #include <memory>
+#include <mutex>
 #include <string>
 #include <utility>
 #include <vector>
@@ -112,6 +114,16 @@ public:
     // coefficients corresponding to conj(U0^T); used in encoding
     std::vector<std::vector<ConstPlaintext>> m_U0hatTPreFFT;
 
+    /**
+   * Returns the permutation for the automorphism autoIndex in ring dimension n. The maps are
+   * computed on first use and shared by all subsequent linear transforms.
+   *
+   * @param n ring dimension
+   * @param autoIndex automorphism index
+   * @return the precomputed automorphism map
+   */
+    std::shared_ptr<const std::vector<uint32_t>> GetAutomorphismMap(uint32_t n, uint32_t autoIndex);
+
     template <class Archive>
     void save(Archive& ar) const {
         ar(cereal::make_nvp("dim1_Enc", m_dim1));
@@ -129,6 +141,11 @@ public:
         ar(cereal::make_nvp("lEnc", m_paramsEnc[CKKS_BOOT_PARAMS::LEVEL_BUDGET]));
         ar(cereal::make_nvp("lDec", m_paramsDec[CKKS_BOOT_PARAMS::LEVEL_BUDGET]));
     }
+
+private:
+    // automorphism maps of the giant-step rotations, keyed by automorphism index
+    std::map<uint32_t, std::shared_ptr<const std::vector<uint32_t>>> m_autoMaps;
+    std::mutex m_autoMapsMutex;
 };
 
 class FHECKKSRNS : public FHERNS {
@@ -253,6 +270,42 @@ private:
 
     Ciphertext<DCRTPoly> EvalAddExt(ConstCiphertext<DCRTPoly> ciphertext1, ConstCiphertext<DCRTPoly> ciphertext2) const;
 
+    /**
+   * Rotates a giant-step sum given in the extended basis P*Q by rotation. Returns the rotated
+   * ciphertext in the extended basis with a zero first element; the first element is returned
+   * separately in the basis Q, so that giant steps can be summed up before the final ModDown.
+   *
+   * @param inner giant-step sum in the extended basis
+   * @param rotation rotation index
+   * @param precom bootstrapping precomputations holding the cached automorphism maps
+   * @param first output: the first element of the rotated ciphertext
+   * @return the rotated ciphertext in the extended basis
+   */
+    Ciphertext<DCRTPoly> EvalGiantStepExt(Ciphertext<DCRTPoly> inner, int32_t rotation, CKKSBootstrapPrecom& precom,
+                                          DCRTPoly& first) const;
+
+    /**
+   * Adds a rotated giant step (or a partial sum of them) to the accumulator (outer, first).
+   * An empty outer is initialized with the term.
+   */
+    void AddGiantStepExt(Ciphertext<DCRTPoly>& outer, DCRTPoly& first, Ciphertext<DCRTPoly> term,
+                         DCRTPoly& termFirst) const;
+
+    /**
+   * Computes the giant steps 0, ..., count - 1 in parallel, sums them up in the extended basis and
+   * brings the sum back to Q with a single KeySwitchDown.
+   *
+   * @param count number of giant steps
+   * @param innerStep returns the baby-step sum of giant step i in the extended basis
+   * @param rotation returns the rotation index of giant step i
+   * @param precom the bootstrapping precomputations holding the cached automorphism maps
+   * @return the sum of all rotated giant steps
+   */
+    Ciphertext<DCRTPoly> EvalGiantStepsSum(uint32_t count,
+                                           const std::function<Ciphertext<DCRTPoly>(uint32_t)>& innerStep,
+                                           const std::function<int32_t(uint32_t)>& rotation,
+                                           CKKSBootstrapPrecom& precom) const;
+
     EvalKey<DCRTPoly> ConjugateKeyGen(const PrivateKey<DCRTPoly> privateKey) const;
 
     Ciphertext<DCRTPoly> Conjugate(ConstCiphertext<DCRTPoly> ciphertext,
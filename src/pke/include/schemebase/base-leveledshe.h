@@ -607,6 +607,28 @@ public:
         OPENFHE_THROW(errMsg);
     }
 
+    /**
+   * Multiplies a ciphertext in the extended basis P*Q by a plaintext in the same basis.
+   * No rescaling or level adjustment is done.
+   *
+   * @param ciphertext the input ciphertext in the extended basis.
+   * @param plaintext the input plaintext in the extended basis.
+   * @return the new ciphertext in the extended basis.
+   */
+    virtual Ciphertext<Element> EvalMultExt(ConstCiphertext<Element> ciphertext, ConstPlaintext plaintext) const;
+
+    /**
+   * Adds two ciphertexts in the extended basis P*Q.
+   *
+   * @param ciphertext1 the first ciphertext in the extended basis.
+   * @param ciphertext2 the second ciphertext in the extended basis.
+   * @return the new ciphertext in the extended basis.
+   */
+    virtual Ciphertext<Element> EvalAddExt(ConstCiphertext<Element> ciphertext1,
+                                           ConstCiphertext<Element> ciphertext2) const;
+
+    virtual void EvalAddExtInPlace(Ciphertext<Element>& ciphertext1, ConstCiphertext<Element> ciphertext2) const;
+
     /**
    * Generates evaluation keys for a list of indices
    * Currently works only for power-of-two and cyclic-group cyclotomics
@@ -349,6 +349,18 @@ public:
         return;
     }
 
+    virtual std::vector<Ciphertext<Element>> KeySwitchMany(ConstCiphertext<Element> ciphertext,
+                                                           const std::vector<EvalKey<Element>>& evalKeys) const {
+        VerifyKeySwitchEnabled(__func__);
+        if (!ciphertext)
+            OPENFHE_THROW("Input ciphertext is nullptr");
+        for (const auto& evalKey : evalKeys) {
+            if (!evalKey)
+                OPENFHE_THROW("Input evaluation key is nullptr");
+        }
+        return m_KeySwitch->KeySwitchMany(ciphertext, evalKeys);
+    }
+
     virtual Ciphertext<Element> KeySwitchDown(ConstCiphertext<Element> ciphertext) const {
         VerifyKeySwitchEnabled(__func__);
         if (!ciphertext)
@@ -930,6 +942,30 @@ public:
         return m_LeveledSHE->EvalFastRotationExt(ciphertext, index, digits, addFirst, evalKeys);
     }
 
+    virtual Ciphertext<Element> EvalMultExt(ConstCiphertext<Element> ciphertext, ConstPlaintext plaintext) const {
+        VerifyLeveledSHEEnabled(__func__);
+        if (!ciphertext)
+            OPENFHE_THROW("Input ciphertext is nullptr");
+        if (!plaintext)
+            OPENFHE_THROW("Input plaintext is nullptr");
+        return m_LeveledSHE->EvalMultExt(ciphertext, plaintext);
+    }
+
+    virtual Ciphertext<Element> EvalAddExt(ConstCiphertext<Element> ciphertext1,
+                                           ConstCiphertext<Element> ciphertext2) const {
+        VerifyLeveledSHEEnabled(__func__);
+        if (!ciphertext1 || !ciphertext2)
+            OPENFHE_THROW("Input ciphertext is nullptr");
+        return m_LeveledSHE->EvalAddExt(ciphertext1, ciphertext2);
+    }
+
+    virtual void EvalAddExtInPlace(Ciphertext<Element>& ciphertext1, ConstCiphertext<Element> ciphertext2) const {
+        VerifyLeveledSHEEnabled(__func__);
+        if (!ciphertext1 || !ciphertext2)
+            OPENFHE_THROW("Input ciphertext is nullptr");
+        m_LeveledSHE->EvalAddExtInPlace(ciphertext1, ciphertext2);
+    }
+
     /**
    * Only supported for hybrid key switching.
    * Scales down the polynomial c0 from extended basis P*Q to Q.
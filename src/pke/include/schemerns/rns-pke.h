@@ -113,6 +113,17 @@ public:
     std::shared_ptr<std::vector<DCRTPoly>> EncryptZeroCore(const PrivateKey<DCRTPoly> privateKey,
                                                            const std::shared_ptr<ParmType> params) const override;
 
+    /**
+   * Secret-key encryption of zero with the "a" component drawn from the given generator; the second
+   * element of the result is the first polynomial sampled from dug.
+   *
+   * @param privateKey the secret key
+   * @param params element parameters; the parameters of the crypto context are used if nullptr
+   * @param dug uniform generator, possibly seeded (see CryptoObject::ExpandSeed)
+   */
+    std::shared_ptr<std::vector<DCRTPoly>> EncryptZeroCore(const PrivateKey<DCRTPoly> privateKey,
+                                                           const std::shared_ptr<ParmType> params, DugType& dug) const;
+
     std::shared_ptr<std::vector<DCRTPoly>> EncryptZeroCore(const PublicKey<DCRTPoly> publicKey,
                                                            const std::shared_ptr<ParmType> params) const override;
 
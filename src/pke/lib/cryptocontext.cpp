@@ -40,6 +40,7 @@
 #include "math/chebyshev.h"
 #include "schemerns/rns-scheme.h"
 #include "scheme/ckksrns/ckksrns-cryptoparameters.h"
+#include "utils/parallel.h"
 
 namespace lbcrypto {
 
@@ -505,6 +506,131 @@ DecryptResult CryptoContextImpl<Element>::Decrypt(ConstCiphertext<Element> ciphe
     return result;
 }
 
+//------------------------------------------------------------------------------
+// Streaming encryption/decryption
+//------------------------------------------------------------------------------
+
+template <typename Element>
+uint32_t CryptoContextImpl<Element>::GetStreamBlockSize() const {
+    uint32_t blockSize = GetEncodingParams()->GetBatchSize();
+    if (blockSize == 0) {
+        uint32_t ringDim = GetRingDimension();
+        blockSize        = isCKKS(m_schemeId) ? ringDim / 2 : ringDim;
+    }
+    return blockSize;
+}
+
+template <typename Element>
+template <typename T, typename KeyType>
+void CryptoContextImpl<Element>::EncryptStreamInternal(const KeyType key, const T* values, size_t size,
+                                                       const std::function<void(size_t, Ciphertext<Element>)>& sink,
+                                                       uint32_t level) const {
+    if (values == nullptr || size == 0)
+        OPENFHE_THROW("Cannot encrypt an empty value vector");
+    if (!sink)
+        OPENFHE_THROW("The ciphertext sink is empty");
+    ValidateKey(key);
+
+    const size_t blockSize = GetStreamBlockSize();
+    const size_t numBlocks = (size + blockSize - 1) / blockSize;
+
+    auto encryptBlock = [&](std::vector<T>& block, size_t i) {
+        const T* first = values + i * blockSize;
+        block.assign(first, first + std::min(blockSize, size - i * blockSize));
+        return Encrypt(key, MakeStreamPlaintext(block, level));
+    };
+
+    // one reusable input buffer per thread; the first block is encrypted serially so that the
+    // lazily-built encoding tables are initialized before the parallel rounds
+    const size_t roundSize = std::max<size_t>(1, std::min<size_t>(OpenFHEParallelControls.GetThreadLimit(numBlocks),
+                                                                  numBlocks));
+    std::vector<std::vector<T>> scratch(roundSize);
+    for (auto& block : scratch)
+        block.reserve(blockSize);
+    std::vector<Ciphertext<Element>> round(roundSize);
+
+    sink(0, encryptBlock(scratch[0], 0));
+
+    for (size_t start = 1; start < numBlocks; start += roundSize) {
+        const size_t count = std::min(roundSize, numBlocks - start);
+        ParallelFor(0, count, static_cast<int>(count),
+                    [&](size_t j) { round[j] = encryptBlock(scratch[j], start + j); });
+
+        for (size_t j = 0; j < count; ++j)
+            sink(start + j, std::move(round[j]));
+    }
+}
+
+template <typename Element>
+void CryptoContextImpl<Element>::EncryptStream(const PublicKey<Element> publicKey, const double* values, size_t size,
+                                               const std::function<void(size_t, Ciphertext<Element>)>& sink,
+                                               uint32_t level) const {
+    EncryptStreamInternal(publicKey, values, size, sink, level);
+}
+
+template <typename Element>
+void CryptoContextImpl<Element>::EncryptStream(const PrivateKey<Element> privateKey, const double* values, size_t size,
+                                               const std::function<void(size_t, Ciphertext<Element>)>& sink,
+                                               uint32_t level) const {
+    EncryptStreamInternal(privateKey, values, size, sink, level);
+}
+
+template <typename Element>
+void CryptoContextImpl<Element>::EncryptStream(const PublicKey<Element> publicKey, const int64_t* values, size_t size,
+                                               const std::function<void(size_t, Ciphertext<Element>)>& sink,
+                                               uint32_t level) const {
+    EncryptStreamInternal(publicKey, values, size, sink, level);
+}
+
+template <typename Element>
+void CryptoContextImpl<Element>::EncryptStream(const PrivateKey<Element> privateKey, const int64_t* values,
+                                               size_t size,
+                                               const std::function<void(size_t, Ciphertext<Element>)>& sink,
+                                               uint32_t level) const {
+    EncryptStreamInternal(privateKey, values, size, sink, level);
+}
+
+template <typename Element>
+void CryptoContextImpl<Element>::DecryptStream(const PrivateKey<Element> privateKey, size_t numCiphertexts,
+                                               const std::function<ConstCiphertext<Element>(size_t)>& source,
+                                               const std::function<void(size_t, Plaintext)>& sink) {
+    if (!source || !sink)
+        OPENFHE_THROW("The ciphertext source and the plaintext sink must be set");
+    if (numCiphertexts == 0)
+        return;
+    ValidateKey(privateKey);
+
+    auto decryptOne = [&](ConstCiphertext<Element>& ciphertext) {
+        Plaintext plaintext;
+        DecryptResult result = Decrypt(privateKey, ciphertext, &plaintext);
+        if (!result.isValid)
+            OPENFHE_THROW("Decryption failed");
+        // release the ciphertext as soon as it is decrypted
+        ciphertext.reset();
+        return plaintext;
+    };
+
+    const size_t roundSize = std::max<size_t>(
+        1, std::min<size_t>(OpenFHEParallelControls.GetThreadLimit(numCiphertexts), numCiphertexts));
+    std::vector<ConstCiphertext<Element>> inputs(roundSize);
+    std::vector<Plaintext> outputs(roundSize);
+
+    // the first ciphertext is decrypted serially to initialize the decoding tables
+    inputs[0] = source(0);
+    sink(0, decryptOne(inputs[0]));
+
+    for (size_t start = 1; start < numCiphertexts; start += roundSize) {
+        const size_t count = std::min(roundSize, numCiphertexts - start);
+        for (size_t j = 0; j < count; ++j)
+            inputs[j] = source(start + j);
+
+        ParallelFor(0, count, static_cast<int>(count), [&](size_t j) { outputs[j] = decryptOne(inputs[j]); });
+
+        for (size_t j = 0; j < count; ++j)
+            sink(start + j, std::move(outputs[j]));
+    }
+}
+
 //------------------------------------------------------------------------------
 // Advanced SHE CHEBYSHEV SERIES EXAMPLES
 //------------------------------------------------------------------------------
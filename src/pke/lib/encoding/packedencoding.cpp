@@ -40,13 +40,9 @@
 namespace lbcrypto {
 
 // TODO (dsuponit): we should not have globals!
-std::map<ModulusM, NativeInteger> PackedEncoding::m_initRoot;
-std::map<ModulusM, NativeInteger> PackedEncoding::m_bigModulus;
-std::map<ModulusM, NativeInteger> PackedEncoding::m_bigRoot;
-
-std::map<usint, usint> PackedEncoding::m_automorphismGenerator;
-std::map<usint, std::vector<usint>> PackedEncoding::m_toCRTPerm;
-std::map<usint, std::vector<usint>> PackedEncoding::m_fromCRTPerm;
+PrecomputationRegistry<ModulusM, PackedEncoding::PlaintextRoots, intnat::HashModulusOrder> PackedEncoding::m_roots;
+PrecomputationRegistry<usint, PackedEncoding::SlotPermutation> PackedEncoding::m_permutations;
+std::mutex PackedEncoding::m_paramsMutex;
 
 bool PackedEncoding::Encode() {
     if (this->isEncoded)
@@ -230,13 +226,13 @@ bool PackedEncoding::Decode() {
 }
 
 void PackedEncoding::Destroy() {
-    m_initRoot.clear();
-    m_bigModulus.clear();
-    m_bigRoot.clear();
+    std::lock_guard<std::mutex> lock(m_paramsMutex);
+    m_roots.Clear();
+    m_permutations.Clear();
+}
 
-    m_automorphismGenerator.clear();
-    m_toCRTPerm.clear();
-    m_fromCRTPerm.clear();
+size_t PackedEncoding::GetRetainedCount() {
+    return m_roots.GetRetainedCount() + m_permutations.GetRetainedCount();
 }
 
 void PackedEncoding::SetParams(usint m, EncodingParams params) {
@@ -246,74 +242,75 @@ void PackedEncoding::SetParams(usint m, EncodingParams params) {
 
     // initialize the CRT coefficients if not initialized
     try {
+        std::lock_guard<std::mutex> lock(m_paramsMutex);
         if (IsPowerOfTwo(m)) {
-#pragma omp critical
-            { SetParams_2n(m, params); }
+            SetParams_2n(m, params);
         }
         else {
-#pragma omp critical
-            {
-                const ModulusM modulusM = {modulusNI, m};
-                // Arbitrary: Bluestein based CRT Arb. So we need the 2mth root of unity
-                if (params->GetPlaintextRootOfUnity() == 0) {
-                    NativeInteger initRoot = RootOfUnity<NativeInteger>(2 * m, modulusNI);
-                    m_initRoot[modulusM]   = initRoot;
-                    params->SetPlaintextRootOfUnity(m_initRoot[modulusM].ConvertToInt());
-                }
-                else {
-                    m_initRoot[modulusM] = params->GetPlaintextRootOfUnity();
-                }
+            const ModulusM modulusM = {modulusNI, m};
+            PlaintextRoots roots;
+            SlotPermutation permutation;
+            // Arbitrary: Bluestein based CRT Arb. So we need the 2mth root of unity
+            if (params->GetPlaintextRootOfUnity() == 0) {
+                roots.initRoot = RootOfUnity<NativeInteger>(2 * m, modulusNI);
+                params->SetPlaintextRootOfUnity(roots.initRoot.ConvertToInt());
+            }
+            else {
+                roots.initRoot = params->GetPlaintextRootOfUnity();
+            }
 
-                // Find a compatible big-modulus and root of unity for CRTArb
-                if (params->GetPlaintextBigModulus() == 0) {
-                    usint nttDim = pow(2, ceil(log2(2 * m - 1)));
-                    if ((modulusNI.ConvertToInt() - 1) % nttDim == 0) {
-                        m_bigModulus[modulusM] = modulusNI;
-                    }
-                    else {
-                        usint bigModulusSize   = ceil(log2(2 * m - 1)) + 2 * modulusNI.GetMSB() + 1;
-                        m_bigModulus[modulusM] = LastPrime<NativeInteger>(bigModulusSize, nttDim);
-                    }
-                    m_bigRoot[modulusM] = RootOfUnity<NativeInteger>(nttDim, m_bigModulus[modulusM]);
-                    params->SetPlaintextBigModulus(m_bigModulus[modulusM]);
-                    params->SetPlaintextBigRootOfUnity(m_bigRoot[modulusM]);
+            // Find a compatible big-modulus and root of unity for CRTArb
+            if (params->GetPlaintextBigModulus() == 0) {
+                usint nttDim = pow(2, ceil(log2(2 * m - 1)));
+                if ((modulusNI.ConvertToInt() - 1) % nttDim == 0) {
+                    roots.bigModulus = modulusNI;
                 }
                 else {
-                    m_bigModulus[modulusM] = params->GetPlaintextBigModulus();
-                    m_bigRoot[modulusM]    = params->GetPlaintextBigRootOfUnity();
+                    usint bigModulusSize = ceil(log2(2 * m - 1)) + 2 * modulusNI.GetMSB() + 1;
+                    roots.bigModulus     = LastPrime<NativeInteger>(bigModulusSize, nttDim);
                 }
+                roots.bigRoot = RootOfUnity<NativeInteger>(nttDim, roots.bigModulus);
+                params->SetPlaintextBigModulus(roots.bigModulus);
+                params->SetPlaintextBigRootOfUnity(roots.bigRoot);
+            }
+            else {
+                roots.bigModulus = params->GetPlaintextBigModulus();
+                roots.bigRoot    = params->GetPlaintextBigRootOfUnity();
+            }
 
-                // Find a generator for the automorphism group
-                if (params->GetPlaintextGenerator() == 0) {
-                    NativeInteger M(m);  // Hackish typecast
-                    NativeInteger automorphismGenerator = FindGeneratorCyclic<NativeInteger>(M);
-                    m_automorphismGenerator[m]          = automorphismGenerator.ConvertToInt();
-                    params->SetPlaintextGenerator(m_automorphismGenerator[m]);
-                }
-                else {
-                    m_automorphismGenerator[m] = params->GetPlaintextGenerator();
-                }
+            // Find a generator for the automorphism group
+            if (params->GetPlaintextGenerator() == 0) {
+                NativeInteger M(m);  // Hackish typecast
+                NativeInteger automorphismGenerator = FindGeneratorCyclic<NativeInteger>(M);
+                permutation.automorphismGenerator   = automorphismGenerator.ConvertToInt();
+                params->SetPlaintextGenerator(permutation.automorphismGenerator);
+            }
+            else {
+                permutation.automorphismGenerator = params->GetPlaintextGenerator();
+            }
 
-                // Create the permutations that interchange the automorphism and crt
-                // ordering
-                usint phim = GetTotient(m);
-                auto tList = GetTotientList(m);
-                auto tIdx  = std::vector<usint>(m, -1);
-                for (usint i = 0; i < phim; i++) {
-                    tIdx[tList[i]] = i;
-                }
+            // Create the permutations that interchange the automorphism and crt
+            // ordering
+            usint phim = GetTotient(m);
+            auto tList = GetTotientList(m);
+            auto tIdx  = std::vector<usint>(m, -1);
+            for (usint i = 0; i < phim; i++) {
+                tIdx[tList[i]] = i;
+            }
 
-                m_toCRTPerm[m]   = std::vector<usint>(phim);
-                m_fromCRTPerm[m] = std::vector<usint>(phim);
+            permutation.toCRTPerm   = std::vector<usint>(phim);
+            permutation.fromCRTPerm = std::vector<usint>(phim);
 
-                usint curr_index = 1;
-                for (usint i = 0; i < phim; i++) {
-                    m_toCRTPerm[m][tIdx[curr_index]] = i;
-                    m_fromCRTPerm[m][i]              = tIdx[curr_index];
+            usint curr_index = 1;
+            for (usint i = 0; i < phim; i++) {
+                permutation.toCRTPerm[tIdx[curr_index]] = i;
+                permutation.fromCRTPerm[i]              = tIdx[curr_index];
 
-                    curr_index = curr_index * m_automorphismGenerator[m] % m;
-                }
+                curr_index = curr_index * permutation.automorphismGenerator % m;
             }
+
+            m_roots.Set(modulusM, std::move(roots));
+            m_permutations.Set(m, std::move(permutation));
         }
     }
     catch (std::exception& e) {
@@ -325,6 +322,21 @@ void PackedEncoding::SetParams(usint m, EncodingParams params) {
         OPENFHE_THROW(exception_message);
 }
 
+std::pair<std::shared_ptr<const PackedEncoding::PlaintextRoots>, std::shared_ptr<const PackedEncoding::SlotPermutation>>
+PackedEncoding::GetParams(usint m, const PlaintextModulus& modulus) {
+    const ModulusM modulusM = {NativeInteger(modulus), m};
+    auto roots              = m_roots.FindShared(modulusM);
+    auto permutation        = m_permutations.FindShared(m);
+
+    // Do the precomputation if not initialized
+    if (roots == nullptr || permutation == nullptr) {
+        SetParams(m, EncodingParams(std::make_shared<EncodingParamsImpl>(modulus)));
+        roots       = m_roots.FindShared(modulusM);
+        permutation = m_permutations.FindShared(m);
+    }
+    return {roots, permutation};
+}
+
 template <typename P>
 void PackedEncoding::Pack(P* ring, const PlaintextModulus& modulus) const {
     OPENFHE_DEBUG_FLAG(false);
@@ -332,12 +344,7 @@ void PackedEncoding::Pack(P* ring, const PlaintextModulus& modulus) const {
     usint m = ring->GetCyclotomicOrder();  // cyclotomic order
     NativeInteger modulusNI(modulus);      // native int modulus
 
-    const ModulusM modulusM = {modulusNI, m};
-
-    // Do the precomputation if not initialized
-    if (this->m_initRoot[modulusM].GetMSB() == 0) {
-        SetParams(m, EncodingParams(std::make_shared<EncodingParamsImpl>(modulus)));
-    }
+    const auto [roots, permutation] = GetParams(m, modulus);
 
     usint phim = ring->GetRingDimension();
 
@@ -354,35 +361,35 @@ void PackedEncoding::Pack(P* ring, const PlaintextModulus& modulus) const {
 
     // Transform Eval to Coeff
     if (IsPowerOfTwo(m)) {
-        if (m_toCRTPerm[m].size() > 0) {
+        if (permutation->toCRTPerm.size() > 0) {
             // Permute to CRT Order
             NativeVector permutedSlots(phim, modulusNI);
 
             for (usint i = 0; i < phim; i++) {
-                permutedSlots[i] = slotValues[m_toCRTPerm[m][i]];
+                permutedSlots[i] = slotValues[permutation->toCRTPerm[i]];
             }
             ChineseRemainderTransformFTT<NativeVector>().InverseTransformFromBitReverse(
-                permutedSlots, m_initRoot[modulusM], m, &slotValues);
+                permutedSlots, roots->initRoot, m, &slotValues);
         }
         else {
             ChineseRemainderTransformFTT<NativeVector>().InverseTransformFromBitReverse(
-                slotValues, m_initRoot[modulusM], m, &slotValues);
+                slotValues, roots->initRoot, m, &slotValues);
         }
     }
     else {  // Arbitrary cyclotomic
         // Permute to CRT Order
         NativeVector permutedSlots(phim, modulusNI);
         for (usint i = 0; i < phim; i++) {
-            permutedSlots[i] = slotValues[m_toCRTPerm[m][i]];
+            permutedSlots[i] = slotValues[permutation->toCRTPerm[i]];
         }
 
         OPENFHE_DEBUG("permutedSlots " << permutedSlots);
-        OPENFHE_DEBUG("m_initRoot[modulusM] " << m_initRoot[modulusM]);
-        OPENFHE_DEBUG("m_bigModulus[modulusM] " << m_bigModulus[modulusM]);
-        OPENFHE_DEBUG("m_bigRoot[modulusM] " << m_bigRoot[modulusM]);
+        OPENFHE_DEBUG("initRoot " << roots->initRoot);
+        OPENFHE_DEBUG("bigModulus " << roots->bigModulus);
+        OPENFHE_DEBUG("bigRoot " << roots->bigRoot);
 
         slotValues = ChineseRemainderTransformArb<NativeVector>().InverseTransform(
-            permutedSlots, m_initRoot[modulusM], m_bigModulus[modulusM], m_bigRoot[modulusM], m);
+            permutedSlots, roots->initRoot, roots->bigModulus, roots->bigRoot, m);
     }
 
     OPENFHE_DEBUG("slotvalues now " << slotValues);
@@ -402,39 +409,34 @@ void PackedEncoding::PackNativeVector(const PlaintextModulus& modulus, uint32_t
     NativeInteger modulusNI(modulus);  // native int modulus
     usint phim = slotValues.GetLength();
 
-    const ModulusM modulusM = {modulusNI, m};
-
-    // Do the precomputation if not initialized
-    if (this->m_initRoot[modulusM].GetMSB() == 0) {
-        SetParams(m, EncodingParams(std::make_shared<EncodingParamsImpl>(modulus)));
-    }
+    const auto [roots, permutation] = GetParams(m, modulus);
 
     // Transform Eval to Coeff
     if (IsPowerOfTwo(m)) {
-        if (m_toCRTPerm[m].size() > 0) {
+        if (permutation->toCRTPerm.size() > 0) {
             // Permute to CRT Order
             NativeVector permutedSlots(phim, modulusNI);
 
             for (usint i = 0; i < phim; i++) {
-                permutedSlots[i] = slotValues[m_toCRTPerm[m][i]];
+                permutedSlots[i] = slotValues[permutation->toCRTPerm[i]];
             }
             ChineseRemainderTransformFTT<NativeVector>().InverseTransformFromBitReverse(
-                permutedSlots, m_initRoot[modulusM], m, &slotValues);
+                permutedSlots, roots->initRoot, m, &slotValues);
         }
         else {
             ChineseRemainderTransformFTT<NativeVector>().InverseTransformFromBitReverse(
-                slotValues, m_initRoot[modulusM], m, &slotValues);
+                slotValues, roots->initRoot, m, &slotValues);
         }
     }
     else {  // Arbitrary cyclotomic
         // Permute to CRT Order
         NativeVector permutedSlots(phim, modulusNI);
         for (usint i = 0; i < phim; i++) {
-            permutedSlots[i] = slotValues[m_toCRTPerm[m][i]];
+            permutedSlots[i] = slotValues[permutation->toCRTPerm[i]];
         }
 
         slotValues = ChineseRemainderTransformArb<NativeVector>().InverseTransform(
-            permutedSlots, m_initRoot[modulusM], m_bigModulus[modulusM], m_bigRoot[modulusM], m);
+            permutedSlots, roots->initRoot, roots->bigModulus, roots->bigRoot, m);
     }
 }
 
@@ -445,12 +447,7 @@ void PackedEncoding::Unpack(P* ring, const PlaintextModulus& modulus) const {
     usint m = ring->GetCyclotomicOrder();  // cyclotomic order
     NativeInteger modulusNI(modulus);      // native int modulus
 
-    const ModulusM modulusM = {modulusNI, m};
-
-    // Do the precomputation if not initialized
-    if (this->m_initRoot[modulusM].GetMSB() == 0) {
-        SetParams(m, EncodingParams(std::make_shared<EncodingParamsImpl>(modulus)));
-    }
+    const auto [roots, permutation] = GetParams(m, modulus);
 
     usint phim = ring->GetRingDimension();  // ring dimension
 
@@ -467,18 +464,18 @@ void PackedEncoding::Unpack(P* ring, const PlaintextModulus& modulus) const {
     // Transform Coeff to Eval
     NativeVector permutedSlots(phim, modulusNI);
     if (IsPowerOfTwo(m)) {
-        ChineseRemainderTransformFTT<NativeVector>().ForwardTransformToBitReverse(packedVector, m_initRoot[modulusM], m,
+        ChineseRemainderTransformFTT<NativeVector>().ForwardTransformToBitReverse(packedVector, roots->initRoot, m,
                                                                                   &permutedSlots);
     }
     else {  // Arbitrary cyclotomic
         permutedSlots = ChineseRemainderTransformArb<NativeVector>().ForwardTransform(
-            packedVector, m_initRoot[modulusM], m_bigModulus[modulusM], m_bigRoot[modulusM], m);
+            packedVector, roots->initRoot, roots->bigModulus, roots->bigRoot, m);
     }
 
-    if (m_fromCRTPerm[m].size() > 0) {
+    if (permutation->fromCRTPerm.size() > 0) {
         // Permute to automorphism Order
         for (usint i = 0; i < phim; i++) {
-            packedVector[i] = permutedSlots[m_fromCRTPerm[m][i]];
+            packedVector[i] = permutedSlots[permutation->fromCRTPerm[i]];
         }
     }
     else {
@@ -504,7 +501,8 @@ void PackedEncoding::SetParams_2n(usint m, const NativeInteger& modulusNI) {
     const ModulusM modulusM = {modulusNI, m};
 
     // Power of two: m/2-point FTT. So we need the mth root of unity
-    m_initRoot[modulusM] = RootOfUnity<NativeInteger>(m, modulusNI);
+    PlaintextRoots roots;
+    roots.initRoot = RootOfUnity<NativeInteger>(m, modulusNI);
 
     // Create the permutations that interchange the automorphism and crt ordering
     // First we create the cyclic group generated by 5 and then adjoin the
@@ -513,22 +511,26 @@ void PackedEncoding::SetParams_2n(usint m, const NativeInteger& modulusNI) {
     usint phim      = (m >> 1);
     usint phim_by_2 = (m >> 2);
 
-    m_toCRTPerm[m]   = std::vector<usint>(phim);
-    m_fromCRTPerm[m] = std::vector<usint>(phim);
+    SlotPermutation permutation;
+    permutation.toCRTPerm   = std::vector<usint>(phim);
+    permutation.fromCRTPerm = std::vector<usint>(phim);
 
     usint curr_index = 1;
     usint logn       = std::round(log2(m / 2));
     for (usint i = 0; i < phim_by_2; i++) {
-        m_toCRTPerm[m][ReverseBits((curr_index - 1) / 2, logn)] = i;
-        m_fromCRTPerm[m][i]                                     = ReverseBits((curr_index - 1) / 2, logn);
+        permutation.toCRTPerm[ReverseBits((curr_index - 1) / 2, logn)] = i;
+        permutation.fromCRTPerm[i]                                     = ReverseBits((curr_index - 1) / 2, logn);
 
         usint cofactor_index = curr_index * (m - 1) % m;
 
-        m_toCRTPerm[m][ReverseBits((cofactor_index - 1) / 2, logn)] = i + phim_by_2;
-        m_fromCRTPerm[m][i + phim_by_2]                             = ReverseBits((cofactor_index - 1) / 2, logn);
+        permutation.toCRTPerm[ReverseBits((cofactor_index - 1) / 2, logn)] = i + phim_by_2;
+        permutation.fromCRTPerm[i + phim_by_2] = ReverseBits((cofactor_index - 1) / 2, logn);
 
         curr_index = curr_index * 5 % m;
     }
+
+    m_roots.Set(modulusM, std::move(roots));
+    m_permutations.Set(m, std::move(permutation));
 }
 
 void PackedEncoding::SetParams_2n(usint m, EncodingParams params) {
@@ -541,12 +543,13 @@ void PackedEncoding::SetParams_2n(usint m, EncodingParams params) {
     const ModulusM modulusM = {modulusNI, m};
 
     // Power of two: m/2-point FTT. So we need the mth root of unity
+    PlaintextRoots roots;
     if (params->GetPlaintextRootOfUnity() == 0) {
-        m_initRoot[modulusM] = RootOfUnity<NativeInteger>(m, modulusNI);
-        params->SetPlaintextRootOfUnity(m_initRoot[modulusM]);
+        roots.initRoot = RootOfUnity<NativeInteger>(m, modulusNI);
+        params->SetPlaintextRootOfUnity(roots.initRoot);
     }
     else {
-        m_initRoot[modulusM] = params->GetPlaintextRootOfUnity();
+        roots.initRoot = params->GetPlaintextRootOfUnity();
     }
 
     // Create the permutations that interchange the automorphism and crt ordering
@@ -555,21 +558,25 @@ void PackedEncoding::SetParams_2n(usint m, EncodingParams params) {
     usint phim      = (m >> 1);
     usint phim_by_2 = (m >> 2);
 
-    m_toCRTPerm[m]   = std::vector<usint>(phim);
-    m_fromCRTPerm[m] = std::vector<usint>(phim);
+    SlotPermutation permutation;
+    permutation.toCRTPerm   = std::vector<usint>(phim);
+    permutation.fromCRTPerm = std::vector<usint>(phim);
 
     usint curr_index = 1;
     usint logn       = std::round(log2(m >> 1));
     for (usint i = 0; i < phim_by_2; i++) {
-        m_toCRTPerm[m][ReverseBits((curr_index - 1) / 2, logn)] = i;
-        m_fromCRTPerm[m][i]                                     = ReverseBits((curr_index - 1) / 2, logn);
+        permutation.toCRTPerm[ReverseBits((curr_index - 1) / 2, logn)] = i;
+        permutation.fromCRTPerm[i]                                     = ReverseBits((curr_index - 1) / 2, logn);
 
         usint cofactor_index = curr_index * (m - 1) % m;
 
-        m_toCRTPerm[m][ReverseBits((cofactor_index - 1) / 2, logn)] = i + phim_by_2;
-        m_fromCRTPerm[m][i + phim_by_2]                             = ReverseBits((cofactor_index - 1) / 2, logn);
+        permutation.toCRTPerm[ReverseBits((cofactor_index - 1) / 2, logn)] = i + phim_by_2;
+        permutation.fromCRTPerm[i + phim_by_2] = ReverseBits((cofactor_index - 1) / 2, logn);
 
         curr_index = curr_index * 5 % m;
     }
+
+    m_roots.Set(modulusM, std::move(roots));
+    m_permutations.Set(m, std::move(permutation));
 }
 }  // namespace lbcrypto
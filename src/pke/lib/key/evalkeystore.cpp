@@ -0,0 +1,363 @@
+//==================================================================================
+// BSD 2-Clause License
+//
+// Copyright (c) 2014-2022, NJIT, Duality Technologies Inc. and other contributors
+//
+// All rights reserved.
+//
+// Author TPOC: contact@openfhe.org
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice, this
+//    list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+//    this list of conditions and the following disclaimer in the documentation
+//    and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+// OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//==================================================================================
+
+
+#include "key/evalkeystore.h"
+#include "key/evalkeyrelin.h"
+#include "cryptocontext.h"
+#include "utils/exception.h"
+#include "utils/parallel.h"
+
+#include <cstring>
+#include <fstream>
+#include <utility>
+
+#if !defined(_WIN32)
+    #include <fcntl.h>
+    #include <sys/mman.h>
+    #include <sys/stat.h>
+    #include <unistd.h>
+#endif
+
+namespace lbcrypto {
+
+namespace {
+
+constexpr char STORE_MAGIC[8]      = {'O', 'F', 'H', 'E', 'K', 'E', 'Y', 'S'};
+constexpr uint32_t STORE_VERSION   = 1;
+constexpr uint64_t STORE_ALIGNMENT = 4096;
+
+struct StoreHeader {
+    char magic[8];
+    uint32_t version;
+    uint32_t wordSize;
+    uint32_t cyclotomicOrder;
+    uint32_t numTowers;
+    uint32_t numKeys;
+    uint32_t keyTagSize;
+    uint64_t dataOffset;
+};
+
+struct StoreIndexEntry {
+    uint32_t index;
+    uint32_t numDigits;
+    uint64_t offset;
+};
+
+using Word = NativeInteger::Integer;
+
+}  // namespace
+
+EvalKeyStore::~EvalKeyStore() {
+    Close();
+}
+
+bool EvalKeyStore::Write(const std::string& filename, const std::map<uint32_t, EvalKey<DCRTPoly>>& evalKeyMap) {
+    if (evalKeyMap.empty())
+        OPENFHE_THROW("There are no evaluation keys to write");
+
+    const DCRTPoly& first = evalKeyMap.begin()->second->GetAVector().at(0);
+    const auto& params    = first.GetParams();
+    uint32_t numTowers    = params->GetParams().size();
+    uint32_t ringDim      = params->GetRingDimension();
+    std::string keyTag    = evalKeyMap.begin()->second->GetKeyTag();
+
+    // header, moduli and roots, index, key tag; the data starts at the next page boundary
+    uint64_t headerSize = sizeof(StoreHeader) + 2 * numTowers * sizeof(Word) +
+                          evalKeyMap.size() * sizeof(StoreIndexEntry) + keyTag.size();
+    uint64_t dataOffset = (headerSize + STORE_ALIGNMENT - 1) / STORE_ALIGNMENT * STORE_ALIGNMENT;
+
+    std::vector<StoreIndexEntry> index;
+    index.reserve(evalKeyMap.size());
+    uint64_t offset = dataOffset;
+    for (const auto& [autoIndex, evalKey] : evalKeyMap) {
+        const auto& a = evalKey->GetAVector();
+        const auto& b = evalKey->GetBVector();
+        if (a.size() != b.size())
+            OPENFHE_THROW("Evaluation key for index [" + std::to_string(autoIndex) + "] is malformed");
+        if (evalKey->GetKeyTag() != keyTag)
+            OPENFHE_THROW("All evaluation keys in a key store must have the same key tag");
+        for (const auto* vec : {&a, &b}) {
+            for (const auto& poly : *vec) {
+                if (poly.GetFormat() != Format::EVALUATION)
+                    OPENFHE_THROW("Evaluation keys must be in the EVALUATION format");
+                if (*poly.GetParams() != *params)
+                    OPENFHE_THROW("All evaluation keys in a key store must use the same CRT basis");
+            }
+        }
+        index.push_back({autoIndex, static_cast<uint32_t>(a.size()), offset});
+        offset += 2 * a.size() * numTowers * ringDim * sizeof(Word);
+    }
+
+    std::ofstream out(filename, std::ios::binary | std::ios::trunc);
+    if (!out.is_open())
+        return false;
+
+    StoreHeader header;
+    std::memcpy(header.magic, STORE_MAGIC, sizeof(header.magic));
+    header.version         = STORE_VERSION;
+    header.wordSize        = sizeof(Word);
+    header.cyclotomicOrder = params->GetCyclotomicOrder();
+    header.numTowers       = numTowers;
+    header.numKeys         = index.size();
+    header.keyTagSize      = keyTag.size();
+    header.dataOffset      = dataOffset;
+    out.write(reinterpret_cast<const char*>(&header), sizeof(header));
+
+    std::vector<Word> moduliRoots(2 * numTowers);
+    for (uint32_t i = 0; i < numTowers; ++i) {
+        moduliRoots[i]             = params->GetParams()[i]->GetModulus().ConvertToInt<Word>();
+        moduliRoots[numTowers + i] = params->GetParams()[i]->GetRootOfUnity().ConvertToInt<Word>();
+    }
+    out.write(reinterpret_cast<const char*>(moduliRoots.data()), moduliRoots.size() * sizeof(Word));
+    out.write(reinterpret_cast<const char*>(index.data()), index.size() * sizeof(StoreIndexEntry));
+    out.write(keyTag.data(), keyTag.size());
+    std::vector<char> padding(dataOffset - headerSize, 0);
+    out.write(padding.data(), padding.size());
+
+    // one write per tower
+    std::vector<Word> tower(ringDim);
+    for (const auto& [autoIndex, evalKey] : evalKeyMap) {
+        for (const auto* vec : {&evalKey->GetAVector(), &evalKey->GetBVector()}) {
+            for (const auto& poly : *vec) {
+                for (const auto& towerPoly : poly.GetAllElements()) {
+                    const auto& values = towerPoly.GetValues();
+                    for (uint32_t j = 0; j < ringDim; ++j)
+                        tower[j] = values[j].ConvertToInt<Word>();
+                    out.write(reinterpret_cast<const char*>(tower.data()), ringDim * sizeof(Word));
+                }
+            }
+        }
+    }
+
+    return out.good();
+}
+
+bool EvalKeyStore::Open(const std::string& filename) {
+    Close();
+
+#if !defined(_WIN32)
+    int fd = open(filename.c_str(), O_RDONLY);
+    if (fd < 0)
+        return false;
+    struct stat st;
+    if (fstat(fd, &st) != 0 || st.st_size < static_cast<off_t>(sizeof(StoreHeader))) {
+        close(fd);
+        return false;
+    }
+    size_t size = st.st_size;
+    void* addr  = mmap(nullptr, size, PROT_READ, MAP_SHARED, fd, 0);
+    close(fd);
+    if (addr == MAP_FAILED)
+        return false;
+    // the mapping is released with the store and the last view of it
+    m_mapping = std::shared_ptr<const uint8_t>(static_cast<const uint8_t*>(addr),
+                                               [size](const uint8_t* p) { munmap(const_cast<uint8_t*>(p), size); });
+    m_size    = size;
+#else
+    std::ifstream in(filename, std::ios::binary | std::ios::ate);
+    if (!in.is_open())
+        return false;
+    size_t size = in.tellg();
+    in.seekg(0);
+    std::shared_ptr<uint8_t> buffer(new uint8_t[size], std::default_delete<uint8_t[]>());
+    if (size < sizeof(StoreHeader) || !in.read(reinterpret_cast<char*>(buffer.get()), size))
+        return false;
+    m_mapping = std::move(buffer);
+    m_size    = size;
+#endif
+    const uint8_t* base = m_mapping.get();
+
+    StoreHeader header;
+    std::memcpy(&header, base, sizeof(header));
+    if (std::memcmp(header.magic, STORE_MAGIC, sizeof(header.magic)) != 0 || header.version != STORE_VERSION) {
+        Close();
+        OPENFHE_THROW("[" + filename + "] is not an evaluation key store");
+    }
+    if (header.wordSize != sizeof(Word)) {
+        Close();
+        OPENFHE_THROW("[" + filename + "] was written with " + std::to_string(8 * header.wordSize) +
+                      "-bit native integers");
+    }
+
+    // the header is checked against the file size before anything is allocated from it; every key holds
+    // at least the towers of one digit of its A and B vectors
+    uint64_t ringDim    = header.cyclotomicOrder / 2;
+    uint64_t towerBytes = ringDim * sizeof(Word);
+    bool valid = header.cyclotomicOrder >= 4 && (header.cyclotomicOrder & (header.cyclotomicOrder - 1)) == 0 &&
+                 header.numTowers > 0 && header.numKeys > 0 && header.numTowers <= m_size / (2 * towerBytes) &&
+                 header.numKeys <= m_size / sizeof(StoreIndexEntry) && header.keyTagSize <= m_size &&
+                 header.dataOffset <= m_size;
+    uint64_t headerSize = 0;
+    if (valid) {
+        headerSize = sizeof(header) + 2 * uint64_t(header.numTowers) * sizeof(Word) +
+                     uint64_t(header.numKeys) * sizeof(StoreIndexEntry) + header.keyTagSize;
+        valid      = headerSize <= header.dataOffset;
+    }
+    if (!valid) {
+        Close();
+        OPENFHE_THROW("[" + filename + "] has a corrupt header");
+    }
+
+    const uint8_t* ptr = base + sizeof(header);
+    std::vector<Word> moduliRoots(2 * header.numTowers);
+    std::vector<StoreIndexEntry> index(header.numKeys);
+    std::memcpy(moduliRoots.data(), ptr, moduliRoots.size() * sizeof(Word));
+    ptr += moduliRoots.size() * sizeof(Word);
+    std::memcpy(index.data(), ptr, index.size() * sizeof(StoreIndexEntry));
+    ptr += index.size() * sizeof(StoreIndexEntry);
+    m_keyTag.assign(reinterpret_cast<const char*>(ptr), header.keyTagSize);
+
+    // numTowers * towerBytes does not overflow as it is bounded by the file size
+    uint64_t digitBytes = 2 * header.numTowers * towerBytes;
+    for (const auto& entry : index) {
+        if (entry.offset < header.dataOffset || entry.offset > m_size || entry.offset % sizeof(Word) != 0 ||
+            entry.numDigits == 0 || entry.numDigits > (m_size - entry.offset) / digitBytes) {
+            Close();
+            OPENFHE_THROW("[" + filename + "] is truncated");
+        }
+    }
+
+    std::vector<NativeInteger> moduli(header.numTowers);
+    std::vector<NativeInteger> roots(header.numTowers);
+    for (uint32_t i = 0; i < header.numTowers; ++i) {
+        moduli[i] = NativeInteger(moduliRoots[i]);
+        roots[i]  = NativeInteger(moduliRoots[header.numTowers + i]);
+    }
+    m_params  = std::make_shared<DCRTPoly::Params>(header.cyclotomicOrder, moduli, roots);
+    m_ringDim = m_params->GetRingDimension();
+
+    for (const auto& entry : index)
+        m_index[entry.index] = {entry.numDigits, entry.offset};
+
+    return true;
+}
+
+void EvalKeyStore::Close() {
+    m_mapping.reset();
+    m_size = 0;
+    m_index.clear();
+    m_params.reset();
+}
+
+std::vector<uint32_t> EvalKeyStore::GetIndices() const {
+    std::vector<uint32_t> indices;
+    indices.reserve(m_index.size());
+    for (const auto& entry : m_index)
+        indices.push_back(entry.first);
+    return indices;
+}
+
+const Word* EvalKeyStore::KeyView::GetTower(bool bVector, uint32_t digit, uint32_t tower) const {
+    if (digit >= m_numDigits || tower >= m_numTowers)
+        OPENFHE_THROW("Tower [" + std::to_string(digit) + ", " + std::to_string(tower) + "] is out of range");
+    return m_data + ((uint64_t(bVector) * m_numDigits + digit) * m_numTowers + tower) * m_ringDim;
+}
+
+EvalKeyStore::KeyView EvalKeyStore::GetKeyView(uint32_t index) const {
+    if (!IsOpen())
+        OPENFHE_THROW("The evaluation key store is not open");
+    auto it = m_index.find(index);
+    if (it == m_index.end())
+        OPENFHE_THROW("EvalKey for index [" + std::to_string(index) + "] is not found.");
+
+    KeyView view;
+    view.m_mapping   = m_mapping;
+    view.m_data      = reinterpret_cast<const Word*>(m_mapping.get() + it->second.offset);
+    view.m_numDigits = it->second.numDigits;
+    view.m_numTowers = m_params->GetParams().size();
+    view.m_ringDim   = m_ringDim;
+    return view;
+}
+
+std::vector<DCRTPoly> EvalKeyStore::ReadVector(const KeyView& view, bool bVector) const {
+    const auto& towerParams = m_params->GetParams();
+
+    std::vector<DCRTPoly> result;
+    result.reserve(view.GetNumDigits());
+    for (uint32_t d = 0; d < view.GetNumDigits(); ++d) {
+        DCRTPoly poly(m_params, Format::EVALUATION);
+        auto& towers = poly.GetAllElements();
+        for (uint32_t t = 0; t < towers.size(); ++t) {
+            const Word* src = view.GetTower(bVector, d, t);
+            NativeVector values(m_ringDim, towerParams[t]->GetModulus());
+            for (uint32_t j = 0; j < m_ringDim; ++j)
+                values[j] = NativeInteger(src[j]);
+            towers[t].SetValues(std::move(values), Format::EVALUATION);
+        }
+        result.push_back(std::move(poly));
+    }
+    return result;
+}
+
+void EvalKeyStore::ValidateContext(const CryptoContext<DCRTPoly> cc) const {
+    if (!IsOpen())
+        OPENFHE_THROW("The evaluation key store is not open");
+    if (cc == nullptr)
+        OPENFHE_THROW("CryptoContext is nullptr");
+
+    // the key basis is Q for BV and Q*P for hybrid key switching
+    const auto& paramsQ = cc->GetCryptoParameters()->GetElementParams()->GetParams();
+    const auto& paramsK = m_params->GetParams();
+    bool matches        = m_ringDim == cc->GetRingDimension() && paramsK.size() >= paramsQ.size();
+    for (size_t i = 0; matches && i < paramsQ.size(); ++i)
+        matches = paramsQ[i]->GetModulus() == paramsK[i]->GetModulus();
+    if (!matches)
+        OPENFHE_THROW("The evaluation key store was not generated for this CryptoContext");
+}
+
+EvalKey<DCRTPoly> EvalKeyStore::GetEvalKey(uint32_t index, const CryptoContext<DCRTPoly> cc) const {
+    ValidateContext(cc);
+    KeyView view = GetKeyView(index);
+
+    auto evalKey = std::make_shared<EvalKeyRelinImpl<DCRTPoly>>(cc);
+    evalKey->SetAVector(ReadVector(view, false));
+    evalKey->SetBVector(ReadVector(view, true));
+    evalKey->SetKeyTag(m_keyTag);
+    return evalKey;
+}
+
+std::shared_ptr<std::map<uint32_t, EvalKey<DCRTPoly>>> EvalKeyStore::GetEvalKeyMap(
+    const CryptoContext<DCRTPoly> cc) const {
+    ValidateContext(cc);
+
+    std::vector<uint32_t> indices = GetIndices();
+    std::vector<EvalKey<DCRTPoly>> keys(indices.size());
+    ParallelFor(0, indices.size(), OpenFHEParallelControls.GetThreadLimit(indices.size()),
+                [&](size_t i) { keys[i] = GetEvalKey(indices[i], cc); });
+
+    auto evalKeyMap = std::make_shared<std::map<uint32_t, EvalKey<DCRTPoly>>>();
+    for (size_t i = 0; i < indices.size(); ++i)
+        (*evalKeyMap)[indices[i]] = std::move(keys[i]);
+    return evalKeyMap;
+}
+
+}  // namespace lbcrypto
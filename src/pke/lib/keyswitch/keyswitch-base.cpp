@@ -38,6 +38,7 @@ Base class for Lattice-based cryptography(LBC) Somewhat Homomorphic Encryption(S
 #include "lattice/lat-hal.h"
 #include "ciphertext.h"
 #include "key/evalkey.h"
+#include "utils/parallel.h"
 
 namespace lbcrypto {
 
@@ -49,6 +50,16 @@ Ciphertext<Element> KeySwitchBase<Element>::KeySwitch(ConstCiphertext<Element> c
     return result;
 }
 
+template <typename Element>
+std::vector<Ciphertext<Element>> KeySwitchBase<Element>::KeySwitchMany(
+    ConstCiphertext<Element> ciphertext, const std::vector<EvalKey<Element>>& evalKeys) const {
+    std::vector<Ciphertext<Element>> result(evalKeys.size());
+#pragma omp parallel for num_threads(OpenFHEParallelControls.GetThreadLimit(evalKeys.size()))
+    for (size_t i = 0; i < evalKeys.size(); ++i)
+        result[i] = KeySwitch(ciphertext, evalKeys[i]);
+    return result;
+}
+
 template class KeySwitchBase<DCRTPoly>;
 
 }  // namespace lbcrypto
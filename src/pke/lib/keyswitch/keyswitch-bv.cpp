@@ -45,6 +45,8 @@
 #include "key/evalkeyrelin.h"
 #include "schemerns/rns-cryptoparameters.h"
 #include "cryptocontext.h"
+#include "globals.h"
+#include "utils/parallel.h"
 
 namespace lbcrypto {
 
@@ -61,6 +63,12 @@ EvalKey<DCRTPoly> KeySwitchBV::KeySwitchGenInternal(const PrivateKey<DCRTPoly> o
     const auto ns      = cryptoParams->GetNoiseScale();
     const DggType& dgg = cryptoParams->GetDiscreteGaussianGenerator();
     DugType dug;
+    if (SeedCompressionEnabled()) {
+        // vector A is expanded from a fresh seed that is stored in the key (see CryptoObject::ExpandSeed)
+        PRNGSeed seed = DugType::GenerateSeed();
+        dug.SetSeed(seed);
+        ek->SetSeed(seed);
+    }
 
     usint digitSize = cryptoParams->GetDigitSize();
 
@@ -137,6 +145,12 @@ EvalKey<DCRTPoly> KeySwitchBV::KeySwitchGenInternal(const PrivateKey<DCRTPoly> o
     const auto ns      = cryptoParams->GetNoiseScale();
     const DggType& dgg = cryptoParams->GetDiscreteGaussianGenerator();
     DugType dug;
+    if (ek == nullptr && SeedCompressionEnabled()) {
+        // vector A is expanded from a fresh seed that is stored in the key (see CryptoObject::ExpandSeed)
+        PRNGSeed seed = DugType::GenerateSeed();
+        dug.SetSeed(seed);
+        evalKey->SetSeed(seed);
+    }
 
     usint digitSize = cryptoParams->GetDigitSize();
 
@@ -313,25 +327,25 @@ std::shared_ptr<std::vector<DCRTPoly>> KeySwitchBV::EvalKeySwitchPrecomputeCore(
 std::shared_ptr<std::vector<DCRTPoly>> KeySwitchBV::EvalFastKeySwitchCore(
     const std::shared_ptr<std::vector<DCRTPoly>> digits, const EvalKey<DCRTPoly> evalKey,
     const std::shared_ptr<ParmType> paramsQl) const {
-    std::vector<DCRTPoly> bv(evalKey->GetBVector());
-    std::vector<DCRTPoly> av(evalKey->GetAVector());
+    const std::vector<DCRTPoly>& bv = evalKey->GetBVector();
+    const std::vector<DCRTPoly>& av = evalKey->GetAVector();
 
-    auto sizeQ    = bv[0].GetParams()->GetParams().size();
-    auto sizeQl   = paramsQl->GetParams().size();
-    size_t diffQl = sizeQ - sizeQl;
+    // the key towers above level l are skipped instead of copying and dropping them
+    size_t sizeQl = paramsQl->GetParams().size();
 
-    for (size_t k = 0; k < bv.size(); k++) {
-        av[k].DropLastElements(diffQl);
-        bv[k].DropLastElements(diffQl);
-    }
+    DCRTPoly ct0(paramsQl, Format::EVALUATION, true);
+    DCRTPoly ct1(paramsQl, Format::EVALUATION, true);
 
-    DCRTPoly ct1 = (av[0] *= (*digits)[0]);
-    DCRTPoly ct0 = (bv[0] *= (*digits)[0]);
+    auto& ct0Towers = ct0.GetAllElements();
+    auto& ct1Towers = ct1.GetAllElements();
 
-    for (usint i = 1; i < (*digits).size(); ++i) {
-        ct0 += (bv[i] *= (*digits)[i]);
-        ct1 += (av[i] *= (*digits)[i]);
-    }
+    ParallelFor(0, sizeQl, OpenFHEParallelControls.GetThreadLimit(sizeQl), [&](size_t i) {
+        for (size_t k = 0; k < digits->size(); ++k) {
+            const auto& cki = (*digits)[k].GetElementAtIndex(i);
+            ct0Towers[i].AddProductEq(cki, bv[k].GetElementAtIndex(i));
+            ct1Towers[i].AddProductEq(cki, av[k].GetElementAtIndex(i));
+        }
+    });
 
     return std::make_shared<std::vector<DCRTPoly>>(std::initializer_list<DCRTPoly>{std::move(ct0), std::move(ct1)});
 }
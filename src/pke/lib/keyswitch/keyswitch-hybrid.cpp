@@ -42,6 +42,8 @@
 #include "key/evalkeyrelin.h"
 #include "scheme/ckksrns/ckksrns-cryptoparameters.h"
 #include "ciphertext.h"
+#include "globals.h"
+#include "utils/parallel.h"
 
 namespace lbcrypto {
 
@@ -90,6 +92,12 @@ EvalKey<DCRTPoly> KeySwitchHYBRID::KeySwitchGenInternal(const PrivateKey<DCRTPol
     const auto ns      = cryptoParams->GetNoiseScale();
     const DggType& dgg = cryptoParams->GetDiscreteGaussianGenerator();
     DugType dug;
+    if (ekPrev == nullptr && SeedCompressionEnabled()) {
+        // vector A is expanded from a fresh seed that is stored in the key (see CryptoObject::ExpandSeed)
+        PRNGSeed seed = DugType::GenerateSeed();
+        dug.SetSeed(seed);
+        ek->SetSeed(seed);
+    }
 
     size_t numPartQ = cryptoParams->GetNumPartQ();
 
@@ -227,6 +235,39 @@ void KeySwitchHYBRID::KeySwitchInPlace(Ciphertext<DCRTPoly>& ciphertext, const E
     cv.resize(2);
 }
 
+std::vector<Ciphertext<DCRTPoly>> KeySwitchHYBRID::KeySwitchMany(
+    ConstCiphertext<DCRTPoly> ciphertext, const std::vector<EvalKey<DCRTPoly>>& evalKeys) const {
+    const std::vector<DCRTPoly>& cv = ciphertext->GetElements();
+
+    // the digits of the last element are shared by all keys
+    std::shared_ptr<std::vector<DCRTPoly>> digits =
+        EvalKeySwitchPrecomputeCore(cv.back(), ciphertext->GetCryptoParameters());
+
+    std::vector<Ciphertext<DCRTPoly>> result(evalKeys.size());
+    // the key switches of the individual keys run as tasks; their own DCRTPoly loops nest inside them
+    ParallelFor(0, evalKeys.size(), OpenFHEParallelControls.GetThreadLimit(evalKeys.size()), [&](size_t k) {
+        std::shared_ptr<std::vector<DCRTPoly>> ba = EvalFastKeySwitchCore(digits, evalKeys[k], cv[0].GetParams());
+
+        DCRTPoly c0 = cv[0];
+        c0.SetFormat((*ba)[0].GetFormat());
+        c0 += (*ba)[0];
+
+        DCRTPoly c1;
+        if (cv.size() > 2) {
+            c1 = cv[1];
+            c1.SetFormat((*ba)[1].GetFormat());
+            c1 += (*ba)[1];
+        }
+        else {
+            c1 = std::move((*ba)[1]);
+        }
+
+        result[k] = ciphertext->CloneZero();
+        result[k]->SetElements(std::vector<DCRTPoly>{std::move(c0), std::move(c1)});
+    });
+    return result;
+}
+
 Ciphertext<DCRTPoly> KeySwitchHYBRID::KeySwitchExt(ConstCiphertext<DCRTPoly> ciphertext, bool addFirst) const {
     const auto cryptoParams = std::dynamic_pointer_cast<CryptoParametersCKKSRNS>(ciphertext->GetCryptoParameters());
 
@@ -381,19 +422,15 @@ std::shared_ptr<std::vector<DCRTPoly>> KeySwitchHYBRID::EvalKeySwitchPrecomputeC
     std::vector<DCRTPoly> partsCtExt(numPartQl);
 
     for (uint32_t part = 0; part < numPartQl; part++) {
-        auto partCtClone = partsCt[part].Clone();
-        partCtClone.SetFormat(Format::COEFFICIENT);
-
+        // modulus raising of the digit: inverse NTT, basis conversion and NTT in one pass
         uint32_t sizePartQl = partsCt[part].GetNumOfElements();
-        partsCtCompl[part]  = partCtClone.ApproxSwitchCRTBasis(
+        partsCtCompl[part]  = partsCt[part].ApproxSwitchCRTBasisEval(
              cryptoParams->GetParamsPartQ(part), cryptoParams->GetParamsComplPartQ(sizeQl - 1, part),
              cryptoParams->GetPartQlHatInvModq(part, sizePartQl - 1),
              cryptoParams->GetPartQlHatInvModqPrecon(part, sizePartQl - 1),
              cryptoParams->GetPartQlHatModp(sizeQl - 1, part),
              cryptoParams->GetmodComplPartqBarrettMu(sizeQl - 1, part));
 
-        partsCtCompl[part].SetFormat(Format::EVALUATION);
-
         partsCtExt[part] = DCRTPoly(paramsQlP, Format::EVALUATION, true);
 
         usint startPartIdx = alpha * part;
@@ -453,6 +490,9 @@ std::shared_ptr<std::vector<DCRTPoly>> KeySwitchHYBRID::EvalFastKeySwitchCoreExt
     DCRTPoly cTilda0(paramsQlP, Format::EVALUATION, true);
     DCRTPoly cTilda1(paramsQlP, Format::EVALUATION, true);
 
+    auto& cTilda0Towers = cTilda0.GetAllElements();
+    auto& cTilda1Towers = cTilda1.GetAllElements();
+
     for (uint32_t j = 0; j < digits->size(); j++) {
         const DCRTPoly& cj = (*digits)[j];
         const DCRTPoly& bj = bv[j];
@@ -463,16 +503,16 @@ std::shared_ptr<std::vector<DCRTPoly>> KeySwitchHYBRID::EvalFastKeySwitchCoreExt
             const auto& aji = aj.GetElementAtIndex(i);
             const auto& bji = bj.GetElementAtIndex(i);
 
-            cTilda0.SetElementAtIndex(i, cTilda0.GetElementAtIndex(i) + cji * bji);
-            cTilda1.SetElementAtIndex(i, cTilda1.GetElementAtIndex(i) + cji * aji);
+            cTilda0Towers[i].AddProductEq(cji, bji);
+            cTilda1Towers[i].AddProductEq(cji, aji);
         }
         for (usint i = sizeQl, idx = sizeQ; i < sizeQlP; i++, idx++) {
             const auto& cji = cj.GetElementAtIndex(i);
             const auto& aji = aj.GetElementAtIndex(idx);
             const auto& bji = bj.GetElementAtIndex(idx);
 
-            cTilda0.SetElementAtIndex(i, cTilda0.GetElementAtIndex(i) + cji * bji);
-            cTilda1.SetElementAtIndex(i, cTilda1.GetElementAtIndex(i) + cji * aji);
+            cTilda0Towers[i].AddProductEq(cji, bji);
+            cTilda1Towers[i].AddProductEq(cji, aji);
         }
     }
 
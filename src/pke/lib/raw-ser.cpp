@@ -0,0 +1,374 @@
+//==================================================================================
+// BSD 2-Clause License
+//
+// Copyright (c) 2014-2022, NJIT, Duality Technologies Inc. and other contributors
+//
+// All rights reserved.
+//
+// Author TPOC: contact@openfhe.org
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice, this
+//    list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+//    this list of conditions and the following disclaimer in the documentation
+//    and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+// OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//==================================================================================
+
+
+#include "raw-ser.h"
+#include "cryptocontext.h"
+#include "key/evalkeyrelin.h"
+#include "schemerns/rns-cryptoparameters.h"
+#include "utils/exception.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <utility>
+#include <vector>
+
+namespace lbcrypto {
+
+namespace {
+
+constexpr char RAW_MAGIC[8]    = {'O', 'F', 'H', 'E', 'R', 'A', 'W', '\0'};
+constexpr uint32_t RAW_VERSION = 2;
+// written in the native byte order; reads back differently on a platform with another byte order
+constexpr uint32_t RAW_BYTE_ORDER = 0x01020304;
+
+using Word = NativeInteger::Integer;
+
+enum RawObjectType : uint32_t {
+    RAW_CIPHERTEXT = 1,
+    RAW_EVALKEY    = 2,
+};
+
+struct RawHeader {
+    char magic[8];
+    uint32_t byteOrder;
+    uint32_t version;
+    uint32_t wordSize;
+    uint32_t objectType;
+    uint32_t keyTagSize;
+    uint32_t reserved;
+    uint64_t contextId;
+};
+
+struct RawCiphertextHeader {
+    uint32_t noiseScaleDeg;
+    uint32_t level;
+    uint32_t hopslevel;
+    uint32_t encodingType;
+    uint32_t slots;
+    uint32_t reserved;
+    double scalingFactor;
+    Word scalingFactorInt;
+};
+
+struct RawPolyVectorHeader {
+    uint32_t numPolys;
+    uint32_t cyclotomicOrder;
+    uint32_t numTowers;
+    uint32_t format;
+};
+
+// the tower data is written from and read into NativeVector storage directly
+static_assert(sizeof(NativeInteger) == sizeof(Word), "NativeInteger must have the size of its underlying word");
+
+// FNV-1a hash of the scheme, its RNS techniques, plaintext modulus and CRT moduli;
+// identifies the context of a RAW object
+uint64_t GetContextId(const CryptoContext<DCRTPoly>& cc) {
+    uint64_t hash = 14695981039346656037ULL;
+    auto mix      = [&hash](uint64_t value) {
+        for (uint32_t i = 0; i < sizeof(value); ++i) {
+            hash ^= (value >> (8 * i)) & 0xff;
+            hash *= 1099511628211ULL;
+        }
+    };
+
+    const auto cryptoParams = cc->GetCryptoParameters();
+    mix(static_cast<uint64_t>(cc->getSchemeId()));
+    mix(cc->GetCyclotomicOrder());
+    mix(cryptoParams->GetPlaintextModulus());
+    for (const auto& params : cryptoParams->GetElementParams()->GetParams())
+        mix(params->GetModulus().ConvertToInt<uint64_t>());
+
+    const auto cryptoParamsRNS = std::dynamic_pointer_cast<CryptoParametersRNS>(cryptoParams);
+    if (cryptoParamsRNS != nullptr) {
+        mix(cryptoParamsRNS->GetKeySwitchTechnique());
+        mix(cryptoParamsRNS->GetScalingTechnique());
+    }
+    if (cryptoParamsRNS != nullptr && cryptoParamsRNS->GetParamsP() != nullptr) {
+        for (const auto& params : cryptoParamsRNS->GetParamsP()->GetParams())
+            mix(params->GetModulus().ConvertToInt<uint64_t>());
+    }
+    return hash;
+}
+
+CryptoContext<DCRTPoly> FindContext(uint64_t contextId) {
+    for (const auto& cc : CryptoContextFactory<DCRTPoly>::GetAllContexts()) {
+        if (GetContextId(cc) == contextId)
+            return cc;
+    }
+    OPENFHE_THROW("No registered CryptoContext matches the serialized object; deserialize the context first");
+}
+
+void ReadBytes(std::istream& stream, void* dst, size_t size) {
+    if (!stream.read(reinterpret_cast<char*>(dst), size))
+        OPENFHE_THROW("The RAW serialization stream is truncated");
+}
+
+// number of bytes left in the stream, or the maximum value if the stream cannot seek
+uint64_t RemainingBytes(std::istream& stream) {
+    auto pos = stream.tellg();
+    if (pos < 0)
+        return UINT64_MAX;
+    stream.seekg(0, std::ios::end);
+    auto end = stream.tellg();
+    stream.seekg(pos);
+    if (end < pos || !stream)
+        return UINT64_MAX;
+    return static_cast<uint64_t>(end - pos);
+}
+
+void WriteHeader(std::ostream& stream, const CryptoObject<DCRTPoly>& obj, RawObjectType type) {
+    std::string keyTag = obj.GetKeyTag();
+
+    RawHeader header;
+    std::memcpy(header.magic, RAW_MAGIC, sizeof(header.magic));
+    header.byteOrder  = RAW_BYTE_ORDER;
+    header.version    = RAW_VERSION;
+    header.wordSize   = sizeof(Word);
+    header.objectType = type;
+    header.keyTagSize = keyTag.size();
+    header.reserved   = 0;
+    header.contextId  = GetContextId(obj.GetCryptoContext());
+    stream.write(reinterpret_cast<const char*>(&header), sizeof(header));
+    stream.write(keyTag.data(), keyTag.size());
+}
+
+CryptoContext<DCRTPoly> ReadHeader(std::istream& stream, RawObjectType type, std::string& keyTag) {
+    RawHeader header;
+    ReadBytes(stream, &header, sizeof(header));
+    if (std::memcmp(header.magic, RAW_MAGIC, sizeof(header.magic)) != 0)
+        OPENFHE_THROW("The stream does not contain a RAW serialized object");
+    if (header.byteOrder != RAW_BYTE_ORDER)
+        OPENFHE_THROW("RAW serialized object was written on a platform with a different byte order");
+    if (header.version != RAW_VERSION)
+        OPENFHE_THROW("RAW serialized object version " + std::to_string(header.version) + " is not supported");
+    if (header.wordSize != sizeof(Word))
+        OPENFHE_THROW("RAW serialized object was written with " + std::to_string(8 * header.wordSize) +
+                      "-bit native integers");
+    if (header.objectType != type)
+        OPENFHE_THROW("RAW serialized object has an unexpected type");
+
+    if (header.keyTagSize > RemainingBytes(stream))
+        OPENFHE_THROW("The RAW serialization stream is truncated");
+    keyTag.resize(header.keyTagSize);
+    ReadBytes(stream, &keyTag[0], keyTag.size());
+    return FindContext(header.contextId);
+}
+
+void WritePolyVector(std::ostream& stream, const std::vector<DCRTPoly>& polys) {
+    if (polys.empty()) {
+        RawPolyVectorHeader header{0, 0, 0, 0};
+        stream.write(reinterpret_cast<const char*>(&header), sizeof(header));
+        return;
+    }
+
+    const auto& params = polys[0].GetParams();
+    uint32_t numTowers = params->GetParams().size();
+    Format format      = polys[0].GetFormat();
+    for (const auto& poly : polys) {
+        if (poly.GetFormat() != format || *poly.GetParams() != *params)
+            OPENFHE_THROW("All polynomials of a RAW serialized object must use the same format and CRT basis");
+    }
+
+    RawPolyVectorHeader header;
+    header.numPolys        = polys.size();
+    header.cyclotomicOrder = params->GetCyclotomicOrder();
+    header.numTowers       = numTowers;
+    header.format          = format;
+    stream.write(reinterpret_cast<const char*>(&header), sizeof(header));
+
+    std::vector<Word> moduliRoots(2 * numTowers);
+    for (uint32_t i = 0; i < numTowers; ++i) {
+        moduliRoots[i]             = params->GetParams()[i]->GetModulus().ConvertToInt<Word>();
+        moduliRoots[numTowers + i] = params->GetParams()[i]->GetRootOfUnity().ConvertToInt<Word>();
+    }
+    stream.write(reinterpret_cast<const char*>(moduliRoots.data()), moduliRoots.size() * sizeof(Word));
+
+    // one write per tower
+    uint32_t ringDim = params->GetRingDimension();
+    for (const auto& poly : polys) {
+        for (const auto& tower : poly.GetAllElements()) {
+            const auto& values = tower.GetValues();
+            stream.write(reinterpret_cast<const char*>(&values[0]), ringDim * sizeof(NativeInteger));
+        }
+    }
+}
+
+std::vector<DCRTPoly> ReadPolyVector(std::istream& stream, const CryptoContext<DCRTPoly>& cc) {
+    RawPolyVectorHeader header;
+    ReadBytes(stream, &header, sizeof(header));
+    if (header.numPolys == 0)
+        return {};
+    if (header.format != Format::EVALUATION && header.format != Format::COEFFICIENT)
+        OPENFHE_THROW("RAW serialized polynomial has an invalid format");
+
+    // the header is checked against the context and the stream length before anything is allocated from it:
+    // the towers are a subset of the moduli of Q and P
+    const auto cryptoParams = std::dynamic_pointer_cast<CryptoParametersRNS>(cc->GetCryptoParameters());
+    uint64_t maxTowers       = cc->GetCryptoParameters()->GetElementParams()->GetParams().size();
+    if (cryptoParams != nullptr && cryptoParams->GetParamsP() != nullptr)
+        maxTowers += cryptoParams->GetParamsP()->GetParams().size();
+    if (header.cyclotomicOrder != cc->GetCyclotomicOrder() || header.numTowers == 0 || header.numTowers > maxTowers)
+        OPENFHE_THROW("RAW serialized polynomial does not match the CryptoContext");
+    uint64_t towerBytes = uint64_t(header.cyclotomicOrder / 2) * sizeof(Word);
+    uint64_t polyBytes  = header.numTowers * towerBytes;
+    uint64_t remaining  = RemainingBytes(stream);
+    if (2 * header.numTowers * sizeof(Word) > remaining ||
+        header.numPolys > (remaining - 2 * header.numTowers * sizeof(Word)) / polyBytes)
+        OPENFHE_THROW("The RAW serialization stream is truncated");
+
+    std::vector<Word> moduliRoots(2 * header.numTowers);
+    ReadBytes(stream, moduliRoots.data(), moduliRoots.size() * sizeof(Word));
+
+    // every tower must be a tower of the context, whose params are reused: params built from the stream would
+    // repeat the NTT precomputation for every vector read
+    const auto elementParams = cc->GetCryptoParameters()->GetElementParams();
+    std::vector<std::shared_ptr<ILNativeParams>> contextTowers(elementParams->GetParams());
+    if (cryptoParams != nullptr && cryptoParams->GetParamsP() != nullptr) {
+        const auto& towersP = cryptoParams->GetParamsP()->GetParams();
+        contextTowers.insert(contextTowers.end(), towersP.begin(), towersP.end());
+    }
+    std::vector<std::shared_ptr<ILNativeParams>> towerParams(header.numTowers);
+    for (uint32_t i = 0; i < header.numTowers; ++i) {
+        NativeInteger modulus(moduliRoots[i]);
+        NativeInteger root(moduliRoots[header.numTowers + i]);
+        for (const auto& tower : contextTowers) {
+            if (tower->GetModulus() == modulus && tower->GetRootOfUnity() == root) {
+                towerParams[i] = tower;
+                break;
+            }
+        }
+        if (towerParams[i] == nullptr)
+            OPENFHE_THROW("RAW serialized polynomial does not match the CryptoContext");
+    }
+
+    auto sameTowers = [&towerParams](const std::shared_ptr<DCRTPoly::Params>& candidate) {
+        return candidate != nullptr &&
+               std::equal(towerParams.begin(), towerParams.end(), candidate->GetParams().begin(),
+                          candidate->GetParams().end(), [](const auto& a, const auto& b) { return *a == *b; });
+    };
+    std::shared_ptr<DCRTPoly::Params> params;
+    if (sameTowers(elementParams))
+        params = elementParams;
+    else if (cryptoParams != nullptr && sameTowers(cryptoParams->GetParamsQP()))
+        params = cryptoParams->GetParamsQP();
+    else
+        params = std::make_shared<DCRTPoly::Params>(header.cyclotomicOrder, towerParams);
+    auto format      = static_cast<Format>(header.format);
+    uint32_t ringDim = params->GetRingDimension();
+
+    std::vector<DCRTPoly> polys;
+    // without a known stream length the vector only grows with the data actually read
+    if (remaining != UINT64_MAX)
+        polys.reserve(header.numPolys);
+    for (uint32_t p = 0; p < header.numPolys; ++p) {
+        // the towers are left unallocated and each one is read straight into its own storage
+        DCRTPoly poly(params, format);
+        auto& towers = poly.GetAllElements();
+        for (uint32_t t = 0; t < header.numTowers; ++t) {
+            towers[t].SetValues(NativeVector(ringDim, towerParams[t]->GetModulus()), format);
+            ReadBytes(stream, &towers[t][0], ringDim * sizeof(NativeInteger));
+        }
+        polys.push_back(std::move(poly));
+    }
+    return polys;
+}
+
+}  // namespace
+
+namespace Serial {
+
+void Serialize(const Ciphertext<DCRTPoly>& obj, std::ostream& stream, const SerType::SERRAW& sertype) {
+    if (obj == nullptr)
+        OPENFHE_THROW("Ciphertext is nullptr");
+    if (!obj->GetMetadataMap()->empty())
+        OPENFHE_THROW("Ciphertexts with metadata cannot be serialized with SerType::RAW");
+
+    WriteHeader(stream, *obj, RAW_CIPHERTEXT);
+
+    RawCiphertextHeader header;
+    header.noiseScaleDeg    = obj->GetNoiseScaleDeg();
+    header.level            = obj->GetLevel();
+    header.hopslevel        = obj->GetHopLevel();
+    header.encodingType     = obj->GetEncodingType();
+    header.slots            = obj->GetSlots();
+    header.reserved         = 0;
+    header.scalingFactor    = obj->GetScalingFactor();
+    header.scalingFactorInt = obj->GetScalingFactorInt().ConvertToInt<Word>();
+    stream.write(reinterpret_cast<const char*>(&header), sizeof(header));
+
+    WritePolyVector(stream, obj->GetElements());
+}
+
+void Deserialize(Ciphertext<DCRTPoly>& obj, std::istream& stream, const SerType::SERRAW& sertype) {
+    std::string keyTag;
+    auto cc = ReadHeader(stream, RAW_CIPHERTEXT, keyTag);
+
+    RawCiphertextHeader header;
+    ReadBytes(stream, &header, sizeof(header));
+
+    auto result = std::make_shared<CiphertextImpl<DCRTPoly>>(cc, keyTag,
+                                                             static_cast<PlaintextEncodings>(header.encodingType));
+    result->SetElements(ReadPolyVector(stream, cc));
+    result->SetNoiseScaleDeg(header.noiseScaleDeg);
+    result->SetLevel(header.level);
+    result->SetHopLevel(header.hopslevel);
+    result->SetSlots(header.slots);
+    result->SetScalingFactor(header.scalingFactor);
+    result->SetScalingFactorInt(NativeInteger(header.scalingFactorInt));
+    obj = result;
+}
+
+void Serialize(const EvalKey<DCRTPoly>& obj, std::ostream& stream, const SerType::SERRAW& sertype) {
+    if (obj == nullptr)
+        OPENFHE_THROW("EvalKey is nullptr");
+
+    WriteHeader(stream, *obj, RAW_EVALKEY);
+    WritePolyVector(stream, obj->GetAVector());
+    WritePolyVector(stream, obj->GetBVector());
+}
+
+void Deserialize(EvalKey<DCRTPoly>& obj, std::istream& stream, const SerType::SERRAW& sertype) {
+    std::string keyTag;
+    auto cc = ReadHeader(stream, RAW_EVALKEY, keyTag);
+
+    auto result = std::make_shared<EvalKeyRelinImpl<DCRTPoly>>(cc);
+    result->SetKeyTag(keyTag);
+    result->SetAVector(ReadPolyVector(stream, cc));
+    result->SetBVector(ReadPolyVector(stream, cc));
+    obj = result;
+}
+
+}  // namespace Serial
+
+}  // namespace lbcrypto
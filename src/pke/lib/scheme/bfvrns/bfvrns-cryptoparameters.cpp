@@ -710,6 +710,7 @@ void CryptoParametersBFVRNS::PrecomputeCRTTables(KeySwitchTechnique ksTech, Scal
 
         params.emplace_back(std::make_shared<ILNativeParams>(2 * n, m_moduliBsk.back(), m_rootsBsk.back()));
         m_paramsQBsk = std::make_shared<ILDCRTParams<BigInteger>>(2 * n, params);
+        m_paramsQBsk->PrecomputeNTTTables();
 
         ChineseRemainderTransformFTT<NativeVector>().PreCompute(m_rootsBsk, 2 * n, m_moduliBsk);
 
@@ -36,6 +36,7 @@ BFV implementation. See https://eprint.iacr.org/2021/204 for details.
 #define PROFILE
 
 #include "cryptocontext.h"
+#include "globals.h"
 #include "key/privatekey.h"
 #include "key/publickey.h"
 #include "scheme/bfvrns/bfvrns-cryptoparameters.h"
@@ -121,7 +122,16 @@ Ciphertext<DCRTPoly> PKEBFVRNS::Encrypt(DCRTPoly ptxt, const PrivateKey<DCRTPoly
     }
     ptxt.SetFormat(Format::COEFFICIENT);
 
-    std::shared_ptr<std::vector<DCRTPoly>> ba = EncryptZeroCore(privateKey, encParams);
+    DugType dug;
+    if (SeedCompressionEnabled() && cryptoParams->GetEncryptionTechnique() != EXTENDED) {
+        // the "a" component is expanded from a fresh seed that is stored in the ciphertext;
+        // EXTENDED encryption rescales it afterwards, so it cannot be seed-compressed
+        PRNGSeed seed = DugType::GenerateSeed();
+        dug.SetSeed(seed);
+        ciphertext->SetSeed(seed);
+    }
+
+    std::shared_ptr<std::vector<DCRTPoly>> ba = EncryptZeroCore(privateKey, encParams, dug);
 
     NativeInteger NegQModt       = cryptoParams->GetNegQModt(level);
     NativeInteger NegQModtPrecon = cryptoParams->GetNegQModtPrecon(level);
@@ -743,6 +743,21 @@ Ciphertext<DCRTPoly> FHECKKSRNS::EvalBootstrap(ConstCiphertext<DCRTPoly> ciphert
     return ctxtDec;
 }
 
+std::shared_ptr<const std::vector<uint32_t>> CKKSBootstrapPrecom::GetAutomorphismMap(uint32_t n, uint32_t autoIndex) {
+    {
+        std::lock_guard<std::mutex> lock(m_autoMapsMutex);
+        auto it = m_autoMaps.find(autoIndex);
+        if (it != m_autoMaps.end())
+            return it->second;
+    }
+
+    auto map = std::make_shared<std::vector<uint32_t>>(n);
+    PrecomputeAutoMap(n, autoIndex, map.get());
+
+    std::lock_guard<std::mutex> lock(m_autoMapsMutex);
+    return m_autoMaps.emplace(autoIndex, std::move(map)).first->second;
+}
+
 //------------------------------------------------------------------------------
 // Find Rotation Indices
 //------------------------------------------------------------------------------
@@ -1586,9 +1601,6 @@ Ciphertext<DCRTPoly> FHECKKSRNS::EvalLinearTransform(const std::vector<ConstPlai
     uint32_t bStep = (precom->m_dim1 == 0) ? ceil(sqrt(slots)) : precom->m_dim1;
     uint32_t gStep = ceil(static_cast<double>(slots) / bStep);
 
-    uint32_t M = cc->GetCyclotomicOrder();
-    uint32_t N = cc->GetRingDimension();
-
     // computes the NTTs for each CRT limb (for the hoisted automorphisms used
     // later on)
     auto digits = cc->EvalFastRotationPrecompute(ct);
@@ -1601,44 +1613,20 @@ Ciphertext<DCRTPoly> FHECKKSRNS::EvalLinearTransform(const std::vector<ConstPlai
         fastRotation[j - 1] = cc->EvalFastRotationExt(ct, j, digits, true);
     }
 
-    Ciphertext<DCRTPoly> result;
-    DCRTPoly first;
+    // the key-switched input in the extended basis is shared by all giant steps
+    Ciphertext<DCRTPoly> ctExt = cc->KeySwitchExt(ct, true);
 
-    for (uint32_t j = 0; j < gStep; j++) {
-        Ciphertext<DCRTPoly> inner = EvalMultExt(cc->KeySwitchExt(ct, true), A[bStep * j]);
+    auto innerStep = [&](uint32_t j) {
+        Ciphertext<DCRTPoly> inner = EvalMultExt(ctExt, A[bStep * j]);
         for (uint32_t i = 1; i < bStep; i++) {
             if (bStep * j + i < slots) {
                 EvalAddExtInPlace(inner, EvalMultExt(fastRotation[i - 1], A[bStep * j + i]));
             }
         }
+        return inner;
+    };
 
-        if (j == 0) {
-            first         = cc->KeySwitchDownFirstElement(inner);
-            auto elements = inner->GetElements();
-            elements[0].SetValuesToZero();
-            inner->SetElements(std::move(elements));
-            result = inner;
-        }
-        else {
-            inner = cc->KeySwitchDown(inner);
-            // Find the automorphism index that corresponds to rotation index index.
-            usint autoIndex = FindAutomorphismIndex2nComplex(bStep * j, M);
-            std::vector<usint> map(N);
-            PrecomputeAutoMap(N, autoIndex, &map);
-            DCRTPoly firstCurrent = inner->GetElements()[0].AutomorphismTransform(autoIndex, map);
-            first += firstCurrent;
-
-            auto innerDigits = cc->EvalFastRotationPrecompute(inner);
-            EvalAddExtInPlace(result, cc->EvalFastRotationExt(inner, bStep * j, innerDigits, false));
-        }
-    }
-
-    result        = cc->KeySwitchDown(result);
-    auto elements = result->GetElements();
-    elements[0] += first;
-    result->SetElements(std::move(elements));
-
-    return result;
+    return EvalGiantStepsSum(gStep, innerStep, [bStep](uint32_t j) { return bStep * j; }, *precom);
 }
 
 Ciphertext<DCRTPoly> FHECKKSRNS::EvalCoeffsToSlots(const std::vector<std::vector<ConstPlaintext>>& A,
@@ -1656,7 +1644,6 @@ Ciphertext<DCRTPoly> FHECKKSRNS::EvalCoeffsToSlots(const std::vector<std::vector
 
     auto cc    = ctxt->GetCryptoContext();
     uint32_t M = cc->GetCyclotomicOrder();
-    uint32_t N = cc->GetRingDimension();
 
     int32_t levelBudget     = precom->m_paramsEnc[CKKS_BOOT_PARAMS::LEVEL_BUDGET];
     int32_t layersCollapse  = precom->m_paramsEnc[CKKS_BOOT_PARAMS::LAYERS_COLL];
@@ -1739,9 +1726,7 @@ Ciphertext<DCRTPoly> FHECKKSRNS::EvalCoeffsToSlots(const std::vector<std::vector
             }
         }
 
-        Ciphertext<DCRTPoly> outer;
-        DCRTPoly first;
-        for (int32_t i = 0; i < b; i++) {
+        auto innerStep = [&](int32_t i) {
             // for the first iteration with j=0:
             int32_t G                  = g * i;
             Ciphertext<DCRTPoly> inner = EvalMultExt(fastRotation[0], A[s][G]);
@@ -1751,37 +1736,10 @@ Ciphertext<DCRTPoly> FHECKKSRNS::EvalCoeffsToSlots(const std::vector<std::vector
                     EvalAddExtInPlace(inner, EvalMultExt(fastRotation[j], A[s][G + j]));
                 }
             }
+            return inner;
+        };
 
-            if (i == 0) {
-                first         = cc->KeySwitchDownFirstElement(inner);
-                auto elements = inner->GetElements();
-                elements[0].SetValuesToZero();
-                inner->SetElements(std::move(elements));
-                outer = inner;
-            }
-            else {
-                if (rot_out[s][i] != 0) {
-                    inner = cc->KeySwitchDown(inner);
-                    // Find the automorphism index that corresponds to rotation index index.
-                    usint autoIndex = FindAutomorphismIndex2nComplex(rot_out[s][i], M);
-                    std::vector<usint> map(N);
-                    PrecomputeAutoMap(N, autoIndex, &map);
-                    first += inner->GetElements()[0].AutomorphismTransform(autoIndex, map);
-                    auto innerDigits = cc->EvalFastRotationPrecompute(inner);
-                    EvalAddExtInPlace(outer, cc->EvalFastRotationExt(inner, rot_out[s][i], innerDigits, false));
-                }
-                else {
-                    first += cc->KeySwitchDownFirstElement(inner);
-                    auto elements = inner->GetElements();
-                    elements[0].SetValuesToZero();
-                    inner->SetElements(std::move(elements));
-                    EvalAddExtInPlace(outer, inner);
-                }
-            }
-        }
-        result                          = cc->KeySwitchDown(outer);
-        std::vector<DCRTPoly>& elements = result->GetElements();
-        elements[0] += first;
+        result = EvalGiantStepsSum(b, innerStep, [&](int32_t i) { return rot_out[s][i]; }, *precom);
     }
 
     if (flagRem) {
@@ -1801,9 +1759,7 @@ Ciphertext<DCRTPoly> FHECKKSRNS::EvalCoeffsToSlots(const std::vector<std::vector
             }
         }
 
-        Ciphertext<DCRTPoly> outer;
-        DCRTPoly first;
-        for (int32_t i = 0; i < bRem; i++) {
+        auto innerStep = [&](int32_t i) {
             Ciphertext<DCRTPoly> inner;
             // for the first iteration with j=0:
             int32_t GRem = gRem * i;
@@ -1814,38 +1770,10 @@ Ciphertext<DCRTPoly> FHECKKSRNS::EvalCoeffsToSlots(const std::vector<std::vector
                     EvalAddExtInPlace(inner, EvalMultExt(fastRotation[j], A[stop][GRem + j]));
                 }
             }
+            return inner;
+        };
 
-            if (i == 0) {
-                first         = cc->KeySwitchDownFirstElement(inner);
-                auto elements = inner->GetElements();
-                elements[0].SetValuesToZero();
-                inner->SetElements(std::move(elements));
-                outer = inner;
-            }
-            else {
-                if (rot_out[stop][i] != 0) {
-                    inner = cc->KeySwitchDown(inner);
-                    // Find the automorphism index that corresponds to rotation index index.
-                    usint autoIndex = FindAutomorphismIndex2nComplex(rot_out[stop][i], M);
-                    std::vector<usint> map(N);
-                    PrecomputeAutoMap(N, autoIndex, &map);
-                    first += inner->GetElements()[0].AutomorphismTransform(autoIndex, map);
-                    auto innerDigits = cc->EvalFastRotationPrecompute(inner);
-                    EvalAddExtInPlace(outer, cc->EvalFastRotationExt(inner, rot_out[stop][i], innerDigits, false));
-                }
-                else {
-                    first += cc->KeySwitchDownFirstElement(inner);
-                    auto elements = inner->GetElements();
-                    elements[0].SetValuesToZero();
-                    inner->SetElements(std::move(elements));
-                    EvalAddExtInPlace(outer, inner);
-                }
-            }
-        }
-
-        result                          = cc->KeySwitchDown(outer);
-        std::vector<DCRTPoly>& elements = result->GetElements();
-        elements[0] += first;
+        result = EvalGiantStepsSum(bRem, innerStep, [&](int32_t i) { return rot_out[stop][i]; }, *precom);
     }
 
     return result;
@@ -1868,7 +1796,6 @@ Ciphertext<DCRTPoly> FHECKKSRNS::EvalSlotsToCoeffs(const std::vector<std::vector
     auto cc = ctxt->GetCryptoContext();
 
     uint32_t M = cc->GetCyclotomicOrder();
-    uint32_t N = cc->GetRingDimension();
 
     int32_t levelBudget     = precom->m_paramsDec[CKKS_BOOT_PARAMS::LEVEL_BUDGET];
     int32_t layersCollapse  = precom->m_paramsDec[CKKS_BOOT_PARAMS::LAYERS_COLL];
@@ -1951,9 +1878,7 @@ Ciphertext<DCRTPoly> FHECKKSRNS::EvalSlotsToCoeffs(const std::vector<std::vector
             }
         }
 
-        Ciphertext<DCRTPoly> outer;
-        DCRTPoly first;
-        for (int32_t i = 0; i < b; i++) {
+        auto innerStep = [&](int32_t i) {
             Ciphertext<DCRTPoly> inner;
             // for the first iteration with j=0:
             int32_t G = g * i;
@@ -1964,38 +1889,10 @@ Ciphertext<DCRTPoly> FHECKKSRNS::EvalSlotsToCoeffs(const std::vector<std::vector
                     EvalAddExtInPlace(inner, EvalMultExt(fastRotation[j], A[s][G + j]));
                 }
             }
+            return inner;
+        };
 
-            if (i == 0) {
-                first         = cc->KeySwitchDownFirstElement(inner);
-                auto elements = inner->GetElements();
-                elements[0].SetValuesToZero();
-                inner->SetElements(std::move(elements));
-                outer = inner;
-            }
-            else {
-                if (rot_out[s][i] != 0) {
-                    inner = cc->KeySwitchDown(inner);
-                    // Find the automorphism index that corresponds to rotation index index.
-                    usint autoIndex = FindAutomorphismIndex2nComplex(rot_out[s][i], M);
-                    std::vector<usint> map(N);
-                    PrecomputeAutoMap(N, autoIndex, &map);
-                    first += inner->GetElements()[0].AutomorphismTransform(autoIndex, map);
-                    auto innerDigits = cc->EvalFastRotationPrecompute(inner);
-                    EvalAddExtInPlace(outer, cc->EvalFastRotationExt(inner, rot_out[s][i], innerDigits, false));
-                }
-                else {
-                    first += cc->KeySwitchDownFirstElement(inner);
-                    auto elements = inner->GetElements();
-                    elements[0].SetValuesToZero();
-                    inner->SetElements(std::move(elements));
-                    EvalAddExtInPlace(outer, inner);
-                }
-            }
-        }
-
-        result                          = cc->KeySwitchDown(outer);
-        std::vector<DCRTPoly>& elements = result->GetElements();
-        elements[0] += first;
+        result = EvalGiantStepsSum(b, innerStep, [&](int32_t i) { return rot_out[s][i]; }, *precom);
     }
 
     if (flagRem) {
@@ -2015,9 +1912,7 @@ Ciphertext<DCRTPoly> FHECKKSRNS::EvalSlotsToCoeffs(const std::vector<std::vector
             }
         }
 
-        Ciphertext<DCRTPoly> outer;
-        DCRTPoly first;
-        for (int32_t i = 0; i < bRem; i++) {
+        auto innerStep = [&](int32_t i) {
             Ciphertext<DCRTPoly> inner;
             // for the first iteration with j=0:
             int32_t GRem = gRem * i;
@@ -2027,38 +1922,10 @@ Ciphertext<DCRTPoly> FHECKKSRNS::EvalSlotsToCoeffs(const std::vector<std::vector
                 if ((GRem + j) != int32_t(numRotationsRem))
                     EvalAddExtInPlace(inner, EvalMultExt(fastRotation[j], A[s][GRem + j]));
             }
+            return inner;
+        };
 
-            if (i == 0) {
-                first         = cc->KeySwitchDownFirstElement(inner);
-                auto elements = inner->GetElements();
-                elements[0].SetValuesToZero();
-                inner->SetElements(std::move(elements));
-                outer = inner;
-            }
-            else {
-                if (rot_out[s][i] != 0) {
-                    inner = cc->KeySwitchDown(inner);
-                    // Find the automorphism index that corresponds to rotation index index.
-                    usint autoIndex = FindAutomorphismIndex2nComplex(rot_out[s][i], M);
-                    std::vector<usint> map(N);
-                    PrecomputeAutoMap(N, autoIndex, &map);
-                    first += inner->GetElements()[0].AutomorphismTransform(autoIndex, map);
-                    auto innerDigits = cc->EvalFastRotationPrecompute(inner);
-                    EvalAddExtInPlace(outer, cc->EvalFastRotationExt(inner, rot_out[s][i], innerDigits, false));
-                }
-                else {
-                    first += cc->KeySwitchDownFirstElement(inner);
-                    auto elements = inner->GetElements();
-                    elements[0].SetValuesToZero();
-                    inner->SetElements(std::move(elements));
-                    EvalAddExtInPlace(outer, inner);
-                }
-            }
-        }
-
-        result                          = cc->KeySwitchDown(outer);
-        std::vector<DCRTPoly>& elements = result->GetElements();
-        elements[0] += first;
+        result = EvalGiantStepsSum(bRem, innerStep, [&](int32_t i) { return rot_out[s][i]; }, *precom);
     }
 
     return result;
@@ -2488,6 +2355,66 @@ Ciphertext<DCRTPoly> FHECKKSRNS::EvalAddExt(ConstCiphertext<DCRTPoly> ciphertext
     return result;
 }
 
+Ciphertext<DCRTPoly> FHECKKSRNS::EvalGiantStepExt(Ciphertext<DCRTPoly> inner, int32_t rotation,
+                                                  CKKSBootstrapPrecom& precom, DCRTPoly& first) const {
+    auto cc = inner->GetCryptoContext();
+
+    if (rotation == 0) {
+        first                           = cc->KeySwitchDownFirstElement(inner);
+        std::vector<DCRTPoly>& elements = inner->GetElements();
+        elements[0].SetValuesToZero();
+        return inner;
+    }
+
+    inner = cc->KeySwitchDown(inner);
+    // Find the automorphism index that corresponds to rotation index index.
+    usint autoIndex = FindAutomorphismIndex2nComplex(rotation, cc->GetCyclotomicOrder());
+    auto map        = precom.GetAutomorphismMap(cc->GetRingDimension(), autoIndex);
+    first           = inner->GetElements()[0].AutomorphismTransform(autoIndex, *map);
+    auto digits     = cc->EvalFastRotationPrecompute(inner);
+    return cc->EvalFastRotationExt(inner, rotation, digits, false);
+}
+
+void FHECKKSRNS::AddGiantStepExt(Ciphertext<DCRTPoly>& outer, DCRTPoly& first, Ciphertext<DCRTPoly> term,
+                                 DCRTPoly& termFirst) const {
+    if (!term)
+        return;
+    if (!outer) {
+        outer = std::move(term);
+        first = std::move(termFirst);
+    }
+    else {
+        EvalAddExtInPlace(outer, term);
+        first += termFirst;
+    }
+}
+
+Ciphertext<DCRTPoly> FHECKKSRNS::EvalGiantStepsSum(uint32_t count,
+                                                   const std::function<Ciphertext<DCRTPoly>(uint32_t)>& innerStep,
+                                                   const std::function<int32_t(uint32_t)>& rotation,
+                                                   CKKSBootstrapPrecom& precom) const {
+    Ciphertext<DCRTPoly> outer;
+    DCRTPoly first;
+    std::mutex mtx;
+    // every chunk sums up its rotated giant steps in the extended basis, and the partial sums
+    // are added before the single ModDown below
+    ParallelForRange(0, count, OpenFHEParallelControls.GetThreadLimit(count), [&](size_t begin, size_t end) {
+        Ciphertext<DCRTPoly> partial;
+        DCRTPoly partialFirst;
+        for (size_t i = begin; i < end; ++i) {
+            DCRTPoly innerFirst;
+            Ciphertext<DCRTPoly> rotated = EvalGiantStepExt(innerStep(i), rotation(i), precom, innerFirst);
+            AddGiantStepExt(partial, partialFirst, std::move(rotated), innerFirst);
+        }
+        std::lock_guard<std::mutex> lock(mtx);
+        AddGiantStepExt(outer, first, std::move(partial), partialFirst);
+    });
+
+    Ciphertext<DCRTPoly> result = outer->GetCryptoContext()->KeySwitchDown(outer);
+    result->GetElements()[0] += first;
+    return result;
+}
+
 EvalKey<DCRTPoly> FHECKKSRNS::ConjugateKeyGen(const PrivateKey<DCRTPoly> privateKey) const {
     const auto cc = privateKey->GetCryptoContext();
     auto algo     = cc->GetScheme();
@@ -521,6 +521,48 @@ Ciphertext<Element> LeveledSHEBase<Element>::EvalFastRotation(
     return result;
 }
 
+template <class Element>
+Ciphertext<Element> LeveledSHEBase<Element>::EvalMultExt(ConstCiphertext<Element> ciphertext,
+                                                         ConstPlaintext plaintext) const {
+    Element pt = plaintext->GetElement<Element>();
+    if (pt.GetNumOfElements() != ciphertext->GetElements()[0].GetNumOfElements()) {
+        OPENFHE_THROW("The plaintext has " + std::to_string(pt.GetNumOfElements()) +
+                      " towers, but the ciphertext in the extended basis has " +
+                      std::to_string(ciphertext->GetElements()[0].GetNumOfElements()));
+    }
+    pt.SetFormat(Format::EVALUATION);
+
+    Ciphertext<Element> result = ciphertext->Clone();
+    for (auto& c : result->GetElements()) {
+        c *= pt;
+    }
+    result->SetNoiseScaleDeg(result->GetNoiseScaleDeg() + plaintext->GetNoiseScaleDeg());
+    result->SetScalingFactor(result->GetScalingFactor() * plaintext->GetScalingFactor());
+    return result;
+}
+
+template <class Element>
+Ciphertext<Element> LeveledSHEBase<Element>::EvalAddExt(ConstCiphertext<Element> ciphertext1,
+                                                        ConstCiphertext<Element> ciphertext2) const {
+    Ciphertext<Element> result = ciphertext1->Clone();
+    EvalAddExtInPlace(result, ciphertext2);
+    return result;
+}
+
+template <class Element>
+void LeveledSHEBase<Element>::EvalAddExtInPlace(Ciphertext<Element>& ciphertext1,
+                                                ConstCiphertext<Element> ciphertext2) const {
+    std::vector<Element>& cv1       = ciphertext1->GetElements();
+    const std::vector<Element>& cv2 = ciphertext2->GetElements();
+
+    if (cv1.size() != cv2.size() || cv1[0].GetNumOfElements() != cv2[0].GetNumOfElements())
+        OPENFHE_THROW("Ciphertexts in the extended basis have different sizes");
+
+    for (size_t i = 0; i < cv1.size(); ++i) {
+        cv1[i] += cv2[i];
+    }
+}
+
 template <class Element>
 std::shared_ptr<std::map<usint, EvalKey<Element>>> LeveledSHEBase<Element>::EvalAtIndexKeyGen(
     const PublicKey<Element> publicKey, const PrivateKey<Element> privateKey,
@@ -33,14 +33,23 @@
 #include "key/privatekey.h"
 #include "key/publickey.h"
 #include "cryptocontext.h"
+#include "globals.h"
 
 namespace lbcrypto {
 
 Ciphertext<DCRTPoly> PKERNS::Encrypt(DCRTPoly plaintext, const PrivateKey<DCRTPoly> privateKey) const {
     Ciphertext<DCRTPoly> ciphertext(std::make_shared<CiphertextImpl<DCRTPoly>>(privateKey));
 
+    DugType dug;
+    if (SeedCompressionEnabled()) {
+        // the "a" component is expanded from a fresh seed that is stored in the ciphertext
+        PRNGSeed seed = DugType::GenerateSeed();
+        dug.SetSeed(seed);
+        ciphertext->SetSeed(seed);
+    }
+
     const std::shared_ptr<ParmType> ptxtParams = plaintext.GetParams();
-    std::shared_ptr<std::vector<DCRTPoly>> ba  = EncryptZeroCore(privateKey, ptxtParams);
+    std::shared_ptr<std::vector<DCRTPoly>> ba  = EncryptZeroCore(privateKey, ptxtParams, dug);
 
     plaintext.SetFormat(EVALUATION);
 
@@ -109,22 +118,29 @@ DecryptResult PKERNS::Decrypt(ConstCiphertext<DCRTPoly> ciphertext, const Privat
 
 std::shared_ptr<std::vector<DCRTPoly>> PKERNS::EncryptZeroCore(const PrivateKey<DCRTPoly> privateKey,
                                                                const std::shared_ptr<ParmType> params) const {
+    DugType dug;
+    return EncryptZeroCore(privateKey, params, dug);
+}
+
+std::shared_ptr<std::vector<DCRTPoly>> PKERNS::EncryptZeroCore(const PrivateKey<DCRTPoly> privateKey,
+                                                               const std::shared_ptr<ParmType> params,
+                                                               DugType& dug) const {
     const auto cryptoParams = std::dynamic_pointer_cast<CryptoParametersRNS>(privateKey->GetCryptoParameters());
 
     const DCRTPoly& s  = privateKey->GetPrivateElement();
     const auto ns      = cryptoParams->GetNoiseScale();
     const DggType& dgg = cryptoParams->GetDiscreteGaussianGenerator();
-    DugType dug;
 
     const std::shared_ptr<ParmType> elementParams = (params == nullptr) ? cryptoParams->GetElementParams() : params;
 
-    DCRTPoly a(dug, elementParams, Format::EVALUATION);
+    // c1 is sampled directly (c1 = -a), so a seeded generator reproduces it exactly
+    DCRTPoly c1(dug, elementParams, Format::EVALUATION);
     DCRTPoly e(dgg, elementParams, Format::EVALUATION);
 
     uint32_t sizeQ  = s.GetParams()->GetParams().size();
     uint32_t sizeQl = elementParams->GetParams().size();
 
-    DCRTPoly c0, c1;
+    DCRTPoly c0;
     if (sizeQl != sizeQ) {
         // Clone secret key because we need to drop towers.
         DCRTPoly scopy(s);
@@ -132,13 +148,11 @@ std::shared_ptr<std::vector<DCRTPoly>> PKERNS::EncryptZeroCore(const PrivateKey<
         uint32_t diffQl = sizeQ - sizeQl;
         scopy.DropLastElements(diffQl);
 
-        c0 = a * scopy + ns * e;
-        c1 = -a;
+        c0 = ns * e - c1 * scopy;
     }
     else {
         // Use secret key as is
-        c0 = a * s + ns * e;
-        c1 = -a;
+        c0 = ns * e - c1 * s;
     }
 
     return std::make_shared<std::vector<DCRTPoly>>(std::initializer_list<DCRTPoly>({std::move(c0), std::move(c1)}));
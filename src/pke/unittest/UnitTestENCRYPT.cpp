@@ -35,8 +35,10 @@
 #include "utils/exception.h"
 
 #include "include/gtest/gtest.h"
+#include <algorithm>
 #include <iostream>
 #include <sstream>
+#include <type_traits>
 #include <vector>
 
 using namespace lbcrypto;
@@ -45,6 +47,7 @@ using namespace lbcrypto;
 enum TEST_CASE_TYPE {
     STRING_TEST = 0,
     COEF_PACKED_TEST,
+    STREAM_TEST,
 };
 
 static std::ostream& operator<<(std::ostream& os, const TEST_CASE_TYPE& type) {
@@ -56,6 +59,9 @@ static std::ostream& operator<<(std::ostream& os, const TEST_CASE_TYPE& type) {
         case COEF_PACKED_TEST:
             typeName = "COEF_PACKED_TEST";
             break;
+        case STREAM_TEST:
+            typeName = "STREAM_TEST";
+            break;
         default:
             typeName = "UNKNOWN";
             break;
@@ -133,6 +139,13 @@ static std::vector<TEST_CASE_UTGENERAL_ENCRYPT_DECRYPT> testCases = {
     { COEF_PACKED_TEST, "14", {BFVRNS_SCHEME, DFLT, DFLT,      DFLT,     20,       BATCH,   UNIFORM_TERNARY, DFLT,          DFLT,     DFLT,         BV,     FIXEDMANUAL,     DFLT,    512,   DFLT,   DFLT,      DFLT, BEHZ,             EXTENDED, DFLT} },
     { COEF_PACKED_TEST, "15", {BFVRNS_SCHEME, DFLT, DFLT,      DFLT,     20,       BATCH,   GAUSSIAN,        DFLT,          DFLT,     DFLT,         BV,     FIXEDMANUAL,     DFLT,    512,   DFLT,   DFLT,      DFLT, HPSPOVERQ,        EXTENDED, DFLT} },
     { COEF_PACKED_TEST, "16", {BFVRNS_SCHEME, DFLT, DFLT,      DFLT,     20,       BATCH,   GAUSSIAN,        DFLT,          DFLT,     DFLT,         BV,     FIXEDMANUAL,     DFLT,    512,   DFLT,   DFLT,      DFLT, HPSPOVERQLEVELED, EXTENDED, DFLT} },
+    // ==========================================
+    // TestType,  Descr, Scheme,         RDim, MultDepth, SModSize, DSize,    BatchSz, SecKeyDist,      MaxRelinSkDeg, FModSize, SecLvl,       KSTech, ScalTech,        LDigits, PtMod, StdDev, EvalAddCt, KSCt, MultTech,         EncTech,  PREMode
+    { STREAM_TEST, "01", {BGVRNS_SCHEME, 256,  2,         DFLT,     BV_DSIZE, BATCH,   UNIFORM_TERNARY, 1,             60,       HEStd_NotSet, BV,     FIXEDMANUAL,     DFLT,    65537, DFLT,   DFLT,      DFLT, DFLT,             STANDARD, DFLT} },
+    { STREAM_TEST, "02", {BGVRNS_SCHEME, 256,  2,         DFLT,     BV_DSIZE, DFLT,    UNIFORM_TERNARY, 1,             DFLT,     HEStd_NotSet, BV,     FLEXIBLEAUTO,    DFLT,    65537, DFLT,   DFLT,      DFLT, DFLT,             STANDARD, DFLT} },
+    { STREAM_TEST, "03", {BFVRNS_SCHEME, DFLT, DFLT,      DFLT,     20,       BATCH,   UNIFORM_TERNARY, DFLT,          DFLT,     DFLT,         BV,     FIXEDMANUAL,     DFLT,    65537, DFLT,   DFLT,      DFLT, HPSPOVERQLEVELED, STANDARD, DFLT} },
+    { STREAM_TEST, "04", {CKKSRNS_SCHEME, 256, 2,         50,       DFLT,     BATCH,   UNIFORM_TERNARY, DFLT,          60,       HEStd_NotSet, HYBRID, FLEXIBLEAUTO,    DFLT,    DFLT,  DFLT,   DFLT,      DFLT, DFLT,             STANDARD, DFLT} },
+    { STREAM_TEST, "05", {CKKSRNS_SCHEME, 256, 2,         50,       DFLT,     DFLT,    UNIFORM_TERNARY, DFLT,          60,       HEStd_NotSet, HYBRID, FIXEDMANUAL,     DFLT,    DFLT,  DFLT,   DFLT,      DFLT, DFLT,             STANDARD, DFLT} },
 };
 // clang-format on
 //===========================================================================================================
@@ -224,6 +237,72 @@ protected:
             UNIT_TEST_HANDLE_ALL_EXCEPTIONS;
         }
     }
+
+    template <typename T>
+    void EncryptionStream(CryptoContext<Element> cc, const std::string& failmsg) {
+        // three full blocks and a partial one
+        const size_t blockSize = cc->GetStreamBlockSize();
+        const size_t size      = 3 * blockSize + blockSize / 2;
+        std::vector<T> values(size);
+        for (size_t i = 0; i < size; ++i)
+            values[i] = static_cast<T>(static_cast<int64_t>(i % 1000) - 500) / (std::is_same_v<T, double> ? 100 : 1);
+
+        KeyPair<Element> kp = cc->KeyGen();
+        EXPECT_EQ(kp.good(), true) << failmsg << " key generation for stream encrypt/decrypt failed";
+
+        std::vector<Ciphertext<Element>> ciphertexts;
+        cc->EncryptStream(kp.publicKey, values, [&](size_t i, Ciphertext<Element> ciphertext) {
+            EXPECT_EQ(i, ciphertexts.size()) << failmsg << " ciphertexts are out of order";
+            ciphertexts.push_back(std::move(ciphertext));
+        });
+        EXPECT_EQ(ciphertexts.size(), size_t(4)) << failmsg << " wrong number of ciphertexts";
+
+        std::vector<T> result;
+        cc->DecryptStream(kp.secretKey, ciphertexts, [&](size_t i, Plaintext plaintext) {
+            EXPECT_EQ(i * blockSize, result.size()) << failmsg << " plaintexts are out of order";
+            plaintext->SetLength(std::min(blockSize, size - result.size()));
+            if constexpr (std::is_same_v<T, double>) {
+                const auto& block = plaintext->GetRealPackedValue();
+                result.insert(result.end(), block.begin(), block.end());
+            }
+            else {
+                const auto& block = plaintext->GetPackedValue();
+                result.insert(result.end(), block.begin(), block.end());
+            }
+        });
+        if constexpr (std::is_same_v<T, double>) {
+            ASSERT_EQ(result.size(), values.size()) << failmsg << " stream encrypt/decrypt failed";
+            for (size_t i = 0; i < size; ++i)
+                EXPECT_NEAR(result[i], values[i], 0.0001) << failmsg << " stream encrypt/decrypt failed at " << i;
+        }
+        else {
+            EXPECT_EQ(result, values) << failmsg << " stream encrypt/decrypt failed";
+        }
+
+        // an exception thrown while the ciphertexts are decrypted in parallel reaches the caller
+        ciphertexts[2] = nullptr;
+        EXPECT_THROW(cc->DecryptStream(kp.secretKey, ciphertexts, [](size_t, Plaintext) {}), OpenFHEException)
+            << failmsg << " the decryption error is not propagated";
+    }
+
+    void EncryptionStream(const TEST_CASE_UTGENERAL_ENCRYPT_DECRYPT& testData,
+                          const std::string& failmsg = std::string()) {
+        try {
+            CryptoContext<Element> cc(UnitTestGenerateContext(testData.params));
+            if (cc->getSchemeId() == CKKSRNS_SCHEME)
+                EncryptionStream<double>(cc, failmsg);
+            else
+                EncryptionStream<int64_t>(cc, failmsg);
+        }
+        catch (std::exception& e) {
+            std::cerr << "Exception thrown from " << __func__ << "(): " << e.what() << std::endl;
+            // make it fail
+            EXPECT_TRUE(0 == 1) << failmsg;
+        }
+        catch (...) {
+            UNIT_TEST_HANDLE_ALL_EXCEPTIONS;
+        }
+    }
 };
 //===========================================================================================================
 TEST_P(UTGENERAL_ENCRYPT_DECRYPT, ENCRYPT) {
@@ -233,6 +312,8 @@ TEST_P(UTGENERAL_ENCRYPT_DECRYPT, ENCRYPT) {
         EncryptionString(test, test.buildTestName());
     else if (test.testCaseType == COEF_PACKED_TEST)
         EncryptionCoefPacked(test, test.buildTestName());
+    else if (test.testCaseType == STREAM_TEST)
+        EncryptionStream(test, test.buildTestName());
 }
 
 INSTANTIATE_TEST_SUITE_P(UnitTests, UTGENERAL_ENCRYPT_DECRYPT, ::testing::ValuesIn(testCases), testName);
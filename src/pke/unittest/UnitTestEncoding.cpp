@@ -115,6 +115,25 @@ TEST_F(UTGENERAL_ENCODING, packed_int_ptxt_encoding_negative) {
     EXPECT_EQ(se.GetPackedValue(), vectorOfInts1) << "packed int";
 }
 
+TEST_F(UTGENERAL_ENCODING, packed_int_ptxt_encoding_repeated_setparams) {
+    // the precomputations for both orders are published once; calling SetParams again, alternating between
+    // them, must neither republish them nor keep the replaced snapshots
+    PlaintextModulus p = 270337;  // 1 mod 2m for both orders
+    std::vector<uint32_t> orders{22, 1024};
+    std::vector<EncodingParams> eps;
+    for (uint32_t m : orders) {
+        eps.push_back(std::make_shared<EncodingParamsImpl>(p));
+        PackedEncoding::SetParams(m, eps.back());
+    }
+    size_t retained = PackedEncoding::GetRetainedCount();
+
+    for (uint32_t i = 0; i < 100; i++) {
+        for (size_t j = 0; j < orders.size(); j++)
+            PackedEncoding::SetParams(orders[j], eps[j]);
+    }
+    EXPECT_EQ(PackedEncoding::GetRetainedCount(), retained) << "retained precomputations grow with SetParams";
+}
+
 TEST_F(UTGENERAL_ENCODING, packed_int_ptxt_encoding_DCRTPoly_prime_cyclotomics) {
     uint32_t init_size   = 3;
     uint32_t dcrtBits    = 24;
@@ -0,0 +1,198 @@
+//==================================================================================
+// BSD 2-Clause License
+//
+// Copyright (c) 2014-2022, NJIT, Duality Technologies Inc. and other contributors
+//
+// All rights reserved.
+//
+// Author TPOC: contact@openfhe.org
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice, this
+//    list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+//    this list of conditions and the following disclaimer in the documentation
+//    and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+// OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//==================================================================================
+
+#include "scheme/bgvrns/gen-cryptocontext-bgvrns.h"
+#include "scheme/ckksrns/gen-cryptocontext-ckksrns.h"
+#include "gen-cryptocontext.h"
+
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <iterator>
+#include <string>
+#include <vector>
+#include "gtest/gtest.h"
+
+#include "cryptocontext.h"
+#include "key/evalkeystore.h"
+
+using namespace lbcrypto;
+
+// Writes the rotation keys of kp to a key store, reloads them and checks that they are identical to the
+// original keys and that rotations with the reloaded keys decrypt correctly.
+static void RunEvalKeyStoreTest(CryptoContext<DCRTPoly> cc, const std::vector<int32_t>& rotations,
+                                const std::string& filename) {
+    KeyPair<DCRTPoly> kp = cc->KeyGen();
+    cc->EvalRotateKeyGen(kp.secretKey, rotations);
+
+    const auto& evalKeys = cc->GetEvalAutomorphismKeyMap(kp.secretKey->GetKeyTag());
+    ASSERT_TRUE(EvalKeyStore::Write(filename, evalKeys));
+
+    EvalKeyStore store;
+    ASSERT_TRUE(store.Open(filename));
+    EXPECT_EQ(store.GetKeyTag(), kp.secretKey->GetKeyTag());
+    EXPECT_EQ(store.GetIndices().size(), evalKeys.size());
+
+    auto loaded = store.GetEvalKeyMap(cc);
+    ASSERT_EQ(loaded->size(), evalKeys.size());
+    for (const auto& [index, evalKey] : evalKeys) {
+        EXPECT_TRUE(*evalKey == *loaded->at(index)) << "Key for index " << index << " differs";
+    }
+
+    // a view reads the mapped towers in place and outlives the store
+    const uint32_t viewIndex        = evalKeys.begin()->first;
+    const EvalKey<DCRTPoly> viewKey = evalKeys.begin()->second;
+    EvalKeyStore::KeyView view      = store.GetKeyView(viewIndex);
+
+    cc->ClearEvalAutomorphismKeys();
+    cc->InsertEvalAutomorphismKey(loaded, store.GetKeyTag());
+    store.Close();
+    std::remove(filename.c_str());
+
+    ASSERT_EQ(view.GetNumDigits(), viewKey->GetAVector().size());
+    for (uint32_t d = 0; d < view.GetNumDigits(); ++d) {
+        for (bool bVector : {false, true}) {
+            const auto& towers = (bVector ? viewKey->GetBVector() : viewKey->GetAVector())[d].GetAllElements();
+            ASSERT_EQ(view.GetNumTowers(), towers.size());
+            for (uint32_t t = 0; t < towers.size(); ++t) {
+                const auto* data = view.GetTower(bVector, d, t);
+                for (uint32_t j = 0; j < view.GetRingDimension(); ++j)
+                    ASSERT_EQ(data[j], towers[t][j].ConvertToInt()) << "View of tower " << d << ", " << t << " differs";
+            }
+        }
+    }
+
+    std::vector<int64_t> vec = {1, 2, 3, 4, 5, 6, 7, 8};
+    Plaintext plaintext      = (cc->getSchemeId() == CKKSRNS_SCHEME) ?
+                                   cc->MakeCKKSPackedPlaintext(std::vector<double>(vec.begin(), vec.end())) :
+                                   cc->MakePackedPlaintext(vec);
+    auto ciphertext = cc->Encrypt(kp.publicKey, plaintext);
+    for (int32_t r : rotations) {
+        Plaintext result;
+        cc->Decrypt(kp.secretKey, cc->EvalRotate(ciphertext, r), &result);
+        result->SetLength(vec.size());
+        if (cc->getSchemeId() == CKKSRNS_SCHEME) {
+            for (size_t i = 0; i + r < vec.size(); ++i)
+                EXPECT_NEAR(result->GetRealPackedValue()[i], vec[i + r], 0.0001) << "Rotation by " << r;
+        }
+        else {
+            for (size_t i = 0; i + r < vec.size(); ++i)
+                EXPECT_EQ(result->GetPackedValue()[i], vec[i + r]) << "Rotation by " << r;
+        }
+    }
+    cc->ClearEvalAutomorphismKeys();
+}
+
+TEST(UTGENERAL_EVALKEYSTORE, CKKSrns_Hybrid) {
+    CCParams<CryptoContextCKKSRNS> parameters;
+    parameters.SetMultiplicativeDepth(2);
+    parameters.SetScalingModSize(50);
+    parameters.SetBatchSize(8);
+    parameters.SetRingDim(1 << 10);
+    parameters.SetSecurityLevel(HEStd_NotSet);
+    parameters.SetKeySwitchTechnique(HYBRID);
+
+    CryptoContext<DCRTPoly> cc = GenCryptoContext(parameters);
+    cc->Enable(PKE);
+    cc->Enable(KEYSWITCH);
+    cc->Enable(LEVELEDSHE);
+
+    RunEvalKeyStoreTest(cc, {1, 2, 3}, "evalkeystore-ckks.bin");
+}
+
+TEST(UTGENERAL_EVALKEYSTORE, BGVrns_BV) {
+    CCParams<CryptoContextBGVRNS> parameters;
+    parameters.SetMultiplicativeDepth(2);
+    parameters.SetPlaintextModulus(65537);
+    parameters.SetRingDim(1 << 10);
+    parameters.SetSecurityLevel(HEStd_NotSet);
+    parameters.SetKeySwitchTechnique(BV);
+    parameters.SetDigitSize(20);
+
+    CryptoContext<DCRTPoly> cc = GenCryptoContext(parameters);
+    cc->Enable(PKE);
+    cc->Enable(KEYSWITCH);
+    cc->Enable(LEVELEDSHE);
+
+    RunEvalKeyStoreTest(cc, {1, 2, 3}, "evalkeystore-bgv.bin");
+}
+
+TEST(UTGENERAL_EVALKEYSTORE, Open_Errors) {
+    EvalKeyStore store;
+    EXPECT_FALSE(store.Open("evalkeystore-does-not-exist.bin"));
+    EXPECT_FALSE(store.IsOpen());
+}
+
+TEST(UTGENERAL_EVALKEYSTORE, Open_CorruptHeader) {
+    CCParams<CryptoContextBGVRNS> parameters;
+    parameters.SetMultiplicativeDepth(1);
+    parameters.SetPlaintextModulus(65537);
+    parameters.SetRingDim(1 << 10);
+    parameters.SetSecurityLevel(HEStd_NotSet);
+
+    CryptoContext<DCRTPoly> cc = GenCryptoContext(parameters);
+    cc->Enable(PKE);
+    cc->Enable(KEYSWITCH);
+    cc->Enable(LEVELEDSHE);
+
+    KeyPair<DCRTPoly> kp = cc->KeyGen();
+    cc->EvalRotateKeyGen(kp.secretKey, {1});
+    const std::string filename = "evalkeystore-corrupt.bin";
+    ASSERT_TRUE(EvalKeyStore::Write(filename, cc->GetEvalAutomorphismKeyMap(kp.secretKey->GetKeyTag())));
+    cc->ClearEvalAutomorphismKeys();
+
+    std::ifstream in(filename, std::ios::binary);
+    const std::vector<char> original((std::istreambuf_iterator<char>(in)), std::istreambuf_iterator<char>());
+    in.close();
+
+    // writes the first size bytes of the original file with value stored at offset (if it fits) and opens it
+    auto openPatched = [&](size_t offset, uint32_t value, size_t size) {
+        std::vector<char> patched(original.begin(), original.begin() + size);
+        if (offset + sizeof(value) <= size)
+            std::memcpy(patched.data() + offset, &value, sizeof(value));
+        std::ofstream out(filename, std::ios::binary | std::ios::trunc);
+        out.write(patched.data(), patched.size());
+        out.close();
+        EvalKeyStore store;
+        return store.Open(filename);
+    };
+    // the header fields are checked against the file size before anything is allocated from them;
+    // numTowers and numKeys follow the magic, the version, the word size and the cyclotomic order
+    const size_t numTowersOffset = 8 + 3 * sizeof(uint32_t);
+    const size_t numKeysOffset   = numTowersOffset + sizeof(uint32_t);
+    EXPECT_THROW(openPatched(numTowersOffset, 0xFFFFFFFF, original.size()), OpenFHEException);
+    EXPECT_THROW(openPatched(numKeysOffset, 0xFFFFFFFF, original.size()), OpenFHEException);
+    EXPECT_THROW(openPatched(numKeysOffset, 0, original.size()), OpenFHEException);
+    // a key that runs past the end of the file
+    EXPECT_THROW(openPatched(original.size(), 0, original.size() - 8), OpenFHEException);
+    EXPECT_TRUE(openPatched(original.size(), 0, original.size()));
+    std::remove(filename.c_str());
+}
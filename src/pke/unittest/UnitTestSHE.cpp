@@ -55,6 +55,7 @@ enum TEST_CASE_TYPE {
     METADATA,
     EVALSUM_ALL,
     KS_SINGLE_CRT,
+    KS_MANY,
     KS_MOD_REDUCE_DCRT,
     EVALSQUARE,
     RING_DIM_ERROR_HANDLING
@@ -90,6 +91,9 @@ static std::ostream& operator<<(std::ostream& os, const TEST_CASE_TYPE& type) {
         case KS_SINGLE_CRT:
             typeName = "KS_SINGLE_CRT";
             break;
+        case KS_MANY:
+            typeName = "KS_MANY";
+            break;
         case KS_MOD_REDUCE_DCRT:
             typeName = "KS_MOD_REDUCE_DCRT";
             break;
@@ -446,6 +450,11 @@ static std::vector<TEST_CASE_UTGENERAL_SHE> testCases = {
     { KS_SINGLE_CRT, "03", {BGVRNS_SCHEME, 1<<13,     1,         DFLT,     1,     DFLT,    DFLT,       DFLT,          DFLT,     DFLT,    DFLT,   FLEXIBLEAUTO,    DFLT,    256,     4,      DFLT,      DFLT, DFLT,     STANDARD,  DFLT}, },
     { KS_SINGLE_CRT, "04", {BGVRNS_SCHEME, 1<<13,     1,         DFLT,     1,     DFLT,    DFLT,       DFLT,          DFLT,     DFLT,    DFLT,   FLEXIBLEAUTOEXT, DFLT,    256,     4,      DFLT,      DFLT, DFLT,     STANDARD,  DFLT}, },
     // ==========================================
+    // TestType, Descr, Scheme,       RDim,      MultDepth, SModSize, DSize,    BatchSz, SecKeyDist, MaxRelinSkDeg, FModSize, SecLvl,  KSTech, ScalTech,        LDigits, PtMod,   StdDev, EvalAddCt, KSCt, MultTech, EncTech,   PREMode
+    { KS_MANY,   "01", {BGVRNS_SCHEME, 1<<13,     1,         DFLT,     1,        DFLT,    DFLT,       DFLT,          DFLT,     DFLT,    DFLT,   FIXEDMANUAL,     DFLT,    256,     4,      DFLT,      DFLT, DFLT,     STANDARD,  DFLT}, },
+    { KS_MANY,   "02", {BGVRNS_SCHEME, 1<<13,     1,         DFLT,     1,        DFLT,    DFLT,       DFLT,          DFLT,     DFLT,    DFLT,   FLEXIBLEAUTO,    DFLT,    256,     4,      DFLT,      DFLT, DFLT,     STANDARD,  DFLT}, },
+    { KS_MANY,   "03", {BGVRNS_SCHEME, 1<<13,     1,         DFLT,     BV_DSIZE, DFLT,    DFLT,       DFLT,          DFLT,     DFLT,    BV,     FIXEDMANUAL,     DFLT,    256,     4,      DFLT,      DFLT, DFLT,     STANDARD,  DFLT}, },
+    // ==========================================
     // TestType,           Descr, Scheme,       RDim,      MultDepth, SModSize, DSize, BatchSz, SecKeyDist, MaxRelinSkDeg, FModSize, SecLvl,  KSTech, ScalTech,        LDigits, PtMod,   StdDev, EvalAddCt, KSCt, MultTech, EncTech,   PREMode
     { KS_MOD_REDUCE_DCRT, "01", {BGVRNS_SCHEME, 1<<13,     1,         DFLT,     1,     DFLT,    DFLT,       DFLT,          DFLT,     DFLT,    DFLT,   FIXEDMANUAL,     DFLT,    256,     4,      DFLT,      DFLT, DFLT,     STANDARD,  DFLT}, },
     // Calling ModReduce in the AUTO modes doesn't do anything because we automatically mod reduce before multiplication,
@@ -1103,6 +1112,46 @@ protected:
         }
     }
 
+    void UnitTest_Keyswitch_Many(const TEST_CASE_UTGENERAL_SHE& testData, const std::string& failmsg = std::string()) {
+        try {
+            CryptoContext<Element> cc(UnitTestGenerateContext(testData.params));
+
+            Plaintext plaintext  = cc->MakeStringPlaintext("I am good, what are you?! 32 ch");
+            KeyPair<DCRTPoly> kp = cc->KeyGen();
+
+            Ciphertext<DCRTPoly> ciphertext = cc->Encrypt(kp.publicKey, plaintext);
+
+            std::vector<KeyPair<DCRTPoly>> newKeys;
+            std::vector<EvalKey<DCRTPoly>> keySwitchHints;
+            for (size_t i = 0; i < 3; ++i) {
+                newKeys.push_back(cc->KeyGen());
+                keySwitchHints.push_back(cc->KeySwitchGen(kp.secretKey, newKeys.back().secretKey));
+            }
+
+            std::vector<Ciphertext<DCRTPoly>> newCts = cc->KeySwitchMany(ciphertext, keySwitchHints);
+            ASSERT_EQ(newCts.size(), keySwitchHints.size()) << failmsg;
+
+            for (size_t i = 0; i < newCts.size(); ++i) {
+                Ciphertext<DCRTPoly> expected = cc->KeySwitch(ciphertext, keySwitchHints[i]);
+                EXPECT_EQ(expected->GetElements(), newCts[i]->GetElements())
+                    << failmsg << " KeySwitchMany differs from KeySwitch for key " << i;
+
+                Plaintext plaintextNew;
+                cc->Decrypt(newKeys[i].secretKey, newCts[i], &plaintextNew);
+                EXPECT_EQ(plaintext->GetStringValue(), plaintextNew->GetStringValue())
+                    << failmsg << " Key-Switched Decrypt fails for key " << i;
+            }
+        }
+        catch (std::exception& e) {
+            std::cerr << "Exception thrown from " << __func__ << "(): " << e.what() << std::endl;
+            // make it fail
+            EXPECT_TRUE(0 == 1) << failmsg;
+        }
+        catch (...) {
+            UNIT_TEST_HANDLE_ALL_EXCEPTIONS;
+        }
+    }
+
     void UnitTest_Keyswitch_ModReduce_DCRT(const TEST_CASE_UTGENERAL_SHE& testData,
                                            const std::string& failmsg = std::string()) {
         try {
@@ -1261,6 +1310,9 @@ TEST_P(UTGENERAL_SHE, SHE) {
         case KS_SINGLE_CRT:
             UnitTest_Keyswitch_SingleCRT(test, test.buildTestName());
             break;
+        case KS_MANY:
+            UnitTest_Keyswitch_Many(test, test.buildTestName());
+            break;
         case KS_MOD_REDUCE_DCRT:
             UnitTest_Keyswitch_ModReduce_DCRT(test, test.buildTestName());
             break;
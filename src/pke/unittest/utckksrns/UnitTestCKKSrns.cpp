@@ -53,6 +53,7 @@ enum TEST_CASE_TYPE {
     AUTO_LEVEL_REDUCE,
     COMPRESS,
     EVAL_FAST_ROTATION,
+    EVAL_FAST_ROTATION_EXT,
     EVALATINDEX,
     EVALMERGE,
     EVAL_LINEAR_WSUM,
@@ -86,6 +87,9 @@ static std::ostream& operator<<(std::ostream& os, const TEST_CASE_TYPE& type) {
         case EVAL_FAST_ROTATION:
             typeName = "EVAL_FAST_ROTATION";
             break;
+        case EVAL_FAST_ROTATION_EXT:
+            typeName = "EVAL_FAST_ROTATION_EXT";
+            break;
         case EVALATINDEX:
             typeName = "EVALATINDEX";
             break;
@@ -404,6 +408,14 @@ static std::vector<TEST_CASE_UTCKKSRNS> testCases = {
     { EVAL_FAST_ROTATION, "46", {CKKSRNS_SCHEME, RING_DIM, 7,     DFLT,     DSIZE, BATCH,   DFLT,       DFLT,          DFLT,     HEStd_NotSet, HYBRID, FLEXIBLEAUTO,    DFLT,    DFLT,  DFLT,   DFLT,      DFLT, DFLT,     DFLT,    DFLT},   RING_DIM_HALF},
     { EVAL_FAST_ROTATION, "47", {CKKSRNS_SCHEME, RING_DIM, 7,     DFLT,     DSIZE, BATCH,   DFLT,       DFLT,          DFLT,     HEStd_NotSet, BV,     FLEXIBLEAUTOEXT, DFLT,    DFLT,  DFLT,   DFLT,      DFLT, DFLT,     DFLT,    DFLT},   RING_DIM_HALF},
     { EVAL_FAST_ROTATION, "48", {CKKSRNS_SCHEME, RING_DIM, 7,     DFLT,     DSIZE, BATCH,   DFLT,       DFLT,          DFLT,     HEStd_NotSet, HYBRID, FLEXIBLEAUTOEXT, DFLT,    DFLT,  DFLT,   DFLT,      DFLT, DFLT,     DFLT,    DFLT},   RING_DIM_HALF},
+#endif
+    // ==========================================
+    // TestType,             Descr, Scheme,         RDim, MultDepth, SModSize, DSize, BatchSz, SecKeyDist, MaxRelinSkDeg, FModSize, SecLvl,       KSTech, ScalTech,        LDigits, PtMod, StdDev, EvalAddCt, KSCt, MultTech, EncTech, PREMode, Slots
+    { EVAL_FAST_ROTATION_EXT, "01", {CKKSRNS_SCHEME, RING_DIM, 7,     DFLT,     DSIZE, BATCH,   DFLT,       DFLT,          DFLT,     HEStd_NotSet, HYBRID, FIXEDMANUAL,     DFLT,    DFLT,  DFLT,   DFLT,      DFLT, DFLT,     DFLT,    DFLT},   0},
+    { EVAL_FAST_ROTATION_EXT, "02", {CKKSRNS_SCHEME, RING_DIM, 7,     DFLT,     DSIZE, BATCH,   DFLT,       DFLT,          DFLT,     HEStd_NotSet, HYBRID, FIXEDAUTO,       DFLT,    DFLT,  DFLT,   DFLT,      DFLT, DFLT,     DFLT,    DFLT},   0},
+    { EVAL_FAST_ROTATION_EXT, "03", {CKKSRNS_SCHEME, RING_DIM, 7,     DFLT,     DSIZE, BATCH,   DFLT,       DFLT,          DFLT,     HEStd_NotSet, HYBRID, FIXEDMANUAL,     DFLT,    DFLT,  DFLT,   DFLT,      DFLT, DFLT,     DFLT,    DFLT},   RING_DIM_HALF},
+#if NATIVEINT != 128
+    { EVAL_FAST_ROTATION_EXT, "04", {CKKSRNS_SCHEME, RING_DIM, 7,     DFLT,     DSIZE, BATCH,   DFLT,       DFLT,          DFLT,     HEStd_NotSet, HYBRID, FLEXIBLEAUTO,    DFLT,    DFLT,  DFLT,   DFLT,      DFLT, DFLT,     DFLT,    DFLT},   0},
 #endif
     // ==========================================
     // TestType,  Descr,  Scheme,         RDim, MultDepth, SModSize, DSize, BatchSz, SecKeyDist, MaxRelinSkDeg, FModSize, SecLvl,       KSTech, ScalTech,        LDigits, PtMod, StdDev, EvalAddCt, KSCt, MultTech, EncTech, PREMode, Slots
@@ -1495,6 +1507,80 @@ protected:
         }
     }
 
+    void UnitTest_EvalFastRotationExt(const TEST_CASE_UTCKKSRNS& testData,
+                                      const std::string& failmsg = std::string()) {
+        try {
+            CryptoContext<Element> cc(UnitTestGenerateContext(testData.params));
+
+            uint32_t slots = (testData.slots != 0) ? testData.slots : (BATCH != 0) ? BATCH : cc->GetRingDimension() / 2;
+
+            const std::vector<int32_t> indices = {0, 2, -2, 5};
+
+            std::vector<std::complex<double>> vectorOfInts(slots);
+            for (uint32_t i = 0; i < slots; i++) {
+                vectorOfInts[i] = rand() % 10;  // NOLINT
+            }
+            Plaintext plaintext = cc->MakeCKKSPackedPlaintext(vectorOfInts, 1, 0, nullptr, testData.slots);
+
+            // computes sum_k rot_{indices[k]}(x) * w_k in the clear
+            std::vector<std::vector<std::complex<double>>> weights(indices.size(),
+                                                                   std::vector<std::complex<double>>(slots));
+            std::vector<std::complex<double>> expected(slots);
+            for (size_t k = 0; k < indices.size(); k++) {
+                for (uint32_t i = 0; i < slots; i++) {
+                    weights[k][i] = (rand() % 10) / 10.0;  // NOLINT
+                    expected[i] += vectorOfInts[(i + slots + indices[k] % int32_t(slots)) % slots] * weights[k][i];
+                }
+            }
+            Plaintext plaintextExpected = cc->MakeCKKSPackedPlaintext(expected, 1, 0, nullptr, testData.slots);
+
+            KeyPair<Element> kp = cc->KeyGen();
+            cc->EvalAtIndexKeyGen(kp.secretKey, {2, -2, 5});
+
+            Ciphertext<Element> ciphertext = cc->Encrypt(kp.publicKey, plaintext);
+
+            // accumulates all terms in the extended basis P*Q and does a single ModDown
+            auto digits = cc->EvalFastRotationPrecompute(ciphertext);
+            Ciphertext<Element> acc;
+            for (size_t k = 0; k < indices.size(); k++) {
+                Plaintext weight =
+                    cc->MakeCKKSPackedPlaintextExt(weights[k], 1, ciphertext->GetLevel(), testData.slots);
+                Ciphertext<Element> rotated = (indices[k] == 0) ?
+                                                  cc->KeySwitchExt(ciphertext, true) :
+                                                  cc->EvalFastRotationExt(ciphertext, indices[k], digits, true);
+                Ciphertext<Element> term = cc->EvalMultExt(rotated, weight);
+                if (k == 0)
+                    acc = term;
+                else
+                    cc->EvalAddExtInPlace(acc, term);
+            }
+            Ciphertext<Element> cResult = cc->KeySwitchDown(acc);
+
+            Plaintext results;
+            cc->Decrypt(kp.secretKey, cResult, &results);
+            results->SetLength(plaintextExpected->GetLength());
+            checkEquality(plaintextExpected->GetCKKSPackedValue(), results->GetCKKSPackedValue(), eps,
+                          failmsg + " EvalMultExt/EvalAddExtInPlace/KeySwitchDown fails");
+
+            // EvalAddExt gives the same result as EvalAddExtInPlace
+            Ciphertext<Element> doubled = cc->KeySwitchDown(cc->EvalAddExt(acc, acc));
+            cc->Decrypt(kp.secretKey, doubled, &results);
+            results->SetLength(plaintextExpected->GetLength());
+            std::vector<std::complex<double>> expectedDoubled(expected);
+            for (auto& v : expectedDoubled)
+                v *= 2;
+            checkEquality(expectedDoubled, results->GetCKKSPackedValue(), eps, failmsg + " EvalAddExt fails");
+        }
+        catch (std::exception& e) {
+            std::cerr << "Exception thrown from " << __func__ << "(): " << e.what() << std::endl;
+            // make it fail
+            EXPECT_TRUE(0 == 1) << failmsg;
+        }
+        catch (...) {
+            UNIT_TEST_HANDLE_ALL_EXCEPTIONS;
+        }
+    }
+
     void UnitTest_EvalAtIndex(const TEST_CASE_UTCKKSRNS& testData, const std::string& failmsg = std::string()) {
         try {
             CryptoContext<Element> cc(UnitTestGenerateContext(testData.params));
@@ -2130,6 +2216,9 @@ TEST_P(UTCKKSRNS, CKKSRNS) {
         case EVAL_FAST_ROTATION:
             UnitTest_EvalFastRotation(test, test.buildTestName());
             break;
+        case EVAL_FAST_ROTATION_EXT:
+            UnitTest_EvalFastRotationExt(test, test.buildTestName());
+            break;
         case EVALATINDEX:
             UnitTest_EvalAtIndex(test, test.buildTestName());
             break;
@@ -34,12 +34,15 @@
 #include "UnitTestCCParams.h"
 #include "UnitTestCryptoContext.h"
 
+#include <cstring>
 #include <iostream>
 #include <vector>
 #include "gtest/gtest.h"
 
 #include "ciphertext-ser.h"
 #include "cryptocontext-ser.h"
+#include "key/key-ser.h"
+#include "raw-ser.h"
 #include "scheme/ckksrns/ckksrns-ser.h"
 #include "globals.h"  // for SERIALIZE_PRECOMPUTE
 
@@ -50,6 +53,8 @@ enum TEST_CASE_TYPE {
     CONTEXT_WITH_SERTYPE = 0,
     KEYS_AND_CIPHERTEXTS,
     NO_CRT_TABLES,
+    RAW_SERTYPE,
+    SEED_COMPRESSION,
 };
 
 static std::ostream& operator<<(std::ostream& os, const TEST_CASE_TYPE& type) {
@@ -64,6 +69,12 @@ static std::ostream& operator<<(std::ostream& os, const TEST_CASE_TYPE& type) {
         case NO_CRT_TABLES:
             typeName = "NO_CRT_TABLES";
             break;
+        case RAW_SERTYPE:
+            typeName = "RAW_SERTYPE";
+            break;
+        case SEED_COMPRESSION:
+            typeName = "SEED_COMPRESSION";
+            break;
         default:
             typeName = "UNKNOWN";
             break;
@@ -168,6 +179,19 @@ static std::vector<TEST_CASE_UTCKKSRNS_SER> testCases = {
     { NO_CRT_TABLES, "08", {CKKSRNS_SCHEME, RING_DIM, MULT_DEPTH, SMODSIZE, 0,     BATCH,   DFLT,       DFLT,          DFLT,     HEStd_NotSet, HYBRID, FLEXIBLEAUTOEXT, DFLT,    DFLT,  DFLT,   DFLT,      DFLT, DFLT,      DFLT,    DFLT}, },
 #endif
     // ==========================================
+    // TestType,  Descr, Scheme,         RDim,     MultDepth,  SModSize, DSize, BatchSz, SecKeyDist, MaxRelinSkDeg, FModSize, SecLvl,       KSTech, ScalTech,        LDigits, PtMod, StdDev, EvalAddCt, KSCt, MultTech,  EncTech, PREMode
+    { RAW_SERTYPE, "01", {CKKSRNS_SCHEME, RING_DIM, MULT_DEPTH, SMODSIZE, 0,     BATCH,   DFLT,       DFLT,          DFLT,     HEStd_NotSet, BV,     FIXEDMANUAL,     DFLT,    DFLT,  DFLT,   DFLT,      DFLT, DFLT,      DFLT,    DFLT}, },
+    { RAW_SERTYPE, "02", {CKKSRNS_SCHEME, RING_DIM, MULT_DEPTH, SMODSIZE, 0,     BATCH,   DFLT,       DFLT,          DFLT,     HEStd_NotSet, HYBRID, FIXEDMANUAL,     DFLT,    DFLT,  DFLT,   DFLT,      DFLT, DFLT,      DFLT,    DFLT}, },
+#if NATIVEINT != 128
+    { RAW_SERTYPE, "03", {CKKSRNS_SCHEME, RING_DIM, MULT_DEPTH, SMODSIZE, 0,     BATCH,   DFLT,       DFLT,          DFLT,     HEStd_NotSet, BV,     FLEXIBLEAUTO,    DFLT,    DFLT,  DFLT,   DFLT,      DFLT, DFLT,      DFLT,    DFLT}, },
+    { RAW_SERTYPE, "04", {CKKSRNS_SCHEME, RING_DIM, MULT_DEPTH, SMODSIZE, 0,     BATCH,   DFLT,       DFLT,          DFLT,     HEStd_NotSet, HYBRID, FLEXIBLEAUTO,    DFLT,    DFLT,  DFLT,   DFLT,      DFLT, DFLT,      DFLT,    DFLT}, },
+#endif
+    // ==========================================
+    // TestType,       Descr, Scheme,         RDim,     MultDepth,  SModSize, DSize, BatchSz, SecKeyDist, MaxRelinSkDeg, FModSize, SecLvl,       KSTech, ScalTech,        LDigits, PtMod, StdDev, EvalAddCt, KSCt, MultTech,  EncTech, PREMode
+    { SEED_COMPRESSION, "01", {CKKSRNS_SCHEME, RING_DIM, MULT_DEPTH, SMODSIZE, 0,     BATCH,   DFLT,       DFLT,          DFLT,     HEStd_NotSet, BV,     FIXEDMANUAL,     DFLT,    DFLT,  DFLT,   DFLT,      DFLT, DFLT,      DFLT,    DFLT}, },
+    { SEED_COMPRESSION, "02", {CKKSRNS_SCHEME, RING_DIM, MULT_DEPTH, SMODSIZE, DSIZE, BATCH,   DFLT,       DFLT,          DFLT,     HEStd_NotSet, BV,     FIXEDMANUAL,     DFLT,    DFLT,  DFLT,   DFLT,      DFLT, DFLT,      DFLT,    DFLT}, },
+    { SEED_COMPRESSION, "03", {CKKSRNS_SCHEME, RING_DIM, MULT_DEPTH, SMODSIZE, 0,     BATCH,   DFLT,       DFLT,          DFLT,     HEStd_NotSet, HYBRID, FIXEDMANUAL,     DFLT,    DFLT,  DFLT,   DFLT,      DFLT, DFLT,      DFLT,    DFLT}, },
+    // ==========================================
 };
 // clang-format on
 //===========================================================================================================
@@ -455,6 +479,182 @@ protected:
         TestDecryptionSerNoCRTTables(testData, SerType::JSON, "json");
         TestDecryptionSerNoCRTTables(testData, SerType::BINARY, "binary");
     }
+
+    void UnitTestRawSer(const TEST_CASE_UTCKKSRNS_SER& testData, const std::string& failmsg = std::string()) {
+        try {
+            CryptoContext<Element> cc(UnitTestGenerateContext(testData.params));
+
+            KeyPair<Element> kp = cc->KeyGen();
+            cc->EvalMultKeyGen(kp.secretKey);
+            EvalKey<Element> evalKey = cc->GetEvalMultKeyVector(kp.secretKey->GetKeyTag())[0];
+
+            std::vector<std::complex<double>> vals = {1.0, 3.0, 5.0, 7.0, 9.0, 2.0, 4.0, 6.0, 8.0, 11.0};
+            Plaintext plaintext                    = cc->MakeCKKSPackedPlaintext(vals);
+            Ciphertext<Element> ciphertext         = cc->Encrypt(kp.publicKey, plaintext);
+            // a ciphertext with fewer towers and a higher noise scale degree
+            Ciphertext<Element> ciphertextMult = cc->EvalMult(ciphertext, ciphertext);
+            if (testData.params.scalTech == FIXEDMANUAL)
+                ciphertextMult = cc->Rescale(ciphertextMult);
+
+            for (const auto& ct : {ciphertext, ciphertextMult}) {
+                std::stringstream s;
+                Serial::Serialize(ct, s, SerType::RAW);
+                Ciphertext<Element> newC;
+                Serial::Deserialize(newC, s, SerType::RAW);
+                ASSERT_TRUE(newC) << failmsg << " ciphertext deserialize failed";
+                EXPECT_EQ(*ct, *newC) << failmsg << " ciphertext mismatch after ser/deser";
+                EXPECT_EQ(ct->GetCryptoContext(), newC->GetCryptoContext()) << failmsg << " context mismatch";
+            }
+
+            {
+                std::stringstream s;
+                Serial::Serialize(evalKey, s, SerType::RAW);
+                EvalKey<Element> newKey;
+                Serial::Deserialize(newKey, s, SerType::RAW);
+                ASSERT_TRUE(newKey) << failmsg << " eval key deserialize failed";
+                EXPECT_EQ(*evalKey, *newKey) << failmsg << " eval key mismatch after ser/deser";
+            }
+
+            {
+                std::stringstream s;
+                Serial::Serialize(ciphertext, s, SerType::RAW);
+                Ciphertext<Element> newC;
+                Serial::Deserialize(newC, s, SerType::RAW);
+                // the element params of the context are reused rather than rebuilt from the stream
+                const auto& elementParams = cc->GetCryptoParameters()->GetElementParams();
+                if (newC->GetElements()[0].GetNumOfElements() == elementParams->GetParams().size()) {
+                    EXPECT_EQ(newC->GetElements()[0].GetParams(), elementParams) << failmsg << " params not reused";
+                }
+                Plaintext result;
+                cc->Decrypt(kp.secretKey, newC, &result);
+                result->SetLength(plaintext->GetLength());
+                checkEquality(plaintext->GetCKKSPackedValue(), result->GetCKKSPackedValue(), eps,
+                              failmsg + " Decryption Failed");
+            }
+
+            {
+                // corrupt streams are rejected before anything is allocated from their headers
+                std::stringstream s;
+                Serial::Serialize(ciphertext, s, SerType::RAW);
+                const std::string original = s.str();
+                auto deserializePatched    = [&](size_t offset, uint32_t value, size_t size) {
+                    std::string patched = original.substr(0, size);
+                    if (offset + sizeof(value) <= size)
+                        std::memcpy(&patched[offset], &value, sizeof(value));
+                    std::stringstream in(patched);
+                    Ciphertext<Element> newC;
+                    Serial::Deserialize(newC, in, SerType::RAW);
+                };
+                // the object header (magic, byte order mark, five 32-bit fields and the context id) and the
+                // ciphertext header come before the header of the polynomials, whose third field is numTowers;
+                // the moduli follow that header
+                const size_t byteOrderOffset = 8;
+                const size_t numTowersOffset = 40 + kp.secretKey->GetKeyTag().size() + 40 + 8;
+                const size_t modulusOffset   = numTowersOffset + 8;
+                EXPECT_THROW(deserializePatched(byteOrderOffset, 0x04030201, original.size()), OpenFHEException)
+                    << failmsg << " byte order";
+                EXPECT_THROW(deserializePatched(numTowersOffset, 0xFFFFFFFF, original.size()), OpenFHEException)
+                    << failmsg << " number of towers";
+                EXPECT_THROW(deserializePatched(modulusOffset, 1, original.size()), OpenFHEException)
+                    << failmsg << " modulus not in the context";
+                EXPECT_THROW(deserializePatched(original.size(), 0, original.size() - 8), OpenFHEException)
+                    << failmsg << " truncated stream";
+                EXPECT_NO_THROW(deserializePatched(original.size(), 0, original.size())) << failmsg;
+            }
+
+            {
+                // the stream was produced for a context that is no longer registered
+                std::stringstream s;
+                Serial::Serialize(ciphertext, s, SerType::RAW);
+                CryptoContextFactory<DCRTPoly>::ReleaseAllContexts();
+                Ciphertext<Element> newC;
+                EXPECT_THROW(Serial::Deserialize(newC, s, SerType::RAW), OpenFHEException) << failmsg;
+            }
+        }
+        catch (std::exception& e) {
+            std::cerr << "Exception thrown from " << __func__ << "(): " << e.what() << std::endl;
+            // make it fail
+            EXPECT_TRUE(0 == 1) << failmsg;
+        }
+        catch (...) {
+            UNIT_TEST_HANDLE_ALL_EXCEPTIONS;
+        }
+    }
+
+    template <typename T>
+    static size_t SerializedSize(const T& obj) {
+        std::stringstream s;
+        Serial::Serialize(obj, s, SerType::BINARY);
+        return s.str().size();
+    }
+
+    void UnitTestSeedCompression(const TEST_CASE_UTCKKSRNS_SER& testData, const std::string& failmsg = std::string()) {
+        try {
+            CryptoContext<Element> cc(UnitTestGenerateContext(testData.params));
+            KeyPair<Element> kp = cc->KeyGen();
+
+            std::vector<std::complex<double>> vals = {1.0, 3.0, 5.0, 7.0, 9.0, 2.0, 4.0, 6.0, 8.0, 11.0};
+            Plaintext plaintext                    = cc->MakeCKKSPackedPlaintext(vals);
+
+            EvalKey<Element> fullKey = cc->KeySwitchGen(kp.secretKey, kp.secretKey);
+            Ciphertext<Element> full = cc->Encrypt(kp.secretKey, plaintext);
+
+            EnableSeedCompression();
+            EvalKey<Element> seededKey = cc->KeySwitchGen(kp.secretKey, kp.secretKey);
+            Ciphertext<Element> seeded = cc->Encrypt(kp.secretKey, plaintext);
+            DisableSeedCompression();
+
+            EXPECT_LT(SerializedSize(seededKey), SerializedSize(fullKey)) << failmsg << " eval key is not compressed";
+            EXPECT_LT(SerializedSize(seeded), SerializedSize(full)) << failmsg << " ciphertext is not compressed";
+
+            {
+                std::stringstream s;
+                Serial::Serialize(seededKey, s, SerType::BINARY);
+                EvalKey<Element> newKey;
+                Serial::Deserialize(newKey, s, SerType::BINARY);
+                ASSERT_TRUE(newKey) << failmsg << " eval key deserialize failed";
+                EXPECT_EQ(*seededKey, *newKey) << failmsg << " eval key mismatch after ser/deser";
+            }
+
+            {
+                std::stringstream s;
+                Serial::Serialize(seeded, s, SerType::BINARY);
+                Ciphertext<Element> newC;
+                Serial::Deserialize(newC, s, SerType::BINARY);
+                ASSERT_TRUE(newC) << failmsg << " ciphertext deserialize failed";
+                EXPECT_EQ(*seeded, *newC) << failmsg << " ciphertext mismatch after ser/deser";
+
+                Plaintext result;
+                cc->Decrypt(kp.secretKey, newC, &result);
+                result->SetLength(plaintext->GetLength());
+                checkEquality(plaintext->GetCKKSPackedValue(), result->GetCKKSPackedValue(), eps,
+                              failmsg + " Decryption Failed");
+            }
+
+            {
+                // a ciphertext derived from a seeded one is serialized in full
+                Ciphertext<Element> sum = cc->EvalAdd(seeded, seeded);
+                sum->SetSeed(*seeded->GetSeed());
+                EXPECT_FALSE(sum->IsSeedCompressible()) << failmsg;
+
+                std::stringstream s;
+                Serial::Serialize(sum, s, SerType::BINARY);
+                Ciphertext<Element> newC;
+                Serial::Deserialize(newC, s, SerType::BINARY);
+                EXPECT_EQ(*sum, *newC) << failmsg << " modified ciphertext mismatch after ser/deser";
+            }
+        }
+        catch (std::exception& e) {
+            DisableSeedCompression();
+            std::cerr << "Exception thrown from " << __func__ << "(): " << e.what() << std::endl;
+            // make it fail
+            EXPECT_TRUE(0 == 1) << failmsg;
+        }
+        catch (...) {
+            DisableSeedCompression();
+            UNIT_TEST_HANDLE_ALL_EXCEPTIONS;
+        }
+    }
 };
 //===========================================================================================================
 TEST_P(UTCKKSRNS_SER, CKKSSer) {
@@ -467,6 +667,10 @@ TEST_P(UTCKKSRNS_SER, CKKSSer) {
         UnitTestKeysAndCiphertexts(test, test.buildTestName());
     else if (test.testCaseType == NO_CRT_TABLES)
         UnitTestDecryptionSerNoCRTTables(test, test.buildTestName());
+    else if (test.testCaseType == RAW_SERTYPE)
+        UnitTestRawSer(test, test.buildTestName());
+    else if (test.testCaseType == SEED_COMPRESSION)
+        UnitTestSeedCompression(test, test.buildTestName());
 }
 
 INSTANTIATE_TEST_SUITE_P(UnitTests, UTCKKSRNS_SER, ::testing::ValuesIn(testCases), testName);